@@ -0,0 +1,84 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "flint.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define HAVE_CPUID 1
+#else
+#define HAVE_CPUID 0
+#endif
+
+static volatile int cpu_features_detected = -1;
+static volatile int cpu_features_allowed = -1;
+
+static int cpu_detect(void)
+{
+    int features = 0;
+#if HAVE_CPUID
+    unsigned int a, b, c, d, xcr0;
+
+    if (__get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid(1, a, b, c, d);
+
+    /* AVX, and OSXSAVE so that xgetbv is available */
+    if ((c & (1U << 27)) == 0 || (c & (1U << 28)) == 0)
+        return 0;
+
+    /* xgetbv, as bytes for old assemblers; the OS must save ymm/zmm state */
+    __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0"
+                          : "=a" (xcr0), "=d" (d) : "c" (0));
+
+    if ((xcr0 & 6) != 6)
+        return 0;
+
+    __cpuid_count(7, 0, a, b, c, d);
+
+    if (b & (1U << 5))
+        features |= FLINT_CPU_AVX2;
+
+    if ((xcr0 & 0xe6) == 0xe6 && (b & (1U << 16)))
+    {
+        features |= FLINT_CPU_AVX512;
+
+        if (b & (1U << 21))
+            features |= FLINT_CPU_AVX512IFMA;
+    }
+#endif
+
+    return features;
+}
+
+int flint_cpu_features(void)
+{
+    /* detection is idempotent, so racing threads do no harm */
+    if (cpu_features_detected == -1)
+        cpu_features_detected = cpu_detect();
+
+    return cpu_features_detected & cpu_features_allowed;
+}
+
+void flint_set_cpu_features(int features)
+{
+    cpu_features_allowed = features;
+}
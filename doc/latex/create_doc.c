@@ -78,6 +78,7 @@ static char * docsin[] = {
     "../../fft/doc/fft.txt",
     "../../qsieve/doc/qsieve.txt",
     "../../perm/doc/perm.txt",
+    "../../thread_pool/doc/thread_pool.txt",
     "../../flintxx/doc/flintxx.txt",
     "../../flintxx/doc/genericxx.txt",
 };
@@ -131,6 +132,7 @@ static char * docsout[] = {
     "input/fft.tex",
     "input/qsieve.tex",
     "input/perm.tex",
+    "input/thread_pool.tex",
     "input/flintxx.tex",
     "input/genericxx.tex",
 };
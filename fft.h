@@ -47,6 +47,7 @@ or implied, of William Hart.
 #define ulong mp_limb_t
 #include "flint.h"
 #include "mpn_extras.h"
+#include "thread_pool.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -212,6 +213,9 @@ FLINT_DLL void ifft_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
 FLINT_DLL void mul_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, mp_bitcnt_t w);
 
+FLINT_DLL void sqr_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                          mp_bitcnt_t depth, mp_bitcnt_t w);
+
 FLINT_DLL void fft_butterfly_twiddle(mp_limb_t * u, mp_limb_t * v, 
    mp_limb_t * s, mp_limb_t * t, mp_size_t limbs, mp_bitcnt_t b1, mp_bitcnt_t b2);
 
@@ -245,6 +249,9 @@ FLINT_DLL void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
 FLINT_DLL void mul_mfa_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, mp_bitcnt_t w);
 
+FLINT_DLL void sqr_mfa_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                          mp_bitcnt_t depth, mp_bitcnt_t w);
+
 FLINT_DLL void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
                       mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
                                 mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc);
@@ -257,6 +264,89 @@ FLINT_DLL void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
                         mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
                                 mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc);
 
+/* storage for the matrix fourier passes, spilt to a file if too large */
+
+typedef struct
+{
+   char * ptr;
+   size_t bytes;
+   int fd;                  /* scratch file, or -1 if the storage is in memory */
+   size_t page;
+   size_t block;            /* bytes worked on between releases, or 0 */
+} fft_scratch_struct;
+
+typedef fft_scratch_struct fft_scratch_t[1];
+
+FLINT_DLL void fft_set_memory_limit(size_t limit, const char * dir);
+
+FLINT_DLL void * _fft_scratch_init(fft_scratch_t S, size_t bytes);
+
+FLINT_DLL void _fft_scratch_clear(fft_scratch_t S);
+
+FLINT_DLL void _fft_scratch_release(fft_scratch_t S, void * start, size_t bytes);
+
+/* the matrix fourier passes work on rows and columns in parallel */
+
+typedef struct
+{
+   mp_limb_t ** ii;
+   mp_limb_t ** jj;
+   mp_size_t n;
+   mp_bitcnt_t w;
+   mp_limb_t ** t1;
+   mp_limb_t ** t2;
+   mp_limb_t ** temp;
+   mp_limb_t * tt;
+   mp_size_t n1;
+   mp_size_t n2;
+   mp_size_t trunc;
+   mp_size_t trunc2;        /* relevant rows of the truncated half */
+   mp_size_t half;          /* start of the truncated half, 0 or 2*n */
+   mp_size_t rows;          /* number of rows in the inner pass */
+   mp_size_t limbs;
+   mp_bitcnt_t depth;
+   mp_bitcnt_t depth2;
+   mp_size_t count;         /* number of rows or columns in the pass */
+   mp_size_t chunk;         /* number claimed at a time */
+   mp_size_t * next;        /* first unclaimed row or column */
+   pthread_mutex_t * mutex;
+   fft_scratch_struct * scratch; /* storage to release as the pass goes */
+   mp_size_t block;         /* most claimed at a time if spilling, or 0 */
+} fft_mfa_arg_struct;
+
+FLINT_DLL void _fft_mfa_arg_init(fft_mfa_arg_struct * arg, mp_limb_t ** ii,
+          mp_limb_t ** jj, mp_size_t n, mp_bitcnt_t w, mp_limb_t ** t1,
+                 mp_limb_t ** t2, mp_limb_t ** temp, mp_limb_t * tt,
+                                              mp_size_t n1, mp_size_t trunc);
+
+FLINT_DLL int _fft_mfa_claim(fft_mfa_arg_struct * arg,
+                                        mp_size_t * start, mp_size_t * stop);
+
+FLINT_DLL void _fft_mfa_run(thread_pool_fxn_t f,
+                                   fft_mfa_arg_struct * arg, mp_size_t count);
+
+FLINT_DLL void _fft_mfa_set_scratch(fft_mfa_arg_struct * arg,
+                                               fft_scratch_t S, int cols);
+
+FLINT_DLL void _fft_mfa_release_cols(fft_mfa_arg_struct * arg,
+                                             mp_size_t start, mp_size_t stop);
+
+FLINT_DLL void _fft_mfa_release_rows(fft_mfa_arg_struct * arg,
+                                             mp_size_t start, mp_size_t stop);
+
+FLINT_DLL void _fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
+                      mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, fft_scratch_t S);
+
+FLINT_DLL void _fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, 
+            mp_size_t n, mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t * tt,
+                                                              fft_scratch_t S);
+
+FLINT_DLL void _ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
+                        mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, fft_scratch_t S);
+
 FLINT_DLL void fft_negacyclic(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
                              mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp);
 
@@ -274,13 +364,186 @@ FLINT_DLL slong fft_adjust_limbs(mp_size_t limbs);
 FLINT_DLL void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2, 
                                         mp_size_t n, mp_size_t w, mp_limb_t * tt);
 
+FLINT_DLL mp_size_t _fft_mulmod_2expp1_temp_limbs(mp_bitcnt_t depth,
+                                                             mp_bitcnt_t w);
+
+FLINT_DLL void _fft_mulmod_2expp1_temp(mp_limb_t * r1, mp_limb_t * i1,
+                 mp_limb_t * i2, mp_size_t r_limbs, mp_bitcnt_t depth,
+                                          mp_bitcnt_t w, mp_limb_t * temp);
+
+FLINT_DLL int _fft_mulmod_2expp1_params(mp_bitcnt_t * depth1,
+                                mp_bitcnt_t * w1, mp_size_t n, mp_size_t w);
+
+FLINT_DLL void _fft_mulmod_2expp1_batch(mp_limb_t ** ii, mp_limb_t ** jj,
+             mp_size_t count, mp_size_t n, mp_bitcnt_t w, mp_limb_t * tt);
+
+FLINT_DLL void fft_mulmod_2expp1_batch(mp_limb_t ** ii, mp_limb_t ** jj,
+                              mp_size_t count, mp_size_t n, mp_bitcnt_t w);
+
 FLINT_DLL void flint_mpn_mul_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2);
 
+FLINT_DLL void flint_mpn_sqr_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1);
+
+FLINT_DLL mp_size_t fft_adjust_limbs_2expm1(mp_size_t limbs);
+
+FLINT_DLL void flint_mpn_mulmod_2expm1(mp_ptr r, mp_srcptr i1, mp_size_t n1,
+                          mp_srcptr i2, mp_size_t n2, mp_size_t limbs);
+
+FLINT_DLL int fft_mul_params(mp_bitcnt_t * depth, mp_bitcnt_t * w,
+                                 mp_size_t n1, mp_size_t n2, int threaded);
+
+/* an operand split and transformed once for many products */
+
+typedef struct
+{
+   mp_size_t n1;        /* limbs of the operand */
+   mp_size_t n2;        /* maximum limbs of the other operands */
+   mp_size_t j1;        /* number of coefficients of the operand */
+   mp_bitcnt_t depth;
+   mp_bitcnt_t w;
+   mp_size_t trunc;
+   int mfa;             /* whether the matrix fourier algorithm is used */
+   int threaded;
+   mp_limb_t ** jj;     /* the transformed coefficients, normalised */
+} fft_precache_struct;
+
+typedef fft_precache_struct fft_precache_t[1];
+
+FLINT_DLL void fft_precache_init(fft_precache_t P,
+                             mp_srcptr i1, mp_size_t n1, mp_size_t n2);
+
+FLINT_DLL void fft_precache_clear(fft_precache_t P);
+
+FLINT_DLL void fft_mul_precache(mp_ptr r1, mp_srcptr i2, mp_size_t n2,
+                                                  const fft_precache_t P);
+
 FLINT_DLL void fft_convolution(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
                                  slong limbs, slong trunc, mp_limb_t ** t1, 
                                 mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t * tt);
 
+FLINT_DLL void _fft_convolution_threaded(mp_limb_t ** ii, mp_limb_t ** jj,
+                                     slong depth, slong limbs, slong trunc);
+
+/* number theoretic transforms modulo word sized primes */
+
+#if FLINT_BITS == 64
+
+#define FFT_NTT 1
+
+#define FFT_NTT_NUM_PRIMES 4
+
+/* the primes are c*2^36 + 1 < 2^50 */
+#define FFT_NTT_MAX_DEPTH 36
+
+/* tables up to this depth are kept by fft_ntt_init_prime */
+#define FFT_NTT_CACHE_DEPTH 20
+
+FLINT_DLL extern const mp_limb_t fft_ntt_primes[FFT_NTT_NUM_PRIMES];
+FLINT_DLL extern const mp_limb_t fft_ntt_generators[FFT_NTT_NUM_PRIMES];
+
+typedef struct
+{
+   mp_limb_t p;
+   mp_limb_t pinv;
+   mp_bitcnt_t depth;
+   mp_limb_t * tw;      /* tw[m + j] = w^j for w a primitive 2m-th root */
+   mp_limb_t * twpre;   /* floor(tw[i]*2^64/p) */
+   mp_limb_t * itw;     /* inverses of tw */
+   mp_limb_t * itwpre;
+   int alloc;           /* whether the tables are owned */
+} fft_ntt_struct;
+
+typedef fft_ntt_struct fft_ntt_t[1];
+
+FLINT_DLL void fft_ntt_init(fft_ntt_t T, mp_limb_t p, mp_limb_t g,
+                                                          mp_bitcnt_t depth);
+
+FLINT_DLL void fft_ntt_init_prime(fft_ntt_t T, slong i, mp_bitcnt_t depth);
+
+FLINT_DLL void fft_ntt_clear(fft_ntt_t T);
+
+FLINT_DLL void fft_ntt(mp_limb_t * a, const fft_ntt_t T);
+
+FLINT_DLL void ifft_ntt(mp_limb_t * a, const fft_ntt_t T);
+
+FLINT_DLL void fft_ntt_mul(mp_limb_t * a, mp_srcptr i1, mp_size_t n1,
+                          mp_srcptr i2, mp_size_t n2, const fft_ntt_t T);
+
+FLINT_DLL void fft_ntt_mul_primes(mp_limb_t ** res, mp_srcptr i1, mp_size_t n1,
+          mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, int num_primes);
+
+FLINT_DLL void fft_ntt_mat22_mul(mp_limb_t ** c, mp_srcptr * a,
+                      const mp_size_t * na, mp_srcptr * b,
+                      const mp_size_t * nb, slong k, const fft_ntt_t T);
+
+FLINT_DLL void fft_ntt_mat22_mul_primes(mp_limb_t ** res, mp_srcptr * a,
+                      const mp_size_t * na, mp_srcptr * b,
+                      const mp_size_t * nb, slong k, mp_bitcnt_t depth,
+                                                         int num_primes);
+
+FLINT_DLL void _mul_ntt(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                   mp_srcptr i2, mp_size_t n2, int num_primes);
+
+FLINT_DLL void mul_ntt(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                                 mp_srcptr i2, mp_size_t n2);
+
+FLINT_DLL void _mul_ntt_2expm1(mp_ptr r, mp_srcptr i1, mp_size_t n1,
+                 mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, int num_primes);
+
+FLINT_DLL void sqr_ntt(mp_ptr r1, mp_srcptr i1, mp_size_t n1);
+
+FLINT_DLL void mul_ntt_mat22(mp_ptr * r, mp_srcptr * a, const mp_size_t * na,
+                           mp_srcptr * b, const mp_size_t * nb, slong k);
+
+#if defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define FFT_NTT_SIMD 1
+#else
+#define FFT_NTT_SIMD 0
+#endif
+
+#if FFT_NTT_SIMD
+
+FLINT_DLL void _fft_ntt_layer_ifma(mp_limb_t * a, mp_size_t len,
+            mp_size_t m, mp_srcptr tw, mp_srcptr twpre, mp_limb_t p);
+
+FLINT_DLL void _ifft_ntt_layer_ifma(mp_limb_t * a, mp_size_t len,
+            mp_size_t m, mp_srcptr tw, mp_srcptr twpre, mp_limb_t p);
+
+FLINT_DLL void _fft_ntt_base_ifma(mp_limb_t * a, mp_size_t len,
+                                 mp_srcptr tw, mp_srcptr twpre, mp_limb_t p);
+
+FLINT_DLL void _ifft_ntt_base_ifma(mp_limb_t * a, mp_size_t len,
+                                 mp_srcptr tw, mp_srcptr twpre, mp_limb_t p);
+
+FLINT_DLL void _fft_ntt_reduce_ifma(mp_limb_t * a, mp_srcptr x,
+          mp_size_t len, mp_limb_t c, mp_limb_t cpre, mp_limb_t p);
+
+FLINT_DLL void _fft_ntt_mul_ifma(mp_limb_t * a, mp_srcptr b, mp_size_t len,
+                     mp_limb_t c0, mp_limb_t c0pre, mp_limb_t c1,
+                                         mp_limb_t c1pre, mp_limb_t p);
+
+#endif
+
+#else
+
+#define FFT_NTT 0
+
+#endif
+
+/* whether flint_mpn_mul_fft_main passes a product of this size to mul_ntt */
+static __inline__
+int fft_mul_use_ntt(mp_size_t n1, mp_size_t n2)
+{
+#if FFT_NTT && FFT_NTT_SIMD
+   return n1 + n2 < flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] &&
+          (flint_cpu_features() & FLINT_CPU_AVX512IFMA);
+#else
+   return 0;
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,7 +36,12 @@ or implied, of William Hart.
 #include "fmpz_poly.h"
 #include "fft.h"
 
-void fft_convolution(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
+/*
+   The convolution proper. For depth > 6 the matrix Fourier passes use
+   flint_get_num_threads() threads, each with its own entry of t1, t2, s1
+   and its own 2*(limbs + 1) limbs of tt.
+*/
+static void _fft_convolution(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
                               slong limbs, slong trunc, mp_limb_t ** t1, 
                           mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t * tt)
 {
@@ -46,20 +51,13 @@ void fft_convolution(mp_limb_t ** ii, mp_limb_t ** jj, slong depth,
    
    if (depth <= 6)
    {
-      trunc = 2*((trunc + 1)/2);
-      
       fft_truncate_sqrt2(ii, n, w, t1, t2, s1, trunc);
    
       if (ii != jj)
          fft_truncate_sqrt2(jj, n, w, t1, t2, s1, trunc);
 
-      for (j = 0; j < trunc; j++)
-      {
-         mpn_normmod_2expp1(ii[j], limbs);
-         if (ii != jj) mpn_normmod_2expp1(jj[j], limbs);
-         
-         fft_mulmod_2expp1(ii[j], ii[j], jj[j], n, w, tt);
-      }
+      /* with few, large coefficients the pointwise products dominate */
+      fft_mulmod_2expp1_batch(ii, jj, trunc, n, w);
 
       ifft_truncate_sqrt2(ii, n, w, t1, t2, s1, trunc);
 
@@ -72,13 +70,67 @@ void fft_convolution(mp_limb_t ** ii, mp_limb_t ** jj, slong depth,
    {
       trunc = 2*sqrt*((trunc + 2*sqrt - 1)/(2*sqrt));
       
-      fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc);
+      _fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, NULL);
       
       if (ii != jj)
-         fft_mfa_truncate_sqrt2_outer(jj, n, w, t1, t2, s1, sqrt, trunc);
+         _fft_mfa_truncate_sqrt2_outer(jj, n, w, t1, t2, s1, sqrt, trunc, NULL);
       
-      fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, t1, t2, s1, sqrt, trunc, tt);
+      _fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, t1, t2, s1,
+                                                      sqrt, trunc, tt, NULL);
       
-      ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc);
+      _ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, NULL);
    }
 }
+
+void fft_convolution(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
+                              slong limbs, slong trunc, mp_limb_t ** t1, 
+                          mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t * tt)
+{
+   /* the caller supplies a single set of temporaries */
+   int num_threads = flint_limit_num_threads(1);
+
+   _fft_convolution(ii, jj, depth, limbs, trunc, t1, t2, s1, tt);
+
+   flint_restore_num_threads(num_threads);
+}
+
+void _fft_convolution_threaded(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
+                                                     slong limbs, slong trunc)
+{
+   slong n = (WORD(1)<<depth), size = limbs + 1, N, i, j;
+   mp_limb_t ** t1, ** t2, ** s1, * tt, * ptr;
+
+   /* only the matrix Fourier passes are shared between threads */
+   N = (depth <= 6) ? 1 : flint_get_num_threads();
+
+   t1 = flint_malloc(3*N*sizeof(mp_limb_t *) + 5*size*N*sizeof(mp_limb_t));
+   t2 = t1 + N;
+   s1 = t2 + N;
+   for (i = 0, ptr = (mp_limb_t *) (s1 + N); i < N; i++, ptr += 3*size)
+   {
+      t1[i] = ptr;
+      t2[i] = t1[i] + size;
+      s1[i] = t2[i] + size;
+   }
+   tt = ptr;
+
+   _fft_convolution(ii, jj, depth, limbs, trunc, t1, t2, s1, tt);
+
+   /*
+      coefficients may have been swapped into the temporaries, which are
+      freed here, so move them to the buffers swapped out in their place
+   */
+   for (i = 0, j = 0; i < 4*n; i++)
+   {
+      if (ii[i] >= (mp_limb_t *) (s1 + N) && ii[i] < tt)
+      {
+         while (t1[j] >= (mp_limb_t *) (s1 + N) && t1[j] < tt)
+            j++;
+
+         flint_mpn_copyi(t1[j], ii[i], size);
+         ii[i] = t1[j++];
+      }
+   }
+
+   flint_free(t1);
+}
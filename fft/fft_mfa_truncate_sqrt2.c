@@ -132,7 +132,7 @@ void fft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
 {
    mp_size_t i, j, s;
    mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
+   mp_size_t trunc2;
    mp_size_t limbs = (n*w)/FLINT_BITS;
    mp_bitcnt_t depth = 0;
    mp_bitcnt_t depth2 = 0;
@@ -140,72 +140,79 @@ void fft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
    while ((UWORD(1)<<depth) < n2) depth++;
    while ((UWORD(1)<<depth2) < n1) depth2++;
 
-   /* first half matrix fourier FFT : n2 rows, n1 cols */
+   if (trunc > 2*n)
+   {
+      trunc2 = (trunc - 2*n)/n1;
+
+      /* first half matrix fourier FFT : n2 rows, n1 cols */
    
-   /* FFTs on columns */
-   for (i = 0; i < n1; i++)
-   {   
-      /* relevant part of first layer of full sqrt2 FFT */
-      if (w & 1)
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            if (j & 1)
-               fft_butterfly_sqrt2(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w, *temp);
-            else
-               fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j/2, limbs, w);     
-
-            SWAP_PTRS(ii[j],     *t1);
-            SWAP_PTRS(ii[2*n+j], *t2);
-         }
+      /* FFTs on columns */
+      for (i = 0; i < n1; i++)
+      {   
+         /* relevant part of first layer of full sqrt2 FFT */
+         if (w & 1)
+         {
+            for (j = i; j < trunc - 2*n; j+=n1) 
+            {   
+               if (j & 1)
+                  fft_butterfly_sqrt2(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w, *temp);
+               else
+                  fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j/2, limbs, w);     
+
+               SWAP_PTRS(ii[j],     *t1);
+               SWAP_PTRS(ii[2*n+j], *t2);
+            }
 
-         for ( ; j < 2*n; j+=n1)
+            for ( ; j < 2*n; j+=n1)
+            {
+                if (i & 1)
+                   fft_adjust_sqrt2(ii[j + 2*n], ii[j], j, limbs, w, *temp); 
+                else
+                   fft_adjust(ii[j + 2*n], ii[j], j/2, limbs, w); 
+            }
+         } else
          {
-             if (i & 1)
-                fft_adjust_sqrt2(ii[j + 2*n], ii[j], j, limbs, w, *temp); 
-             else
-                fft_adjust(ii[j + 2*n], ii[j], j/2, limbs, w); 
-         }
-      } else
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w/2);
+            for (j = i; j < trunc - 2*n; j+=n1) 
+            {   
+               fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w/2);
    
-            SWAP_PTRS(ii[j],     *t1);
-            SWAP_PTRS(ii[2*n+j], *t2);
-         }
+               SWAP_PTRS(ii[j],     *t1);
+               SWAP_PTRS(ii[2*n+j], *t2);
+            }
 
-         for ( ; j < 2*n; j+=n1)
-            fft_adjust(ii[j + 2*n], ii[j], j, limbs, w/2);
-      }
+            for ( ; j < 2*n; j+=n1)
+               fft_adjust(ii[j + 2*n], ii[j], j, limbs, w/2);
+         }
    
-      /* 
-         FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
+         /* 
+            FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+            of 1 starting at row 0, where z => w bits
+         */
       
-      fft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+         fft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
+         for (j = 0; j < n2; j++)
+         {
+            mp_size_t s = n_revbin(j, depth);
+            if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+         }
       }
-   }
    
-   /* FFTs on rows */
-   for (i = 0; i < n2; i++)
-   {
-      fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
-      for (j = 0; j < n1; j++)
+      /* FFTs on rows */
+      for (i = 0; i < n2; i++)
       {
-         mp_size_t t = n_revbin(j, depth2);
-         if (j < t) SWAP_PTRS(ii[i*n1+j], ii[i*n1+t]);
+         fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
+         for (j = 0; j < n1; j++)
+         {
+            mp_size_t t = n_revbin(j, depth2);
+            if (j < t) SWAP_PTRS(ii[i*n1+j], ii[i*n1+t]);
+         }
       }
-   }
    
-   /* second half matrix fourier FFT : n2 rows, n1 cols */
-   ii += 2*n;
+      ii += 2*n;
+   } else /* the top half of the data is zero, so the sqrt2 layer is trivial */
+      trunc2 = trunc/n1;
+
+   /* truncated half matrix fourier FFT : n2 rows, n1 cols */
 
    /* FFTs on columns */
    for (i = 0; i < n1; i++)
@@ -237,89 +244,127 @@ void fft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
    }
 }
 
-void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
-                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
-                             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+/*
+   Column i of both halves of the outer layers. The first layer of the sqrt2
+   FFT only combines entries j and 2*n + j with j = i mod n1, so different
+   columns can be processed independently. If trunc <= 2*n only the first
+   half is transformed, and it is truncated.
+*/
+static void * _fft_outer_worker(void * arg_ptr)
 {
-   mp_size_t i, j;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_size_t limbs = (n*w)/FLINT_BITS;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   
-   while ((UWORD(1)<<depth) < n2) depth++;
-   while ((UWORD(1)<<depth2) < n1) depth2++;
+   fft_mfa_arg_struct * arg = (fft_mfa_arg_struct *) arg_ptr;
+   mp_limb_t ** ii = arg->ii;
+   mp_size_t n = arg->n;
+   mp_bitcnt_t w = arg->w;
+   mp_limb_t ** t1 = arg->t1;
+   mp_limb_t ** t2 = arg->t2;
+   mp_limb_t ** temp = arg->temp;
+   mp_size_t n1 = arg->n1;
+   mp_size_t n2 = arg->n2;
+   mp_size_t trunc = arg->trunc;
+   mp_size_t trunc2 = arg->trunc2;
+   mp_size_t half = arg->half;
+   mp_size_t limbs = arg->limbs;
+   mp_bitcnt_t depth = arg->depth;
+   mp_size_t i, j, start, stop;
 
-   /* first half matrix fourier FFT : n2 rows, n1 cols */
-   
-   /* FFTs on columns */
-   for (i = 0; i < n1; i++)
-   {   
-      /* relevant part of first layer of full sqrt2 FFT */
-      if (w & 1)
+   while (_fft_mfa_claim(arg, &start, &stop))
+   {
+      for (i = start; i < stop; i++)
       {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            if (j & 1)
-               fft_butterfly_sqrt2(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w, *temp);
-            else
-               fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j/2, limbs, w);     
-
-            SWAP_PTRS(ii[j],     *t1);
-            SWAP_PTRS(ii[2*n+j], *t2);
-         }
-
-         for ( ; j < 2*n; j+=n1)
+         if (half)
          {
-             if (i & 1)
-                fft_adjust_sqrt2(ii[j + 2*n], ii[j], j, limbs, w, *temp); 
-             else
-                fft_adjust(ii[j + 2*n], ii[j], j/2, limbs, w); 
-         }
-      } else
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w/2);
+            /* first half matrix fourier FFT : n2 rows, n1 cols */
+
+            /* relevant part of first layer of full sqrt2 FFT */
+            if (w & 1)
+            {
+               for (j = i; j < trunc - 2*n; j+=n1) 
+               {   
+                  if (j & 1)
+                     fft_butterfly_sqrt2(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w, *temp);
+                  else
+                     fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j/2, limbs, w);     
+
+                  SWAP_PTRS(ii[j],     *t1);
+                  SWAP_PTRS(ii[2*n+j], *t2);
+               }
+
+               for ( ; j < 2*n; j+=n1)
+               {
+                   if (i & 1)
+                      fft_adjust_sqrt2(ii[j + 2*n], ii[j], j, limbs, w, *temp); 
+                   else
+                      fft_adjust(ii[j + 2*n], ii[j], j/2, limbs, w); 
+               }
+            } else
+            {
+               for (j = i; j < trunc - 2*n; j+=n1) 
+               {   
+                  fft_butterfly(*t1, *t2, ii[j], ii[2*n+j], j, limbs, w/2);
    
-            SWAP_PTRS(ii[j],     *t1);
-            SWAP_PTRS(ii[2*n+j], *t2);
-         }
+                  SWAP_PTRS(ii[j],     *t1);
+                  SWAP_PTRS(ii[2*n+j], *t2);
+               }
 
-         for ( ; j < 2*n; j+=n1)
-            fft_adjust(ii[j + 2*n], ii[j], j, limbs, w/2);
-      }
+               for ( ; j < 2*n; j+=n1)
+                  fft_adjust(ii[j + 2*n], ii[j], j, limbs, w/2);
+            }
    
-      /* 
-         FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      
-      fft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
-   }
+            /* 
+               FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+               of 1 starting at row 0, where z => w bits
+            */
       
-   /* second half matrix fourier FFT : n2 rows, n1 cols */
-   ii += 2*n;
+            fft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
+            for (j = 0; j < n2; j++)
+            {
+               mp_size_t s = n_revbin(j, depth);
+               if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+            }
+         }
 
-   /* FFTs on columns */
-   for (i = 0; i < n1; i++)
-   {   
-      /*
-         FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
+         /* truncated half matrix fourier FFT : n2 rows, n1 cols */
+
+         /*
+            FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+            of 1 starting at row 0, where z => w bits
+         */
       
-      fft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1, trunc2);
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+         fft_truncate1_twiddle(ii + half + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1, trunc2);
+         for (j = 0; j < n2; j++)
+         {
+            mp_size_t s = n_revbin(j, depth);
+            if (j < s) SWAP_PTRS(ii[half+i+j*n1], ii[half+i+s*n1]);
+         }
       }
+
+      _fft_mfa_release_cols(arg, start, stop);
    }
+
+   return NULL;
+}
+
+void _fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+          mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, fft_scratch_t S)
+{
+   fft_mfa_arg_struct arg;
+
+   _fft_mfa_arg_init(&arg, ii, NULL, n, w, t1, t2, temp, NULL, n1, trunc);
+   _fft_mfa_set_scratch(&arg, S, 1);
+
+   /* FFTs on columns */
+   _fft_mfa_run(_fft_outer_worker, &arg, n1);
+}
+
+void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+{
+   int num_threads = flint_limit_num_threads(1);
+
+   _fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, temp, n1, trunc, NULL);
+
+   flint_restore_num_threads(num_threads);
 }
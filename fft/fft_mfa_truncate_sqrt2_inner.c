@@ -33,59 +33,80 @@ or implied, of William Hart.
 #include "ulong_extras.h"
 #include "fft.h"
 
-void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n, 
-                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
-                  mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t * tt)
+/*
+   Rows 0 to trunc2 - 1 of the pass are the relevant rows of the truncated
+   half of the data, taken in bit reversed order, and the remaining n2 rows,
+   if any, are those of the first half. Each is transformed, multiplied
+   pointwise and transformed back independently of the others.
+*/
+static void * _fft_inner_worker(void * arg_ptr)
 {
-   mp_size_t i, j, s;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_size_t limbs = (n*w)/FLINT_BITS;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   
-   while ((UWORD(1)<<depth) < n2) depth++;
-   while ((UWORD(1)<<depth2) < n1) depth2++;
-
-   ii += 2*n;
-   jj += 2*n;
-
-   /* convolutions on relevant rows */
-   for (s = 0; s < trunc2; s++)
+   fft_mfa_arg_struct * arg = (fft_mfa_arg_struct *) arg_ptr;
+   mp_limb_t ** ii;
+   mp_limb_t ** jj;
+   mp_size_t n = arg->n;
+   mp_bitcnt_t w = arg->w;
+   mp_limb_t ** t1 = arg->t1;
+   mp_limb_t ** t2 = arg->t2;
+   mp_limb_t * tt = arg->tt;
+   mp_size_t n1 = arg->n1;
+   mp_size_t n2 = arg->n2;
+   mp_size_t trunc2 = arg->trunc2;
+   mp_bitcnt_t depth = arg->depth;
+   mp_size_t i, s, start, stop;
+
+   while (_fft_mfa_claim(arg, &start, &stop))
    {
-      i = n_revbin(s, depth);
-      fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
-      if (ii != jj) fft_radix2(jj + i*n1, n1/2, w*n2, t1, t2);
-      
-      for (j = 0; j < n1; j++)
+      for (s = start; s < stop; s++)
       {
-         mp_size_t t = i*n1 + j;
-         mpn_normmod_2expp1(ii[t], limbs);
-         if (ii != jj) mpn_normmod_2expp1(jj[t], limbs);
-         fft_mulmod_2expp1(ii[t], ii[t], jj[t], n, w, tt);
-      }      
+         if (s < trunc2)
+         {
+            /* convolutions on relevant rows */
+            ii = arg->ii + arg->half;
+            jj = arg->jj + arg->half;
+            i = n_revbin(s, depth);
+         } else
+         {
+            /* convolutions on rows */
+            ii = arg->ii;
+            jj = arg->jj;
+            i = s - trunc2;
+         }
+
+         fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
+         if (ii != jj) fft_radix2(jj + i*n1, n1/2, w*n2, t1, t2);
+      
+         _fft_mulmod_2expp1_batch(ii + i*n1, jj + i*n1, n1, n, w, tt);
       
-      ifft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
+         ifft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
+      }
+
+      _fft_mfa_release_rows(arg, start, stop);
    }
 
-   ii -= 2*n;
-   jj -= 2*n;
+   return NULL;
+}
 
-   /* convolutions on rows */
-   for (i = 0; i < n2; i++)
-   {
-      fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
-      if (ii != jj) fft_radix2(jj + i*n1, n1/2, w*n2, t1, t2);
+void _fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj,
+             mp_size_t n, mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t * tt,
+                                                              fft_scratch_t S)
+{
+   fft_mfa_arg_struct arg;
 
-      for (j = 0; j < n1; j++)
-      {
-         mp_size_t t = i*n1 + j;
-         mpn_normmod_2expp1(ii[t], limbs);
-         if (ii != jj) mpn_normmod_2expp1(jj[t], limbs);
-         fft_mulmod_2expp1(ii[t], ii[t], jj[t], n, w, tt);
-      }      
-      
-      ifft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
-   }
+   _fft_mfa_arg_init(&arg, ii, jj, n, w, t1, t2, temp, tt, n1, trunc);
+   _fft_mfa_set_scratch(&arg, S, 0);
+
+   _fft_mfa_run(_fft_inner_worker, &arg, arg.rows);
 }
 
+void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                  mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t * tt)
+{
+   int num_threads = flint_limit_num_threads(1);
+
+   _fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, t1, t2, temp, n1, trunc, tt, NULL);
+
+   flint_restore_num_threads(num_threads);
+}
@@ -45,7 +45,8 @@ void fft_truncate1(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
         for (i = 0; i < n; i++)
             mpn_add_n(ii[i], ii[i], ii[i+n], limbs + 1);
       
-        fft_truncate1(ii, n/2, 2*w, t1, t2, trunc);
+        if (n > 1)
+            fft_truncate1(ii, n/2, 2*w, t1, t2, trunc);
     } else
     {
         for (i = 0; i < n; i++) 
@@ -70,7 +71,10 @@ void fft_truncate(mp_limb_t ** ii,  mp_size_t n, mp_bitcnt_t w,
     if (trunc == 2*n)
        fft_radix2(ii, n, w, t1, t2);
     else if (trunc <= n)
-       fft_truncate(ii, n/2, 2*w, t1, t2, trunc);
+    {
+       if (n > 1) /* otherwise the input ii[0] is already the output */
+          fft_truncate(ii, n/2, 2*w, t1, t2, trunc);
+    }
     else
     {
         for (i = 0; i < trunc - n; i++) 
@@ -87,29 +87,31 @@ void fft_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
         fft_truncate(ii, 2*n, w/2, t1, t2, trunc);
         return;
     }
+
+    /* the top half of the input is zero, so the sqrt2 layer is trivial */
+    if (trunc <= 2*n)
+    {
+        fft_truncate(ii, n, w, t1, t2, trunc);
+        return;
+    }
    
     for (i = 0; i < trunc - 2*n; i++) 
     {   
-        fft_butterfly(*t1, *t2, ii[i], ii[2*n+i], i/2, limbs, w);
+        if (i & 1)
+            fft_butterfly_sqrt2(*t1, *t2, ii[i], ii[2*n+i], i, limbs, w, *temp);
+        else
+            fft_butterfly(*t1, *t2, ii[i], ii[2*n+i], i/2, limbs, w);
    
         SWAP_PTRS(ii[i],     *t1);
         SWAP_PTRS(ii[i+2*n], *t2);
- 
-        i++;
-      
-        fft_butterfly_sqrt2(*t1, *t2, ii[i], ii[2*n+i], i, limbs, w, *temp);
-
-        SWAP_PTRS(ii[i],     *t1);
-        SWAP_PTRS(ii[2*n+i], *t2);
     }
 
-    for (i = trunc - 2*n; i < 2*n; i++)
+    for ( ; i < 2*n; i++)
     {
-        fft_adjust(ii[i+2*n], ii[i], i/2, limbs, w); 
-         
-        i++;
-
-        fft_adjust_sqrt2(ii[i+2*n], ii[i], i, limbs, w, *temp); 
+        if (i & 1)
+            fft_adjust_sqrt2(ii[i+2*n], ii[i], i, limbs, w, *temp); 
+        else
+            fft_adjust(ii[i+2*n], ii[i], i/2, limbs, w); 
     }
    
     fft_radix2(ii, n, w, t1, t2);
@@ -153,7 +153,8 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
 {
    mp_size_t i, j, s;
    mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
+   mp_size_t half = (trunc > 2*n) ? 2*n : 0;
+   mp_size_t trunc2 = (trunc - half)/n1;
    mp_bitcnt_t depth = 0;
    mp_bitcnt_t depth2 = 0;
    mp_bitcnt_t limbs = (w*n)/FLINT_BITS;
@@ -161,38 +162,45 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
    while ((UWORD(1)<<depth) < n2) depth++;
    while ((UWORD(1)<<depth2) < n1) depth2++;
 
-   /* first half mfa IFFT : n2 rows, n1 cols */
-
-   /* row IFFTs */
-   for (i = 0; i < n2; i++)
+   if (half)
    {
-      for (j = 0; j < n1; j++)
+      /* first half mfa IFFT : n2 rows, n1 cols */
+
+      /* row IFFTs */
+      for (i = 0; i < n2; i++)
       {
-         mp_size_t s = n_revbin(j, depth2);
-         if (j < s) SWAP_PTRS(ii[i*n1+j], ii[i*n1+s]);
-      }      
+         for (j = 0; j < n1; j++)
+         {
+            mp_size_t s = n_revbin(j, depth2);
+            if (j < s) SWAP_PTRS(ii[i*n1+j], ii[i*n1+s]);
+         }      
       
-      ifft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
-   }
-   
-   /* column IFFTs */
-   for (i = 0; i < n1; i++)
-   {   
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+         ifft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
       }
+   
+      /* column IFFTs */
+      for (i = 0; i < n1; i++)
+      {   
+         for (j = 0; j < n2; j++)
+         {
+            mp_size_t s = n_revbin(j, depth);
+            if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+         }
       
-      /*
-         IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      ifft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
-   }
+         /*
+            IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+            of 1 starting at row 0, where z => w bits
+         */
+         ifft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
+      }
    
-   /* second half IFFT : n2 rows, n1 cols */
-   ii += 2*n;
+      ii += 2*n;
+   }
+
+   /* 
+      truncated half IFFT : n2 rows, n1 cols, which is the first half, with
+      a trivial sqrt2 layer, if trunc <= 2*n
+   */
 
    /* row IFFTs */
    for (s = 0; s < trunc2; s++)
@@ -219,7 +227,9 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
       for ( ; j < n2; j++)
       {
          mp_size_t u = i + j*n1;
-         if (w & 1)
+         if (!half)
+            flint_mpn_zero(ii[u], limbs + 1);
+         else if (w & 1)
          {
             if (i & 1)
                fft_adjust_sqrt2(ii[i + j*n1], ii[u - 2*n], u, limbs, w, *temp); 
@@ -235,6 +245,14 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
       */
       ifft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1, trunc2);
       
+      if (!half)
+      {
+         for (j = i; j < trunc; j+=n1)
+            mpn_add_n(ii[j], ii[j], ii[j], limbs + 1);
+
+         continue;
+      }
+
       /* relevant components of final sqrt2 layer of IFFT */
       if (w & 1)
       {
@@ -264,107 +282,161 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
    }
 }
 
-void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
-   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+/*
+   Column i of both halves of the outer layers. The final sqrt2 layer only
+   combines entries j - 2*n and j with j = i mod n1, so different columns can
+   be processed independently. If trunc <= 2*n only the first half is
+   transformed, and it is truncated.
+*/
+static void * _ifft_outer_worker(void * arg_ptr)
 {
-   mp_size_t i, j;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   mp_bitcnt_t limbs = (w*n)/FLINT_BITS;
-   
-   while ((UWORD(1)<<depth) < n2) depth++;
-   while ((UWORD(1)<<depth2) < n1) depth2++;
-
-   /* first half mfa IFFT : n2 rows, n1 cols */
-   
-   /* column IFFTs */
-   for (i = 0; i < n1; i++)
-   {   
-      for (j = 0; j < n2; j++)
+   fft_mfa_arg_struct * arg = (fft_mfa_arg_struct *) arg_ptr;
+   mp_limb_t ** ii = arg->ii;
+   mp_size_t n = arg->n;
+   mp_bitcnt_t w = arg->w;
+   mp_limb_t ** t1 = arg->t1;
+   mp_limb_t ** t2 = arg->t2;
+   mp_limb_t ** temp = arg->temp;
+   mp_size_t n1 = arg->n1;
+   mp_size_t n2 = arg->n2;
+   mp_size_t trunc = arg->trunc;
+   mp_size_t trunc2 = arg->trunc2;
+   mp_size_t half = arg->half;
+   mp_size_t limbs = arg->limbs;
+   mp_bitcnt_t depth = arg->depth;
+   mp_bitcnt_t depth2 = arg->depth2;
+   mp_size_t i, j, start, stop;
+
+   /* the inverse of the truncated half alone only scales by 2*n */
+   mp_bitcnt_t shift = depth + depth2 + (half != 0);
+
+   while (_fft_mfa_claim(arg, &start, &stop))
+   {
+      for (i = start; i < stop; i++)
       {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
+         if (half)
+         {
+            /* first half mfa IFFT : n2 rows, n1 cols */
+
+            for (j = 0; j < n2; j++)
+            {
+               mp_size_t s = n_revbin(j, depth);
+               if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+            }
       
-      /*
-         IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      ifft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
-   }
-   
-   /* second half IFFT : n2 rows, n1 cols */
-   ii += 2*n;
+            /*
+               IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+               of 1 starting at row 0, where z => w bits
+            */
+            ifft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
 
-   /* column IFFTs with relevant sqrt2 layer butterflies combined */
-   for (i = 0; i < n1; i++)
-   {   
-      for (j = 0; j < trunc2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
+            ii += 2*n;
+         }
 
-      for ( ; j < n2; j++)
-      {
-         mp_size_t u = i + j*n1;
-         if (w & 1)
-         {
-            if (i & 1)
-               fft_adjust_sqrt2(ii[i + j*n1], ii[u - 2*n], u, limbs, w, *temp); 
-            else
-               fft_adjust(ii[i + j*n1], ii[u - 2*n], u/2, limbs, w); 
-         } else
-            fft_adjust(ii[i + j*n1], ii[u - 2*n], u, limbs, w/2);
-      }
+         /* truncated half IFFT : n2 rows, n1 cols */
 
-      /* 
-         IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      ifft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1, trunc2);
-      
-      /* relevant components of final sqrt2 layer of IFFT */
-      if (w & 1)
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            if (j & 1)
-               ifft_butterfly_sqrt2(*t1, *t2, ii[j - 2*n], ii[j], j, limbs, w, *temp); 
-            else
-               ifft_butterfly(*t1, *t2, ii[j - 2*n], ii[j], j/2, limbs, w);
+         for (j = 0; j < trunc2; j++)
+         {
+            mp_size_t s = n_revbin(j, depth);
+            if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+         }
 
-            SWAP_PTRS(ii[j-2*n], *t1);
-            SWAP_PTRS(ii[j],     *t2);
+         for ( ; j < n2; j++)
+         {
+            mp_size_t u = i + j*n1;
+            if (!half)
+               flint_mpn_zero(ii[u], limbs + 1);
+            else if (w & 1)
+            {
+               if (i & 1)
+                  fft_adjust_sqrt2(ii[i + j*n1], ii[u - 2*n], u, limbs, w, *temp); 
+               else
+                  fft_adjust(ii[i + j*n1], ii[u - 2*n], u/2, limbs, w); 
+            } else
+               fft_adjust(ii[i + j*n1], ii[u - 2*n], u, limbs, w/2);
          }
-      } else
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            ifft_butterfly(*t1, *t2, ii[j - 2*n], ii[j], j, limbs, w/2);
+
+         /* 
+            IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+            of 1 starting at row 0, where z => w bits
+         */
+         ifft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1, trunc2);
+      
+         if (half)
+         {
+            /* relevant components of final sqrt2 layer of IFFT */
+            if (w & 1)
+            {
+               for (j = i; j < trunc - 2*n; j+=n1) 
+               {   
+                  if (j & 1)
+                     ifft_butterfly_sqrt2(*t1, *t2, ii[j - 2*n], ii[j], j, limbs, w, *temp); 
+                  else
+                     ifft_butterfly(*t1, *t2, ii[j - 2*n], ii[j], j/2, limbs, w);
+
+                  SWAP_PTRS(ii[j-2*n], *t1);
+                  SWAP_PTRS(ii[j],     *t2);
+               }
+            } else
+            {
+               for (j = i; j < trunc - 2*n; j+=n1) 
+               {   
+                  ifft_butterfly(*t1, *t2, ii[j - 2*n], ii[j], j, limbs, w/2);
    
-            SWAP_PTRS(ii[j-2*n], *t1);
-            SWAP_PTRS(ii[j],     *t2);
+                  SWAP_PTRS(ii[j-2*n], *t1);
+                  SWAP_PTRS(ii[j],     *t2);
+               }
+            }
+
+            for (j = trunc + i - 2*n; j < 2*n; j+=n1)
+                 mpn_add_n(ii[j - 2*n], ii[j - 2*n], ii[j - 2*n], limbs + 1);
          }
-      }
 
-      for (j = trunc + i - 2*n; j < 2*n; j+=n1)
-           mpn_add_n(ii[j - 2*n], ii[j - 2*n], ii[j - 2*n], limbs + 1);
+         for (j = 0; j < trunc2; j++)
+         {
+            mp_size_t t = j*n1 + i;
+            mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, shift);
+            mpn_normmod_2expp1(ii[t], limbs);
+         }
 
-      for (j = 0; j < trunc2; j++)
-      {
-         mp_size_t t = j*n1 + i;
-         mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, depth + depth2 + 1);
-         mpn_normmod_2expp1(ii[t], limbs);
+         if (half)
+         {
+            for (j = 0; j < n2; j++)
+            {
+               mp_size_t t = j*n1 + i - 2*n;
+               mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, shift);
+               mpn_normmod_2expp1(ii[t], limbs);
+            }
+
+            ii -= 2*n;
+         }
       }
 
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t t = j*n1 + i - 2*n;
-         mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, depth + depth2 + 1);
-         mpn_normmod_2expp1(ii[t], limbs);
-      }
+      _fft_mfa_release_cols(arg, start, stop);
    }
+
+   return NULL;
+}
+
+void _ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
+                    mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, 
+                             mp_size_t n1, mp_size_t trunc, fft_scratch_t S)
+{
+   fft_mfa_arg_struct arg;
+
+   _fft_mfa_arg_init(&arg, ii, NULL, n, w, t1, t2, temp, NULL, n1, trunc);
+   _fft_mfa_set_scratch(&arg, S, 1);
+
+   /* column IFFTs */
+   _fft_mfa_run(_ifft_outer_worker, &arg, n1);
+}
+
+void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
+   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+{
+   int num_threads = flint_limit_num_threads(1);
+
+   _ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, temp, n1, trunc, NULL);
+
+   flint_restore_num_threads(num_threads);
 }
@@ -48,7 +48,8 @@ void ifft_truncate1(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
             mpn_div_2expmod_2expp1(ii[i], ii[i], limbs, 1);
         }
       
-        ifft_truncate1(ii, n/2, 2*w, t1, t2, trunc);
+        if (n > 1)
+            ifft_truncate1(ii, n/2, 2*w, t1, t2, trunc);
 
         for (i = 0; i < trunc; i++)
         {
@@ -93,7 +94,8 @@ void ifft_truncate(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
         ifft_radix2(ii, n, w, t1, t2);
     else if (trunc <= n)
     {
-        ifft_truncate(ii, n/2, 2*w, t1, t2, trunc);
+        if (n > 1)
+            ifft_truncate(ii, n/2, 2*w, t1, t2, trunc);
 
         for (i = 0; i < trunc; i++)
             mpn_add_n(ii[i], ii[i], ii[i], limbs + 1);
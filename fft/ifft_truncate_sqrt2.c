@@ -88,34 +88,40 @@ void ifft_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
       return;
    }
 
+   /* the top half of the output is zero, so the sqrt2 layer is trivial */
+   if (trunc <= 2*n)
+   {
+      ifft_truncate(ii, n, w, t1, t2, trunc);
+
+      for (i = 0; i < trunc; i++)
+         mpn_add_n(ii[i], ii[i], ii[i], limbs + 1);
+
+      return;
+   }
+
    ifft_radix2(ii, n, w, t1, t2);
 
    for (i = trunc - 2*n; i < 2*n; i++)
    {
-      fft_adjust(ii[i+2*n], ii[i], i/2, limbs, w);
-
-      i++;
-
-      fft_adjust_sqrt2(ii[i+2*n], ii[i], i, limbs, w, *temp);
+      if (i & 1)
+         fft_adjust_sqrt2(ii[i+2*n], ii[i], i, limbs, w, *temp);
+      else
+         fft_adjust(ii[i+2*n], ii[i], i/2, limbs, w);
    }
    
    ifft_truncate1(ii + 2*n, n, w, t1, t2, trunc - 2*n);
 
    for (i = 0; i < trunc - 2*n; i++) 
    {   
-      ifft_butterfly(*t1, *t2, ii[i], ii[2*n+i], i/2, limbs, w);
-   
-      SWAP_PTRS(ii[i], *t1);
-      SWAP_PTRS(ii[2*n+i], *t2);
-
-      i++;
-
-      ifft_butterfly_sqrt2(*t1, *t2, ii[i], ii[2*n+i], i, limbs, w, *temp);
+      if (i & 1)
+         ifft_butterfly_sqrt2(*t1, *t2, ii[i], ii[2*n+i], i, limbs, w, *temp);
+      else
+         ifft_butterfly(*t1, *t2, ii[i], ii[2*n+i], i/2, limbs, w);
    
       SWAP_PTRS(ii[i], *t1);
       SWAP_PTRS(ii[2*n+i], *t2);
    }
 
-  for (i = trunc - 2*n; i < 2*n; i++)
-     mpn_add_n(ii[i], ii[i], ii[i], limbs + 1);
+   for (i = trunc - 2*n; i < 2*n; i++)
+      mpn_add_n(ii[i], ii[i], ii[i], limbs + 1);
 }
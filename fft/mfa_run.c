@@ -0,0 +1,132 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+void _fft_mfa_arg_init(fft_mfa_arg_struct * arg, mp_limb_t ** ii,
+          mp_limb_t ** jj, mp_size_t n, mp_bitcnt_t w, mp_limb_t ** t1,
+                 mp_limb_t ** t2, mp_limb_t ** temp, mp_limb_t * tt,
+                                               mp_size_t n1, mp_size_t trunc)
+{
+   arg->ii = ii;
+   arg->jj = jj;
+   arg->n = n;
+   arg->w = w;
+   arg->t1 = t1;
+   arg->t2 = t2;
+   arg->temp = temp;
+   arg->tt = tt;
+   arg->n1 = n1;
+   arg->n2 = (2*n)/n1;
+   arg->trunc = trunc;
+
+   /*
+      if trunc <= 2*n the top half of the data is zero, the sqrt2 layer is
+      trivial and the truncated transform is done on the first half
+   */
+   arg->half = (trunc > 2*n) ? 2*n : 0;
+   arg->trunc2 = (trunc - arg->half)/n1;
+   arg->rows = arg->trunc2 + (arg->half ? arg->n2 : 0);
+   arg->limbs = (n*w)/FLINT_BITS;
+   arg->scratch = NULL;
+   arg->block = 0;
+
+   arg->depth = 0;
+   arg->depth2 = 0;
+   while ((UWORD(1)<<arg->depth) < arg->n2) arg->depth++;
+   while ((UWORD(1)<<arg->depth2) < n1) arg->depth2++;
+}
+
+int _fft_mfa_claim(fft_mfa_arg_struct * arg,
+                                         mp_size_t * start, mp_size_t * stop)
+{
+   if (arg->mutex != NULL)
+      pthread_mutex_lock(arg->mutex);
+
+   *start = *arg->next;
+   *stop = FLINT_MIN(*start + arg->chunk, arg->count);
+   *arg->next = *stop;
+
+   if (arg->mutex != NULL)
+      pthread_mutex_unlock(arg->mutex);
+
+   return *start < *stop;
+}
+
+void _fft_mfa_run(thread_pool_fxn_t f, fft_mfa_arg_struct * arg,
+                                                              mp_size_t count)
+{
+   fft_mfa_arg_struct * args;
+   thread_pool_handle * threads;
+   pthread_mutex_t mutex;
+   mp_size_t next = 0;
+   slong i, num_threads;
+
+   arg->count = count;
+   arg->chunk = arg->block ? FLINT_MIN(arg->block, count) : count;
+   arg->next = &next;
+   arg->mutex = NULL;
+
+   /*
+      thread i works with the temporaries t1[i], t2[i], temp[i] and the
+      i-th block of 2*(limbs + 1) limbs of tt
+   */
+   num_threads = flint_request_threads(&threads, count);
+
+   if (num_threads == 0)
+   {
+      f(arg);
+      flint_give_back_threads(threads, 0);
+      return;
+   }
+
+   args = flint_malloc((num_threads + 1)*sizeof(fft_mfa_arg_struct));
+   pthread_mutex_init(&mutex, NULL);
+
+   for (i = 0; i <= num_threads; i++)
+   {
+      args[i] = *arg;
+      args[i].t1 = arg->t1 + i;
+      args[i].t2 = arg->t2 + i;
+      args[i].temp = arg->temp + i;
+      if (arg->tt != NULL)
+         args[i].tt = arg->tt + 2*(arg->limbs + 1)*i;
+      args[i].chunk = FLINT_MAX(1, count/(4*(num_threads + 1)));
+      if (arg->block) /* the threads share the memory limit */
+         args[i].chunk = FLINT_MIN(args[i].chunk,
+                                 FLINT_MAX(1, arg->block/(num_threads + 1)));
+      args[i].mutex = &mutex;
+   }
+
+   for (i = 0; i < num_threads; i++)
+      thread_pool_wake(global_thread_pool, threads[i], f, args + i + 1);
+
+   f(args);
+
+   for (i = 0; i < num_threads; i++)
+      thread_pool_wait(global_thread_pool, threads[i]);
+
+   flint_give_back_threads(threads, num_threads);
+
+   pthread_mutex_destroy(&mutex);
+   flint_free(args);
+}
@@ -32,74 +32,65 @@ or implied, of William Hart.
 #include "flint.h"
 #include "fft.h"
 #include "ulong_extras.h"
-#include "fft_tuning.h"
-
-static int fft_tuning_table[5][2] = FFT_TAB;
+#include "profiler.h"
 
 void flint_mpn_mul_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1, 
                         mp_srcptr i2, mp_size_t n2)
 {
-   mp_size_t off, depth = 6;
-   mp_size_t w = 1;
-   mp_size_t n = ((mp_size_t) 1 << depth);
-   mp_bitcnt_t bits = (n*w - (depth+1))/2;
+   mp_bitcnt_t depth, w;
 
-   mp_bitcnt_t bits1 = n1*FLINT_BITS;
-   mp_bitcnt_t bits2 = n2*FLINT_BITS;
+   /* the matrix fourier algorithm is threaded, the other is not */
+   int threaded = flint_get_num_threads() > 1 &&
+                  n1 + n2 >= flint_tune_params[FLINT_TUNE_FFT_MUL_THREADED];
+   int num_threads;
 
-   mp_size_t j1 = (bits1 - 1)/bits + 1;
-   mp_size_t j2 = (bits2 - 1)/bits + 1;
+   /* squarings transform a single operand */
+   int sqr = (i1 == i2 && n1 == n2);
 
    FLINT_ASSERT(n1 > 0);
    FLINT_ASSERT(n2 > 0);
-   FLINT_ASSERT(j1 + j2 - 1 > 2*n);
 
-   while (j1 + j2 - 1 > 4*n) /* find initial n, w */
+#if FFT_NTT
+   /* the small prime transforms only pay off with vectorised butterflies */
+   if (fft_mul_use_ntt(n1, n2))
    {
-      if (w == 1) w = 2;
-      else 
-      {
-         depth++;
-         w = 1;
-         n *= 2;
-      }
-
-      bits = (n*w - (depth+1))/2;
-      j1 = (bits1 - 1)/bits + 1;
-      j2 = (bits2 - 1)/bits + 1;
+      if (sqr)
+         FLINT_TRACE_CALL("mpn_mul_fft_main:sqr_ntt", n1 + n2,
+            sqr_ntt(r1, i1, n1));
+      else
+         FLINT_TRACE_CALL("mpn_mul_fft_main:ntt", n1 + n2,
+            mul_ntt(r1, i1, n1, i2, n2));
+      return;
    }
-   
-   if (depth < 11)
+#endif
+
+   if (!fft_mul_params(&depth, &w, n1, n2, threaded))
    {
-      mp_size_t wadj = 1;
-      
-      off = fft_tuning_table[depth - 6][w - 1]; /* adjust n and w */
-      depth -= off;
-      n = ((mp_size_t) 1 << depth);
-      w *= ((mp_size_t) 1 << (2*off));
-      
-      if (depth < 6) wadj = ((mp_size_t) 1 << (6 - depth));
-
-      if (w > wadj)
-      {
-         do { /* see if a smaller w will work */
-            w -= wadj;
-            bits = (n*w - (depth+1))/2;
-            j1 = (bits1 - 1)/bits + 1;
-            j2 = (bits2 - 1)/bits + 1;
-         } while (j1 + j2 - 1 <= 4*n && w > wadj);  
-         w += wadj;
-      }
-
-      mul_truncate_sqrt2(r1, i1, n1, i2, n2, depth, w);
+      if (sqr)
+         FLINT_TRACE_CALL("mpn_mul_fft_main:sqr_truncate_sqrt2", n1 + n2,
+            sqr_truncate_sqrt2(r1, i1, n1, depth, w));
+      else
+         FLINT_TRACE_CALL("mpn_mul_fft_main:truncate_sqrt2", n1 + n2,
+            mul_truncate_sqrt2(r1, i1, n1, i2, n2, depth, w));
    } else
    {
-      if (j1 + j2 - 1 <= 3*n)
-      {
-         depth--;
-         w *= 3;
-      }
-      mul_mfa_truncate_sqrt2(r1, i1, n1, i2, n2, depth, w);
+      if (!threaded)
+         num_threads = flint_limit_num_threads(1);
+
+      if (sqr && threaded)
+         FLINT_TRACE_CALL("mpn_mul_fft_main:sqr_mfa_truncate_sqrt2_threaded",
+            n1 + n2, sqr_mfa_truncate_sqrt2(r1, i1, n1, depth, w));
+      else if (sqr)
+         FLINT_TRACE_CALL("mpn_mul_fft_main:sqr_mfa_truncate_sqrt2", n1 + n2,
+            sqr_mfa_truncate_sqrt2(r1, i1, n1, depth, w));
+      else if (threaded)
+         FLINT_TRACE_CALL("mpn_mul_fft_main:mfa_truncate_sqrt2_threaded",
+            n1 + n2, mul_mfa_truncate_sqrt2(r1, i1, n1, i2, n2, depth, w));
+      else
+         FLINT_TRACE_CALL("mpn_mul_fft_main:mfa_truncate_sqrt2", n1 + n2,
+            mul_mfa_truncate_sqrt2(r1, i1, n1, i2, n2, depth, w));
+
+      if (!threaded)
+         flint_restore_num_threads(num_threads);
    }
 }
-
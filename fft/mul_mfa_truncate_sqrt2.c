@@ -49,54 +49,67 @@ void mul_mfa_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
    
    mp_size_t i, j, trunc;
 
-   mp_limb_t ** ii, ** jj, * t1, * t2, * s1, * ptr;
+   mp_limb_t ** ii, ** jj, ** t1, ** t2, ** s1, * ptr;
    mp_limb_t * tt;
+   fft_scratch_t S;
+   size_t bytes;
+
+   /* each thread working on the transforms needs its own temporaries */
+   slong N = flint_get_num_threads();
+
+   if (i1 == i2 && n1 == n2)
+   {
+      sqr_mfa_truncate_sqrt2(r1, i1, n1, depth, w);
+      return;
+   }
    
-   ii = flint_malloc((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
+   /* both transforms share storage, which goes to a file if too large */
+   bytes = (4*(n + n*size) + 5*size*N)*sizeof(mp_limb_t);
+   ii = _fft_scratch_init(S, bytes + 4*(n + n*size)*sizeof(mp_limb_t));
    for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
    {
       ii[i] = ptr;
    }
-   t1 = ptr;
-   t2 = t1 + size;
-   s1 = t2 + size;
-   tt = s1 + size;
+   t1 = flint_malloc(3*N*sizeof(mp_limb_t *));
+   t2 = t1 + N;
+   s1 = t2 + N;
+   for (i = 0; i < N; i++, ptr += 3*size)
+   {
+      t1[i] = ptr;
+      t2[i] = t1[i] + size;
+      s1[i] = t2[i] + size;
+   }
+   tt = ptr;
    
-   if (i1 != i2)
+   jj = (mp_limb_t **) ((char *) ii + bytes);
+   for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
    {
-      jj = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
-      for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
-      {
-         jj[i] = ptr;
-      }
-   } else jj = ii;
+      jj[i] = ptr;
+   }
    
    trunc = j1 + j2 - 1;
-   if (trunc <= 2*n) trunc = 2*n + 1;
    trunc = 2*sqrt*((trunc + 2*sqrt - 1)/(2*sqrt)); /* trunc must be divisible by 2*sqrt */
 
    j1 = fft_split_bits(ii, i1, n1, bits1, limbs);
    for (j = j1 ; j < 4*n; j++)
       flint_mpn_zero(ii[j], limbs + 1);
+   _fft_scratch_release(S, ii + 4*n, 4*n*size*sizeof(mp_limb_t));
    
-   fft_mfa_truncate_sqrt2_outer(ii, n, w, &t1, &t2, &s1, sqrt, trunc);
+   _fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, S);
    
-   if (i1 != i2)
-   {
-      j2 = fft_split_bits(jj, i2, n2, bits1, limbs);
-      for (j = j2 ; j < 4*n; j++)
-         flint_mpn_zero(jj[j], limbs + 1);
+   j2 = fft_split_bits(jj, i2, n2, bits1, limbs);
+   for (j = j2 ; j < 4*n; j++)
+      flint_mpn_zero(jj[j], limbs + 1);
+   _fft_scratch_release(S, jj + 4*n, 4*n*size*sizeof(mp_limb_t));
 
-      fft_mfa_truncate_sqrt2_outer(jj, n, w, &t1, &t2, &s1, sqrt, trunc);
-   } else j2 = j1;
+   _fft_mfa_truncate_sqrt2_outer(jj, n, w, t1, t2, s1, sqrt, trunc, S);
    
-   fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, &t1, &t2, &s1, sqrt, trunc, tt);
-   ifft_mfa_truncate_sqrt2_outer(ii, n, w, &t1, &t2, &s1, sqrt, trunc);
+   _fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, t1, t2, s1, sqrt, trunc, tt, S);
+   _ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, S);
        
    flint_mpn_zero(r1, r_limbs);
    fft_combine_bits(r1, ii, j1 + j2 - 1, bits1, limbs, r_limbs);
      
-   flint_free(ii);
-   if (i1 != i2)
-      flint_free(jj);
+   _fft_scratch_clear(S);
+   flint_free(t1);
 }
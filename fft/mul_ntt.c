@@ -0,0 +1,629 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "ulong_extras.h"
+#include "thread_pool.h"
+#include "fft.h"
+
+#if FFT_NTT
+
+typedef struct
+{
+   mp_limb_t * a;
+   mp_srcptr i1;
+   mp_size_t n1;
+   mp_srcptr i2;
+   mp_size_t n2;
+   mp_bitcnt_t depth;
+   slong prime;
+   fft_ntt_struct T;
+} mul_ntt_arg_t;
+
+/* x*c mod p where cpre = floor(c*2^64/p) */
+static __inline__ mp_limb_t
+_mulmod_shoup(mp_limb_t x, mp_limb_t c, mp_limb_t cpre, mp_limb_t p)
+{
+   mp_limb_t q, r;
+
+   umul_ppmm(q, r, x, cpre);
+   r = x*c - q*p;
+
+   return (r >= p) ? r - p : r;
+}
+
+static mp_limb_t _shoup_precomp(mp_limb_t c, mp_limb_t p)
+{
+   mp_limb_t q, r;
+   unsigned int norm;
+
+   count_leading_zeros(norm, p);
+   udiv_qrnnd(q, r, c << norm, 0, p << norm);
+
+   return q;
+}
+
+/* sets a to values in [0, 2p) congruent to the limbs of (x, n), padded */
+static void _mul_ntt_reduce(mp_limb_t * a, mp_size_t N, mp_srcptr x,
+                         mp_size_t n, const fft_ntt_struct * T, int ifma)
+{
+   mp_size_t j;
+
+#if FFT_NTT_SIMD
+   if (ifma)
+   {
+      mp_limb_t c = (UWORD(1) << 52) % T->p;
+
+      _fft_ntt_reduce_ifma(a, x, n, c, _shoup_precomp(c, T->p), T->p);
+   } else
+#endif
+   {
+      for (j = 0; j < n; j++)
+         a[j] = n_mod2_preinv(x[j], T->p, T->pinv);
+   }
+
+   for (j = n; j < N; j++)
+      a[j] = 0;
+}
+
+/*
+   Sets a to a*b/N in [0, 2p) for a, b in [0, 2p): with the product
+   written as h*B + l, the parts are multiplied by 1/N and B/N modulo p.
+*/
+static void _mul_ntt_pointwise(mp_limb_t * a, mp_srcptr b, mp_size_t N,
+                                        const fft_ntt_struct * T, int ifma)
+{
+   mp_limb_t p = T->p, c0, c0pre, c1, c1pre, hi, lo;
+   mp_size_t j;
+
+   c0 = p - ((p - 1) >> T->depth);
+   c0pre = _shoup_precomp(c0, p);
+
+#if FFT_NTT_SIMD
+   if (ifma && N >= 8)
+   {
+      c1 = n_mulmod2_preinv((UWORD(1) << 52) % p, c0, p, T->pinv);
+      _fft_ntt_mul_ifma(a, b, N, c0, c0pre, c1, _shoup_precomp(c1, p), p);
+      return;
+   }
+#endif
+
+   c1 = n_mulmod2_preinv((UWORD_MAX % p) + 1, c0, p, T->pinv);
+   c1pre = _shoup_precomp(c1, p);
+
+   for (j = 0; j < N; j++)
+   {
+      umul_ppmm(hi, lo, a[j], b[j]);
+      a[j] = _mulmod_shoup(lo, c0, c0pre, p)
+           + _mulmod_shoup(hi, c1, c1pre, p);
+   }
+}
+
+void fft_ntt_mul(mp_limb_t * a, mp_srcptr i1, mp_size_t n1,
+                       mp_srcptr i2, mp_size_t n2, const fft_ntt_t T)
+{
+   mp_size_t N = (WORD(1) << T->depth);
+   mp_limb_t * b;
+#if FFT_NTT_SIMD
+   int ifma = (flint_cpu_features() & FLINT_CPU_AVX512IFMA) != 0;
+#else
+   int ifma = 0;
+#endif
+
+   _mul_ntt_reduce(a, N, i1, n1, T, ifma);
+   fft_ntt(a, T);
+
+   if (i1 == i2 && n1 == n2)
+   {
+      _mul_ntt_pointwise(a, a, N, T, ifma);
+   } else
+   {
+      b = flint_malloc(N*sizeof(mp_limb_t));
+
+      _mul_ntt_reduce(b, N, i2, n2, T, ifma);
+      fft_ntt(b, T);
+      _mul_ntt_pointwise(a, b, N, T, ifma);
+
+      flint_free(b);
+   }
+
+   ifft_ntt(a, T);
+}
+
+void fft_ntt_mat22_mul(mp_limb_t ** c, mp_srcptr * a, const mp_size_t * na,
+                          mp_srcptr * b, const mp_size_t * nb, slong k,
+                                                          const fft_ntt_t T)
+{
+   mp_size_t N = (WORD(1) << T->depth), j;
+   mp_limb_t * buf, * at[4], * bt[4], * r, * s, p2 = 2*T->p;
+   slong i, l;
+   int t0, t1;
+#if FFT_NTT_SIMD
+   int ifma = (flint_cpu_features() & FLINT_CPU_AVX512IFMA) != 0;
+#else
+   int ifma = 0;
+#endif
+
+   buf = flint_malloc((5 + 2*k)*N*sizeof(mp_limb_t));
+
+   /* each entry is transformed once, if it takes part in a product */
+   for (i = 0; i < 4; i++)
+   {
+      at[i] = buf + i*N;
+      for (l = 0; l < k && nb[(i & 1)*k + l] == 0; l++) ;
+      if (na[i] != 0 && l < k)
+      {
+         _mul_ntt_reduce(at[i], N, a[i], na[i], T, ifma);
+         fft_ntt(at[i], T);
+      }
+   }
+
+   for (l = 0; l < 2*k; l++)
+   {
+      bt[l] = buf + (4 + l)*N;
+      if (nb[l] != 0 && (na[l/k] != 0 || na[2 + l/k] != 0))
+      {
+         _mul_ntt_reduce(bt[l], N, b[l], nb[l], T, ifma);
+         fft_ntt(bt[l], T);
+      }
+   }
+
+   s = buf + (4 + 2*k)*N;
+
+   for (i = 0; i < 2; i++)
+   {
+      for (l = 0; l < k; l++)
+      {
+         r = c[i*k + l];
+         t0 = (na[2*i] != 0 && nb[l] != 0);
+         t1 = (na[2*i + 1] != 0 && nb[k + l] != 0);
+
+         if (t0)
+         {
+            flint_mpn_copyi(r, at[2*i], N);
+            _mul_ntt_pointwise(r, bt[l], N, T, ifma);
+         }
+
+         if (t1)
+         {
+            flint_mpn_copyi(t0 ? s : r, at[2*i + 1], N);
+            _mul_ntt_pointwise(t0 ? s : r, bt[k + l], N, T, ifma);
+         }
+
+         if (t0 && t1)
+         {
+            for (j = 0; j < N; j++)
+            {
+               r[j] += s[j];
+               r[j] = (r[j] >= p2) ? r[j] - p2 : r[j];
+            }
+         }
+
+         if (t0 || t1)
+            ifft_ntt(r, T);
+         else
+            flint_mpn_zero(r, N);
+      }
+   }
+
+   flint_free(buf);
+}
+
+/* sets arg.a to the product of the inputs modulo p, in [0, 2p) */
+static void * _mul_ntt_worker(void * arg_ptr)
+{
+   mul_ntt_arg_t * arg = (mul_ntt_arg_t *) arg_ptr;
+   fft_ntt_struct * T = &arg->T;
+
+   if (arg->depth > FFT_NTT_CACHE_DEPTH)
+      fft_ntt_init_prime(T, arg->prime, arg->depth);
+
+   fft_ntt_mul(arg->a, arg->i1, arg->n1, arg->i2, arg->n2, T);
+
+   if (arg->depth > FFT_NTT_CACHE_DEPTH)
+      fft_ntt_clear(T);
+
+   return NULL;
+}
+
+void fft_ntt_mul_primes(mp_limb_t ** res, mp_srcptr i1, mp_size_t n1,
+                 mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, int np)
+{
+   mul_ntt_arg_t args[FFT_NTT_NUM_PRIMES];
+   int i;
+
+   for (i = 0; i < np; i++)
+   {
+      args[i].a = res[i];
+      args[i].i1 = i1;
+      args[i].n1 = n1;
+      args[i].i2 = i2;
+      args[i].n2 = n2;
+      args[i].depth = depth;
+      args[i].prime = i;
+
+      /* the cached tables belong to this thread */
+      if (depth <= FFT_NTT_CACHE_DEPTH)
+         fft_ntt_init_prime(&args[i].T, i, depth);
+   }
+
+   flint_parallel_map(_mul_ntt_worker, args, sizeof(mul_ntt_arg_t), np);
+
+   if (depth <= FFT_NTT_CACHE_DEPTH)
+   {
+      for (i = 0; i < np; i++)
+         fft_ntt_clear(&args[i].T);
+   }
+}
+
+typedef struct
+{
+   mp_limb_t ** c;
+   mp_srcptr * a;
+   const mp_size_t * na;
+   mp_srcptr * b;
+   const mp_size_t * nb;
+   slong k;
+   mp_bitcnt_t depth;
+   slong prime;
+   fft_ntt_struct T;
+} mat22_mul_ntt_arg_t;
+
+static void * _mat22_mul_ntt_worker(void * arg_ptr)
+{
+   mat22_mul_ntt_arg_t * arg = (mat22_mul_ntt_arg_t *) arg_ptr;
+   fft_ntt_struct * T = &arg->T;
+
+   if (arg->depth > FFT_NTT_CACHE_DEPTH)
+      fft_ntt_init_prime(T, arg->prime, arg->depth);
+
+   fft_ntt_mat22_mul(arg->c, arg->a, arg->na, arg->b, arg->nb, arg->k, T);
+
+   if (arg->depth > FFT_NTT_CACHE_DEPTH)
+      fft_ntt_clear(T);
+
+   return NULL;
+}
+
+void fft_ntt_mat22_mul_primes(mp_limb_t ** res, mp_srcptr * a,
+                  const mp_size_t * na, mp_srcptr * b, const mp_size_t * nb,
+                                     slong k, mp_bitcnt_t depth, int np)
+{
+   mat22_mul_ntt_arg_t args[FFT_NTT_NUM_PRIMES];
+   int i;
+
+   for (i = 0; i < np; i++)
+   {
+      args[i].c = res + 2*k*i;
+      args[i].a = a;
+      args[i].na = na;
+      args[i].b = b;
+      args[i].nb = nb;
+      args[i].k = k;
+      args[i].depth = depth;
+      args[i].prime = i;
+
+      if (depth <= FFT_NTT_CACHE_DEPTH)
+         fft_ntt_init_prime(&args[i].T, i, depth);
+   }
+
+   flint_parallel_map(_mat22_mul_ntt_worker, args,
+                                       sizeof(mat22_mul_ntt_arg_t), np);
+
+   if (depth <= FFT_NTT_CACHE_DEPTH)
+   {
+      for (i = 0; i < np; i++)
+         fft_ntt_clear(&args[i].T);
+   }
+}
+
+typedef struct
+{
+   mp_limb_t * r;
+   mp_limb_t ** res;
+   mp_size_t k0;
+   mp_size_t k1;
+   int np;
+   mp_limb_t carry[FFT_NTT_NUM_PRIMES];
+   const mp_limb_t * inv;
+   const mp_limb_t * invpre;
+} mul_ntt_crt_arg_t;
+
+/*
+   Garner's algorithm: the coefficient is y_0 + p_0(y_1 + p_1(y_2 + ...))
+   with y_i = (((r_i - y_0)/p_0 - y_1)/p_1 - ...) mod p_i; the coefficients
+   are added into r[k0, k1) and the final carry is saved
+*/
+static void * _mul_ntt_crt_worker(void * arg_ptr)
+{
+   mul_ntt_crt_arg_t * arg = (mul_ntt_crt_arg_t *) arg_ptr;
+   const mp_limb_t * primes = fft_ntt_primes;
+   mp_limb_t y[FFT_NTT_NUM_PRIMES], v[FFT_NTT_NUM_PRIMES];
+   mp_limb_t c[FFT_NTT_NUM_PRIMES];
+   mp_limb_t hi, lo, t, cy, p;
+   mp_size_t k;
+   int i, j, l, vn, np = arg->np;
+
+   for (l = 0; l < np; l++)
+      c[l] = 0;
+
+   for (k = arg->k0; k < arg->k1; k++)
+   {
+      t = arg->res[0][k];
+      y[0] = (t >= primes[0]) ? t - primes[0] : t;
+
+      for (i = 1; i < np; i++)
+      {
+         p = primes[i];
+         t = arg->res[i][k];
+         t = (t >= p) ? t - p : t;
+
+         for (j = 0; j < i; j++)
+         {
+            /* y_j < p_j < 2p_i */
+            lo = (y[j] >= p) ? y[j] - p : y[j];
+            t = (t >= lo) ? t - lo : t - lo + p;
+            t = _mulmod_shoup(t, arg->inv[i*np + j],
+                                 arg->invpre[i*np + j], p);
+         }
+
+         y[i] = t;
+      }
+
+      /* Horner evaluation of the mixed radix representation */
+      v[0] = y[np - 1];
+      vn = 1;
+      for (i = np - 2; i >= 0; i--)
+      {
+         cy = y[i];
+         for (l = 0; l < vn; l++)
+         {
+            umul_ppmm(hi, lo, v[l], primes[i]);
+            add_ssaaaa(hi, lo, hi, lo, 0, cy);
+            v[l] = lo;
+            cy = hi;
+         }
+         v[vn++] = cy;
+      }
+
+      /* add to the running carry and write out the bottom limb */
+      cy = 0;
+      for (l = 0; l < np; l++)
+      {
+         add_ssaaaa(hi, lo, 0, c[l], 0, v[l]);
+         add_ssaaaa(hi, lo, hi, lo, 0, cy);
+         c[l] = lo;
+         cy = hi;
+      }
+
+      arg->r[k] = c[0];
+      for (l = 0; l < np - 1; l++)
+         c[l] = c[l + 1];
+      c[np - 1] = 0;
+   }
+
+   for (l = 0; l < np; l++)
+      arg->carry[l] = c[l];
+
+   return NULL;
+}
+
+/*
+   sets (r1, r1len) to the sequence of length len with residues res[i]
+   modulo the first np primes, evaluated at 2^FLINT_BITS, for r1len > len
+*/
+static void _mul_ntt_crt(mp_ptr r1, mp_size_t r1len,
+                                  mp_limb_t ** res, mp_size_t len, int np)
+{
+   mp_limb_t inv[FFT_NTT_NUM_PRIMES*FFT_NTT_NUM_PRIMES];
+   mp_limb_t invpre[FFT_NTT_NUM_PRIMES*FFT_NTT_NUM_PRIMES];
+   mul_ntt_crt_arg_t * crt;
+   slong num_threads;
+   int i, j;
+
+   for (i = 1; i < np; i++)
+   {
+      for (j = 0; j < i; j++)
+      {
+         inv[i*np + j] = n_invmod(fft_ntt_primes[j] % fft_ntt_primes[i],
+                                                           fft_ntt_primes[i]);
+         invpre[i*np + j] = _shoup_precomp(inv[i*np + j], fft_ntt_primes[i]);
+      }
+   }
+
+   num_threads = flint_get_num_threads();
+   num_threads = FLINT_MAX(WORD(1), FLINT_MIN(num_threads, len/1024));
+   crt = flint_malloc(num_threads*sizeof(mul_ntt_crt_arg_t));
+
+   for (i = 0; i < num_threads; i++)
+   {
+      crt[i].r = r1;
+      crt[i].res = res;
+      crt[i].k0 = (len*i)/num_threads;
+      crt[i].k1 = (len*(i + 1))/num_threads;
+      crt[i].np = np;
+      crt[i].inv = inv;
+      crt[i].invpre = invpre;
+   }
+
+   flint_parallel_map(_mul_ntt_crt_worker, crt,
+                                  sizeof(mul_ntt_crt_arg_t), num_threads);
+
+   /* the result fits, so the carries only spill into r1 */
+   flint_mpn_zero(r1 + len, r1len - len);
+   for (i = 0; i < num_threads; i++)
+   {
+      mp_size_t k1 = crt[i].k1;
+
+      mpn_add(r1 + k1, r1 + k1, r1len - k1, crt[i].carry,
+                                            FLINT_MIN(np, r1len - k1));
+   }
+
+   flint_free(crt);
+}
+
+/*
+   sets (r1, r1len) to the convolution of length 2^depth of the limbs of
+   the inputs, evaluated at 2^FLINT_BITS, for r1len > min(n1 + n2 - 1, N)
+*/
+static void __mul_ntt(mp_ptr r1, mp_size_t r1len, mp_srcptr i1, mp_size_t n1,
+                        mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, int np)
+{
+   mp_size_t N = (WORD(1) << depth), len = FLINT_MIN(n1 + n2 - 1, N);
+   mp_limb_t * res[FFT_NTT_NUM_PRIMES];
+   mp_limb_t * buf;
+   int i;
+
+   buf = flint_malloc(np*N*sizeof(mp_limb_t));
+
+   for (i = 0; i < np; i++)
+      res[i] = buf + i*N;
+
+   fft_ntt_mul_primes(res, i1, n1, i2, n2, depth, np);
+
+   _mul_ntt_crt(r1, r1len, res, len, np);
+
+   flint_free(buf);
+}
+
+void _mul_ntt(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                   mp_srcptr i2, mp_size_t n2, int np)
+{
+   mp_bitcnt_t depth = FLINT_CLOG2(n1 + n2 - 1);
+
+   if (depth > FFT_NTT_MAX_DEPTH)
+   {
+      flint_printf("Exception (mul_ntt). Product too long.\n");
+      abort();
+   }
+
+   __mul_ntt(r1, n1 + n2, i1, n1, i2, n2, depth, np);
+}
+
+void _mul_ntt_2expm1(mp_ptr r, mp_srcptr i1, mp_size_t n1,
+                 mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, int np)
+{
+   if (depth > FFT_NTT_MAX_DEPTH)
+   {
+      flint_printf("Exception (mul_ntt). Product too long.\n");
+      abort();
+   }
+
+   /* a coefficient wrapped around is no larger than one of a product */
+   __mul_ntt(r, (WORD(1) << depth) + np, i1, n1, i2, n2, depth, np);
+}
+
+void mul_ntt(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                               mp_srcptr i2, mp_size_t n2)
+{
+   /*
+      the coefficients of the product are below min(n1, n2)*2^128, which is
+      less than the product of the first three primes if min(n1, n2) <= 2^21
+   */
+   int np = (FLINT_MIN(n1, n2) <= (WORD(1) << 21)) ? 3 : 4;
+
+   _mul_ntt(r1, i1, n1, i2, n2, np);
+}
+
+void mul_ntt_mat22(mp_ptr * r, mp_srcptr * a, const mp_size_t * na,
+                      mp_srcptr * b, const mp_size_t * nb, slong k)
+{
+   mp_size_t N, len[4], lmax = 0, nmin = 0, n;
+   mp_limb_t * res[4*FFT_NTT_NUM_PRIMES];
+   mp_limb_t * crt[FFT_NTT_NUM_PRIMES];
+   mp_limb_t * buf;
+   mp_bitcnt_t depth;
+   slong i, l, o;
+   int j, np;
+
+   /* the length of the convolution for each output, or 0 if it is zero */
+   for (i = 0; i < 2; i++)
+   {
+      for (l = 0; l < k; l++)
+      {
+         o = i*k + l;
+         len[o] = 0;
+
+         if (na[2*i] != 0 && nb[l] != 0)
+         {
+            len[o] = na[2*i] + nb[l] - 1;
+            nmin = FLINT_MAX(nmin, FLINT_MIN(na[2*i], nb[l]));
+         }
+
+         if (na[2*i + 1] != 0 && nb[k + l] != 0)
+         {
+            len[o] = FLINT_MAX(len[o], na[2*i + 1] + nb[k + l] - 1);
+            nmin = FLINT_MAX(nmin, FLINT_MIN(na[2*i + 1], nb[k + l]));
+         }
+
+         lmax = FLINT_MAX(lmax, len[o]);
+      }
+   }
+
+   if (lmax == 0)
+   {
+      for (o = 0; o < 2*k; o++)
+      {
+         n = FLINT_MAX(na[2*(o/k)] + nb[o % k],
+                       na[2*(o/k) + 1] + nb[k + o % k]) + 1;
+         flint_mpn_zero(r[o], n);
+      }
+      return;
+   }
+
+   depth = FLINT_CLOG2(lmax);
+
+   if (depth > FFT_NTT_MAX_DEPTH)
+   {
+      flint_printf("Exception (mul_ntt_mat22). Product too long.\n");
+      abort();
+   }
+
+   /* the coefficients are sums of two products, below 2 nmin 2^128 */
+   np = (nmin <= (WORD(1) << 20)) ? 3 : 4;
+
+   N = (WORD(1) << depth);
+   buf = flint_malloc(2*k*np*N*sizeof(mp_limb_t));
+   for (o = 0; o < 2*k*np; o++)
+      res[o] = buf + o*N;
+
+   fft_ntt_mat22_mul_primes(res, a, na, b, nb, k, depth, np);
+
+   for (o = 0; o < 2*k; o++)
+   {
+      n = FLINT_MAX(na[2*(o/k)] + nb[o % k],
+                    na[2*(o/k) + 1] + nb[k + o % k]) + 1;
+
+      if (len[o] == 0)
+         flint_mpn_zero(r[o], n);
+      else
+      {
+         for (j = 0; j < np; j++)
+            crt[j] = res[2*k*j + o];
+
+         _mul_ntt_crt(r[o], n, crt, len[o], np);
+      }
+   }
+
+   flint_free(buf);
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+int fft_mul_params(mp_bitcnt_t * depth_out, mp_bitcnt_t * w_out,
+                                mp_size_t n1, mp_size_t n2, int threaded)
+{
+   mp_size_t off, depth = 6;
+   mp_size_t w = 1;
+   mp_size_t n = ((mp_size_t) 1 << depth);
+   mp_bitcnt_t bits = (n*w - (depth+1))/2;
+
+   mp_bitcnt_t bits1 = n1*FLINT_BITS;
+   mp_bitcnt_t bits2 = n2*FLINT_BITS;
+
+   mp_size_t j1 = (bits1 - 1)/bits + 1;
+   mp_size_t j2 = (bits2 - 1)/bits + 1;
+
+   FLINT_ASSERT(j1 + j2 - 1 > 2*n);
+
+   while (j1 + j2 - 1 > 4*n) /* find initial n, w */
+   {
+      if (w == 1) w = 2;
+      else 
+      {
+         depth++;
+         w = 1;
+         n *= 2;
+      }
+
+      bits = (n*w - (depth+1))/2;
+      j1 = (bits1 - 1)/bits + 1;
+      j2 = (bits2 - 1)/bits + 1;
+   }
+   
+   if (depth < 11 && !threaded)
+   {
+      mp_size_t wadj = 1;
+      
+      off = flint_tune_fft_tab[depth - 6][w - 1]; /* adjust n and w */
+      depth -= off;
+      n = ((mp_size_t) 1 << depth);
+      w *= ((mp_size_t) 1 << (2*off));
+      
+      if (depth < 6) wadj = ((mp_size_t) 1 << (6 - depth));
+
+      if (w > wadj)
+      {
+         do { /* see if a smaller w will work */
+            w -= wadj;
+            bits = (n*w - (depth+1))/2;
+            j1 = (bits1 - 1)/bits + 1;
+            j2 = (bits2 - 1)/bits + 1;
+         } while (j1 + j2 - 1 <= 4*n && w > wadj);  
+         w += wadj;
+      }
+
+      *depth_out = depth;
+      *w_out = w;
+      return 0;
+   } else
+   {
+      if (j1 + j2 - 1 <= 3*n && depth > 6) /* nw must be a multiple of 64 */
+      {
+         depth--;
+         w *= 3;
+      }
+
+      *depth_out = depth;
+      *w_out = w;
+      return 1;
+   }
+}
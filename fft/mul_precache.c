@@ -0,0 +1,159 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+/*
+   As for the inner pass of mul_mfa_truncate_sqrt2, except that the rows
+   of jj have already been transformed and normalised
+*/
+static void * _fft_mul_precache_worker(void * arg_ptr)
+{
+   fft_mfa_arg_struct * arg = (fft_mfa_arg_struct *) arg_ptr;
+   mp_limb_t ** ii;
+   mp_limb_t ** jj;
+   mp_size_t n1 = arg->n1;
+   mp_size_t i, j, s, start, stop;
+
+   while (_fft_mfa_claim(arg, &start, &stop))
+   {
+      for (s = start; s < stop; s++)
+      {
+         if (s < arg->trunc2)
+         {
+            ii = arg->ii + arg->half;
+            jj = arg->jj + arg->half;
+            i = n_revbin(s, arg->depth);
+         } else
+         {
+            ii = arg->ii;
+            jj = arg->jj;
+            i = s - arg->trunc2;
+         }
+
+         fft_radix2(ii + i*n1, n1/2, arg->w*arg->n2, arg->t1, arg->t2);
+      
+         for (j = 0; j < n1; j++)
+         {
+            mp_size_t t = i*n1 + j;
+            mpn_normmod_2expp1(ii[t], arg->limbs);
+            fft_mulmod_2expp1(ii[t], ii[t], jj[t], arg->n, arg->w, arg->tt);
+         }      
+      
+         ifft_radix2(ii + i*n1, n1/2, arg->w*arg->n2, arg->t1, arg->t2);
+      }
+   }
+
+   return NULL;
+}
+
+void fft_mul_precache(mp_ptr r1, mp_srcptr i2, mp_size_t n2,
+                                                   const fft_precache_t P)
+{
+   mp_bitcnt_t depth = P->depth, w = P->w;
+   mp_size_t n = (UWORD(1)<<depth);
+   mp_bitcnt_t bits1 = (n*w - (depth + 1))/2;
+   mp_size_t sqrt = (UWORD(1)<<(depth/2));
+   mp_size_t trunc = P->trunc;
+
+   mp_size_t r_limbs = P->n1 + n2;
+   mp_size_t limbs = (n*w)/FLINT_BITS;
+   mp_size_t size = limbs + 1;
+
+   mp_size_t i, j, j2;
+   mp_limb_t ** ii, ** t1, ** t2, ** s1, * tt, * ptr;
+   slong N;
+   int num_threads = 0;
+
+   if (n2 > P->n2 || n2 <= 0)
+   {
+      flint_printf("Exception (fft_mul_precache). Operand has wrong length.\n");
+      abort();
+   }
+
+   if (P->mfa && !P->threaded)
+      num_threads = flint_limit_num_threads(1);
+
+   N = P->mfa ? flint_get_num_threads() : 1;
+
+   ii = flint_malloc((4*(n + n*size) + 5*size*N)*sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
+      ii[i] = ptr;
+
+   t1 = flint_malloc(3*N*sizeof(mp_limb_t *));
+   t2 = t1 + N;
+   s1 = t2 + N;
+   for (i = 0; i < N; i++, ptr += 3*size)
+   {
+      t1[i] = ptr;
+      t2[i] = t1[i] + size;
+      s1[i] = t2[i] + size;
+   }
+   tt = ptr;
+
+   j2 = fft_split_bits(ii, i2, n2, bits1, limbs);
+   for (j = j2; j < 4*n; j++)
+      flint_mpn_zero(ii[j], limbs + 1);
+
+   if (P->mfa)
+   {
+      fft_mfa_arg_struct arg;
+
+      _fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, NULL);
+
+      _fft_mfa_arg_init(&arg, ii, P->jj, n, w, t1, t2, s1, tt, sqrt, trunc);
+      _fft_mfa_run(_fft_mul_precache_worker, &arg, arg.rows);
+
+      _ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, NULL);
+   } else
+   {
+      mp_limb_t c;
+
+      fft_truncate_sqrt2(ii, n, w, t1, t2, s1, trunc);
+
+      for (j = 0; j < trunc; j++)
+      {
+         mpn_normmod_2expp1(ii[j], limbs);
+         c = 2*ii[j][limbs] + P->jj[j][limbs];
+         ii[j][limbs] = flint_mpn_mulmod_2expp1_basecase(ii[j], ii[j],
+                                                     P->jj[j], c, n*w, tt);
+      }
+
+      ifft_truncate_sqrt2(ii, n, w, t1, t2, s1, trunc);
+      for (j = 0; j < trunc; j++)
+      {
+         mpn_div_2expmod_2expp1(ii[j], ii[j], limbs, depth + 2);
+         mpn_normmod_2expp1(ii[j], limbs);
+      }
+   }
+
+   if (P->mfa && !P->threaded)
+      flint_restore_num_threads(num_threads);
+
+   flint_mpn_zero(r1, r_limbs);
+   fft_combine_bits(r1, ii, P->j1 + j2 - 1, bits1, limbs, r_limbs);
+
+   flint_free(ii);
+   flint_free(t1);
+}
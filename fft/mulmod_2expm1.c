@@ -0,0 +1,214 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "mpn_extras.h"
+
+/*
+   The depth of the cyclic convolution for a product modulo 2^B - 1 with
+   B = limbs*FLINT_BITS, or 0 if a full product is cheaper. It is the depth
+   flint_mpn_mul_fft_main would use for a full product of B bits.
+*/
+static mp_bitcnt_t _mulmod_2expm1_depth(mp_size_t limbs)
+{
+   mp_bitcnt_t depth, w;
+   int threaded = flint_get_num_threads() > 1 &&
+                  limbs >= flint_tune_params[FLINT_TUNE_FFT_MUL_THREADED];
+
+   if (limbs/2 < flint_tune_params[FLINT_TUNE_MPN_MUL_FFT])
+      return 0;
+
+   fft_mul_params(&depth, &w, limbs - limbs/2, limbs/2, threaded);
+
+   return FLINT_MAX(depth, 4);
+}
+
+mp_size_t fft_adjust_limbs_2expm1(mp_size_t limbs)
+{
+   mp_bitcnt_t depth = _mulmod_2expm1_depth(limbs);
+   mp_size_t adj;
+
+   if (depth == 0)
+      return limbs;
+
+#if FFT_NTT
+   /* the small prime transforms wrap around at a power of two limbs */
+   if (fft_mul_use_ntt(limbs - limbs/2, limbs/2))
+      return (WORD(1) << FLINT_CLOG2(limbs));
+#endif
+
+   if (depth <= 4)
+      return limbs;
+
+   /* the 4n coefficients of the convolution must split B evenly */
+   adj = (WORD(1) << (depth - 4));
+
+   return adj*((limbs + adj - 1)/adj);
+}
+
+/* sets (r, limbs) to (t, tn) modulo 2^B - 1, reduced, for tn <= 2*limbs */
+static void _fold_2expm1(mp_ptr r, mp_srcptr t, mp_size_t tn, mp_size_t limbs)
+{
+   mp_limb_t cy;
+   mp_size_t i;
+
+   if (tn <= limbs)
+   {
+      flint_mpn_copyi(r, t, tn);
+      flint_mpn_zero(r + tn, limbs - tn);
+   } else
+   {
+      cy = mpn_add(r, t, limbs, t + limbs, tn - limbs);
+      while (cy)
+         cy = mpn_add_1(r, r, limbs, cy);
+   }
+
+   /* 2^B - 1 is zero */
+   for (i = 0; i < limbs && r[i] == ~UWORD(0); i++) ;
+   if (i == limbs)
+      flint_mpn_zero(r, limbs);
+}
+
+/* limbs of the coefficients of a cyclic convolution of length 4*2^depth */
+static mp_size_t _mulmod_2expm1_climbs(mp_size_t n1, mp_size_t n2,
+                                     mp_size_t limbs, mp_bitcnt_t depth)
+{
+   mp_size_t n = (WORD(1) << depth), j1, j2, climbs, adj;
+   mp_bitcnt_t bits1 = (limbs*FLINT_BITS)/(4*n), output_bits;
+
+   j1 = FLINT_MIN((n1*FLINT_BITS - 1)/bits1 + 1, 4*n);
+   j2 = FLINT_MIN((n2*FLINT_BITS - 1)/bits1 + 1, 4*n);
+
+   /* each coefficient of the convolution is a sum of min(j1, j2) products */
+   output_bits = 2*bits1 + FLINT_CLOG2(FLINT_MIN(j1, j2));
+
+   /* nw must be a multiple of FLINT_BITS and suit the pointwise products */
+   output_bits = (((output_bits - 1) >> depth) + 1) << depth;
+   climbs = (output_bits - 1)/FLINT_BITS + 1;
+   adj = FLINT_MAX(n/FLINT_BITS, 1);
+   while (1)
+   {
+      climbs = fft_adjust_limbs(climbs);
+      if (climbs % adj == 0)
+         break;
+      climbs = adj*((climbs + adj - 1)/adj);
+   }
+
+   return climbs;
+}
+
+void flint_mpn_mulmod_2expm1(mp_ptr r, mp_srcptr i1, mp_size_t n1,
+                        mp_srcptr i2, mp_size_t n2, mp_size_t limbs)
+{
+   mp_bitcnt_t depth, bits1;
+   mp_size_t n, i, j1, j2, climbs, size;
+   mp_limb_t ** ii, ** jj, * ptr, * t;
+   int sqr = (i1 == i2 && n1 == n2), ntt = 0;
+
+   depth = _mulmod_2expm1_depth(limbs);
+
+#if FFT_NTT
+   /* the small prime transforms only wrap around at a power of two */
+   if (depth != 0 && fft_mul_use_ntt(limbs - limbs/2, limbs/2))
+      ntt = ((limbs & (limbs - 1)) == 0) ? 1 : -1;
+#endif
+
+   /* a full product is no larger than the cyclic one */
+   if (depth == 0 || n1 + n2 <= limbs || ntt < 0)
+   {
+      t = flint_malloc((n1 + n2)*sizeof(mp_limb_t));
+      flint_mpn_mul(t, i1, n1, i2, n2);
+      _fold_2expm1(r, t, n1 + n2, limbs);
+      flint_free(t);
+      return;
+   }
+
+#if FFT_NTT
+   if (ntt)
+   {
+      int np = (FLINT_MIN(n1, n2) <= (WORD(1) << 21)) ? 3 : 4;
+
+      t = flint_malloc((limbs + np)*sizeof(mp_limb_t));
+      _mul_ntt_2expm1(t, i1, n1, i2, n2, FLINT_CLOG2(limbs), np);
+      _fold_2expm1(r, t, limbs + np, limbs);
+      flint_free(t);
+      return;
+   }
+#endif
+
+   /* 2^(depth + 2) must divide B, which it always does for depth 4 */
+   while (depth > 4 && ((limbs*FLINT_BITS) & ((WORD(4) << depth) - 1)) != 0)
+      depth--;
+
+   /*
+      rounding nw up to a multiple of n can waste enough bits that a
+      shorter transform is cheaper, despite its larger pointwise products
+   */
+   climbs = _mulmod_2expm1_climbs(n1, n2, limbs, depth);
+   while (depth > 4)
+   {
+      mp_size_t c = _mulmod_2expm1_climbs(n1, n2, limbs, depth - 1);
+
+      if (4*c >= 7*climbs)
+         break;
+
+      climbs = c;
+      depth--;
+   }
+
+   n = (WORD(1) << depth);
+   bits1 = (limbs*FLINT_BITS)/(4*n);
+   size = climbs + 1;
+
+   ii = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size)
+      ii[i] = ptr;
+
+   j1 = fft_split_bits(ii, i1, n1, bits1, climbs);
+   for (i = j1; i < 4*n; i++)
+      flint_mpn_zero(ii[i], size);
+
+   if (!sqr)
+   {
+      jj = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+      for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size)
+         jj[i] = ptr;
+
+      j2 = fft_split_bits(jj, i2, n2, bits1, climbs);
+      for (i = j2; i < 4*n; i++)
+         flint_mpn_zero(jj[i], size);
+   } else
+      jj = ii;
+
+   /* an untruncated transform wraps coefficient 4n + i onto i */
+   _fft_convolution_threaded(ii, jj, depth, climbs, 4*n);
+
+   /* the coefficients overlap B by less than climbs + 1 limbs */
+   t = flint_calloc(limbs + size, sizeof(mp_limb_t));
+   fft_combine_bits(t, ii, 4*n, bits1, climbs, limbs + size);
+   _fold_2expm1(r, t, limbs + size, limbs);
+
+   flint_free(t);
+   flint_free(ii);
+   if (!sqr)
+      flint_free(jj);
+}
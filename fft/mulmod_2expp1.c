@@ -36,7 +36,6 @@ or implied, of William Hart.
 #include "fft_tuning.h"
 #include "mpn_extras.h"
 
-static mp_size_t mulmod_2expp1_table_n[FFT_N_NUM] = MULMOD_TAB;
 
 void fft_naive_convolution_1(mp_limb_t * r, mp_limb_t * ii, mp_limb_t * jj, mp_size_t m)
 {
@@ -55,8 +54,17 @@ void fft_naive_convolution_1(mp_limb_t * r, mp_limb_t * ii, mp_limb_t * jj, mp_s
    }
 }
 
-void _fft_mulmod_2expp1(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2, 
-                 mp_size_t r_limbs, mp_bitcnt_t depth, mp_bitcnt_t w)
+mp_size_t _fft_mulmod_2expp1_temp_limbs(mp_bitcnt_t depth, mp_bitcnt_t w)
+{
+   mp_size_t n = (UWORD(1)<<depth);
+   mp_size_t size = (n*w)/FLINT_BITS + 1;
+
+   return (2*(n + n*size) + 4*n + 5*size) + (2*(n + n*size) + 2*n);
+}
+
+void _fft_mulmod_2expp1_temp(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2, 
+                 mp_size_t r_limbs, mp_bitcnt_t depth, mp_bitcnt_t w,
+                                                           mp_limb_t * temp)
 {
    mp_size_t n = (UWORD(1)<<depth);
    mp_bitcnt_t bits1 = (r_limbs*FLINT_BITS)/(2*n);
@@ -69,7 +77,7 @@ void _fft_mulmod_2expp1(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2,
    mp_limb_t ** ii, ** jj, *tt, *t1, *t2, *s1, *r, *ii0, *jj0;
    mp_limb_t c;
    
-   ii = flint_malloc((2*(n + n*size) + 4*n + 5*size)*sizeof(mp_limb_t));
+   ii = (mp_limb_t **) temp;
    for (i = 0, ptr = (mp_limb_t *) ii + 2*n; i < 2*n; i++, ptr += size) 
    {
       ii[i] = ptr;
@@ -83,7 +91,7 @@ void _fft_mulmod_2expp1(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2,
    
    if (i1 != i2)
    {
-      jj = flint_malloc((2*(n + n*size) + 2*n)*sizeof(mp_limb_t));
+      jj = (mp_limb_t **) (tt + 2*size);
       for (i = 0, ptr = (mp_limb_t *) jj + 2*n; i < 2*n; i++, ptr += size) 
       {
          jj[i] = ptr;
@@ -175,9 +183,38 @@ void _fft_mulmod_2expp1(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2,
    c = mpn_sub_n(r1, r1, ii[2*n - 1] + limb_add, limbs + 1 - limb_add);
    mpn_addmod_2expp1_1(r1 + limbs + 1 - limb_add, r_limbs - limbs - 1 + limb_add, -c);
    mpn_normmod_2expp1(r1, r_limbs);
+}
+
+void _fft_mulmod_2expp1(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2, 
+                 mp_size_t r_limbs, mp_bitcnt_t depth, mp_bitcnt_t w)
+{
+   mp_limb_t * temp;
+
+   temp = flint_malloc(_fft_mulmod_2expp1_temp_limbs(depth, w)*sizeof(mp_limb_t));
+   _fft_mulmod_2expp1_temp(r1, i1, i2, r_limbs, depth, w, temp);
+   flint_free(temp);
+}
+
+int _fft_mulmod_2expp1_params(mp_bitcnt_t * depth1, mp_bitcnt_t * w1,
+                                                      mp_size_t n, mp_size_t w)
+{
+   mp_size_t bits = n*w;
+   mp_size_t limbs = bits/FLINT_BITS;
+   mp_bitcnt_t depth = 1;
+   mp_size_t off;
+
+   if (limbs <= flint_tune_params[FLINT_TUNE_FFT_MULMOD_2EXPP1]) 
+      return 0;
+
+   while ((UWORD(1)<<depth) < bits) depth++;
    
-   flint_free(ii);
-   if (i1 != i2) flint_free(jj);
+   if (depth < 12) off = flint_tune_mulmod_tab[0];
+   else off = flint_tune_mulmod_tab[FLINT_MIN(depth, FFT_N_NUM + 11) - 12];
+   *depth1 = depth/2 - off;
+   
+   *w1 = bits/(UWORD(1)<<(2*(*depth1)));
+
+   return 1;
 }
 
 void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2, 
@@ -185,9 +222,7 @@ void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2,
 {
    mp_size_t bits = n*w;
    mp_size_t limbs = bits/FLINT_BITS;
-   mp_bitcnt_t depth1, depth = 1;
-
-   mp_size_t w1, off;
+   mp_bitcnt_t depth1, w1;
 
    mp_limb_t c = 2*i1[limbs] + i2[limbs];
       
@@ -203,19 +238,11 @@ void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2,
       return;
    }
 
-   if (limbs <= FFT_MULMOD_2EXPP1_CUTOFF) 
+   if (!_fft_mulmod_2expp1_params(&depth1, &w1, n, w)) 
    {
       r[limbs] = flint_mpn_mulmod_2expp1_basecase(r, i1, i2, c, bits, tt);
       return;
    }
-   
-   while ((UWORD(1)<<depth) < bits) depth++;
-   
-   if (depth < 12) off = mulmod_2expp1_table_n[0];
-   else off = mulmod_2expp1_table_n[FLINT_MIN(depth, FFT_N_NUM + 11) - 12];
-   depth1 = depth/2 - off;
-   
-   w1 = bits/(UWORD(1)<<(2*depth1));
 
    _fft_mulmod_2expp1(r, i1, i2, limbs, depth1, w1);
 }
@@ -226,20 +253,20 @@ slong fft_adjust_limbs(mp_size_t limbs)
    mp_size_t depth = 1, limbs2, depth1 = 1, depth2 = 1, adj;
    mp_size_t off1, off2;
 
-   if (limbs <= FFT_MULMOD_2EXPP1_CUTOFF) return limbs;
+   if (limbs <= flint_tune_params[FLINT_TUNE_FFT_MULMOD_2EXPP1]) return limbs;
          
    depth = FLINT_CLOG2(limbs);
    limbs2 = (WORD(1)<<depth); /* within a factor of 2 of limbs */
    bits2 = limbs2*FLINT_BITS;
 
    depth1 = FLINT_CLOG2(bits1);
-   if (depth1 < 12) off1 = mulmod_2expp1_table_n[0];
-   else off1 = mulmod_2expp1_table_n[FLINT_MIN(depth1, FFT_N_NUM + 11) - 12];
+   if (depth1 < 12) off1 = flint_tune_mulmod_tab[0];
+   else off1 = flint_tune_mulmod_tab[FLINT_MIN(depth1, FFT_N_NUM + 11) - 12];
    depth1 = depth1/2 - off1;
    
    depth2 = FLINT_CLOG2(bits2);
-   if (depth2 < 12) off2 = mulmod_2expp1_table_n[0];
-   else off2 = mulmod_2expp1_table_n[FLINT_MIN(depth2, FFT_N_NUM + 11) - 12];
+   if (depth2 < 12) off2 = flint_tune_mulmod_tab[0];
+   else off2 = flint_tune_mulmod_tab[FLINT_MIN(depth2, FFT_N_NUM + 11) - 12];
    depth2 = depth2/2 - off2;
    
    depth1 = FLINT_MAX(depth1, depth2);
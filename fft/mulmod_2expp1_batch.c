@@ -0,0 +1,115 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+void _fft_mulmod_2expp1_batch(mp_limb_t ** ii, mp_limb_t ** jj,
+             mp_size_t count, mp_size_t n, mp_bitcnt_t w, mp_limb_t * tt)
+{
+   mp_size_t j, limbs = (n*w)/FLINT_BITS;
+   mp_bitcnt_t depth1, w1;
+   mp_limb_t * temp = NULL;
+   int big = _fft_mulmod_2expp1_params(&depth1, &w1, n, w);
+
+   /* the temporaries of the negacyclic products are shared by the batch */
+   if (big)
+      temp = flint_malloc(_fft_mulmod_2expp1_temp_limbs(depth1, w1)*sizeof(mp_limb_t));
+
+   for (j = 0; j < count; j++)
+   {
+      mpn_normmod_2expp1(ii[j], limbs);
+      if (ii != jj) mpn_normmod_2expp1(jj[j], limbs);
+
+      if (big && ii[j][limbs] == 0 && jj[j][limbs] == 0)
+         _fft_mulmod_2expp1_temp(ii[j], ii[j], jj[j], limbs, depth1, w1, temp);
+      else
+         fft_mulmod_2expp1(ii[j], ii[j], jj[j], n, w, tt);
+   }
+
+   if (big)
+      flint_free(temp);
+}
+
+typedef struct
+{
+   mp_limb_t ** ii;
+   mp_limb_t ** jj;
+   mp_size_t count;
+   mp_size_t n;
+   mp_bitcnt_t w;
+} _fft_mulmod_batch_arg;
+
+static void * _fft_mulmod_batch_worker(void * arg_ptr)
+{
+   _fft_mulmod_batch_arg * arg = (_fft_mulmod_batch_arg *) arg_ptr;
+   mp_size_t limbs = (arg->n*arg->w)/FLINT_BITS;
+   mp_limb_t * tt = flint_malloc(2*(limbs + 1)*sizeof(mp_limb_t));
+
+   _fft_mulmod_2expp1_batch(arg->ii, arg->jj, arg->count, arg->n, arg->w, tt);
+
+   flint_free(tt);
+
+   return NULL;
+}
+
+void fft_mulmod_2expp1_batch(mp_limb_t ** ii, mp_limb_t ** jj,
+                              mp_size_t count, mp_size_t n, mp_bitcnt_t w)
+{
+   _fft_mulmod_batch_arg * args;
+   mp_size_t limbs = (n*w)/FLINT_BITS;
+   slong i, blocks, num_threads = flint_get_num_threads();
+
+   /* too little work to share between threads */
+   if (num_threads == 1 || count*limbs < 2048)
+   {
+      _fft_mulmod_batch_arg arg;
+
+      arg.ii = ii;
+      arg.jj = jj;
+      arg.count = count;
+      arg.n = n;
+      arg.w = w;
+
+      _fft_mulmod_batch_worker(&arg);
+      return;
+   }
+
+   /* a few contiguous blocks per thread balance the load */
+   blocks = FLINT_MIN(count, 4*num_threads);
+   args = flint_malloc(blocks*sizeof(_fft_mulmod_batch_arg));
+
+   for (i = 0; i < blocks; i++)
+   {
+      mp_size_t start = (i*count)/blocks, stop = ((i + 1)*count)/blocks;
+
+      args[i].ii = ii + start;
+      args[i].jj = jj + start;
+      args[i].count = stop - start;
+      args[i].n = n;
+      args[i].w = w;
+   }
+
+   flint_parallel_map(_fft_mulmod_batch_worker, args,
+                                       sizeof(_fft_mulmod_batch_arg), blocks);
+
+   flint_free(args);
+}
@@ -0,0 +1,103 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+#if FFT_NTT
+
+/*
+   Decimation in frequency butterflies on the blocks of length 2m of
+   (a, len), with Harvey's lazy reduction: the inputs and outputs are in
+   [0, 2p) and the twiddle multiplication is Shoup's.
+*/
+static void _fft_ntt_layer(mp_limb_t * a, mp_size_t len, mp_size_t m,
+               mp_srcptr tw, mp_srcptr twpre, mp_limb_t p, int ifma)
+{
+   mp_limb_t x, y, q, p2 = 2*p;
+   mp_size_t s, j;
+
+#if FFT_NTT_SIMD
+   if (ifma && m >= 8)
+   {
+      _fft_ntt_layer_ifma(a, len, m, tw, twpre, p);
+      return;
+   }
+#endif
+
+   for (s = 0; s < len; s += 2*m)
+   {
+      mp_limb_t * b = a + s + m;
+
+      for (j = 0; j < m; j++)
+      {
+         x = a[s + j];
+         y = b[j];
+
+         a[s + j] = x + y - ((x + y >= p2) ? p2 : 0);
+
+         y = x - y + p2;
+         umul_ppmm(q, x, y, twpre[j]);
+         b[j] = y*tw[j] - q*p;
+      }
+   }
+}
+
+/* blocks of 2^10 entries are transformed layer by layer, in cache */
+static void _fft_ntt(mp_limb_t * a, mp_bitcnt_t depth,
+                                           const fft_ntt_struct * T, int ifma)
+{
+   mp_size_t m, len = (WORD(1) << depth);
+
+   if (depth <= 10)
+   {
+      for (m = len/2; m >= 1; m /= 2)
+      {
+#if FFT_NTT_SIMD
+         if (ifma && m == 4 && len >= 16)
+         {
+            _fft_ntt_base_ifma(a, len, T->tw, T->twpre, T->p);
+            break;
+         }
+#endif
+         _fft_ntt_layer(a, len, m, T->tw + m, T->twpre + m, T->p, ifma);
+      }
+   } else
+   {
+      m = len/2;
+      _fft_ntt_layer(a, len, m, T->tw + m, T->twpre + m, T->p, ifma);
+      _fft_ntt(a, depth - 1, T, ifma);
+      _fft_ntt(a + m, depth - 1, T, ifma);
+   }
+}
+
+void fft_ntt(mp_limb_t * a, const fft_ntt_t T)
+{
+#if FFT_NTT_SIMD
+   int ifma = (flint_cpu_features() & FLINT_CPU_AVX512IFMA) != 0;
+#else
+   int ifma = 0;
+#endif
+
+   _fft_ntt(a, T->depth, T, ifma);
+}
+
+#endif
@@ -0,0 +1,298 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+#if FFT_NTT && FFT_NTT_SIMD
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <immintrin.h>
+#undef ulong
+#define ulong mp_limb_t
+
+#define IFMA __attribute__((target("avx512f,avx512ifma")))
+
+#define LOAD(p) _mm512_loadu_si512((const void *) (p))
+#define STORE(p, x) _mm512_storeu_si512((void *) (p), x)
+
+/* x - n if x >= n, for x < 2 n */
+#define REDUCE_2N(x, n) _mm512_min_epu64(x, _mm512_sub_epi64(x, n))
+
+/*
+   Shoup's multiplication of d < 4p by w with wp = floor(w 2^52 / p), the
+   precomputed twpre shifted right by 12 bits; the result is below 2p.
+*/
+#define SHOUP_MUL52(r, d, w, wp, p, zero, mask) \
+   do { \
+      __m512i __q = _mm512_madd52hi_epu64(zero, d, wp); \
+      (r) = _mm512_sub_epi64(_mm512_madd52lo_epu64(zero, d, w), \
+                             _mm512_madd52lo_epu64(zero, __q, p)); \
+      (r) = _mm512_and_si512(r, mask); \
+   } while (0)
+
+#define MASK52 ((UWORD(1) << 52) - 1)
+
+IFMA void _fft_ntt_layer_ifma(mp_limb_t * a, mp_size_t len, mp_size_t m,
+                                 mp_srcptr tw, mp_srcptr twpre, mp_limb_t p)
+{
+   __m512i x, y, w, wp, pp = _mm512_set1_epi64(p);
+   __m512i p2 = _mm512_set1_epi64(2*p);
+   __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+   mp_size_t s, j;
+
+   for (s = 0; s < len; s += 2*m)
+   {
+      mp_limb_t * b = a + s + m;
+
+      for (j = 0; j < m; j += 8)
+      {
+         x = LOAD(a + s + j);
+         y = LOAD(b + j);
+         w = LOAD(tw + j);
+         wp = _mm512_srli_epi64(LOAD(twpre + j), 12);
+
+         STORE(a + s + j, REDUCE_2N(_mm512_add_epi64(x, y), p2));
+
+         y = _mm512_add_epi64(_mm512_sub_epi64(x, y), p2);
+         SHOUP_MUL52(y, y, w, wp, pp, zero, mask);
+         STORE(b + j, y);
+      }
+   }
+}
+
+IFMA void _ifft_ntt_layer_ifma(mp_limb_t * a, mp_size_t len, mp_size_t m,
+                                 mp_srcptr tw, mp_srcptr twpre, mp_limb_t p)
+{
+   __m512i x, y, w, wp, pp = _mm512_set1_epi64(p);
+   __m512i p2 = _mm512_set1_epi64(2*p);
+   __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+   mp_size_t s, j;
+
+   for (s = 0; s < len; s += 2*m)
+   {
+      mp_limb_t * b = a + s + m;
+
+      for (j = 0; j < m; j += 8)
+      {
+         x = LOAD(a + s + j);
+         y = LOAD(b + j);
+         w = LOAD(tw + j);
+         wp = _mm512_srli_epi64(LOAD(twpre + j), 12);
+
+         SHOUP_MUL52(y, y, w, wp, pp, zero, mask);
+
+         STORE(a + s + j, REDUCE_2N(_mm512_add_epi64(x, y), p2));
+         y = _mm512_add_epi64(_mm512_sub_epi64(x, y), p2);
+         STORE(b + j, REDUCE_2N(y, p2));
+      }
+   }
+}
+
+/*
+   The last three layers work inside blocks of 8, so pairs of blocks u, v
+   are permuted into vectors x, y of the entries combined at level m, with
+   the twiddles for level m repeated in w.
+*/
+#define BASE_PERMS(m, X, Y, U, V) \
+   do { \
+      if ((m) == 4) \
+      { \
+         X = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11); \
+         Y = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15); \
+         U = X; \
+         V = Y; \
+      } else if ((m) == 2) \
+      { \
+         X = _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13); \
+         Y = _mm512_setr_epi64(2, 3, 6, 7, 10, 11, 14, 15); \
+         U = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11); \
+         V = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15); \
+      } else \
+      { \
+         X = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14); \
+         Y = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15); \
+         U = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11); \
+         V = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15); \
+      } \
+   } while (0)
+
+static __inline__ mp_limb_t _base_tw(mp_srcptr tw, int m, int k)
+{
+   return tw[m + (k % m)];
+}
+
+#define BASE_TWIDDLES(w, wp, m, tw, twpre) \
+   do { \
+      w = _mm512_setr_epi64(_base_tw(tw, m, 0), _base_tw(tw, m, 1), \
+                            _base_tw(tw, m, 2), _base_tw(tw, m, 3), \
+                            _base_tw(tw, m, 0), _base_tw(tw, m, 1), \
+                            _base_tw(tw, m, 2), _base_tw(tw, m, 3)); \
+      wp = _mm512_setr_epi64(_base_tw(twpre, m, 0), _base_tw(twpre, m, 1), \
+                             _base_tw(twpre, m, 2), _base_tw(twpre, m, 3), \
+                             _base_tw(twpre, m, 0), _base_tw(twpre, m, 1), \
+                             _base_tw(twpre, m, 2), _base_tw(twpre, m, 3)); \
+      wp = _mm512_srli_epi64(wp, 12); \
+   } while (0)
+
+IFMA void _fft_ntt_base_ifma(mp_limb_t * a, mp_size_t len,
+                                 mp_srcptr tw, mp_srcptr twpre, mp_limb_t p)
+{
+   __m512i u, v, x, y, pp = _mm512_set1_epi64(p);
+   __m512i p2 = _mm512_set1_epi64(2*p);
+   __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+   __m512i ix[3], iy[3], iu[3], iv[3], w[3], wp[3];
+   mp_size_t s;
+   int l, m;
+
+   for (l = 0, m = 4; l < 3; l++, m /= 2)
+   {
+      BASE_PERMS(m, ix[l], iy[l], iu[l], iv[l]);
+      BASE_TWIDDLES(w[l], wp[l], m, tw, twpre);
+   }
+
+   for (s = 0; s < len; s += 16)
+   {
+      u = LOAD(a + s);
+      v = LOAD(a + s + 8);
+
+      for (l = 0; l < 3; l++)
+      {
+         x = _mm512_permutex2var_epi64(u, ix[l], v);
+         y = _mm512_permutex2var_epi64(u, iy[l], v);
+
+         u = REDUCE_2N(_mm512_add_epi64(x, y), p2);
+         y = _mm512_add_epi64(_mm512_sub_epi64(x, y), p2);
+         SHOUP_MUL52(y, y, w[l], wp[l], pp, zero, mask);
+
+         v = _mm512_permutex2var_epi64(u, iv[l], y);
+         u = _mm512_permutex2var_epi64(u, iu[l], y);
+      }
+
+      STORE(a + s, u);
+      STORE(a + s + 8, v);
+   }
+}
+
+IFMA void _ifft_ntt_base_ifma(mp_limb_t * a, mp_size_t len,
+                                 mp_srcptr tw, mp_srcptr twpre, mp_limb_t p)
+{
+   __m512i u, v, x, y, pp = _mm512_set1_epi64(p);
+   __m512i p2 = _mm512_set1_epi64(2*p);
+   __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+   __m512i ix[3], iy[3], iu[3], iv[3], w[3], wp[3];
+   mp_size_t s;
+   int l, m;
+
+   for (l = 0, m = 1; l < 3; l++, m *= 2)
+   {
+      BASE_PERMS(m, ix[l], iy[l], iu[l], iv[l]);
+      BASE_TWIDDLES(w[l], wp[l], m, tw, twpre);
+   }
+
+   for (s = 0; s < len; s += 16)
+   {
+      u = LOAD(a + s);
+      v = LOAD(a + s + 8);
+
+      for (l = 0; l < 3; l++)
+      {
+         x = _mm512_permutex2var_epi64(u, ix[l], v);
+         y = _mm512_permutex2var_epi64(u, iy[l], v);
+
+         SHOUP_MUL52(y, y, w[l], wp[l], pp, zero, mask);
+         u = REDUCE_2N(_mm512_add_epi64(x, y), p2);
+         y = _mm512_add_epi64(_mm512_sub_epi64(x, y), p2);
+         y = REDUCE_2N(y, p2);
+
+         v = _mm512_permutex2var_epi64(u, iv[l], y);
+         u = _mm512_permutex2var_epi64(u, iu[l], y);
+      }
+
+      STORE(a + s, u);
+      STORE(a + s + 8, v);
+   }
+}
+
+/*
+   Sets a to values in [0, 2p) congruent to the limbs of x, where c is
+   2^52 mod p: the top 12 bits of each limb are multiplied by c and the
+   sum of both parts, below 8p, is reduced by 4p and 2p.
+*/
+IFMA void _fft_ntt_reduce_ifma(mp_limb_t * a, mp_srcptr x, mp_size_t len,
+                                 mp_limb_t c, mp_limb_t cpre, mp_limb_t p)
+{
+   __m512i lo, hi, pp = _mm512_set1_epi64(p);
+   __m512i p2 = _mm512_set1_epi64(2*p), p4 = _mm512_set1_epi64(4*p);
+   __m512i cc = _mm512_set1_epi64(c), cp = _mm512_set1_epi64(cpre >> 12);
+   __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+   mp_size_t j;
+
+   for (j = 0; j + 8 <= len; j += 8)
+   {
+      lo = LOAD(x + j);
+      hi = _mm512_srli_epi64(lo, 52);
+      lo = _mm512_and_si512(lo, mask);
+
+      SHOUP_MUL52(hi, hi, cc, cp, pp, zero, mask);
+      lo = _mm512_add_epi64(lo, hi);
+      lo = REDUCE_2N(lo, p4);
+      lo = REDUCE_2N(lo, p2);
+
+      STORE(a + j, lo);
+   }
+
+   for ( ; j < len; j++)
+      a[j] = x[j] % p;
+}
+
+/*
+   Sets a to a b/N in [0, 2p) for a, b in [0, 2p): the product is split as
+   h 2^52 + l and c0 = 1/N, c1 = 2^52/N modulo p are applied to the parts.
+*/
+IFMA void _fft_ntt_mul_ifma(mp_limb_t * a, mp_srcptr b, mp_size_t len,
+                     mp_limb_t c0, mp_limb_t c0pre, mp_limb_t c1,
+                                         mp_limb_t c1pre, mp_limb_t p)
+{
+   __m512i x, y, lo, hi, pp = _mm512_set1_epi64(p);
+   __m512i p2 = _mm512_set1_epi64(2*p);
+   __m512i w0 = _mm512_set1_epi64(c0), wp0 = _mm512_set1_epi64(c0pre >> 12);
+   __m512i w1 = _mm512_set1_epi64(c1), wp1 = _mm512_set1_epi64(c1pre >> 12);
+   __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+   mp_size_t j;
+
+   for (j = 0; j < len; j += 8)
+   {
+      x = LOAD(a + j);
+      y = LOAD(b + j);
+
+      lo = _mm512_madd52lo_epu64(zero, x, y);
+      hi = _mm512_madd52hi_epu64(zero, x, y);
+
+      SHOUP_MUL52(lo, lo, w0, wp0, pp, zero, mask);
+      SHOUP_MUL52(hi, hi, w1, wp1, pp, zero, mask);
+
+      STORE(a + j, REDUCE_2N(_mm512_add_epi64(lo, hi), p2));
+   }
+}
+
+#endif
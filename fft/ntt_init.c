@@ -0,0 +1,102 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "ulong_extras.h"
+
+#if FFT_NTT
+
+const mp_limb_t fft_ntt_primes[FFT_NTT_NUM_PRIMES] =
+{
+   UWORD(0x3ffc000000001), UWORD(0x3ffa000000001),
+   UWORD(0x3ff7000000001), UWORD(0x3fe5000000001)
+};
+
+/* primitive roots modulo the primes */
+const mp_limb_t fft_ntt_generators[FFT_NTT_NUM_PRIMES] = { 11, 3, 3, 3 };
+
+void fft_ntt_init(fft_ntt_t T, mp_limb_t p, mp_limb_t g, mp_bitcnt_t depth)
+{
+   mp_size_t h, m, j, N = (WORD(1) << depth);
+   mp_limb_t w, wpre, q, r, pnorm, pnorminv;
+   unsigned int norm;
+
+   T->p = p;
+   T->pinv = n_preinvert_limb(p);
+   T->depth = depth;
+   T->alloc = 1;
+
+   T->tw = flint_malloc(4*N*sizeof(mp_limb_t));
+   T->twpre = T->tw + N;
+   T->itw = T->twpre + N;
+   T->itwpre = T->itw + N;
+
+   if (depth == 0)
+      return;
+
+   count_leading_zeros(norm, p);
+   pnorm = p << norm;
+   pnorminv = n_preinvert_limb(pnorm);
+
+   /* powers of a primitive N-th root w for the top layer */
+   h = N/2;
+   w = n_powmod2_preinv(g, (p - 1) >> depth, p, T->pinv);
+   udiv_qrnnd_preinv(wpre, r, w << norm, 0, pnorm, pnorminv);
+
+   T->tw[h] = 1;
+   for (j = 1; j < h; j++)
+   {
+      umul_ppmm(q, r, T->tw[h + j - 1], wpre);
+      r = T->tw[h + j - 1]*w - q*p;
+      T->tw[h + j] = (r >= p) ? r - p : r;
+   }
+
+   for (j = 0; j < h; j++)
+      udiv_qrnnd_preinv(T->twpre[h + j], r, T->tw[h + j] << norm, 0,
+                                                            pnorm, pnorminv);
+
+   /*
+      w^-j = -w^(h - j), and floor((p - x)*2^64/p) is the complement of
+      floor(x*2^64/p) for 0 < x < p
+   */
+   T->itw[h] = 1;
+   T->itwpre[h] = T->twpre[h];
+   for (j = 1; j < h; j++)
+   {
+      T->itw[h + j] = p - T->tw[2*h - j];
+      T->itwpre[h + j] = ~T->twpre[2*h - j];
+   }
+
+   /* a primitive 2m-th root is the square of a primitive 4m-th root */
+   for (m = h/2; m >= 1; m /= 2)
+   {
+      for (j = 0; j < m; j++)
+      {
+         T->tw[m + j] = T->tw[2*m + 2*j];
+         T->twpre[m + j] = T->twpre[2*m + 2*j];
+         T->itw[m + j] = T->itw[2*m + 2*j];
+         T->itwpre[m + j] = T->itwpre[2*m + 2*j];
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+#if FFT_NTT
+
+/*
+   The tables for level m do not depend on the depth, so the deepest tables
+   computed so far for each prime serve all smaller transforms.
+*/
+static FLINT_TLS_PREFIX fft_ntt_struct _fft_ntt_cache[FFT_NTT_NUM_PRIMES];
+static FLINT_TLS_PREFIX int _fft_ntt_cache_registered = 0;
+
+static void _fft_ntt_cache_clear(void)
+{
+   slong i;
+
+   for (i = 0; i < FFT_NTT_NUM_PRIMES; i++)
+   {
+      if (_fft_ntt_cache[i].tw != NULL)
+         fft_ntt_clear(_fft_ntt_cache + i);
+
+      _fft_ntt_cache[i].tw = NULL;
+   }
+
+   _fft_ntt_cache_registered = 0;
+}
+
+void fft_ntt_init_prime(fft_ntt_t T, slong i, mp_bitcnt_t depth)
+{
+   fft_ntt_struct * C = _fft_ntt_cache + i;
+
+   if (depth > FFT_NTT_CACHE_DEPTH)
+   {
+      fft_ntt_init(T, fft_ntt_primes[i], fft_ntt_generators[i], depth);
+      return;
+   }
+
+   if (!_fft_ntt_cache_registered)
+   {
+      flint_register_cleanup_function(_fft_ntt_cache_clear);
+      _fft_ntt_cache_registered = 1;
+   }
+
+   if (C->tw == NULL || C->depth < depth)
+   {
+      if (C->tw != NULL)
+         fft_ntt_clear(C);
+
+      fft_ntt_init(C, fft_ntt_primes[i], fft_ntt_generators[i], depth);
+   }
+
+   *T = *C;
+   T->depth = depth;
+   T->alloc = 0;
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "ulong_extras.h"
+
+/* completes the forward transform begun by _fft_mfa_truncate_sqrt2_outer */
+static void * _fft_precache_rows_worker(void * arg_ptr)
+{
+   fft_mfa_arg_struct * arg = (fft_mfa_arg_struct *) arg_ptr;
+   mp_limb_t ** ii;
+   mp_size_t n1 = arg->n1;
+   mp_size_t i, j, s, start, stop;
+
+   while (_fft_mfa_claim(arg, &start, &stop))
+   {
+      for (s = start; s < stop; s++)
+      {
+         if (s < arg->trunc2)
+         {
+            ii = arg->ii + arg->half;
+            i = n_revbin(s, arg->depth);
+         } else
+         {
+            ii = arg->ii;
+            i = s - arg->trunc2;
+         }
+
+         fft_radix2(ii + i*n1, n1/2, arg->w*arg->n2, arg->t1, arg->t2);
+      
+         for (j = 0; j < n1; j++)
+            mpn_normmod_2expp1(ii[i*n1 + j], arg->limbs);
+      }
+   }
+
+   return NULL;
+}
+
+void fft_precache_init(fft_precache_t P,
+                              mp_srcptr i1, mp_size_t n1, mp_size_t n2)
+{
+   mp_bitcnt_t depth, w, bits1;
+   mp_size_t n, limbs, size, sqrt, trunc, i, j, j1, j2;
+   mp_limb_t ** jj, ** t1, ** t2, ** s1, * ptr;
+   slong N;
+   int num_threads = 0;
+
+   P->threaded = flint_get_num_threads() > 1 &&
+                 n1 + n2 >= flint_tune_params[FLINT_TUNE_FFT_MUL_THREADED];
+   P->mfa = fft_mul_params(&depth, &w, n1, n2, P->threaded);
+
+   n = (UWORD(1)<<depth);
+   bits1 = (n*w - (depth + 1))/2;
+   limbs = (n*w)/FLINT_BITS;
+   size = limbs + 1;
+   sqrt = (UWORD(1)<<(depth/2));
+
+   j1 = (n1*FLINT_BITS - 1)/bits1 + 1;
+   j2 = (n2*FLINT_BITS - 1)/bits1 + 1;
+
+   /* the transform must hold the product with any operand of n2 limbs */
+   trunc = j1 + j2 - 1;
+   if (P->mfa)
+      trunc = 2*sqrt*((trunc + 2*sqrt - 1)/(2*sqrt));
+
+   if (P->mfa && !P->threaded)
+      num_threads = flint_limit_num_threads(1);
+
+   N = P->mfa ? flint_get_num_threads() : 1;
+
+   /*
+      the transforms swap coefficients with the temporaries, so these are
+      allocated with the coefficients and kept until fft_precache_clear
+   */
+   jj = flint_malloc((4*(n + n*size) + 3*size*N)*sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
+      jj[i] = ptr;
+
+   t1 = flint_malloc(3*N*sizeof(mp_limb_t *));
+   t2 = t1 + N;
+   s1 = t2 + N;
+   for (i = 0; i < N; i++, ptr += 3*size)
+   {
+      t1[i] = ptr;
+      t2[i] = t1[i] + size;
+      s1[i] = t2[i] + size;
+   }
+
+   j1 = fft_split_bits(jj, i1, n1, bits1, limbs);
+   for (j = j1; j < 4*n; j++)
+      flint_mpn_zero(jj[j], limbs + 1);
+
+   if (P->mfa)
+   {
+      fft_mfa_arg_struct arg;
+
+      _fft_mfa_truncate_sqrt2_outer(jj, n, w, t1, t2, s1, sqrt, trunc, NULL);
+
+      _fft_mfa_arg_init(&arg, jj, jj, n, w, t1, t2, s1, NULL, sqrt, trunc);
+      _fft_mfa_run(_fft_precache_rows_worker, &arg, arg.rows);
+   } else
+   {
+      fft_truncate_sqrt2(jj, n, w, t1, t2, s1, trunc);
+      for (j = 0; j < trunc; j++)
+         mpn_normmod_2expp1(jj[j], limbs);
+   }
+
+   if (P->mfa && !P->threaded)
+      flint_restore_num_threads(num_threads);
+
+   flint_free(t1);
+
+   P->n1 = n1;
+   P->n2 = n2;
+   P->j1 = j1;
+   P->depth = depth;
+   P->w = w;
+   P->trunc = trunc;
+   P->jj = jj;
+}
@@ -0,0 +1,87 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+#include "profiler.h"
+
+/*
+   Times flint_mpn_mul_fft_main for balanced products over a range of sizes
+   in steps of 1/16 of an octave, with the small prime transforms switched
+   off. With truncated transforms of arbitrary length the time per limb
+   should grow smoothly with the size, rather than jumping by up to a factor
+   of two whenever the transform length or coefficient size has to change.
+   The parameters chosen by fft_mul_params are printed alongside.
+*/
+int
+main(void)
+{
+    mp_size_t limbs;
+    double size;
+    mp_limb_t * i1, * i2, * r1;
+    const mp_size_t max_limbs = 1000000;
+
+    FLINT_TEST_INIT(state);
+
+    _flint_rand_init_gmp(state);
+
+    flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = 0;
+
+    i1 = flint_malloc(4*max_limbs*sizeof(mp_limb_t));
+    i2 = i1 + max_limbs;
+    r1 = i2 + max_limbs;
+
+    flint_mpn_urandomb(i1, state->gmp_state, max_limbs*FLINT_BITS);
+    flint_mpn_urandomb(i2, state->gmp_state, max_limbs*FLINT_BITS);
+
+    flint_printf("limbs\tdepth\tw\tmfa\tms\tns/limb\n");
+
+    for (size = 1000.0; size <= max_limbs; size *= 1.044273782427413840)
+    {
+       mp_bitcnt_t depth, w;
+       int mfa;
+       timeit_t timer;
+       slong reps;
+       double t;
+
+       limbs = (mp_size_t) size;
+       mfa = fft_mul_params(&depth, &w, limbs, limbs, 0);
+
+       TIMEIT_REPEAT(timer, reps)
+          flint_mpn_mul_fft_main(r1, i1, limbs, i2, limbs);
+       TIMEIT_END_REPEAT(timer, reps)
+       t = ((double) timer->wall)/reps; /* milliseconds */
+
+       flint_printf("%wd\t%wu\t%wu\t%d\t%.3g\t%.3g\n",
+                    limbs, depth, w, mfa, t, t*1000000.0/limbs);
+    }
+
+    flint_free(i1);
+
+    flint_tune_reset();
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+#include "profiler.h"
+
+/*
+   Compares the small prime transforms with the truncated sqrt2 transforms
+   for products of two integers of the given number of limbs. The depth and
+   w for mul_truncate_sqrt2 are the smallest that fit, as chosen by
+   flint_mpn_mul_fft_main before it adjusts them with the tuning table.
+*/
+void fft_params(mp_bitcnt_t * depth, mp_bitcnt_t * w, mp_size_t limbs)
+{
+   mp_size_t n = 64, j;
+   mp_bitcnt_t bits;
+
+   *depth = 6;
+   *w = 1;
+
+   while (1)
+   {
+      bits = (n*(*w) - (*depth + 1))/2;
+      j = (limbs*FLINT_BITS - 1)/bits + 1;
+
+      if (2*j - 1 <= 4*n)
+         break;
+
+      if (*w == 1)
+         *w = 2;
+      else
+      {
+         (*depth)++;
+         *w = 1;
+         n *= 2;
+      }
+   }
+}
+
+int
+main(void)
+{
+    mp_size_t limbs;
+    double t1, t2;
+
+    FLINT_TEST_INIT(state);
+
+    _flint_rand_init_gmp(state);
+
+    flint_printf("limbs\tmul_ntt\tmul_truncate_sqrt2\tratio\n");
+
+    for (limbs = 1000; limbs <= 1000000; limbs = (limbs*3)/2)
+    {
+       mp_bitcnt_t depth, w;
+       mp_limb_t * i1, * i2, * r1;
+
+       i1 = flint_malloc(4*limbs*sizeof(mp_limb_t));
+       i2 = i1 + limbs;
+       r1 = i2 + limbs;
+
+       flint_mpn_urandomb(i1, state->gmp_state, limbs*FLINT_BITS);
+       flint_mpn_urandomb(i2, state->gmp_state, limbs*FLINT_BITS);
+
+       fft_params(&depth, &w, limbs);
+
+       /* the first call sets up the tables of roots of unity */
+       mul_ntt(r1, i1, limbs, i2, limbs);
+
+       {
+          timeit_t timer;
+          slong reps;
+
+          TIMEIT_REPEAT(timer, reps)
+             mul_ntt(r1, i1, limbs, i2, limbs);
+          TIMEIT_END_REPEAT(timer, reps)
+          t1 = timer->wall*0.001/reps;
+
+          TIMEIT_REPEAT(timer, reps)
+             mul_truncate_sqrt2(r1, i1, limbs, i2, limbs, depth, w);
+          TIMEIT_END_REPEAT(timer, reps)
+          t2 = timer->wall*0.001/reps;
+       }
+
+       flint_printf("%wd\t%.3g\t%.3g\t\t\t%.2f\n", limbs, t1, t2, t2/t1);
+
+       flint_free(i1);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    return 0;
+}
@@ -0,0 +1,273 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#define _GNU_SOURCE /* mkstemp, ftruncate, madvise and posix_fadvise */
+
+#include <string.h>
+#include <pthread.h>
+#include "gmp.h"
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+#if (!defined (__WIN32) || defined(__CYGWIN__)) && !defined(_MSC_VER)
+#define FFT_HAVE_MMAP 1
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#else
+#define FFT_HAVE_MMAP 0
+#endif
+
+/* the limit and directory are read by every thread doing a transform */
+static pthread_mutex_t fft_scratch_lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t fft_memory_limit = 0;
+static char * fft_scratch_dir = NULL;
+
+void fft_set_memory_limit(size_t limit, const char * dir)
+{
+   pthread_mutex_lock(&fft_scratch_lock);
+
+   fft_memory_limit = limit;
+
+   if (fft_scratch_dir != NULL)
+   {
+      flint_free(fft_scratch_dir);
+      fft_scratch_dir = NULL;
+   }
+
+   if (dir != NULL)
+   {
+      fft_scratch_dir = flint_malloc(strlen(dir) + 1);
+      strcpy(fft_scratch_dir, dir);
+   }
+
+   pthread_mutex_unlock(&fft_scratch_lock);
+}
+
+void * _fft_scratch_init(fft_scratch_t S, size_t bytes)
+{
+#if FFT_HAVE_MMAP
+   size_t limit;
+   char * name = NULL;
+#endif
+
+   S->bytes = bytes;
+   S->fd = -1;
+   S->block = 0;
+   S->page = 1;
+
+#if FFT_HAVE_MMAP
+   /* take a copy of the settings, which may change in another thread */
+   pthread_mutex_lock(&fft_scratch_lock);
+
+   limit = fft_memory_limit;
+
+   if (limit != 0 && bytes > limit)
+   {
+      const char * dir = fft_scratch_dir;
+
+      if (dir == NULL)
+         dir = getenv("TMPDIR");
+      if (dir == NULL)
+         dir = "/tmp";
+
+      name = flint_malloc(strlen(dir) + 20);
+      strcpy(name, dir);
+      strcat(name, "/flint_fft_XXXXXX");
+   }
+
+   pthread_mutex_unlock(&fft_scratch_lock);
+
+   if (name != NULL)
+   {
+      void * ptr;
+
+      /* the file disappears with the mapping, however the process exits */
+      S->fd = mkstemp(name);
+      if (S->fd != -1)
+         unlink(name);
+
+      if (S->fd == -1 || ftruncate(S->fd, bytes) != 0)
+      {
+         flint_printf("Exception (_fft_scratch_init). Unable to create "
+                      "scratch file %s.\n", name);
+         abort();
+      }
+
+      flint_free(name);
+
+      ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, S->fd, 0);
+      if (ptr == MAP_FAILED)
+      {
+         flint_printf("Exception (_fft_scratch_init). Unable to map "
+                      "scratch file.\n");
+         abort();
+      }
+
+      S->ptr = ptr;
+      S->page = sysconf(_SC_PAGESIZE);
+      S->block = limit/4;
+
+      return S->ptr;
+   }
+#endif
+
+   S->ptr = flint_malloc(bytes);
+
+   return S->ptr;
+}
+
+void _fft_scratch_clear(fft_scratch_t S)
+{
+#if FFT_HAVE_MMAP
+   if (S->fd != -1)
+   {
+      munmap(S->ptr, S->bytes);
+      close(S->fd);
+      return;
+   }
+#endif
+
+   flint_free(S->ptr);
+}
+
+void _fft_scratch_release(fft_scratch_t S, void * start, size_t bytes)
+{
+#if FFT_HAVE_MMAP
+   size_t lo, hi;
+
+   if (S->fd == -1)
+      return;
+
+   /* only the part inside S, and in that only whole pages, is released */
+   if ((char *) start >= S->ptr + S->bytes
+                                    || (char *) start + bytes <= S->ptr)
+      return;
+
+   lo = ((char *) start < S->ptr) ? 0 : (char *) start - S->ptr;
+   hi = FLINT_MIN((char *) start + bytes - S->ptr, S->bytes);
+   lo = ((lo + S->page - 1)/S->page)*S->page;
+   hi = (hi/S->page)*S->page;
+
+   if (lo >= hi)
+      return;
+
+   /* write the pages back to the file, then drop them from memory */
+   msync(S->ptr + lo, hi - lo, MS_SYNC);
+   madvise(S->ptr + lo, hi - lo, MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+   posix_fadvise(S->fd, lo, hi - lo, POSIX_FADV_DONTNEED);
+#endif
+#endif
+}
+
+void _fft_mfa_set_scratch(fft_mfa_arg_struct * arg, fft_scratch_t S, int cols)
+{
+   size_t size = (arg->limbs + 1)*sizeof(mp_limb_t);
+   size_t item, min;
+
+   arg->scratch = S;
+   arg->block = 0;
+
+   if (S == NULL || S->block == 0)
+      return;
+
+   if (cols)
+   {
+      /* a column of both halves, which must be at least two pages wide */
+      item = ((4*arg->n)/arg->n1)*size;
+      min = (2*S->page + size - 1)/size;
+   } else
+   {
+      /* a row of each input */
+      item = (arg->ii == arg->jj ? 1 : 2)*arg->n1*size;
+      min = 1;
+   }
+
+   arg->block = FLINT_MAX(S->block/item, min);
+}
+
+/*
+   Release the count coefficients ptrs[0], ..., ptrs[count - 1]. They are
+   found through the pointers, since the transforms swap coefficients with
+   each other and with the temporaries, but runs of them adjacent in memory
+   are released together, as only whole pages can be released.
+*/
+static void _fft_mfa_release_ptrs(fft_scratch_t S, mp_limb_t ** ptrs,
+                                                mp_size_t count, size_t size)
+{
+   char * lo = NULL, * hi = NULL, * p;
+   mp_size_t k;
+
+   for (k = 0; k < count; k++)
+   {
+      p = (char *) ptrs[k];
+
+      if (p != hi)
+      {
+         if (lo != NULL)
+            _fft_scratch_release(S, lo, hi - lo);
+         lo = p;
+         hi = p;
+      }
+
+      hi += size;
+   }
+
+   if (lo != NULL)
+      _fft_scratch_release(S, lo, hi - lo);
+}
+
+void _fft_mfa_release_cols(fft_mfa_arg_struct * arg,
+                                              mp_size_t start, mp_size_t stop)
+{
+   size_t size = (arg->limbs + 1)*sizeof(mp_limb_t);
+   mp_size_t r, n1 = arg->n1, rows = (4*arg->n)/n1;
+
+   if (arg->scratch == NULL)
+      return;
+
+   for (r = 0; r < rows; r++)
+      _fft_mfa_release_ptrs(arg->scratch, arg->ii + r*n1 + start,
+                                                          stop - start, size);
+}
+
+void _fft_mfa_release_rows(fft_mfa_arg_struct * arg,
+                                              mp_size_t start, mp_size_t stop)
+{
+   size_t size = (arg->limbs + 1)*sizeof(mp_limb_t);
+   mp_size_t i, s, n1 = arg->n1;
+
+   if (arg->scratch == NULL)
+      return;
+
+   for (s = start; s < stop; s++)
+   {
+      if (s < arg->trunc2)
+         i = arg->half + n_revbin(s, arg->depth)*n1;
+      else
+         i = (s - arg->trunc2)*n1;
+
+      _fft_mfa_release_ptrs(arg->scratch, arg->ii + i, n1, size);
+      if (arg->jj != arg->ii)
+         _fft_mfa_release_ptrs(arg->scratch, arg->jj + i, n1, size);
+   }
+}
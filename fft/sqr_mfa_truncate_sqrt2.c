@@ -0,0 +1,84 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "ulong_extras.h"
+
+void sqr_mfa_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                          mp_bitcnt_t depth, mp_bitcnt_t w)
+{
+   mp_size_t n = (UWORD(1)<<depth);
+   mp_bitcnt_t bits1 = (n*w - (depth+1))/2; 
+   mp_size_t sqrt = (UWORD(1)<<(depth/2));
+
+   mp_size_t r_limbs = 2*n1;
+   mp_size_t limbs = (n*w)/FLINT_BITS;
+   mp_size_t size = limbs + 1;
+
+   mp_size_t j1 = (n1*FLINT_BITS - 1)/bits1 + 1;
+   
+   mp_size_t i, j, trunc;
+
+   mp_limb_t ** ii, ** t1, ** t2, ** s1, * ptr;
+   mp_limb_t * tt;
+   fft_scratch_t S;
+
+   /* each thread working on the transforms needs its own temporaries */
+   slong N = flint_get_num_threads();
+   
+   /* the storage goes to a file if it is too large */
+   ii = _fft_scratch_init(S, (4*(n + n*size) + 5*size*N)*sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
+   {
+      ii[i] = ptr;
+   }
+   t1 = flint_malloc(3*N*sizeof(mp_limb_t *));
+   t2 = t1 + N;
+   s1 = t2 + N;
+   for (i = 0; i < N; i++, ptr += 3*size)
+   {
+      t1[i] = ptr;
+      t2[i] = t1[i] + size;
+      s1[i] = t2[i] + size;
+   }
+   tt = ptr;
+   
+   trunc = 2*j1 - 1;
+   trunc = 2*sqrt*((trunc + 2*sqrt - 1)/(2*sqrt)); /* trunc must be divisible by 2*sqrt */
+
+   j1 = fft_split_bits(ii, i1, n1, bits1, limbs);
+   for (j = j1 ; j < 4*n; j++)
+      flint_mpn_zero(ii[j], limbs + 1);
+   _fft_scratch_release(S, ii + 4*n, 4*n*size*sizeof(mp_limb_t));
+   
+   _fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, S);
+   
+   /* with both arguments equal the inner pass transforms once and squares */
+   _fft_mfa_truncate_sqrt2_inner(ii, ii, n, w, t1, t2, s1, sqrt, trunc, tt, S);
+   _ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc, S);
+       
+   flint_mpn_zero(r1, r_limbs);
+   fft_combine_bits(r1, ii, 2*j1 - 1, bits1, limbs, r_limbs);
+     
+   _fft_scratch_clear(S);
+   flint_free(t1);
+}
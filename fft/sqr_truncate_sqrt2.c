@@ -0,0 +1,83 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "mpn_extras.h"
+
+void sqr_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1, 
+                        mp_bitcnt_t depth, mp_bitcnt_t w)
+{
+   mp_size_t n = (UWORD(1)<<depth);
+   mp_bitcnt_t bits1 = (n*w - (depth+1))/2; 
+   
+   mp_size_t r_limbs = 2*n1;
+   mp_size_t limbs = (n*w)/FLINT_BITS;
+   mp_size_t size = limbs + 1;
+
+   mp_size_t j1 = (n1*FLINT_BITS - 1)/bits1 + 1;
+   
+   mp_size_t i, j, trunc;
+
+   mp_limb_t ** ii, * t1, * t2, * s1, * tt, * ptr;
+   mp_limb_t c;
+   SCRATCH_INIT;
+
+   SCRATCH_START;
+
+   ii = SCRATCH_ALLOC((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
+   {
+      ii[i] = ptr;
+   }
+   t1 = ptr;
+   t2 = t1 + size;
+   s1 = t2 + size;
+   tt = s1 + size;
+   
+   trunc = 2*j1 - 1;
+
+   /* only one forward transform is needed */
+   j1 = fft_split_bits(ii, i1, n1, bits1, limbs);
+   for (j = j1 ; j < 4*n; j++)
+      flint_mpn_zero(ii[j], limbs + 1);
+   
+   fft_truncate_sqrt2(ii, n, w, &t1, &t2, &s1, trunc);
+
+   for (j = 0; j < trunc; j++)
+   {
+      mpn_normmod_2expp1(ii[j], limbs);
+      c = 3*ii[j][limbs];
+      ii[j][limbs] = flint_mpn_mulmod_2expp1_basecase(ii[j], ii[j], ii[j], c, n*w, tt);
+   }
+
+   ifft_truncate_sqrt2(ii, n, w, &t1, &t2, &s1, trunc);
+   for (j = 0; j < trunc; j++)
+   {
+      mpn_div_2expmod_2expp1(ii[j], ii[j], limbs, depth + 2);
+      mpn_normmod_2expp1(ii[j], limbs);
+   }
+   
+   flint_mpn_zero(r1, r_limbs);
+   fft_combine_bits(r1, ii, 2*j1 - 1, bits1, limbs, r_limbs);
+     
+   SCRATCH_END;
+}
@@ -0,0 +1,116 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    mp_bitcnt_t depth, w;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("convolution....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (depth = 6; depth <= 10; depth++)
+    {
+        for (w = 1; w <= 3; w++)
+        {
+            mp_size_t n = (UWORD(1)<<depth);
+            mp_size_t trunc = n_randint(state, 4*n) + 1;
+            mp_size_t limbs = (n*w)/FLINT_BITS;
+            mp_size_t size = limbs + 1;
+            mp_size_t i;
+            mp_limb_t * ptr;
+            mp_limb_t ** ii, ** jj, ** ii2, ** jj2, * t1, * t2, * s1, * tt;
+
+            ii = flint_malloc((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
+            for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
+            {
+                ii[i] = ptr;
+                random_fermat(ii[i], state, limbs);
+                mpn_normmod_2expp1(ii[i], limbs);
+            }
+            t1 = ptr;
+            t2 = t1 + size;
+            s1 = t2 + size;
+            tt = s1 + size;
+
+            jj = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+            for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
+            {
+                jj[i] = ptr;
+                random_fermat(jj[i], state, limbs);
+                mpn_normmod_2expp1(jj[i], limbs);
+            }
+
+            ii2 = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+            for (i = 0, ptr = (mp_limb_t *) ii2 + 4*n; i < 4*n; i++, ptr += size) 
+            {
+                ii2[i] = ptr;
+                flint_mpn_copyi(ii2[i], ii[i], size);
+            }
+
+            jj2 = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+            for (i = 0, ptr = (mp_limb_t *) jj2 + 4*n; i < 4*n; i++, ptr += size) 
+            {
+                jj2[i] = ptr;
+                flint_mpn_copyi(jj2[i], jj[i], size);
+            }
+
+            /* one set of temporaries must suffice whatever the thread count */
+            flint_set_num_threads(n_randint(state, 4) + 1);
+
+            fft_convolution(ii, jj, depth, limbs, trunc, &t1, &t2, &s1, tt);
+            _fft_convolution_threaded(ii2, jj2, depth, limbs, trunc);
+
+            for (i = 0; i < trunc; i++)
+            {
+                if (mpn_cmp(ii[i], ii2[i], size) != 0)
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("n = %wd, w = %wu, trunc = %wd\n", n, w, trunc);
+                    flint_printf("Error in entry %wd\n", i);
+                    abort();
+                }
+            }
+
+            flint_free(ii);
+            flint_free(jj);
+            flint_free(ii2);
+            flint_free(jj2);
+        }
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("fft/ifft_ntt....");
+    fflush(stdout);
+
+#if FFT_NTT
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        mp_bitcnt_t depth = n_randint(state, 13);
+        mp_size_t N = (WORD(1) << depth), j, k;
+        slong prime = n_randint(state, FFT_NTT_NUM_PRIMES);
+        mp_limb_t p = fft_ntt_primes[prime], w, s;
+        mp_limb_t * a, * b;
+        fft_ntt_t T;
+
+        if (n_randint(state, 2))
+            fft_ntt_init_prime(T, prime, depth);
+        else
+            fft_ntt_init(T, p, fft_ntt_generators[prime], depth);
+
+        flint_set_cpu_features(n_randint(state, 8));
+
+        a = flint_malloc(N*sizeof(mp_limb_t));
+        b = flint_malloc(N*sizeof(mp_limb_t));
+
+        /* inputs may be anywhere in [0, 2p) */
+        for (j = 0; j < N; j++)
+            a[j] = b[j] = n_randint(state, 2*p);
+
+        fft_ntt(b, T);
+
+        /* the output is the evaluation at the powers of w in revbin order */
+        if (depth <= 6)
+        {
+            w = n_powmod2_preinv(fft_ntt_generators[prime],
+                                          (p - 1) >> depth, p, T->pinv);
+
+            for (k = 0; k < N; k++)
+            {
+                s = 0;
+                for (j = N - 1; j >= 0; j--)
+                {
+                    s = n_mulmod2_preinv(s, n_powmod2_preinv(w, k, p,
+                                                   T->pinv), p, T->pinv);
+                    s = n_addmod(s, a[j] % p, p);
+                }
+
+                if (b[n_revbin(k, depth)] % p != s)
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("depth = %wu, p = %wu, k = %wd\n",
+                                                               depth, p, k);
+                    abort();
+                }
+            }
+        }
+
+        ifft_ntt(b, T);
+
+        for (j = 0; j < N; j++)
+        {
+            if (b[j] >= 2*p || b[j] % p !=
+                          n_mulmod2_preinv(a[j] % p, N % p, p, T->pinv))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("depth = %wu, p = %wu, j = %wd\n", depth, p, j);
+                abort();
+            }
+        }
+
+        flint_free(a);
+        flint_free(b);
+        fft_ntt_clear(T);
+    }
+
+    flint_set_cpu_features(-1);
+#endif
+
+    flint_randclear(state);
+    flint_cleanup();
+
+    flint_printf("PASS\n");
+    return 0;
+}
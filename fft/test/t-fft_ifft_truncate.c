@@ -59,8 +59,6 @@ main(void)
             mp_size_t i;
             mp_limb_t * ptr;
             mp_limb_t ** ii, ** jj, *t1, *t2;
-        
-            trunc = 2*((trunc + 1)/2);
 
             ii = flint_malloc((2*(n + n*size) + 2*size)*sizeof(mp_limb_t));
             for (i = 0, ptr = (mp_limb_t *) ii + 2*n; i < 2*n; i++, ptr += size) 
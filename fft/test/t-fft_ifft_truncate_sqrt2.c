@@ -53,14 +53,12 @@ main(void)
         for (w = 1; w <= 5; w++)
         {
             mp_size_t n = (UWORD(1)<<depth);
-            mp_size_t trunc = 2*n + n_randint(state, 2*n) + 1;
+            mp_size_t trunc = n_randint(state, 4*n) + 1;
             mp_size_t limbs = (n*w)/GMP_LIMB_BITS;
             mp_size_t size = limbs + 1;
             mp_size_t i;
             mp_limb_t * ptr;
             mp_limb_t ** ii, ** jj, * t1, * t2, * s1;
-        
-            trunc = 2*((trunc + 1)/2);
 
             ii = flint_malloc((4*(n + n*size) + 3*size)*sizeof(mp_limb_t));
             for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
@@ -74,6 +72,10 @@ main(void)
    
             for (i = 0; i < 4*n; i++)
                mpn_normmod_2expp1(ii[i], limbs);
+
+            /* the input has length at most trunc */
+            for (i = trunc; i < 4*n; i++)
+               flint_mpn_zero(ii[i], size);
     
             jj = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
             for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
@@ -91,6 +91,16 @@ main(void)
    
                flint_mpn_urandomb(i1, state->gmp_state, b1);
                flint_mpn_urandomb(i2, state->gmp_state, b2);
+
+               /*
+                  use the threaded path and the small prime transforms at
+                  all sizes half of the time
+               */
+               flint_set_num_threads(n_randint(state, 4) + 1);
+               flint_tune_params[FLINT_TUNE_FFT_MUL_THREADED] =
+                                    n_randint(state, 2) ? 0 : n1 + n2 + 1;
+               flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] =
+                                    n_randint(state, 2) ? 0 : n1 + n2 + 1;
   
                mpn_mul(r2, i1, n1, i2, n2);
                flint_mpn_mul_fft_main(r1, i1, n1, i2, n2);
@@ -109,8 +119,11 @@ main(void)
         }
     }
 
-    FLINT_TEST_CLEANUP(state);
-    
+    flint_tune_reset();
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
     flint_printf("PASS\n");
     return 0;
 }
@@ -54,7 +54,7 @@ main(void)
         {
             mp_size_t n = (UWORD(1)<<depth);
             mp_bitcnt_t bits1 = (n*w - (depth + 1))/2; 
-            mp_size_t trunc = 2*n + 2*n_randint(state, n) + 2; /* trunc is even */
+            mp_size_t trunc = n_randint(state, 4*n) + 2; /* any length */
             mp_bitcnt_t bits = (trunc/2)*bits1;
             mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
             mp_size_t j;
@@ -67,6 +67,8 @@ main(void)
    
             random_fermat(i1, state, int_limbs);
             random_fermat(i2, state, int_limbs);
+
+            flint_set_num_threads(n_randint(state, 4) + 1);
             
             mpn_mul(r2, i1, int_limbs, i2, int_limbs);
             mul_mfa_truncate_sqrt2(r1, i1, int_limbs, i2, int_limbs, depth, w);
@@ -102,6 +104,8 @@ main(void)
             r2 = r1 + 2*int_limbs;
    
             random_fermat(i1, state, int_limbs);
+
+            flint_set_num_threads(n_randint(state, 4) + 1);
             
             mpn_mul(r2, i1, int_limbs, i1, int_limbs);
             mul_mfa_truncate_sqrt2(r1, i1, int_limbs, i1, int_limbs, depth, w);
@@ -119,7 +123,52 @@ main(void)
         }
     }
 
-    FLINT_TEST_CLEANUP(state);
+    /* test products spilt to a scratch file */
+    for (depth = 6; depth <= 11; depth++)
+    {
+        for (w = 1; w <= 2; w++)
+        {
+            mp_size_t n = (UWORD(1)<<depth);
+            mp_bitcnt_t bits1 = (n*w - (depth + 1))/2; 
+            mp_size_t trunc = n_randint(state, 4*n) + 2;
+            mp_bitcnt_t bits = (trunc/2)*bits1;
+            mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
+            mp_size_t j;
+            mp_limb_t * i1, *i2, *r1, *r2;
+        
+            i1 = flint_malloc(6*int_limbs*sizeof(mp_limb_t));
+            i2 = i1 + int_limbs;
+            r1 = i2 + int_limbs;
+            r2 = r1 + 2*int_limbs;
+   
+            random_fermat(i1, state, int_limbs);
+            random_fermat(i2, state, int_limbs);
+
+            flint_set_num_threads(n_randint(state, 4) + 1);
+            fft_set_memory_limit(n_randint(state, 100000) + 1, NULL);
+            
+            if (n_randint(state, 2))
+               i2 = i1;
+
+            mpn_mul(r2, i1, int_limbs, i2, int_limbs);
+            mul_mfa_truncate_sqrt2(r1, i1, int_limbs, i2, int_limbs, depth, w);
+            
+            for (j = 0; j < 2*int_limbs; j++)
+            {
+                if (r1[j] != r2[j]) 
+                {
+                    flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                    abort();
+                }
+            }
+
+            fft_set_memory_limit(0, NULL);
+            flint_free(i1);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
     
     flint_printf("PASS\n");
     return 0;
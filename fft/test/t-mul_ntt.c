@@ -0,0 +1,97 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_ntt....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+#if FFT_NTT
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        mp_size_t n1, n2, j;
+        mp_limb_t * i1, * i2, * r1, * r2;
+        int np, square;
+
+        n1 = n_randint(state, 1 + (i % 10 == 0 ? 20000 : 600)) + 1;
+        n2 = n_randint(state, n1) + 1;
+        square = n_randint(state, 4) == 0;
+        if (square)
+            n2 = n1;
+
+        i1 = flint_malloc(3*(n1 + n2)*sizeof(mp_limb_t));
+        i2 = square ? i1 : i1 + n1;
+        r1 = i1 + n1 + n2;
+        r2 = r1 + n1 + n2;
+
+        /* all ones inputs give the largest coefficients */
+        if (n_randint(state, 4) == 0)
+        {
+            for (j = 0; j < n1 + n2; j++)
+                i1[j] = ~UWORD(0);
+        } else
+        {
+            flint_mpn_urandomb(i1, state->gmp_state, n1*FLINT_BITS);
+            flint_mpn_urandomb(i1 + n1, state->gmp_state, n2*FLINT_BITS);
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        flint_set_cpu_features(n_randint(state, 8));
+        np = 3 + n_randint(state, 2);
+
+        mpn_mul(r2, i1, n1, i2, n2);
+        _mul_ntt(r1, i1, n1, i2, n2, np);
+
+        for (j = 0; j < n1 + n2; j++)
+        {
+            if (r1[j] != r2[j])
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("n1 = %wd, n2 = %wd, np = %d\n", n1, n2, np);
+                flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                abort();
+            }
+        }
+
+        flint_free(i1);
+    }
+
+    flint_set_cpu_features(-1);
+#endif
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    flint_printf("PASS\n");
+    return 0;
+}
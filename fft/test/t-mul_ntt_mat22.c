@@ -0,0 +1,143 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+/* add the product of (a, na) and (b, nb) into (r, n) */
+static void
+_addmul(mp_ptr r, mp_size_t n, mp_srcptr a, mp_size_t na,
+                               mp_srcptr b, mp_size_t nb, mp_ptr t)
+{
+    if (na == 0 || nb == 0)
+        return;
+
+    if (na >= nb)
+        mpn_mul(t, a, na, b, nb);
+    else
+        mpn_mul(t, b, nb, a, na);
+
+    mpn_add(r, r, n, t, na + nb);
+}
+
+int
+main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_ntt_mat22....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+#if FFT_NTT
+    for (i = 0; i < 300 * flint_test_multiplier(); i++)
+    {
+        mp_limb_t * a[4], * b[4], * r1[4], * r2[4], * t;
+        mp_size_t na[4], nb[4], n[4], j, m;
+        slong k, l, o, len;
+
+        k = 1 + n_randint(state, 2);
+        len = (i % 10 == 0) ? 5000 : 300;
+
+        for (j = 0; j < 4; j++)
+        {
+            na[j] = (n_randint(state, 8) == 0) ? 0 : n_randint(state, len) + 1;
+            nb[j] = (n_randint(state, 8) == 0) ? 0 : n_randint(state, len) + 1;
+            a[j] = flint_malloc((na[j] + 1)*sizeof(mp_limb_t));
+            b[j] = flint_malloc((nb[j] + 1)*sizeof(mp_limb_t));
+
+            /* all ones inputs give the largest coefficients */
+            if (n_randint(state, 4) == 0)
+            {
+                for (m = 0; m < na[j]; m++)
+                    a[j][m] = ~UWORD(0);
+                for (m = 0; m < nb[j]; m++)
+                    b[j][m] = ~UWORD(0);
+            } else
+            {
+                flint_mpn_urandomb(a[j], state->gmp_state, na[j]*FLINT_BITS);
+                flint_mpn_urandomb(b[j], state->gmp_state, nb[j]*FLINT_BITS);
+            }
+        }
+
+        t = flint_malloc((2*len + 2)*sizeof(mp_limb_t));
+
+        for (j = 0; j < 2; j++)
+        {
+            for (l = 0; l < k; l++)
+            {
+                o = j*k + l;
+                n[o] = FLINT_MAX(na[2*j] + nb[l], na[2*j + 1] + nb[k + l]) + 1;
+                r1[o] = flint_malloc(n[o]*sizeof(mp_limb_t));
+                r2[o] = flint_malloc(n[o]*sizeof(mp_limb_t));
+
+                flint_mpn_zero(r2[o], n[o]);
+                _addmul(r2[o], n[o], a[2*j], na[2*j], b[l], nb[l], t);
+                _addmul(r2[o], n[o], a[2*j + 1], na[2*j + 1],
+                                     b[k + l], nb[k + l], t);
+            }
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        flint_set_cpu_features(n_randint(state, 8));
+
+        mul_ntt_mat22(r1, (mp_srcptr *) a, na, (mp_srcptr *) b, nb, k);
+
+        for (o = 0; o < 2*k; o++)
+        {
+            for (j = 0; j < n[o]; j++)
+            {
+                if (r1[o][j] != r2[o][j])
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("k = %wd, entry %wd\n", k, o);
+                    flint_printf("error in limb %wd, %wx != %wx\n",
+                                                     j, r1[o][j], r2[o][j]);
+                    abort();
+                }
+            }
+
+            flint_free(r1[o]);
+            flint_free(r2[o]);
+        }
+
+        for (j = 0; j < 4; j++)
+        {
+            flint_free(a[j]);
+            flint_free(b[j]);
+        }
+        flint_free(t);
+    }
+
+    flint_set_cpu_features(-1);
+#endif
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    slong i;
+    
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_precache....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        mp_size_t n1, n2, m, j;
+        mp_limb_t * i1, * i2, * r1, * r2;
+        fft_precache_t P;
+        slong k;
+
+        n1 = n_randint(state, 20000) + 100;
+        n2 = n_randint(state, 20000) + 100;
+
+        i1 = flint_malloc((n1 + n2)*sizeof(mp_limb_t));
+        i2 = i1 + n1;
+        r1 = flint_malloc(2*(n1 + n2)*sizeof(mp_limb_t));
+        r2 = r1 + n1 + n2;
+
+        flint_mpn_rrandom(i1, state->gmp_state, n1);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        flint_tune_params[FLINT_TUNE_FFT_MUL_THREADED] = n_randint(state, 40000);
+
+        fft_precache_init(P, i1, n1, n2);
+
+        /* the cached operand is multiplied by several shorter ones */
+        for (k = 0; k < 3; k++)
+        {
+            m = n_randint(state, n2) + 1;
+            flint_mpn_rrandom(i2, state->gmp_state, m);
+
+            flint_set_num_threads(n_randint(state, 4) + 1);
+
+            fft_mul_precache(r1, i2, m, P);
+
+            if (n1 >= m)
+                mpn_mul(r2, i1, n1, i2, m);
+            else
+                mpn_mul(r2, i2, m, i1, n1);
+
+            for (j = 0; j < n1 + m; j++)
+            {
+                if (r1[j] != r2[j]) 
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("n1 = %wd, n2 = %wd, m = %wd\n", n1, n2, m);
+                    flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                    abort();
+                }
+            }
+        }
+
+        fft_precache_clear(P);
+
+        flint_free(i1);
+        flint_free(r1);
+    }
+
+    flint_tune_reset();
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    
+    flint_printf("PASS\n");
+    return 0;
+}
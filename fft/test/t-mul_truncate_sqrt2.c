@@ -54,7 +54,7 @@ main(void)
         {
             mp_size_t n = (UWORD(1)<<depth);
             mp_bitcnt_t bits1 = (n*w - (depth + 1))/2; 
-            mp_size_t trunc = 2*n + 2*n_randint(state, n) + 2; /* trunc is even */
+            mp_size_t trunc = n_randint(state, 4*n) + 2; /* any length */
             mp_bitcnt_t bits = (trunc/2)*bits1;
             mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
             mp_size_t j;
@@ -119,6 +119,42 @@ main(void)
         }
     }
 
+    /* test aliased operands of different lengths */
+    for (depth = 6; depth <= 12; depth++)
+    {
+        for (w = 1; w <= 5; w++)
+        {
+            mp_size_t n = (UWORD(1)<<depth);
+            mp_bitcnt_t bits1 = (n*w - (depth + 1))/2; 
+            mp_size_t trunc = 2*n + 2*n_randint(state, n) + 2; /* trunc is even */
+            mp_bitcnt_t bits = (trunc/2)*bits1;
+            mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
+            mp_size_t len2 = n_randint(state, int_limbs) + 1;
+            mp_size_t j;
+            mp_limb_t * i1, *r1, *r2;
+        
+            i1 = flint_malloc(5*int_limbs*sizeof(mp_limb_t));
+            r1 = i1 + int_limbs;
+            r2 = r1 + 2*int_limbs;
+   
+            random_fermat(i1, state, int_limbs);
+            
+            mpn_mul(r2, i1, int_limbs, i1, len2);
+            mul_truncate_sqrt2(r1, i1, int_limbs, i1, len2, depth, w);
+            
+            for (j = 0; j < int_limbs + len2; j++)
+            {
+                if (r1[j] != r2[j]) 
+                {
+                    flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                    abort();
+                }
+            }
+
+            flint_free(i1);
+        }
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -0,0 +1,111 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    slong iter, cutoff = flint_tune_params[FLINT_TUNE_MPN_MUL_FFT];
+    slong ntt = flint_tune_params[FLINT_TUNE_FFT_MUL_NTT];
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mulmod_2expm1....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (iter = 0; iter < 1000; iter++)
+    {
+        mp_size_t limbs, n1, n2, j;
+        mp_limb_t * i1, * i2, * r1;
+        mpz_t a, b, m, r2;
+        int sqr = n_randint(state, 4) == 0;
+
+        /* small cutoffs exercise the convolution at small sizes */
+        if (n_randint(state, 2))
+            flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = 64;
+        if (n_randint(state, 2)) /* the small prime transforms or not */
+            flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = 0;
+        flint_set_num_threads(n_randint(state, 3) + 1);
+
+        limbs = n_randint(state, 3000) + 1;
+        if (n_randint(state, 2))
+            limbs = fft_adjust_limbs_2expm1(limbs);
+
+        n1 = n_randint(state, limbs) + 1;
+        n2 = sqr ? n1 : n_randint(state, n1) + 1;
+
+        i1 = flint_malloc((n1 + n2 + limbs)*sizeof(mp_limb_t));
+        i2 = sqr ? i1 : i1 + n1;
+        r1 = i1 + n1 + n2;
+
+        flint_mpn_urandomb(i1, state->gmp_state, n1*FLINT_BITS);
+        if (!sqr)
+            flint_mpn_urandomb(i2, state->gmp_state, n2*FLINT_BITS);
+        if (n_randint(state, 4) == 0) /* all ones */
+            for (j = 0; j < n1; j++)
+                i1[j] = ~UWORD(0);
+
+        flint_mpn_mulmod_2expm1(r1, i1, n1, i2, n2, limbs);
+
+        mpz_init(a);
+        mpz_init(b);
+        mpz_init(m);
+        mpz_init(r2);
+
+        mpz_import(a, n1, -1, sizeof(mp_limb_t), 0, 0, i1);
+        mpz_import(b, n2, -1, sizeof(mp_limb_t), 0, 0, i2);
+        mpz_set_ui(m, 1);
+        mpz_mul_2exp(m, m, limbs*FLINT_BITS);
+        mpz_sub_ui(m, m, 1);
+        mpz_mul(r2, a, b);
+        mpz_mod(r2, r2, m);
+        mpz_import(a, limbs, -1, sizeof(mp_limb_t), 0, 0, r1);
+
+        if (mpz_cmp(a, r2) != 0)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("limbs = %wd, n1 = %wd, n2 = %wd\n", limbs, n1, n2);
+            abort();
+        }
+
+        mpz_clear(a);
+        mpz_clear(b);
+        mpz_clear(m);
+        mpz_clear(r2);
+
+        flint_free(i1);
+
+        flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = cutoff;
+        flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = ntt;
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    int iters;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mulmod_2expp1_batch....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (iters = 0; iters < 200; iters++)
+    {
+        mp_bitcnt_t depth = n_randint(state, 10) + 6;
+        mp_bitcnt_t w = n_randint(state, 2) + 1;
+        mp_size_t n = (UWORD(1)<<depth);
+        mp_size_t limbs = (n*w)/FLINT_BITS;
+        mp_size_t count = n_randint(state, 20) + 1;
+        int sqr = n_randint(state, 4) == 0;
+        mp_size_t i, j;
+        mp_limb_t c, ** ii, ** jj, * r, * tt, * ptr;
+
+        ii = flint_malloc(2*count*(sizeof(mp_limb_t *) + (limbs + 1)*sizeof(mp_limb_t)));
+        jj = ii + count;
+        for (i = 0, ptr = (mp_limb_t *) (jj + count); i < count; i++, ptr += 2*(limbs + 1))
+        {
+            ii[i] = ptr;
+            jj[i] = ptr + limbs + 1;
+        }
+        r = flint_malloc(count*(limbs + 1)*sizeof(mp_limb_t));
+        tt = flint_malloc(2*(limbs + 1)*sizeof(mp_limb_t));
+
+        for (i = 0; i < count; i++)
+        {
+            random_fermat(ii[i], state, limbs);
+            random_fermat(jj[i], state, limbs);
+        }
+        if (sqr)
+            jj = ii;
+
+        for (i = 0; i < count; i++)
+        {
+            mp_limb_t * r1 = r + i*(limbs + 1);
+
+            mpn_normmod_2expp1(ii[i], limbs);
+            if (!sqr) mpn_normmod_2expp1(jj[i], limbs);
+            c = 2*ii[i][limbs] + jj[i][limbs];
+            r1[limbs] = flint_mpn_mulmod_2expp1_basecase(r1, ii[i], jj[i], c,
+                                                      limbs*FLINT_BITS, tt);
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        if (n_randint(state, 2))
+            fft_mulmod_2expp1_batch(ii, jj, count, n, w);
+        else
+            _fft_mulmod_2expp1_batch(ii, jj, count, n, w, tt);
+
+        for (i = 0; i < count; i++)
+        {
+            mp_limb_t * r1 = r + i*(limbs + 1);
+
+            for (j = 0; j <= limbs; j++)
+            {
+                if (r1[j] != ii[i][j]) 
+                {
+                    flint_printf("error in coefficient %wd limb %wd, %wx != %wx\n",
+                                                       i, j, r1[j], ii[i][j]);
+                    abort();
+                }
+            }
+        }
+
+        flint_free(ii);
+        flint_free(r);
+        flint_free(tt);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
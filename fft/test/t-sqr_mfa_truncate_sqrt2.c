@@ -0,0 +1,81 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    mp_bitcnt_t depth, w;
+    
+    FLINT_TEST_INIT(state);
+
+    flint_printf("sqr_mfa_truncate_sqrt2....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (depth = 6; depth <= 13; depth++)
+    {
+        for (w = 1; w <= 3 - (depth >= 12); w++)
+        {
+            mp_size_t n = (UWORD(1)<<depth);
+            mp_bitcnt_t bits1 = (n*w - (depth + 1))/2; 
+            mp_size_t trunc = 2*n + 2*n_randint(state, n) + 2; /* trunc is even */
+            mp_bitcnt_t bits = (trunc/2)*bits1;
+            mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
+            mp_size_t j;
+            mp_limb_t * i1, *r1, *r2;
+        
+            i1 = flint_malloc(5*int_limbs*sizeof(mp_limb_t));
+            r1 = i1 + int_limbs;
+            r2 = r1 + 2*int_limbs;
+   
+            random_fermat(i1, state, int_limbs);
+
+            flint_set_num_threads(n_randint(state, 4) + 1);
+            
+            mpn_sqr(r2, i1, int_limbs);
+            sqr_mfa_truncate_sqrt2(r1, i1, int_limbs, depth, w);
+            
+            for (j = 0; j < 2*int_limbs; j++)
+            {
+                if (r1[j] != r2[j]) 
+                {
+                    flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                    abort();
+                }
+            }
+
+            flint_free(i1);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -99,9 +99,77 @@ void * flint_realloc(void * ptr, size_t size);
 void * flint_calloc(size_t num, size_t size);
 FLINT_DLL void flint_free(void * ptr);
 
+FLINT_DLL void flint_set_memory_functions(void * (*alloc_func) (size_t),
+     void * (*calloc_func) (size_t, size_t),
+     void * (*realloc_func) (void *, size_t),
+     void (*free_func) (void *));
+FLINT_DLL void flint_get_memory_functions(void * (**alloc_func) (size_t),
+     void * (**calloc_func) (size_t, size_t),
+     void * (**realloc_func) (void *, size_t),
+     void (**free_func) (void *));
+
+/* allocation statistics, counted if built with --enable-memory-stats */
+#define FLINT_MEMORY_TAGS 64
+
+typedef struct
+{
+    volatile slong allocs;
+    volatile slong frees;
+    volatile slong bytes;
+    volatile slong current;
+    volatile slong peak;
+} flint_memory_stats_struct;
+
+typedef flint_memory_stats_struct flint_memory_stats_t[1];
+
+#define flint_memory_stats_zero(stats) \
+   do { \
+      (stats)->allocs = (stats)->frees = (stats)->bytes = 0; \
+      (stats)->current = (stats)->peak = 0; \
+   } while (0)
+
+FLINT_DLL void flint_get_memory_stats(flint_memory_stats_t stats);
+FLINT_DLL void flint_get_thread_memory_stats(flint_memory_stats_t stats);
+FLINT_DLL int flint_get_tag_memory_stats(flint_memory_stats_t stats,
+                                                           const char * tag);
+FLINT_DLL void flint_reset_memory_stats(void);
+FLINT_DLL int flint_memory_tag_push(const char * tag);
+FLINT_DLL void flint_memory_tag_pop(int old);
+
+#if WANT_MEMORY_STATS
+#define FLINT_MEMORY_TAG_START(tag) \
+   do { \
+      int __flint_memory_tag = flint_memory_tag_push(tag);
+
+#define FLINT_MEMORY_TAG_END \
+      flint_memory_tag_pop(__flint_memory_tag); \
+   } while (0)
+#else
+#define FLINT_MEMORY_TAG_START(tag) do {
+#define FLINT_MEMORY_TAG_END } while (0)
+#endif
+
+/* size class pool allocator, to be passed to flint_set_memory_functions */
+#define FLINT_POOL_CLASSES 7  /* blocks of 16, 32, ..., 1024 bytes */
+#define FLINT_POOL_CACHE 1024 /* free blocks kept per class and thread */
+
+FLINT_DLL void * flint_pool_malloc(size_t size);
+FLINT_DLL void * flint_pool_calloc(size_t num, size_t size);
+FLINT_DLL void * flint_pool_realloc(void * ptr, size_t size);
+FLINT_DLL void flint_pool_free(void * ptr);
+
+/* instruction set extensions detected at runtime */
+#define FLINT_CPU_AVX2 1
+#define FLINT_CPU_AVX512 2
+#define FLINT_CPU_AVX512IFMA 4
+
+FLINT_DLL int flint_cpu_features(void);
+FLINT_DLL void flint_set_cpu_features(int features);
+
 typedef void (*flint_cleanup_function_t)(void);
 FLINT_DLL void flint_register_cleanup_function(flint_cleanup_function_t cleanup_function);
 FLINT_DLL void flint_cleanup(void);
+FLINT_DLL void flint_cleanup_master(void);
 
 #if defined(_WIN64) || defined(__mips64)
 #define WORD_FMT "%ll"
@@ -144,6 +212,8 @@ FLINT_DLL void flint_cleanup(void);
 
 FLINT_DLL int flint_get_num_threads(void);
 FLINT_DLL void flint_set_num_threads(int num_threads);
+FLINT_DLL int flint_limit_num_threads(int limit);
+FLINT_DLL void flint_restore_num_threads(int num_threads);
 
 FLINT_DLL int flint_test_multiplier(void);
 
@@ -303,6 +373,68 @@ unsigned int FLINT_BIT_COUNT(mp_limb_t x)
       __tmp_root = __tmp_root->next; \
    }
 
+/* thread local scratch arena */
+#define FLINT_SCRATCH_DEFAULT_LIMIT ((size_t) 1 << 24)
+
+typedef struct
+{
+    void * chunk;
+    size_t used;
+    void * heap;
+} flint_scratch_mark_t;
+
+FLINT_DLL void flint_set_scratch_limit(size_t limit);
+FLINT_DLL size_t flint_get_scratch_limit(void);
+FLINT_DLL void flint_scratch_mark(flint_scratch_mark_t * mark);
+FLINT_DLL void * flint_scratch_alloc(size_t size);
+FLINT_DLL void flint_scratch_release(const flint_scratch_mark_t * mark);
+
+#define SCRATCH_INIT \
+   flint_scratch_mark_t __scratch_mark
+
+#define SCRATCH_START \
+   flint_scratch_mark(&__scratch_mark)
+
+#define SCRATCH_ALLOC(size) \
+   flint_scratch_alloc(size)
+
+#define SCRATCH_END \
+   flint_scratch_release(&__scratch_mark)
+
+/* runtime tuning parameters, see tuning.c for their defaults */
+enum
+{
+    FLINT_TUNE_FMPZ_MAT_MUL_CLASSICAL,
+    FLINT_TUNE_FMPZ_MAT_MUL_MULTI_MOD,
+    FLINT_TUNE_FMPZ_POLY_INV_NEWTON,
+    FLINT_TUNE_NMOD_MAT_MUL_STRASSEN,
+    FLINT_TUNE_NMOD_POLY_DIVREM_DIVCONQUER,
+    FLINT_TUNE_NMOD_POLY_DIV_DIVCONQUER,
+    FLINT_TUNE_NMOD_POLY_HGCD,
+    FLINT_TUNE_NMOD_POLY_HGCD_NTT,
+    FLINT_TUNE_NMOD_POLY_GCD,
+    FLINT_TUNE_NMOD_POLY_SMALL_GCD,
+    FLINT_TUNE_NMOD_POLY_MUL_NTT,
+    FLINT_TUNE_NMOD_POLY_FACTOR_EQUAL_DEG_THREADED,
+    FLINT_TUNE_NMOD_POLY_TREE_THREADED,
+    FLINT_TUNE_NMOD_POLY_TREE_PREINV,
+    FLINT_TUNE_FFT_MULMOD_2EXPP1,
+    FLINT_TUNE_FFT_MUL_THREADED,
+    FLINT_TUNE_FFT_MUL_NTT,
+    FLINT_TUNE_MPN_MUL_FFT,
+    FLINT_TUNE_NUM
+};
+
+FLINT_DLL extern slong flint_tune_params[FLINT_TUNE_NUM];
+FLINT_DLL extern slong flint_tune_fft_tab[5][2];
+FLINT_DLL extern slong flint_tune_mulmod_tab[];
+
+FLINT_DLL void flint_tune_reset(void);
+FLINT_DLL int flint_tune_set(const char * name, const slong * values, slong len);
+FLINT_DLL int flint_tune_load(const char * filename);
+FLINT_DLL int flint_tune_load_env(void);
+FLINT_DLL void flint_tune_write(FILE * file);
+
 /* compatibility between gmp and mpir */
 #ifndef mpn_com_n
 #define mpn_com_n mpn_com
@@ -27,34 +27,141 @@
 #include <gmp.h>
 #include "flint.h"
 #include "fmpz.h"
+#include <pthread.h>
 
 /* Always free larger mpz's to avoid wasting too much heap space */
 #define FLINT_MPZ_MAX_CACHE_LIMBS 64
 
+/*
+   The __mpz_struct's are allocated in blocks of MPZ_BLOCK_PAGES pages of
+   MPZ_PAGE_SIZE bytes. The first slot of each page points to the header of
+   its block, which records the thread owning the block. An mpz freed by the
+   owning thread goes on the thread local free list for reuse. An mpz freed
+   by any other thread is cleared and counted as dead in the block header,
+   as are the cached and never used mpz's of a thread when it calls
+   flint_cleanup. Whoever counts the last mpz of a block as dead frees the
+   block, so blocks do not accumulate in producer/consumer setups.
+*/
+#define MPZ_PAGE_SIZE 4096
+#define MPZ_BLOCK_PAGES 16
+#define MPZ_PER_PAGE (MPZ_PAGE_SIZE / sizeof(__mpz_struct) - 1)
+
 /* The number of new mpz's allocated at a time */
-#define MPZ_BLOCK 64 
+#define MPZ_BLOCK (MPZ_BLOCK_PAGES * MPZ_PER_PAGE)
+
+typedef struct
+{
+    volatile slong dead;
+    pthread_t thread;
+    void * address;
+} mpz_block_header_struct;
+
+#if !defined(__GNUC__)
+static pthread_mutex_t mpz_block_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
 FLINT_TLS_PREFIX __mpz_struct ** mpz_free_arr = NULL;
 FLINT_TLS_PREFIX ulong mpz_free_num = 0;
 FLINT_TLS_PREFIX ulong mpz_free_alloc = 0;
 
+/*
+   The never used part of the current block: the next slot is the one after
+   mpz_fresh_page + 1 __mpz_struct's (the first covers the header pointer)
+   from the start of the page at mpz_fresh_base. Addressing the slots from
+   the page start keeps them in step with the pages whatever the padding
+   left at the end of each page.
+*/
+FLINT_TLS_PREFIX char * mpz_fresh_base = NULL;
+FLINT_TLS_PREFIX slong mpz_fresh_page = 0;
+FLINT_TLS_PREFIX slong mpz_fresh_num = 0;
+FLINT_TLS_PREFIX mpz_block_header_struct * mpz_fresh_header = NULL;
+
+static __inline__ mpz_block_header_struct * _mpz_block_header(__mpz_struct * z)
+{
+    return *(mpz_block_header_struct **)
+        ((ulong) z & ~(ulong) (MPZ_PAGE_SIZE - 1));
+}
+
+/* count num mpz's of the block as dead and free it if none are left */
+static void _mpz_block_release(mpz_block_header_struct * header, slong num)
+{
+    slong dead;
+
+#if defined(__GNUC__)
+    dead = __sync_add_and_fetch(&header->dead, num);
+#else
+    pthread_mutex_lock(&mpz_block_lock);
+    dead = (header->dead += num);
+    pthread_mutex_unlock(&mpz_block_lock);
+#endif
+
+    if (dead == (slong) MPZ_BLOCK)
+    {
+        flint_free(header->address);
+        flint_free(header);
+    }
+}
+
+static void _mpz_block_new(void)
+{
+    mpz_block_header_struct * header;
+    char * ptr, * aligned;
+    slong i;
+
+    header = flint_malloc(sizeof(mpz_block_header_struct));
+    ptr = flint_malloc((MPZ_BLOCK_PAGES + 1) * MPZ_PAGE_SIZE);
+    aligned = (char *) (((ulong) ptr + MPZ_PAGE_SIZE - 1)
+                                 & ~(ulong) (MPZ_PAGE_SIZE - 1));
+
+    header->dead = 0;
+    header->thread = pthread_self();
+    header->address = ptr;
+
+    for (i = 0; i < MPZ_BLOCK_PAGES; i++)
+        *(mpz_block_header_struct **) (aligned + i * MPZ_PAGE_SIZE) = header;
+
+    mpz_fresh_header = header;
+    mpz_fresh_base = aligned;
+    mpz_fresh_page = 0;
+    mpz_fresh_num = MPZ_BLOCK;
+}
+
 __mpz_struct * _fmpz_new_mpz(void)
 {
+    __mpz_struct * z;
+
     if (mpz_free_num != 0)
-    {
         return mpz_free_arr[--mpz_free_num];
-    }
-    else
+
+    if (mpz_fresh_num == 0)
+        _mpz_block_new();
+
+    z = (__mpz_struct *) (mpz_fresh_base
+                              + (1 + mpz_fresh_page) * sizeof(__mpz_struct));
+    mpz_fresh_num--;
+
+    if (++mpz_fresh_page == MPZ_PER_PAGE)
     {
-        __mpz_struct * z = flint_malloc(sizeof(__mpz_struct));
-        mpz_init(z);
-        return z;
+        mpz_fresh_page = 0;
+        mpz_fresh_base += MPZ_PAGE_SIZE;
     }
+
+    mpz_init(z);
+
+    return z;
 }
 
 void _fmpz_clear_mpz(fmpz f)
 {
     __mpz_struct * ptr = COEFF_TO_PTR(f);
+    mpz_block_header_struct * header = _mpz_block_header(ptr);
+
+    if (!pthread_equal(header->thread, pthread_self()))
+    {
+        mpz_clear(ptr);
+        _mpz_block_release(header, 1);
+        return;
+    }
 
     if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
         mpz_realloc2(ptr, 1);
@@ -75,7 +182,7 @@ void _fmpz_cleanup_mpz_content(void)
     for (i = 0; i < mpz_free_num; i++)
     {
         mpz_clear(mpz_free_arr[i]);
-        flint_free(mpz_free_arr[i]);
+        _mpz_block_release(_mpz_block_header(mpz_free_arr[i]), 1);
     }
 
     mpz_free_num = mpz_free_alloc = 0;
@@ -86,6 +193,12 @@ void _fmpz_cleanup(void)
     _fmpz_cleanup_mpz_content();
     flint_free(mpz_free_arr);
     mpz_free_arr = NULL;
+
+    if (mpz_fresh_num != 0)
+    {
+        _mpz_block_release(mpz_fresh_header, mpz_fresh_num);
+        mpz_fresh_num = 0;
+    }
 }
 
 __mpz_struct * _fmpz_promote(fmpz_t f)
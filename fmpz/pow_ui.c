@@ -26,12 +26,90 @@
 #include <gmp.h>
 #include "flint.h"
 #include "ulong_extras.h"
+#include "mpn_extras.h"
 #include "fmpz.h"
 
+/*
+   Sets z to (a, an)^exp where an > 0 and a[an - 1] != 0. The power of two
+   dividing a is stripped off and applied with a single shift at the end,
+   the odd part is powered left to right with flint_mpn_sqr, so that the
+   large squarings transform their operand once. Allows a to alias z.
+*/
+static void
+_fmpz_pow_ui_mpn(__mpz_struct * z, mp_srcptr a, mp_size_t an, ulong exp)
+{
+    mp_bitcnt_t shift, bits;
+    mp_size_t rn, tn, zn, alloc, sl;
+    mp_ptr A, R, T, t, d, buf;
+    ulong bit;
+
+    shift = mpn_scan1(a, 0);
+    sl = shift / FLINT_BITS;
+    an -= sl;
+
+    A = flint_malloc(an * sizeof(mp_limb_t));
+    if (shift % FLINT_BITS)
+        mpn_rshift(A, a + sl, an, shift % FLINT_BITS);
+    else
+        flint_mpn_copyi(A, a + sl, an);
+    an -= (A[an - 1] == 0);
+
+    bits = ((an - 1) * FLINT_BITS + FLINT_BIT_COUNT(A[an - 1])) * exp;
+    alloc = bits / FLINT_BITS + 2;
+
+    buf = flint_malloc(2 * alloc * sizeof(mp_limb_t));
+    R = buf;
+    T = buf + alloc;
+
+    flint_mpn_copyi(R, A, an);
+    rn = an;
+
+    for (bit = UWORD(1) << (FLINT_BIT_COUNT(exp) - 1); bit >>= 1; )
+    {
+        flint_mpn_sqr(T, R, rn);
+        tn = 2 * rn;
+        tn -= (T[tn - 1] == 0);
+
+        if (exp & bit)
+        {
+            flint_mpn_mul(R, T, tn, A, an);
+            rn = tn + an;
+            rn -= (R[rn - 1] == 0);
+        }
+        else
+        {
+            t = R; R = T; T = t;
+            rn = tn;
+        }
+    }
+
+    shift *= exp;
+    sl = shift / FLINT_BITS;
+    zn = rn + sl + 1;
+
+    if (z->_mp_alloc < zn)
+        _mpz_realloc(z, zn);
+    d = z->_mp_d;
+
+    flint_mpn_zero(d, sl);
+    if (shift % FLINT_BITS)
+        d[zn - 1] = mpn_lshift(d + sl, R, rn, shift % FLINT_BITS);
+    else
+    {
+        flint_mpn_copyi(d + sl, R, rn);
+        d[zn - 1] = 0;
+    }
+    z->_mp_size = zn - (d[zn - 1] == 0);
+
+    flint_free(A);
+    flint_free(buf);
+}
+
 void
 fmpz_pow_ui(fmpz_t f, const fmpz_t g, ulong exp)
 {
     fmpz c1;
+    mp_limb_t hi, lo;
 
     if (exp == WORD(0))
     {
@@ -41,6 +119,42 @@ fmpz_pow_ui(fmpz_t f, const fmpz_t g, ulong exp)
 
     c1 = *g;
 
+    /* |g| <= 1 is handled directly, as the bit count estimate is useless */
+    if (fmpz_is_zero(g) || fmpz_is_pm1(g))
+    {
+        fmpz_set_si(f, (c1 < WORD(0) && !(exp & 1)) ? WORD(1) : c1);
+        return;
+    }
+
+    /* large results are powered with FFT squarings */
+    umul_ppmm(hi, lo, fmpz_bits(g), exp);
+    if (hi == 0 && lo / FLINT_BITS >=
+                    2 * (ulong) flint_tune_params[FLINT_TUNE_MPN_MUL_FFT])
+    {
+        int neg = (fmpz_sgn(g) < 0) && (exp & 1);
+        __mpz_struct * z;
+
+        if (COEFF_IS_MPZ(c1))
+        {
+            __mpz_struct * m = COEFF_TO_PTR(c1);
+
+            z = _fmpz_promote(f);
+            _fmpz_pow_ui_mpn(z, m->_mp_d, FLINT_ABS(m->_mp_size), exp);
+        }
+        else
+        {
+            mp_limb_t u1 = FLINT_ABS(c1);
+
+            z = _fmpz_promote(f);
+            _fmpz_pow_ui_mpn(z, &u1, 1, exp);
+        }
+
+        if (neg)
+            mpz_neg(z, z);
+        _fmpz_demote_val(f);
+        return;
+    }
+
     if (!COEFF_IS_MPZ(c1))      /* g is small */
     {
         ulong u1 = FLINT_ABS(c1);
@@ -27,6 +27,35 @@
 #include "fmpz_vec.h"
 #include "flint.h"
 #include "ulong_extras.h"
+#include <pthread.h>
+
+typedef struct
+{
+    fmpz * A;       /* created by the main thread, cleared by the worker */
+    fmpz * B;       /* created by the worker, cleared by the main thread */
+    slong n;
+    fmpz_t sum;
+} work_t;
+
+void * worker(void * arg_ptr)
+{
+    work_t * arg = (work_t *) arg_ptr;
+    slong i;
+
+    arg->B = _fmpz_vec_init(arg->n);
+
+    for (i = 0; i < arg->n; i++)
+    {
+        fmpz_mul(arg->B + i, arg->A + i, arg->A + i);
+        fmpz_add(arg->sum, arg->sum, arg->A + i);
+    }
+
+    _fmpz_vec_clear(arg->A, arg->n);
+
+    flint_cleanup();
+
+    return NULL;
+}
 
 int
 main(void)
@@ -71,6 +100,51 @@ main(void)
         _fmpz_vec_clear(B, n);
     }
 
+    /* mpz's cleared by a different thread from the one creating them */
+    for (iter = 0; iter < 30 * flint_test_multiplier(); iter++)
+    {
+        slong i;
+        pthread_t thread;
+        work_t arg;
+        fmpz_t sum;
+
+        arg.n = n_randint(state, 10000);
+        arg.A = _fmpz_vec_init(arg.n);
+        fmpz_init(arg.sum);
+        fmpz_init(sum);
+
+        for (i = 0; i < arg.n; i++)
+        {
+            fmpz_randtest(arg.A + i, state, 1 + n_randint(state, 200));
+            fmpz_add(sum, sum, arg.A + i);
+        }
+
+        pthread_create(&thread, NULL, worker, &arg);
+        pthread_join(thread, NULL);
+
+        if (!fmpz_equal(sum, arg.sum))
+        {
+            flint_printf("FAIL (threads):\n");
+            fmpz_print(sum); flint_printf("\n");
+            fmpz_print(arg.sum); flint_printf("\n");
+            abort();
+        }
+
+        for (i = 0; i < arg.n; i++)
+        {
+            if (!fmpz_is_square(arg.B + i))
+            {
+                flint_printf("FAIL (threads, square):\n");
+                fmpz_print(arg.B + i); flint_printf("\n");
+                abort();
+            }
+        }
+
+        _fmpz_vec_clear(arg.B, arg.n);
+        fmpz_clear(arg.sum);
+        fmpz_clear(sum);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
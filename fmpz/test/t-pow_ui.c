@@ -118,7 +118,106 @@ main(void)
         mpz_clear(f);
     }
 
-    FLINT_TEST_CLEANUP(state);
+    /* Check large powers, which use FFT squarings */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_t a, b;
+        mpz_t d, e, f;
+        ulong x;
+
+        fmpz_init(a);
+        fmpz_init(b);
+
+        mpz_init(d);
+        mpz_init(e);
+        mpz_init(f);
+
+        fmpz_randtest(a, state, 2000);
+        fmpz_mul_2exp(a, a, n_randint(state, 200));
+
+        fmpz_get_mpz(d, a);
+        x = n_randint(state, 200);
+
+        flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = 64 + n_randint(state, 200);
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        if (n_randint(state, 2))
+        {
+            fmpz_pow_ui(b, a, x);
+        }
+        else
+        {
+            fmpz_set(b, a);
+            fmpz_pow_ui(b, b, x);
+        }
+        flint_mpz_pow_ui(e, d, x);
+
+        fmpz_get_mpz(f, b);
+
+        result = (mpz_cmp(e, f) == 0);
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            gmp_printf("d = %Zd, e = %Zd, f = %Zd, x = %wu\n", d, e, f, x);
+            abort();
+        }
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+
+        mpz_clear(d);
+        mpz_clear(e);
+        mpz_clear(f);
+    }
+
+    flint_tune_reset();
+
+    /* Check 0 and +-1 to huge powers stay small */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz_t a, b;
+        slong c;
+        ulong x;
+
+        fmpz_init(a);
+        fmpz_init(b);
+
+        c = (slong) n_randint(state, 3) - 1;
+        fmpz_set_si(a, c);
+        x = n_randtest(state);
+
+        if (n_randint(state, 2))
+        {
+            fmpz_pow_ui(b, a, x);
+        }
+        else
+        {
+            fmpz_set(b, a);
+            fmpz_pow_ui(b, b, x);
+        }
+
+        if (x == 0)
+            result = fmpz_is_one(b);
+        else if (c == 0)
+            result = fmpz_is_zero(b);
+        else
+            result = fmpz_is_pm1(b)
+                  && fmpz_sgn(b) == ((c < 0 && (x & 1)) ? -1 : 1);
+        result = result && !COEFF_IS_MPZ(*b);
+        if (!result)
+        {
+            flint_printf("FAIL (|a| <= 1):\n");
+            flint_printf("a = %wd, x = %wu\n", c, x);
+            fmpz_print(b); flint_printf("\n");
+            abort();
+        }
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
     
     flint_printf("PASS\n");
     return 0;
@@ -51,6 +51,16 @@
  extern "C" {
 #endif
 
+/* Tuning parameters, which may be changed at runtime, see flint_tune_set */
+
+/* Classical -> multimodular multiplication */
+#define FMPZ_MAT_MUL_CLASSICAL_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_FMPZ_MAT_MUL_CLASSICAL])
+
+/* As above for entries close to a word */
+#define FMPZ_MAT_MUL_MULTI_MOD_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_FMPZ_MAT_MUL_MULTI_MOD])
+
 typedef struct
 {
     fmpz * entries;
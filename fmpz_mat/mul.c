@@ -24,6 +24,7 @@
 ******************************************************************************/
 
 #include "fmpz_mat.h"
+#include "profiler.h"
 
 void
 fmpz_mat_mul(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
@@ -46,13 +47,15 @@ fmpz_mat_mul(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
 
     dim = FLINT_MIN(FLINT_MIN(m, n), k);
 
-    if (dim < 12)
+    if (dim < FMPZ_MAT_MUL_CLASSICAL_CUTOFF)
     {
         /* The inline version only benefits from large n */
         if (n <= 2)
-            fmpz_mat_mul_classical(C, A, B);
+            FLINT_TRACE_CALL("fmpz_mat_mul:classical", dim,
+                fmpz_mat_mul_classical(C, A, B));
         else
-            fmpz_mat_mul_classical_inline(C, A, B);
+            FLINT_TRACE_CALL("fmpz_mat_mul:classical_inline", dim,
+                fmpz_mat_mul_classical_inline(C, A, B));
     }
     else
     {
@@ -66,13 +69,16 @@ fmpz_mat_mul(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
 
         bits = ab + bb + FLINT_BIT_COUNT(n) + 1;
 
-        if (5*(ab + bb) > dim * dim || (bits > FLINT_BITS - 3 && dim < 60))
+        if (5*(ab + bb) > dim * dim || (bits > FLINT_BITS - 3
+                                 && dim < FMPZ_MAT_MUL_MULTI_MOD_CUTOFF))
         {
-            fmpz_mat_mul_classical_inline(C, A, B);
+            FLINT_TRACE_CALL("fmpz_mat_mul:classical_inline", dim,
+                fmpz_mat_mul_classical_inline(C, A, B));
         }
         else
         {
-            _fmpz_mat_mul_multi_mod(C, A, B, bits);
+            FLINT_TRACE_CALL("fmpz_mat_mul:multi_mod", dim,
+                _fmpz_mat_mul_multi_mod(C, A, B, bits));
         }
     }
 }
@@ -51,6 +51,7 @@
 
 #define FMPZ_MOD_POLY_HGCD_CUTOFF  128      /* HGCD: Basecase -> Recursion      */
 #define FMPZ_MOD_POLY_GCD_CUTOFF  256       /* GCD:  Euclidean -> HGCD          */
+#define FMPZ_MOD_POLY_HGCD_NTT_CUTOFF  32  /* HGCD: Strassen -> NTT matrix products */
 
 #define FMPZ_MOD_POLY_INV_NEWTON_CUTOFF  64 /* Inv series newton: Basecase -> Newton */
 
@@ -402,6 +403,13 @@ FLINT_DLL void _fmpz_mod_poly_sqr(fmpz *res, const fmpz *poly, slong len, const
 
 FLINT_DLL void fmpz_mod_poly_sqr(fmpz_mod_poly_t res, const fmpz_mod_poly_t poly);
 
+FLINT_DLL void _fmpz_mod_poly_mat22_mul_NTT(fmpz ** C, slong * lenC,
+          fmpz * const * A, const slong * lenA, fmpz * const * B,
+                              const slong * lenB, slong k, const fmpz_t p);
+
+FLINT_DLL int _fmpz_mod_poly_hgcd_use_NTT(slong len, slong lmax,
+                                                           const fmpz_t p);
+
 FLINT_DLL void _fmpz_mod_poly_mulmod(fmpz * res, const fmpz * poly1, slong len1,
                            const fmpz * poly2, slong len2, const fmpz * f,
                            slong lenf, const fmpz_t p);
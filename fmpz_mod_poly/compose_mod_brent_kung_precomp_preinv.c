@@ -79,7 +79,6 @@ _fmpz_mod_poly_precompute_matrix_worker (void * arg_ptr)
                                      arg.poly1.coeffs, n, arg.poly2.coeffs,
                                      n + 1, arg.poly2inv.coeffs, n + 1,
                                      &arg.poly2.p);
-    flint_cleanup();
     return NULL;
 }
 
@@ -169,14 +168,11 @@ _fmpz_mod_poly_compose_mod_brent_kung_precomp_preinv_worker(void * arg_ptr)
     n = arg.poly3.length - 1;
 
     if (arg.poly3.length == 1)
-    {
-        flint_cleanup();
         return NULL;
-    }
+
     if (arg.poly1.length == 1)
     {
         fmpz_set(arg.res.coeffs, arg.poly1.coeffs);
-        flint_cleanup();
         return NULL;
     }
 
@@ -185,7 +181,6 @@ _fmpz_mod_poly_compose_mod_brent_kung_precomp_preinv_worker(void * arg_ptr)
         _fmpz_mod_poly_evaluate_fmpz(arg.res.coeffs, arg.poly1.coeffs,
                                      arg.poly1.length, arg.A.rows[1],
                                      &arg.poly3.p);
-        flint_cleanup();
         return NULL;
     }
 
@@ -229,7 +224,6 @@ _fmpz_mod_poly_compose_mod_brent_kung_precomp_preinv_worker(void * arg_ptr)
 
     fmpz_mat_clear(B);
     fmpz_mat_clear(C);
-    flint_cleanup();
     return NULL;
 }
 
@@ -70,7 +70,9 @@ _fmpz_mod_poly_inv_series_newton(fmpz * Qinv, const fmpz * Q, slong n,
             m = n;
             n = a[i];
 
-            _fmpz_mod_poly_mullow(W, Q, n, Qinv, m, p, n);
+            /* the low m coefficients of Q*Qinv are 1, 0, ..., 0 */
+            _fmpz_poly_mulmid(W + m, Q + 1, n - 1, Qinv, m);
+            _fmpz_vec_scalar_mod_fmpz(W + m, W + m, n - m, p);
             _fmpz_mod_poly_mullow(Qinv + m, Qinv, m, W + m, n - m, p, n - m);
             _fmpz_mod_poly_neg(Qinv + m, Qinv + m, n - m, p);
         }
@@ -0,0 +1,202 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+#include "fmpz_mod_poly.h"
+#include "fft.h"
+
+/* C[i k + j] = A[2 i] B[j] + A[2 i + 1] B[k + j], one product at a time */
+static void
+_fmpz_mod_poly_mat22_mul_classical(fmpz ** C, slong * lenC,
+          fmpz * const * A, const slong * lenA, fmpz * const * B,
+                     const slong * lenB, slong k, fmpz * T, const fmpz_t p)
+{
+    slong i, j, o, lenT;
+
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < k; j++)
+        {
+            o = i*k + j;
+            lenC[o] = 0;
+
+            if (lenA[2*i] != 0 && lenB[j] != 0)
+            {
+                lenC[o] = lenA[2*i] + lenB[j] - 1;
+
+                if (lenA[2*i] >= lenB[j])
+                    _fmpz_mod_poly_mul(C[o], A[2*i], lenA[2*i],
+                                             B[j], lenB[j], p);
+                else
+                    _fmpz_mod_poly_mul(C[o], B[j], lenB[j],
+                                             A[2*i], lenA[2*i], p);
+            }
+
+            if (lenA[2*i + 1] != 0 && lenB[k + j] != 0)
+            {
+                lenT = lenA[2*i + 1] + lenB[k + j] - 1;
+
+                if (lenA[2*i + 1] >= lenB[k + j])
+                    _fmpz_mod_poly_mul(T, A[2*i + 1], lenA[2*i + 1],
+                                          B[k + j], lenB[k + j], p);
+                else
+                    _fmpz_mod_poly_mul(T, B[k + j], lenB[k + j],
+                                          A[2*i + 1], lenA[2*i + 1], p);
+
+                _fmpz_mod_poly_add(C[o], C[o], lenC[o], T, lenT, p);
+                lenC[o] = FLINT_MAX(lenC[o], lenT);
+            }
+
+            FMPZ_VEC_NORM(C[o], lenC[o]);
+        }
+    }
+}
+
+void _fmpz_mod_poly_mat22_mul_NTT(fmpz ** C, slong * lenC,
+          fmpz * const * A, const slong * lenA, fmpz * const * B,
+                              const slong * lenB, slong k, const fmpz_t p)
+{
+    slong i, j, o, lmax = 0, nmin = 0;
+    fmpz * T;
+#if FFT_NTT
+    mp_size_t na[4], nb[4], n[4], size;
+    mp_limb_t * a[4], * b[4], * r[4];
+    mp_limb_t * buf, * ptr;
+    mp_bitcnt_t bits;
+#endif
+
+    /* the length of each product, and the largest inner dimension */
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < k; j++)
+        {
+            o = i*k + j;
+            lenC[o] = 0;
+
+            if (lenA[2*i] != 0 && lenB[j] != 0)
+            {
+                lenC[o] = lenA[2*i] + lenB[j] - 1;
+                nmin = FLINT_MAX(nmin, FLINT_MIN(lenA[2*i], lenB[j]));
+            }
+
+            if (lenA[2*i + 1] != 0 && lenB[k + j] != 0)
+            {
+                lenC[o] = FLINT_MAX(lenC[o],
+                                    lenA[2*i + 1] + lenB[k + j] - 1);
+                nmin = FLINT_MAX(nmin, FLINT_MIN(lenA[2*i + 1], lenB[k + j]));
+            }
+
+            lmax = FLINT_MAX(lmax, lenC[o]);
+        }
+    }
+
+    if (lmax == 0)
+        return;
+
+#if FFT_NTT
+    /* 
+       Kronecker substitution: the coefficients of the products are 
+       below 2 nmin (p - 1)^2, so fit in fields of this many bits
+     */
+    bits = 2*fmpz_bits(p) + FLINT_BIT_COUNT(nmin) + 1;
+
+    if (FLINT_CLOG2((lmax*bits - 1)/FLINT_BITS + 1) <= FFT_NTT_MAX_DEPTH)
+    {
+        size = 0;
+        for (i = 0; i < 4; i++)
+        {
+            na[i] = (lenA[i] == 0) ? 0 : (lenA[i]*bits - 1)/FLINT_BITS + 1;
+            size += na[i];
+        }
+        for (i = 0; i < 2*k; i++)
+        {
+            nb[i] = (lenB[i] == 0) ? 0 : (lenB[i]*bits - 1)/FLINT_BITS + 1;
+            size += nb[i];
+        }
+        for (i = 0; i < 2; i++)
+        {
+            for (j = 0; j < k; j++)
+            {
+                o = i*k + j;
+                n[o] = FLINT_MAX(na[2*i] + nb[j], na[2*i + 1] + nb[k + j]) + 1;
+                size += n[o];
+            }
+        }
+
+        buf = flint_calloc(size, sizeof(mp_limb_t));
+
+        for (i = 0, ptr = buf; i < 4; ptr += na[i], i++)
+        {
+            a[i] = ptr;
+            if (lenA[i] != 0)
+                _fmpz_poly_bit_pack(a[i], A[i], lenA[i], bits, 0);
+        }
+        for (i = 0; i < 2*k; ptr += nb[i], i++)
+        {
+            b[i] = ptr;
+            if (lenB[i] != 0)
+                _fmpz_poly_bit_pack(b[i], B[i], lenB[i], bits, 0);
+        }
+        for (o = 0; o < 2*k; ptr += n[o], o++)
+            r[o] = ptr;
+
+        mul_ntt_mat22(r, (mp_srcptr *) a, na, (mp_srcptr *) b, nb, k);
+
+        for (o = 0; o < 2*k; o++)
+        {
+            _fmpz_poly_bit_unpack_unsigned(C[o], lenC[o], r[o], bits);
+            _fmpz_vec_scalar_mod_fmpz(C[o], C[o], lenC[o], p);
+            FMPZ_VEC_NORM(C[o], lenC[o]);
+        }
+
+        flint_free(buf);
+
+        return;
+    }
+#endif
+
+    T = _fmpz_vec_init(lmax);
+    _fmpz_mod_poly_mat22_mul_classical(C, lenC, A, lenA, B, lenB, k, T, p);
+    _fmpz_vec_clear(T, lmax);
+}
+
+int _fmpz_mod_poly_hgcd_use_NTT(slong len, slong lmax, const fmpz_t p)
+{
+#if FFT_NTT
+    mp_bitcnt_t bits;
+    mp_size_t limbs;
+
+    if (len < FMPZ_MOD_POLY_HGCD_NTT_CUTOFF)
+        return 0;
+
+    /* the products are done by mul_ntt on the packed coefficients */
+    bits = 2*fmpz_bits(p) + FLINT_BIT_COUNT(len) + 1;
+    limbs = (len*bits - 1)/FLINT_BITS + 1;
+
+    return FLINT_CLOG2((lmax*bits - 1)/FLINT_BITS + 1) <= FFT_NTT_MAX_DEPTH
+        && fft_mul_use_ntt(limbs, limbs);
+#else
+    return 0;
+#endif
+}
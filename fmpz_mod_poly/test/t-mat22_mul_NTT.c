@@ -0,0 +1,119 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, l, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mat22_mul_NTT....");
+    fflush(stdout);
+
+    /* Compare with products computed one at a time */
+    for (i = 0; i < 300 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz_mod_poly_t A[4], B[4], C[4], D[4], t;
+        fmpz * Cp[4], * Ap[4], * Bp[4];
+        slong lenA[4], lenB[4], lenC[4];
+        slong k = 1 + n_randint(state, 2);
+        slong len = (i % 10 == 0) ? 1000 : 100;
+
+        fmpz_init(p);
+        fmpz_randtest_unsigned(p, state, 3 * FLINT_BITS);
+        fmpz_add_ui(p, p, 2);
+
+        fmpz_mod_poly_init(t, p);
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mod_poly_init(A[j], p);
+            fmpz_mod_poly_init(B[j], p);
+            fmpz_mod_poly_init(C[j], p);
+            fmpz_mod_poly_init(D[j], p);
+            fmpz_mod_poly_randtest(A[j], state, n_randint(state, len));
+            fmpz_mod_poly_randtest(B[j], state, n_randint(state, len));
+            Ap[j] = A[j]->coeffs;
+            lenA[j] = A[j]->length;
+        }
+        for (j = 0; j < 2*k; j++)
+        {
+            Bp[j] = B[j]->coeffs;
+            lenB[j] = B[j]->length;
+        }
+
+        for (j = 0; j < 2; j++)
+        {
+            for (l = 0; l < k; l++)
+            {
+                slong m = FLINT_MAX(lenA[2*j] + lenB[l],
+                                    lenA[2*j + 1] + lenB[k + l]);
+
+                fmpz_mod_poly_fit_length(C[j*k + l], m);
+                Cp[j*k + l] = C[j*k + l]->coeffs;
+
+                fmpz_mod_poly_mul(D[j*k + l], A[2*j], B[l]);
+                fmpz_mod_poly_mul(t, A[2*j + 1], B[k + l]);
+                fmpz_mod_poly_add(D[j*k + l], D[j*k + l], t);
+            }
+        }
+
+        _fmpz_mod_poly_mat22_mul_NTT(Cp, lenC, Ap, lenA, Bp, lenB, k, p);
+
+        for (j = 0; j < 2*k; j++)
+        {
+            _fmpz_mod_poly_set_length(C[j], lenC[j]);
+
+            result = (fmpz_mod_poly_equal(C[j], D[j]));
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("k = %wd, j = %d\n", k, j);
+                fmpz_print(p), flint_printf("\n\n");
+                fmpz_mod_poly_print(C[j]), flint_printf("\n\n");
+                fmpz_mod_poly_print(D[j]), flint_printf("\n\n");
+                abort();
+            }
+        }
+
+        fmpz_mod_poly_clear(t);
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mod_poly_clear(A[j]);
+            fmpz_mod_poly_clear(B[j]);
+            fmpz_mod_poly_clear(C[j]);
+            fmpz_mod_poly_clear(D[j]);
+        }
+        fmpz_clear(p);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -46,6 +46,7 @@ main(void)
     {
         fmpz_t x, y, n;
         fmpz_mod_poly_t f, g;
+        slong len = (i % 20 == 0) ? 3000 : 300;
 
         fmpz_init(n);
         fmpz_init(x);
@@ -56,8 +57,8 @@ main(void)
         fmpz_mod_poly_init(f, n);
         fmpz_mod_poly_init(g, n);
         
-        fmpz_mod_poly_randtest(f, state, n_randint(state, 300));
-        fmpz_mod_poly_randtest(g, state, n_randint(state, 300));
+        fmpz_mod_poly_randtest(f, state, n_randint(state, len));
+        fmpz_mod_poly_randtest(g, state, n_randint(state, len));
 
         fmpz_mod_poly_resultant_hgcd(x, f, g);
         fmpz_mod_poly_resultant_hgcd(y, g, f);
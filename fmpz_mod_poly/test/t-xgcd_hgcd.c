@@ -49,6 +49,7 @@ main(void)
     {
         fmpz_t p;
         fmpz_mod_poly_t a, b, d, g, s, t, v, w;
+        slong len = (i % 20 == 0) ? 3000 : 300;
 
         fmpz_init(p);
         fmpz_set_ui(p, n_randtest_prime(state, 0));
@@ -61,8 +62,8 @@ main(void)
         fmpz_mod_poly_init(t, p);
         fmpz_mod_poly_init(v, p);
         fmpz_mod_poly_init(w, p);
-        fmpz_mod_poly_randtest(a, state, n_randint(state, 300));
-        fmpz_mod_poly_randtest(b, state, n_randint(state, 300));
+        fmpz_mod_poly_randtest(a, state, n_randint(state, len));
+        fmpz_mod_poly_randtest(b, state, n_randint(state, len));
 
         fmpz_mod_poly_gcd_hgcd(d, a, b);
         fmpz_mod_poly_xgcd_hgcd(g, s, t, a, b);
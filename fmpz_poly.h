@@ -53,7 +53,9 @@
  extern "C" {
 #endif
 
-#define FMPZ_POLY_INV_NEWTON_CUTOFF 32
+/* may be changed at runtime, see flint_tune_set */
+#define FMPZ_POLY_INV_NEWTON_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_FMPZ_POLY_INV_NEWTON])
 
 /*  Type definitions *********************************************************/
 
@@ -413,6 +415,18 @@ FLINT_DLL void _fmpz_poly_mulmid_classical(fmpz * res, const fmpz * poly1,
 FLINT_DLL void fmpz_poly_mulmid_classical(fmpz_poly_t res, 
                           const fmpz_poly_t poly1, const fmpz_poly_t poly2);
 
+FLINT_DLL void _fmpz_poly_mulmid_SS(fmpz * output, const fmpz * input1,
+                          slong len1, const fmpz * input2, slong len2);
+
+FLINT_DLL void fmpz_poly_mulmid_SS(fmpz_poly_t res,
+                          const fmpz_poly_t poly1, const fmpz_poly_t poly2);
+
+FLINT_DLL void _fmpz_poly_mulmid(fmpz * res, const fmpz * poly1,
+                          slong len1, const fmpz * poly2, slong len2);
+
+FLINT_DLL void fmpz_poly_mulmid(fmpz_poly_t res,
+                          const fmpz_poly_t poly1, const fmpz_poly_t poly2);
+
 FLINT_DLL void fmpz_poly_mul_karatsuba(fmpz_poly_t res, 
                           const fmpz_poly_t poly1, const fmpz_poly_t poly2);
 
@@ -476,6 +490,10 @@ FLINT_DLL void _fmpz_poly_sqr_KS(fmpz * rop, const fmpz * op, slong len);
 
 FLINT_DLL void fmpz_poly_sqr_KS(fmpz_poly_t rop, const fmpz_poly_t op);
 
+FLINT_DLL void _fmpz_poly_sqr_SS(fmpz * output, const fmpz * input, slong len);
+
+FLINT_DLL void fmpz_poly_sqr_SS(fmpz_poly_t res, const fmpz_poly_t poly);
+
 FLINT_DLL void fmpz_poly_sqr_karatsuba(fmpz_poly_t rop, const fmpz_poly_t op);
 
 FLINT_DLL void _fmpz_poly_sqr_karatsuba(fmpz * rop, const fmpz * op, slong len);
@@ -79,7 +79,13 @@ _fmpz_poly_inv_series_newton(fmpz * Qinv, const fmpz * Q, slong Qlen, slong n)
         Qnlen = FLINT_MIN(Qlen, n);
         Wlen = FLINT_MIN(Qnlen + m - 1, n);
         W2len = Wlen - m;
-        MULLOW(W, Q, Qnlen, Qinv, m, Wlen);
+        if (Qnlen == n)
+        {
+            /* the low m coefficients of Q*Qinv are 1, 0, ..., 0 */
+            _fmpz_poly_mulmid(W + m, Q + 1, n - 1, Qinv, m);
+        }
+        else
+            MULLOW(W, Q, Qnlen, Qinv, m, Wlen);
         MULLOW(Qinv + m, Qinv, m, W + m, W2len, n - m);
         _fmpz_vec_neg(Qinv + m, Qinv + m, n - m);
         FLINT_NEWTON_END_LOOP
@@ -29,6 +29,7 @@
 #include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
+#include "profiler.h"
 
 void
 _fmpz_poly_mul_tiny1(fmpz * res, const fmpz * poly1,
@@ -57,11 +58,11 @@ _fmpz_poly_mul_tiny2(fmpz * res, const fmpz * poly1,
     slong i, j, k, c, d;
     mp_limb_t hi, lo;
     mp_ptr tmp;
-    TMP_INIT;
+    SCRATCH_INIT;
 
-    TMP_START;
+    SCRATCH_START;
 
-    tmp = TMP_ALLOC(2 * (len1 + len2 - 1) * sizeof(mp_limb_t));
+    tmp = SCRATCH_ALLOC(2 * (len1 + len2 - 1) * sizeof(mp_limb_t));
 
     flint_mpn_zero(tmp, 2 * (len1 + len2 - 1));
 
@@ -103,7 +104,7 @@ _fmpz_poly_mul_tiny2(fmpz * res, const fmpz * poly1,
         }
     }
 
-    TMP_END;
+    SCRATCH_END;
     return;
 }
 
@@ -138,19 +139,22 @@ _fmpz_poly_mul(fmpz * res, const fmpz * poly1,
 
         if (rbits <= FLINT_BITS - 2)
         {
-            _fmpz_poly_mul_tiny1(res, poly1, len1, poly2, len2);
+            FLINT_TRACE_CALL("fmpz_poly_mul:tiny1", len1 + len2 - 1,
+                _fmpz_poly_mul_tiny1(res, poly1, len1, poly2, len2));
             return;
         }
         else if (rbits <= 2 * FLINT_BITS - 1)
         {
-            _fmpz_poly_mul_tiny2(res, poly1, len1, poly2, len2);
+            FLINT_TRACE_CALL("fmpz_poly_mul:tiny2", len1 + len2 - 1,
+                _fmpz_poly_mul_tiny2(res, poly1, len1, poly2, len2));
             return;
         }
     }
 
     if (len2 < 7)
     {
-        _fmpz_poly_mul_classical(res, poly1, len1, poly2, len2);
+        FLINT_TRACE_CALL("fmpz_poly_mul:classical", len1 + len2 - 1,
+            _fmpz_poly_mul_classical(res, poly1, len1, poly2, len2));
         return;
     }
 
@@ -158,15 +162,16 @@ _fmpz_poly_mul(fmpz * res, const fmpz * poly1,
     limbs2 = (bits2 + FLINT_BITS - 1) / FLINT_BITS;
 
     if (len1 < 16 && (limbs1 > 12 || limbs2 > 12))
-        _fmpz_poly_mul_karatsuba(res, poly1, len1, poly2, len2);
-    else if (limbs1 + limbs2 <= 8)
-        _fmpz_poly_mul_KS(res, poly1, len1, poly2, len2);
-    else if ((limbs1+limbs2)/2048 > len1 + len2)
-        _fmpz_poly_mul_KS(res, poly1, len1, poly2, len2);
-    else if ((limbs1 + limbs2)*FLINT_BITS*4 < len1 + len2)
-       _fmpz_poly_mul_KS(res, poly1, len1, poly2, len2);
+        FLINT_TRACE_CALL("fmpz_poly_mul:karatsuba", len1 + len2 - 1,
+            _fmpz_poly_mul_karatsuba(res, poly1, len1, poly2, len2));
+    else if (limbs1 + limbs2 <= 8
+            || (limbs1+limbs2)/2048 > len1 + len2
+            || (limbs1 + limbs2)*FLINT_BITS*4 < len1 + len2)
+        FLINT_TRACE_CALL("fmpz_poly_mul:KS", len1 + len2 - 1,
+            _fmpz_poly_mul_KS(res, poly1, len1, poly2, len2));
     else
-       _fmpz_poly_mul_SS(res, poly1, len1, poly2, len2);
+        FLINT_TRACE_CALL("fmpz_poly_mul:SS", len1 + len2 - 1,
+            _fmpz_poly_mul_SS(res, poly1, len1, poly2, len2));
 }
 
 void
@@ -30,6 +30,7 @@
 #include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
+#include "mpn_extras.h"
 
 void
 _fmpz_poly_mul_KS(fmpz * res, const fmpz * poly1, slong len1,
@@ -41,6 +42,7 @@ _fmpz_poly_mul_KS(fmpz * res, const fmpz * poly1, slong len1,
     slong bits1, bits2, bits;
     mp_limb_t *arr1, *arr2, *arr3;
     slong sign = 0;
+    SCRATCH_INIT;
 
     FMPZ_VEC_NORM(poly1, len1);
     FMPZ_VEC_NORM(poly2, len2);
@@ -80,28 +82,30 @@ _fmpz_poly_mul_KS(fmpz * res, const fmpz * poly1, slong len1,
     limbs1 = (bits * len1 - 1) / FLINT_BITS + 1;
     limbs2 = (bits * len2 - 1) / FLINT_BITS + 1;
 
+    SCRATCH_START;
+
     if (poly1 == poly2)
     {
-        arr1 = (mp_limb_t *) flint_calloc(limbs1, sizeof(mp_limb_t));
+        arr1 = (mp_limb_t *) SCRATCH_ALLOC(limbs1 * sizeof(mp_limb_t));
+        flint_mpn_zero(arr1, limbs1);
         arr2 = arr1;
         _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
     }
     else
     {
-        arr1 = (mp_limb_t *) flint_calloc(limbs1 + limbs2, sizeof(mp_limb_t));
+        arr1 = (mp_limb_t *) SCRATCH_ALLOC((limbs1 + limbs2)*sizeof(mp_limb_t));
+        flint_mpn_zero(arr1, limbs1 + limbs2);
         arr2 = arr1 + limbs1;
         _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
         _fmpz_poly_bit_pack(arr2, poly2, len2, bits, neg2);
     }
 
-    arr3 = (mp_limb_t *) flint_malloc((limbs1 + limbs2) * sizeof(mp_limb_t));
+    arr3 = (mp_limb_t *) SCRATCH_ALLOC((limbs1 + limbs2) * sizeof(mp_limb_t));
 
-    if (limbs1 == limbs2)
-        mpn_mul_n(arr3, arr1, arr2, limbs1);
-    else if (limbs1 > limbs2)
-        mpn_mul(arr3, arr1, limbs1, arr2, limbs2);
+    if (limbs1 >= limbs2)
+        flint_mpn_mul(arr3, arr1, limbs1, arr2, limbs2);
     else
-        mpn_mul(arr3, arr2, limbs2, arr1, limbs1);
+        flint_mpn_mul(arr3, arr2, limbs2, arr1, limbs1);
 
     if (sign)
         _fmpz_poly_bit_unpack(res, len1 + len2 - 1, arr3, bits, neg1 ^ neg2);
@@ -111,8 +115,7 @@ _fmpz_poly_mul_KS(fmpz * res, const fmpz * poly1, slong len1,
     if ((len1 < in1_len) | (len2 < in2_len))
         _fmpz_vec_zero(res + (len1 + len2 - 1), (in1_len - len1) + (in2_len - len2));
 
-    flint_free(arr1);
-    flint_free(arr3);
+    SCRATCH_END;
 }
 
 void
@@ -33,14 +33,17 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
 {
     slong len_out, loglen, loglen2, n;
     slong output_bits, limbs, size, i;
-    mp_limb_t * ptr, * t1, * t2, * tt, * s1, ** ii, ** jj;
+    mp_limb_t * ptr, ** ii, ** jj;
     slong bits1, bits2;
     ulong size1, size2;
-    int sign = 0;
+    int sign = 0, sqr;
 
     len1 = FLINT_MIN(len1, trunc);
     len2 = FLINT_MIN(len2, trunc);
 
+    /* a squaring only needs one operand transformed */
+    sqr = (input1 == input2 && len1 == len2);
+
     len_out = len1 + len2 - 1;
     loglen  = FLINT_CLOG2(len_out);
     loglen2 = FLINT_CLOG2(len2);
@@ -56,20 +59,16 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
     output_bits = (((output_bits - 1) >> (loglen - 2)) + 1) << (loglen - 2);
 
     limbs = (output_bits - 1) / FLINT_BITS + 1; /* initial size of FFT coeffs */
-    if (limbs > FFT_MULMOD_2EXPP1_CUTOFF) /* can't be worse than next power of 2 limbs */
+    if (limbs > flint_tune_params[FLINT_TUNE_FFT_MULMOD_2EXPP1]) /* can't be worse than next power of 2 limbs */
         limbs = (WORD(1) << FLINT_CLOG2(limbs));
     size = limbs + 1;
 
     /* allocate space for ffts */
-    ii = flint_malloc((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
+    ii = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
     for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
         ii[i] = ptr;
-    t1 = ptr;
-    t2 = t1 + size;
-    s1 = t2 + size;
-    tt = s1 + size;
 
-    if (input1 != input2)
+    if (!sqr)
     {
         jj = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
         for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
@@ -81,7 +80,7 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
     for (i = len1; i < 4*n; i++)
         flint_mpn_zero(ii[i], limbs + 1);
 
-    if (input1 != input2) 
+    if (!sqr) 
     {
         bits2 = _fmpz_vec_get_fft(jj, input2, limbs, len2);
         for (i = len2; i < 4*n; i++)
@@ -105,12 +104,12 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
     limbs = (output_bits - 1) / FLINT_BITS + 1;
     limbs = fft_adjust_limbs(limbs); /* round up limbs for Nussbaumer */
     
-    fft_convolution(ii, jj, loglen - 2, limbs, len_out, &t1, &t2, &s1, tt); 
+    _fft_convolution_threaded(ii, jj, loglen - 2, limbs, len_out); 
 
     _fmpz_vec_set_fft(output, trunc, ii, limbs, sign); /* write output */
 
     flint_free(ii); 
-    if (input1 != input2) 
+    if (!sqr) 
         flint_free(jj);
 }
 
@@ -0,0 +1,142 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include "fmpz_poly.h"
+#include "fft.h"
+#include "fft_tuning.h"
+
+void _fmpz_poly_mulmid_SS(fmpz * output, const fmpz * input1, slong len1, 
+                                         const fmpz * input2, slong len2)
+{
+    slong loglen, loglen2, n;
+    slong output_bits, limbs, size, i;
+    mp_limb_t * ptr, ** ii, ** jj;
+    slong bits1, bits2;
+    ulong size1, size2;
+    int sign = 0;
+
+    /*
+       A cyclic convolution of length 4n >= len1 wraps the coefficients of
+       degree 4n and above onto those below len2 - 1 only.
+    */
+    loglen  = FLINT_MAX(FLINT_CLOG2(len1), 3);
+    loglen2 = FLINT_CLOG2(len2);
+    n = (WORD(1) << (loglen - 2));
+
+    size1 = _fmpz_vec_max_limbs(input1, len1); 
+    size2 = _fmpz_vec_max_limbs(input2, len2);
+
+    /* Start with an upper bound on the number of bits needed */
+    output_bits = FLINT_BITS * (size1 + size2) + loglen2 + 1; 
+    
+    /* round up for sqrt2 trick */
+    output_bits = (((output_bits - 1) >> (loglen - 2)) + 1) << (loglen - 2);
+
+    limbs = (output_bits - 1) / FLINT_BITS + 1; /* initial size of FFT coeffs */
+    if (limbs > flint_tune_params[FLINT_TUNE_FFT_MULMOD_2EXPP1]) /* can't be worse than next power of 2 limbs */
+        limbs = (WORD(1) << FLINT_CLOG2(limbs));
+    size = limbs + 1;
+
+    /* allocate space for ffts */
+    ii = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+    for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
+        ii[i] = ptr;
+
+    jj = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
+    for (i = 0, ptr = (mp_limb_t *) jj + 4*n; i < 4*n; i++, ptr += size) 
+        jj[i] = ptr;
+
+    /* put coefficients into FFT vecs */
+    bits1 = _fmpz_vec_get_fft(ii, input1, limbs, len1);
+    for (i = len1; i < 4*n; i++)
+        flint_mpn_zero(ii[i], limbs + 1);
+
+    bits2 = _fmpz_vec_get_fft(jj, input2, limbs, len2);
+    for (i = len2; i < 4*n; i++)
+        flint_mpn_zero(jj[i], limbs + 1);
+
+    if (bits1 < WORD(0) || bits2 < WORD(0)) 
+    {
+        sign = 1;  
+        bits1 = FLINT_ABS(bits1);
+        bits2 = FLINT_ABS(bits2);
+    }
+
+    /* Recompute the number of bits/limbs now that we know how large everything is */
+    output_bits = bits1 + bits2 + loglen2 + sign;
+
+    /* round up output bits for sqrt2 */
+    output_bits = (((output_bits - 1) >> (loglen - 2)) + 1) << (loglen - 2);
+
+    limbs = (output_bits - 1) / FLINT_BITS + 1;
+    limbs = fft_adjust_limbs(limbs); /* round up limbs for Nussbaumer */
+    
+    /* an untruncated convolution is cyclic */
+    _fft_convolution_threaded(ii, jj, loglen - 2, limbs, 4*n); 
+
+    /* write output */
+    _fmpz_vec_set_fft(output, len1 - len2 + 1, ii + len2 - 1, limbs, sign);
+
+    flint_free(ii); 
+    flint_free(jj);
+}
+
+void
+fmpz_poly_mulmid_SS(fmpz_poly_t res,
+                    const fmpz_poly_t poly1, const fmpz_poly_t poly2)
+{
+    const slong len1 = poly1->length;
+    const slong len2 = poly2->length;
+    slong len_out;
+
+    if (len2 == 0 || len1 < len2)
+    {
+        fmpz_poly_zero(res);
+        return;
+    }
+
+    if (len2 <= 2 || len1 - len2 < 2)
+    {
+        fmpz_poly_mulmid_classical(res, poly1, poly2);
+        return;
+    }
+
+    len_out = len1 - len2 + 1;
+
+    if (res == poly1 || res == poly2)
+    {
+        fmpz_poly_t temp;
+        fmpz_poly_init2(temp, len_out);
+        _fmpz_poly_mulmid_SS(temp->coeffs, poly1->coeffs, len1,
+                                           poly2->coeffs, len2);
+        fmpz_poly_swap(res, temp);
+        fmpz_poly_clear(temp);
+    }
+    else
+    {
+        fmpz_poly_fit_length(res, len_out);
+        _fmpz_poly_mulmid_SS(res->coeffs, poly1->coeffs, len1,
+                                          poly2->coeffs, len2);
+    }
+
+    _fmpz_poly_set_length(res, len_out);
+    _fmpz_poly_normalise(res);
+}
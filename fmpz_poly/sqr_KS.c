@@ -30,6 +30,7 @@
 #include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
+#include "mpn_extras.h"
 
 void
 _fmpz_poly_sqr_KS(fmpz *rop, const fmpz *op, slong len)
@@ -39,6 +40,7 @@ _fmpz_poly_sqr_KS(fmpz *rop, const fmpz *op, slong len)
     slong bits, limbs, loglen;
     mp_limb_t *arr, *arr3;
     slong sign = 0;
+    SCRATCH_INIT;
 
     FMPZ_VEC_NORM(op, len);
 
@@ -62,13 +64,16 @@ _fmpz_poly_sqr_KS(fmpz *rop, const fmpz *op, slong len)
     bits   = 2 * bits + loglen + sign;
     limbs  = (bits * len - 1) / FLINT_BITS + 1;
 
-    arr = (mp_limb_t *) flint_calloc(limbs, sizeof(mp_limb_t));
+    SCRATCH_START;
+
+    arr = (mp_limb_t *) SCRATCH_ALLOC(limbs * sizeof(mp_limb_t));
+    flint_mpn_zero(arr, limbs);
 
     _fmpz_poly_bit_pack(arr, op, len, bits, neg);
 
-    arr3 = (mp_limb_t *) flint_malloc((2 * limbs) * sizeof(mp_limb_t));
+    arr3 = (mp_limb_t *) SCRATCH_ALLOC((2 * limbs) * sizeof(mp_limb_t));
 
-    mpn_sqr(arr3, arr, limbs);
+    flint_mpn_sqr(arr3, arr, limbs);
 
     if (sign)
         _fmpz_poly_bit_unpack(rop, 2 * len - 1, arr3, bits, 0);
@@ -78,8 +83,7 @@ _fmpz_poly_sqr_KS(fmpz *rop, const fmpz *op, slong len)
     if (len < in_len)
         _fmpz_vec_zero(rop + (2 * len - 1), 2 * (in_len - len));
 
-    flint_free(arr);
-    flint_free(arr3);
+    SCRATCH_END;
 }
 
 void fmpz_poly_sqr_KS(fmpz_poly_t rop, const fmpz_poly_t op)
@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "fmpz_poly.h"
+#include "fft.h"
+
+void _fmpz_poly_sqr_SS(fmpz * output, const fmpz * input, slong len)
+{
+    /* aliased operands make the convolution transform only once */
+    _fmpz_poly_mullow_SS(output, input, len, input, len, 2 * len - 1);
+}
+
+void fmpz_poly_sqr_SS(fmpz_poly_t res, const fmpz_poly_t poly)
+{
+    const slong len = poly->length;
+    slong rlen;
+
+    if (len == 0)
+    {
+        fmpz_poly_zero(res);
+        return;
+    }
+
+    if (len <= 2)
+    {
+        fmpz_poly_sqr_classical(res, poly);
+        return;
+    }
+
+    rlen = 2 * len - 1;
+
+    fmpz_poly_fit_length(res, rlen);
+    _fmpz_poly_sqr_SS(res->coeffs, poly->coeffs, len);
+    _fmpz_poly_set_length(res, rlen);
+}
@@ -23,11 +23,13 @@
 
 ******************************************************************************/
 
-#include <pthread.h>
 #include <gmp.h>
 #include "flint.h"
+#include "thread_pool.h"
 #include "fmpz.h"
 #include "fmpz_poly.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
 
 typedef struct
 {
@@ -35,6 +37,7 @@ typedef struct
     mp_ptr * residues;
     slong n0;
     slong n1;
+    slong stride;
     mp_srcptr primes;
     slong num_primes;
     int crt;  /* reduce if 0, lift if 1 */
@@ -60,14 +63,14 @@ _fmpz_vec_multi_mod_ui_worker(void * arg_ptr)
         if (arg.crt)
         {
             for (j = 0; j < arg.num_primes; j++)
-                tmp[j] = arg.residues[j][i];
+                tmp[j] = arg.residues[j][i * arg.stride];
             fmpz_multi_CRT_ui(arg.vec + i, tmp, comb, comb_temp, 1);
         }
         else
         {
             fmpz_multi_mod_ui(tmp, arg.vec + i, comb, comb_temp);
             for (j = 0; j < arg.num_primes; j++)
-                arg.residues[j][i] = tmp[j];
+                arg.residues[j][i * arg.stride] = tmp[j];
         }
     }
 
@@ -75,40 +78,34 @@ _fmpz_vec_multi_mod_ui_worker(void * arg_ptr)
     fmpz_comb_clear(comb);
     fmpz_comb_temp_clear(comb_temp);
 
-    flint_cleanup();
     return NULL;
 }
 
 void
-_fmpz_vec_multi_mod_ui_threaded(mp_ptr * residues, fmpz * vec, slong len,
-    mp_srcptr primes, slong num_primes, int crt)
+_fmpz_vec_multi_mod_ui_threaded(mp_ptr * residues, slong stride, fmpz * vec,
+    slong len, mp_srcptr primes, slong num_primes, int crt)
 {
-    pthread_t * threads;
     mod_ui_arg_t * args;
     slong i, num_threads;
 
     num_threads = flint_get_num_threads();
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
     args = flint_malloc(sizeof(mod_ui_arg_t) * num_threads);
 
     for (i = 0; i < num_threads; i++)
     {
         args[i].vec = vec;
         args[i].residues = residues;
+        args[i].stride = stride;
         args[i].n0 = (len * i) / num_threads;
         args[i].n1 = (len * (i + 1)) / num_threads;
         args[i].primes = (mp_ptr) primes;
         args[i].num_primes = num_primes;
         args[i].crt = crt;
-
-        pthread_create(&threads[i], NULL,
-            _fmpz_vec_multi_mod_ui_worker, &args[i]);
     }
 
-    for (i = 0; i < num_threads; i++)
-        pthread_join(threads[i], NULL);
+    flint_parallel_map(_fmpz_vec_multi_mod_ui_worker, args,
+                                          sizeof(mod_ui_arg_t), num_threads);
 
-    flint_free(threads);
     flint_free(args);
 }
 
@@ -141,49 +138,73 @@ _fmpz_poly_multi_taylor_shift_worker(void * arg_ptr)
         _nmod_poly_taylor_shift(arg.residues[i], cm, arg.len, mod);
     }
 
-    flint_cleanup();
+    return NULL;
+}
+
+/* here p0 and p1 index blocks of NMOD_MULTI_MAX interleaved residues */
+void *
+_fmpz_poly_multi_taylor_shift_block_worker(void * arg_ptr)
+{
+    taylor_shift_arg_t arg = *((taylor_shift_arg_t *) arg_ptr);
+    mp_limb_t moduli[NMOD_MULTI_MAX], cm[NMOD_MULTI_MAX];
+    nmod_multi_t M;
+    slong i, j;
+
+    for (i = arg.p0; i < arg.p1; i++)
+    {
+        /* unused lanes of the last block repeat its last prime */
+        for (j = 0; j < NMOD_MULTI_MAX; j++)
+        {
+            moduli[j] = arg.primes[FLINT_MIN(i * NMOD_MULTI_MAX + j,
+                                                     arg.num_primes - 1)];
+            cm[j] = fmpz_fdiv_ui(arg.c, moduli[j]);
+        }
+
+        nmod_multi_init(M, moduli, NMOD_MULTI_MAX);
+        _nmod_poly_multi_taylor_shift_horner(
+                   arg.residues[i * NMOD_MULTI_MAX], cm, arg.len, M);
+    }
+
     return NULL;
 }
 
 void
 _fmpz_poly_multi_taylor_shift_threaded(mp_ptr * residues, slong len,
-    const fmpz_t c, mp_srcptr primes, slong num_primes)
+    const fmpz_t c, mp_srcptr primes, slong num_primes, int interleaved)
 {
-    pthread_t * threads;
     taylor_shift_arg_t * args;
-    slong i, num_threads;
+    slong i, num, num_threads;
 
-    num_threads = flint_get_num_threads();
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
+    num = interleaved ? (num_primes + NMOD_MULTI_MAX - 1) / NMOD_MULTI_MAX
+                      : num_primes;
+    num_threads = FLINT_MIN(flint_get_num_threads(), num);
     args = flint_malloc(sizeof(taylor_shift_arg_t) * num_threads);
 
     for (i = 0; i < num_threads; i++)
     {
         args[i].residues = residues;
         args[i].len = len;
-        args[i].p0 = (num_primes * i) / num_threads;
-        args[i].p1 = (num_primes * (i + 1)) / num_threads;
+        args[i].p0 = (num * i) / num_threads;
+        args[i].p1 = (num * (i + 1)) / num_threads;
         args[i].primes = (mp_ptr) primes;
         args[i].num_primes = num_primes;
         args[i].c = (fmpz *) c;
-
-        pthread_create(&threads[i], NULL,
-            _fmpz_poly_multi_taylor_shift_worker, &args[i]);
     }
 
-    for (i = 0; i < num_threads; i++)
-        pthread_join(threads[i], NULL);
+    flint_parallel_map(interleaved ? _fmpz_poly_multi_taylor_shift_block_worker
+                                   : _fmpz_poly_multi_taylor_shift_worker,
+                       args, sizeof(taylor_shift_arg_t), num_threads);
 
-    flint_free(threads);
     flint_free(args);
 }
 
 void
 _fmpz_poly_taylor_shift_multi_mod(fmpz * poly, const fmpz_t c, slong len)
 {
-    slong xbits, ybits, num_primes, i;
-    mp_ptr primes;
+    slong xbits, ybits, num_primes, pbits, stride, i;
+    mp_ptr primes, blocks = NULL;
     mp_ptr * residues;
+    int interleaved;
 
     if (len <= 1 || fmpz_is_zero(c))
         return;
@@ -207,24 +228,65 @@ _fmpz_poly_taylor_shift_multi_mod(fmpz * poly, const fmpz_t c, slong len)
         fmpz_clear(t);
     }
 
-    /* Use primes greater than 2^(FLINT_BITS-1) */
-    num_primes = (ybits + (FLINT_BITS - 1) - 1) / (FLINT_BITS - 1);
+    /*
+       Up to moderate lengths the shifts are done by Horner's rule for
+       blocks of primes at once, using the multi-modulus functions. The
+       additions are vectorised for any primes, but for c != +-1 this needs
+       primes below 2^50, and the extra primes only pay off from about
+       length 50.
+    */
+    pbits = FLINT_BITS;
+
+    if (fmpz_is_pm1(c))
+        interleaved = (len < 1200);
+    else if (len >= 50 && len < 800 && nmod_multi_simd_mul_bits() >= 50)
+    {
+        interleaved = 1;
+        pbits = 50;
+    }
+    else
+        interleaved = 0;
+
+    /* Use primes greater than 2^(pbits-1) */
+    num_primes = (ybits + (pbits - 1) - 1) / (pbits - 1);
     primes = flint_malloc(sizeof(mp_limb_t) * num_primes);
-    primes[0] = n_nextprime(UWORD(1) << (FLINT_BITS - 1), 1);
+    primes[0] = n_nextprime(UWORD(1) << (pbits - 1), 1);
     for (i = 1; i < num_primes; i++)
         primes[i] = n_nextprime(primes[i-1], 1);
 
     /* Space for poly reduced modulo the primes */
     residues = flint_malloc(sizeof(mp_ptr) * num_primes);
-    for (i = 0; i < num_primes; i++)
-        residues[i] = flint_malloc(sizeof(mp_limb_t) * len);
 
-    _fmpz_vec_multi_mod_ui_threaded(residues, poly, len, primes, num_primes, 0);
-    _fmpz_poly_multi_taylor_shift_threaded(residues, len, c, primes, num_primes);
-    _fmpz_vec_multi_mod_ui_threaded(residues, poly, len, primes, num_primes, 1);
+    if (interleaved)
+    {
+        /* padding lanes of the last block stay zero */
+        stride = NMOD_MULTI_MAX;
+        blocks = flint_calloc(((num_primes + stride - 1) / stride) * stride
+                                                * len, sizeof(mp_limb_t));
+        for (i = 0; i < num_primes; i++)
+            residues[i] = blocks + (i / stride) * stride * len + i % stride;
+    }
+    else
+    {
+        stride = 1;
+        for (i = 0; i < num_primes; i++)
+            residues[i] = flint_malloc(sizeof(mp_limb_t) * len);
+    }
 
-    for (i = 0; i < num_primes; i++)
-        flint_free(residues[i]);
+    _fmpz_vec_multi_mod_ui_threaded(residues, stride, poly, len,
+                                                    primes, num_primes, 0);
+    _fmpz_poly_multi_taylor_shift_threaded(residues, len, c,
+                                       primes, num_primes, interleaved);
+    _fmpz_vec_multi_mod_ui_threaded(residues, stride, poly, len,
+                                                    primes, num_primes, 1);
+
+    if (interleaved)
+        flint_free(blocks);
+    else
+    {
+        for (i = 0; i < num_primes; i++)
+            flint_free(residues[i]);
+    }
     flint_free(residues);
     flint_free(primes);
 }
@@ -142,8 +142,46 @@ main(void)
         fmpz_poly_clear(d);
     }
 
-    FLINT_TEST_CLEANUP(state);
-    
+    /* Compare with mul_KS at lengths using the threaded convolution */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c, d;
+        slong len, trunc;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        fmpz_poly_init(d);
+        fmpz_poly_randtest(b, state, 200 + n_randint(state, 800), 200);
+        fmpz_poly_randtest(c, state, 200 + n_randint(state, 800), 200);
+
+        len = b->length + c->length - 1;
+        trunc = (len <= 0) ? 0 : n_randint(state, len);
+
+        fmpz_poly_mul_KS(a, b, c);
+        fmpz_poly_truncate(a, trunc);
+        fmpz_poly_mullow_SS(d, b, c, trunc);
+
+        result = (fmpz_poly_equal(a, d));
+        if (!result)
+        {
+            flint_printf("FAIL (threaded):\n");
+            fmpz_poly_print(a), flint_printf("\n\n");
+            fmpz_poly_print(d), flint_printf("\n\n");
+            abort();
+        }
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+        fmpz_poly_clear(d);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
     flint_printf("PASS\n");
     return 0;
 }
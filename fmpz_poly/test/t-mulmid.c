@@ -0,0 +1,185 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mulmid....");
+    fflush(stdout);
+
+    
+
+    /* Check aliasing of a and b */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c;
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        fmpz_poly_randtest(b, state, n_randint(state, 50), 200);
+        if (b->length == 0)
+            fmpz_poly_zero(c);
+        else
+            fmpz_poly_randtest(c, state, n_randint(state, b->length), 200);
+
+        fmpz_poly_mulmid(a, b, c);
+        fmpz_poly_mulmid(b, b, c);
+
+        result = (fmpz_poly_equal(a, b));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            fmpz_poly_print(a), flint_printf("\n\n");
+            fmpz_poly_print(b), flint_printf("\n\n");
+            abort();
+        }
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+    }
+
+    /* Check aliasing of a and c */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c;
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        fmpz_poly_randtest(b, state, n_randint(state, 50), 200);
+        if (b->length == 0)
+            fmpz_poly_zero(c);
+        else
+            fmpz_poly_randtest(c, state, n_randint(state, b->length), 200);
+
+        fmpz_poly_mulmid(a, b, c);
+        fmpz_poly_mulmid(c, b, c);
+
+        result = (fmpz_poly_equal(a, c));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            fmpz_poly_print(a), flint_printf("\n\n");
+            fmpz_poly_print(c), flint_printf("\n\n");
+            abort();
+        }
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+    }
+
+    /* Compare with mul */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c, d;
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        fmpz_poly_init(d);
+        fmpz_poly_randtest(b, state, n_randint(state, 50), 200);
+        fmpz_poly_randtest(c, state, n_randint(state, b->length + 1), 200);
+
+        fmpz_poly_mulmid(d, b, c);
+        if (b->length == 0 || c->length == 0)
+        {
+            result = (d->length == 0);
+        }
+        else
+        {
+            fmpz_poly_mul(a, b, c);
+            fmpz_poly_truncate(a, b->length);
+            fmpz_poly_shift_right(a, a, c->length - 1);
+            result = (fmpz_poly_equal(a, d));
+        }
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("b = "), fmpz_poly_print(b), flint_printf("\n\n");
+            flint_printf("c = "), fmpz_poly_print(c), flint_printf("\n\n");
+            flint_printf("a = "), fmpz_poly_print(a), flint_printf("\n\n");
+            flint_printf("d = "), fmpz_poly_print(d), flint_printf("\n\n");
+            abort();
+        }
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+        fmpz_poly_clear(d);
+    }
+
+    /* Compare with mul for larger inputs */
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c, d;
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        fmpz_poly_init(d);
+        fmpz_poly_randtest(b, state, n_randint(state, 600), n_randint(state, 1000) + 1);
+        fmpz_poly_randtest(c, state, n_randint(state, b->length + 1), n_randint(state, 1000) + 1);
+
+        fmpz_poly_mulmid(d, b, c);
+        if (b->length == 0 || c->length == 0)
+        {
+            result = (d->length == 0);
+        }
+        else
+        {
+            fmpz_poly_mul(a, b, c);
+            fmpz_poly_truncate(a, b->length);
+            fmpz_poly_shift_right(a, a, c->length - 1);
+            result = (fmpz_poly_equal(a, d));
+        }
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("b = "), fmpz_poly_print(b), flint_printf("\n\n");
+            flint_printf("c = "), fmpz_poly_print(c), flint_printf("\n\n");
+            flint_printf("a = "), fmpz_poly_print(a), flint_printf("\n\n");
+            flint_printf("d = "), fmpz_poly_print(d), flint_printf("\n\n");
+            abort();
+        }
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+        fmpz_poly_clear(d);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}
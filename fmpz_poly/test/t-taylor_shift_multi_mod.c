@@ -115,6 +115,46 @@ main(void)
         fmpz_clear(c);
     }
 
+    /* Compare with Horner's rule at lengths using blocks of primes */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t f, h1, h2;
+        fmpz_t c;
+
+        fmpz_poly_init(f);
+        fmpz_poly_init(h1);
+        fmpz_poly_init(h2);
+
+        fmpz_init(c);
+
+        fmpz_poly_randtest(f, state, 1 + n_randint(state, 150),
+                                     1 + n_randint(state, 200));
+
+        if (n_randint(state, 2))
+            fmpz_set_si(c, n_randint(state, 2) ? 1 : -1);
+        else
+            fmpz_randtest_not_zero(c, state, 1 + n_randint(state, 70));
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+        flint_set_cpu_features(n_randint(state, 8));
+        fmpz_poly_taylor_shift_multi_mod(h1, f, c);
+        flint_set_cpu_features(-1);
+        fmpz_poly_taylor_shift_horner(h2, f, c);
+
+        if (!fmpz_poly_equal(h1, h2))
+        {
+            flint_printf("FAIL (blocks)\n");
+            fmpz_poly_print(f); flint_printf("\n");
+            fmpz_print(c); flint_printf("\n");
+            abort();
+        }
+
+        fmpz_poly_clear(f);
+        fmpz_poly_clear(h1);
+        fmpz_poly_clear(h2);
+        fmpz_clear(c);
+    }
+
     FLINT_TEST_CLEANUP(state);
     flint_printf("PASS\n");
     return 0;
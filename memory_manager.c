@@ -25,6 +25,8 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <pthread.h>
 #include "flint.h"
 
 #if HAVE_GC
@@ -32,8 +34,6 @@
 #endif
 
 #if FLINT_REENTRANT && !HAVE_TLS
-#include <pthread.h>
-
 static pthread_once_t register_initialised = PTHREAD_ONCE_INIT;
 pthread_mutex_t register_lock;
 #endif
@@ -44,47 +44,341 @@ static void flint_memory_error()
     abort();
 }
 
-void * flint_malloc(size_t size)
+static void * _flint_default_malloc(size_t size)
+{
+#if HAVE_GC
+    return GC_malloc(size);
+#else
+    return malloc(size);
+#endif
+}
+
+static void * _flint_default_realloc(void * ptr, size_t size)
 {
-   void * ptr;
+#if HAVE_GC
+    return GC_realloc(ptr, size);
+#else
+    return realloc(ptr, size);
+#endif
+}
 
+static void * _flint_default_calloc(size_t num, size_t size)
+{
 #if HAVE_GC
-   ptr = GC_malloc(size);
+    return GC_malloc(num*size);
+#else
+    return calloc(num, size);
+#endif
+}
+
+static void _flint_default_free(void * ptr)
+{
+#if !HAVE_GC
+    free(ptr);
+#endif
+}
+
+static void * (*__flint_allocate_func)(size_t) = _flint_default_malloc;
+static void * (*__flint_callocate_func)(size_t, size_t) = _flint_default_calloc;
+static void * (*__flint_reallocate_func)(void *, size_t) = _flint_default_realloc;
+static void (*__flint_free_func)(void *) = _flint_default_free;
+
+#if WANT_MEMORY_STATS
+
+/*
+   Every block allocated by FLINT carries a header with its size and the
+   tag which was active when it was allocated, so that frees can be charged
+   to the right counters. GMP is redirected to FLINT before its first
+   allocation where the compiler supports constructors, and otherwise at
+   the first allocation by FLINT, so the memory GMP hands to FLINT carries
+   a header as well.
+*/
+
+#define STATS_HEADER 16
+
+typedef union
+{
+    struct
+    {
+        size_t size;
+        int tag;
+    } s;
+    char pad[STATS_HEADER];
+} stats_header_union;
+
+typedef struct
+{
+    const char * name;
+    flint_memory_stats_struct stats;
+} stats_tag_struct;
+
+#if defined(__GNUC__)
+#define STATS_ADD(xx, yy) __sync_add_and_fetch(&(xx), (yy))
+#define STATS_CAS(xx, old, new) __sync_bool_compare_and_swap(&(xx), (old), (new))
 #else
-   ptr = malloc(size);
+/* without atomics the process wide counts are approximate under threads */
+#define STATS_ADD(xx, yy) ((xx) += (yy))
+#define STATS_CAS(xx, old, new) ((xx) = (new), 1)
 #endif
 
+static flint_memory_stats_struct stats_total;
+static stats_tag_struct stats_tags[FLINT_MEMORY_TAGS];
+static volatile slong stats_num_tags = 1; /* tag 0 is untagged memory */
+static pthread_mutex_t stats_tag_lock = PTHREAD_MUTEX_INITIALIZER;
+static int stats_gmp_redirected = 0;
+
+static FLINT_TLS_PREFIX flint_memory_stats_struct stats_thread;
+static FLINT_TLS_PREFIX int stats_current_tag = 0;
+
+static void * _flint_gmp_realloc(void * ptr, size_t old_size, size_t new_size);
+static void _flint_gmp_free(void * ptr, size_t size);
+
+static void _stats_record(flint_memory_stats_struct * st, slong size, int shared)
+{
+    slong cur, peak;
+
+    if (shared)
+    {
+        if (size > 0)
+        {
+            STATS_ADD(st->allocs, 1);
+            STATS_ADD(st->bytes, size);
+        }
+        else
+            STATS_ADD(st->frees, 1);
+
+        cur = STATS_ADD(st->current, size);
+
+        while ((peak = st->peak) < cur && !STATS_CAS(st->peak, peak, cur)) ;
+    }
+    else
+    {
+        if (size > 0)
+        {
+            st->allocs++;
+            st->bytes += size;
+        }
+        else
+            st->frees++;
+
+        st->current += size;
+        if (st->current > st->peak)
+            st->peak = st->current;
+    }
+}
+
+static void _stats_change(int tag, slong size)
+{
+    _stats_record(&stats_total, size, 1);
+    _stats_record(&stats_thread, size, 0);
+
+    if (tag != 0)
+        _stats_record(&stats_tags[tag].stats, size, 1);
+}
+
+static void _stats_redirect_gmp(void)
+{
+    stats_gmp_redirected = 1;
+    mp_set_memory_functions(flint_malloc, _flint_gmp_realloc, _flint_gmp_free);
+}
+
+#if defined(__GNUC__)
+
+static void __attribute__((constructor)) stats_init(void)
+{
+    _stats_redirect_gmp();
+}
+
+#endif
+
+static void * _stats_attach(stats_header_union * h, size_t size)
+{
+    h->s.size = size;
+    h->s.tag = stats_current_tag;
+
+    _stats_change(h->s.tag, size);
+
+    if (!stats_gmp_redirected)
+        _stats_redirect_gmp();
+
+    return h + 1;
+}
+
+void * flint_malloc(size_t size)
+{
+    void * ptr = (*__flint_allocate_func)(size + STATS_HEADER);
+
     if (ptr == NULL)
         flint_memory_error();
 
-    return ptr;
+    return _stats_attach(ptr, size);
 }
 
 void * flint_realloc(void * ptr, size_t size)
 {
+    stats_header_union * h;
     void * ptr2;
 
-#if HAVE_GC
-    ptr2 = GC_realloc(ptr, size);
-#else
-    ptr2 = realloc(ptr, size);
-#endif
+    if (ptr == NULL)
+        return flint_malloc(size);
+
+    h = (stats_header_union *) ptr - 1;
+
+    _stats_change(h->s.tag, -(slong) h->s.size);
+
+    ptr2 = (*__flint_reallocate_func)(h, size + STATS_HEADER);
 
     if (ptr2 == NULL)
         flint_memory_error();
 
-    return ptr2;
+    return _stats_attach(ptr2, size);
 }
 
 void * flint_calloc(size_t num, size_t size)
 {
-   void * ptr;
+    void * ptr = (*__flint_callocate_func)(1, num*size + STATS_HEADER);
+
+    if (ptr == NULL)
+        flint_memory_error();
+
+    return _stats_attach(ptr, num*size);
+}
+
+void flint_free(void * ptr)
+{
+    stats_header_union * h;
+
+    if (ptr == NULL)
+        return;
+
+    h = (stats_header_union *) ptr - 1;
+
+    _stats_change(h->s.tag, -(slong) h->s.size);
+
+    (*__flint_free_func)(h);
+}
+
+static void _stats_get(flint_memory_stats_t stats,
+                                    const flint_memory_stats_struct * st)
+{
+    stats->allocs = st->allocs;
+    stats->frees = st->frees;
+    stats->bytes = st->bytes;
+    stats->current = st->current;
+    stats->peak = st->peak;
+}
+
+static void _stats_reset(flint_memory_stats_struct * st)
+{
+    st->allocs = 0;
+    st->frees = 0;
+    st->bytes = 0;
+    st->peak = st->current;
+}
+
+void flint_get_memory_stats(flint_memory_stats_t stats)
+{
+    _stats_get(stats, &stats_total);
+}
+
+void flint_get_thread_memory_stats(flint_memory_stats_t stats)
+{
+    _stats_get(stats, &stats_thread);
+}
+
+int flint_get_tag_memory_stats(flint_memory_stats_t stats, const char * tag)
+{
+    slong i;
+
+    for (i = 1; i < stats_num_tags; i++)
+    {
+        if (strcmp(stats_tags[i].name, tag) == 0)
+        {
+            _stats_get(stats, &stats_tags[i].stats);
+            return 1;
+        }
+    }
+
+    flint_memory_stats_zero(stats);
+    return 0;
+}
+
+void flint_reset_memory_stats(void)
+{
+    slong i;
+
+    _stats_reset(&stats_total);
+    _stats_reset(&stats_thread);
+
+    for (i = 1; i < stats_num_tags; i++)
+        _stats_reset(&stats_tags[i].stats);
+}
+
+int flint_memory_tag_push(const char * tag)
+{
+    int i, old = stats_current_tag;
+    slong n = stats_num_tags;
+
+    for (i = 1; i < n; i++)
+        if (strcmp(stats_tags[i].name, tag) == 0)
+            break;
+
+    if (i == n)
+    {
+        pthread_mutex_lock(&stats_tag_lock);
+
+        for ( ; i < stats_num_tags; i++)
+            if (strcmp(stats_tags[i].name, tag) == 0)
+                break;
+
+        if (i == stats_num_tags && i < FLINT_MEMORY_TAGS)
+        {
+            stats_tags[i].name = tag;
+            STATS_ADD(stats_num_tags, 1); /* publish after the name */
+        }
+
+        pthread_mutex_unlock(&stats_tag_lock);
+
+        /* no space for a new tag */
+        if (i == FLINT_MEMORY_TAGS)
+            return old;
+    }
+
+    stats_current_tag = i;
+
+    return old;
+}
+
+void flint_memory_tag_pop(int old)
+{
+    stats_current_tag = old;
+}
 
-#if HAVE_GC
-    ptr = GC_malloc(num*size);
 #else
-    ptr = calloc(num, size);
-#endif
+
+void * flint_malloc(size_t size)
+{
+    void * ptr = (*__flint_allocate_func)(size);
+
+    if (ptr == NULL)
+        flint_memory_error();
+
+    return ptr;
+}
+
+void * flint_realloc(void * ptr, size_t size)
+{
+    void * ptr2 = (*__flint_reallocate_func)(ptr, size);
+
+    if (ptr2 == NULL)
+        flint_memory_error();
+
+    return ptr2;
+}
+
+void * flint_calloc(size_t num, size_t size)
+{
+    void * ptr = (*__flint_callocate_func)(num, size);
 
     if (ptr == NULL)
         flint_memory_error();
@@ -94,11 +388,257 @@ void * flint_calloc(size_t num, size_t size)
 
 void flint_free(void * ptr)
 {
-#if !HAVE_GC
-    free(ptr);
+    (*__flint_free_func)(ptr);
+}
+
+void flint_get_memory_stats(flint_memory_stats_t stats)
+{
+    flint_memory_stats_zero(stats);
+}
+
+void flint_get_thread_memory_stats(flint_memory_stats_t stats)
+{
+    flint_memory_stats_zero(stats);
+}
+
+int flint_get_tag_memory_stats(flint_memory_stats_t stats, const char * tag)
+{
+    flint_memory_stats_zero(stats);
+    return 0;
+}
+
+void flint_reset_memory_stats(void)
+{
+}
+
+int flint_memory_tag_push(const char * tag)
+{
+    return 0;
+}
+
+void flint_memory_tag_pop(int old)
+{
+}
+
 #endif
+
+/* GMP passes old sizes which the FLINT interface has no use for */
+
+static void * _flint_gmp_realloc(void * ptr, size_t old_size, size_t new_size)
+{
+    return flint_realloc(ptr, new_size);
 }
 
+static void _flint_gmp_free(void * ptr, size_t size)
+{
+    flint_free(ptr);
+}
+
+void flint_set_memory_functions(void * (*alloc_func) (size_t),
+     void * (*calloc_func) (size_t, size_t),
+     void * (*realloc_func) (void *, size_t),
+     void (*free_func) (void *))
+{
+    if (alloc_func == NULL)
+    {
+        __flint_allocate_func = _flint_default_malloc;
+        __flint_callocate_func = _flint_default_calloc;
+        __flint_reallocate_func = _flint_default_realloc;
+        __flint_free_func = _flint_default_free;
+
+        /* restore the GMP defaults, unless GMP is being counted */
+#if WANT_MEMORY_STATS
+        if (!stats_gmp_redirected)
+#endif
+            mp_set_memory_functions(NULL, NULL, NULL);
+    }
+    else
+    {
+        __flint_allocate_func = alloc_func;
+        __flint_callocate_func = calloc_func;
+        __flint_reallocate_func = realloc_func;
+        __flint_free_func = free_func;
+
+        mp_set_memory_functions(flint_malloc, _flint_gmp_realloc,
+                                              _flint_gmp_free);
+    }
+}
+
+void flint_get_memory_functions(void * (**alloc_func) (size_t),
+     void * (**calloc_func) (size_t, size_t),
+     void * (**realloc_func) (void *, size_t),
+     void (**free_func) (void *))
+{
+    *alloc_func = __flint_allocate_func;
+    *calloc_func = __flint_callocate_func;
+    *realloc_func = __flint_reallocate_func;
+    *free_func = __flint_free_func;
+}
+
+/*
+   Size class pool. Every block carries a header holding its size class.
+   Small blocks are not returned to the system when freed but kept on a
+   thread local list for their class, up to FLINT_POOL_CACHE blocks per
+   class, from which later requests of that class are served. A block freed
+   by a thread other than the one which allocated it simply joins the lists
+   of the freeing thread. Larger blocks go straight to the system allocator.
+*/
+
+#define POOL_HEADER 16
+#define POOL_LARGE (-WORD(1))
+#define POOL_CLASS_SIZE(cc) ((size_t) 16 << (cc))
+
+typedef union pool_block_union
+{
+    slong size_class;
+    union pool_block_union * next;
+    char pad[POOL_HEADER];
+} pool_block_union;
+
+/*
+   Without thread local storage the free lists would be shared between
+   threads, so in a reentrant build no blocks are kept for reuse.
+*/
+#if FLINT_REENTRANT && !HAVE_TLS
+#define POOL_CACHE 0
+#else
+#define POOL_CACHE FLINT_POOL_CACHE
+#endif
+
+FLINT_TLS_PREFIX pool_block_union * flint_pool_free_list[FLINT_POOL_CLASSES];
+FLINT_TLS_PREFIX slong flint_pool_free_count[FLINT_POOL_CLASSES];
+
+static slong _flint_pool_class(size_t size)
+{
+    slong c = 0;
+
+    while (c < FLINT_POOL_CLASSES && POOL_CLASS_SIZE(c) < size)
+        c++;
+
+    return (c == FLINT_POOL_CLASSES) ? POOL_LARGE : c;
+}
+
+void * flint_pool_malloc(size_t size)
+{
+    pool_block_union * b;
+    slong c = _flint_pool_class(size);
+
+    if (c == POOL_LARGE)
+    {
+        b = malloc(POOL_HEADER + size);
+        if (b == NULL)
+            return NULL;
+    }
+    else if (flint_pool_free_list[c] != NULL)
+    {
+        b = flint_pool_free_list[c];
+        flint_pool_free_list[c] = b->next;
+        flint_pool_free_count[c]--;
+    }
+    else
+    {
+        b = malloc(POOL_HEADER + POOL_CLASS_SIZE(c));
+        if (b == NULL)
+            return NULL;
+    }
+
+    b->size_class = c;
+
+    return (char *) b + POOL_HEADER;
+}
+
+void * flint_pool_calloc(size_t num, size_t size)
+{
+    void * ptr = flint_pool_malloc(num*size);
+
+    if (ptr != NULL)
+        memset(ptr, 0, num*size);
+
+    return ptr;
+}
+
+void * flint_pool_realloc(void * ptr, size_t size)
+{
+    pool_block_union * b;
+    void * ptr2;
+    size_t old_size;
+
+    if (ptr == NULL)
+        return flint_pool_malloc(size);
+
+    b = (pool_block_union *) ((char *) ptr - POOL_HEADER);
+
+    if (b->size_class == POOL_LARGE)
+    {
+        if (_flint_pool_class(size) != POOL_LARGE)
+        {
+            ptr2 = flint_pool_malloc(size);
+            if (ptr2 != NULL)
+            {
+                memcpy(ptr2, ptr, size);
+                free(b);
+            }
+            return ptr2;
+        }
+
+        b = realloc(b, POOL_HEADER + size);
+        return (b == NULL) ? NULL : (char *) b + POOL_HEADER;
+    }
+
+    old_size = POOL_CLASS_SIZE(b->size_class);
+
+    if (size <= old_size)
+        return ptr;
+
+    ptr2 = flint_pool_malloc(size);
+
+    if (ptr2 != NULL)
+    {
+        memcpy(ptr2, ptr, FLINT_MIN(size, old_size));
+        flint_pool_free(ptr);
+    }
+
+    return ptr2;
+}
+
+void flint_pool_free(void * ptr)
+{
+    pool_block_union * b;
+    slong c;
+
+    if (ptr == NULL)
+        return;
+
+    b = (pool_block_union *) ((char *) ptr - POOL_HEADER);
+    c = b->size_class;
+
+    if (c == POOL_LARGE || flint_pool_free_count[c] >= POOL_CACHE)
+    {
+        free(b);
+        return;
+    }
+
+    b->next = flint_pool_free_list[c];
+    flint_pool_free_list[c] = b;
+    flint_pool_free_count[c]++;
+}
+
+void _flint_pool_cleanup(void)
+{
+    pool_block_union * b;
+    slong c;
+
+    for (c = 0; c < FLINT_POOL_CLASSES; c++)
+    {
+        while ((b = flint_pool_free_list[c]) != NULL)
+        {
+            flint_pool_free_list[c] = b->next;
+            free(b);
+        }
+
+        flint_pool_free_count[c] = 0;
+    }
+}
 
 FLINT_TLS_PREFIX size_t flint_num_cleanup_functions = 0;
 
@@ -130,6 +670,148 @@ void flint_register_cleanup_function(flint_cleanup_function_t cleanup_function)
 #endif
 }
 
+/*
+   Thread local scratch arena. Memory is handed out from a list of chunks
+   by bumping a pointer, and flint_scratch_release resets the pointer to a
+   previously taken mark, so allocations must be released in stack order.
+   Chunks are kept for reuse until flint_cleanup. Once the chunks of a
+   thread would exceed flint_scratch_limit bytes, requests fall back to
+   flint_malloc and are freed when the mark below them is released. The
+   limit is thread local like the arena it applies to.
+*/
+
+#define SCRATCH_ALIGN 16
+#define SCRATCH_ROUND(xx) \
+    (((xx) + SCRATCH_ALIGN - 1) & ~(size_t) (SCRATCH_ALIGN - 1))
+#define SCRATCH_MIN_CHUNK 65536
+#define SCRATCH_HEADER SCRATCH_ROUND(sizeof(flint_scratch_chunk_struct))
+
+/*
+   Without thread local storage the arena would be shared between threads,
+   so in a reentrant build all scratch space comes from the heap.
+*/
+#if FLINT_REENTRANT && !HAVE_TLS
+#define SCRATCH_LIMIT 0
+#else
+#define SCRATCH_LIMIT flint_scratch_limit
+#endif
+
+typedef struct flint_scratch_chunk_struct
+{
+    struct flint_scratch_chunk_struct * next;
+    size_t size;
+} flint_scratch_chunk_struct;
+
+FLINT_TLS_PREFIX size_t flint_scratch_limit = FLINT_SCRATCH_DEFAULT_LIMIT;
+
+FLINT_TLS_PREFIX flint_scratch_chunk_struct * flint_scratch_head = NULL;
+FLINT_TLS_PREFIX flint_scratch_chunk_struct * flint_scratch_cur = NULL;
+FLINT_TLS_PREFIX size_t flint_scratch_used = 0;
+FLINT_TLS_PREFIX size_t flint_scratch_total = 0;
+FLINT_TLS_PREFIX flint_scratch_chunk_struct * flint_scratch_heap = NULL;
+
+void flint_set_scratch_limit(size_t limit)
+{
+    flint_scratch_limit = limit;
+}
+
+size_t flint_get_scratch_limit(void)
+{
+    return flint_scratch_limit;
+}
+
+void flint_scratch_mark(flint_scratch_mark_t * mark)
+{
+    mark->chunk = flint_scratch_cur;
+    mark->used = flint_scratch_used;
+    mark->heap = flint_scratch_heap;
+}
+
+void * flint_scratch_alloc(size_t size)
+{
+    flint_scratch_chunk_struct * c, * next;
+    void * ptr;
+
+    size = SCRATCH_ROUND(size);
+
+    if (flint_scratch_cur != NULL
+            && flint_scratch_used + size <= flint_scratch_cur->size)
+    {
+        ptr = (char *) flint_scratch_cur + SCRATCH_HEADER + flint_scratch_used;
+        flint_scratch_used += size;
+        return ptr;
+    }
+
+    next = (flint_scratch_cur == NULL) ? flint_scratch_head
+                                       : flint_scratch_cur->next;
+
+    if (next == NULL || next->size < size)
+    {
+        size_t chunk_size = SCRATCH_MIN_CHUNK;
+
+        if (flint_scratch_cur != NULL)
+            chunk_size = FLINT_MAX(chunk_size, 2*flint_scratch_cur->size);
+        chunk_size = FLINT_MAX(chunk_size, size);
+
+        if (flint_scratch_total + chunk_size > SCRATCH_LIMIT)
+        {
+            c = flint_malloc(SCRATCH_HEADER + size);
+            c->next = flint_scratch_heap;
+            c->size = size;
+            flint_scratch_heap = c;
+            return (char *) c + SCRATCH_HEADER;
+        }
+
+        c = flint_malloc(SCRATCH_HEADER + chunk_size);
+        c->size = chunk_size;
+        c->next = next;
+        flint_scratch_total += chunk_size;
+
+        if (flint_scratch_cur == NULL)
+            flint_scratch_head = c;
+        else
+            flint_scratch_cur->next = c;
+
+        next = c;
+    }
+
+    flint_scratch_cur = next;
+    flint_scratch_used = size;
+
+    return (char *) next + SCRATCH_HEADER;
+}
+
+void flint_scratch_release(const flint_scratch_mark_t * mark)
+{
+    flint_scratch_chunk_struct * c;
+
+    while (flint_scratch_heap != mark->heap)
+    {
+        c = flint_scratch_heap;
+        flint_scratch_heap = c->next;
+        flint_free(c);
+    }
+
+    flint_scratch_cur = mark->chunk;
+    flint_scratch_used = mark->used;
+}
+
+void _flint_scratch_cleanup(void)
+{
+    flint_scratch_chunk_struct * c;
+
+    while (flint_scratch_head != NULL)
+    {
+        c = flint_scratch_head;
+        flint_scratch_head = c->next;
+        flint_free(c);
+    }
+
+    flint_scratch_cur = NULL;
+    flint_scratch_used = 0;
+    flint_scratch_total = 0;
+}
+
 void _fmpz_cleanup();
 
 void flint_cleanup()
@@ -149,6 +831,8 @@ void flint_cleanup()
 
     mpfr_free_cache();
     _fmpz_cleanup();
+    _flint_scratch_cleanup();
+    _flint_pool_cleanup();
 
 #if FLINT_REENTRANT && !HAVE_TLS
     pthread_mutex_unlock(&register_lock);
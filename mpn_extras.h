@@ -110,6 +110,11 @@ FLINT_DLL int flint_mpn_divides(mp_ptr q, mp_srcptr array1,
 FLINT_DLL mp_size_t flint_mpn_gcd_full(mp_ptr arrayg, 
           mp_ptr array1, mp_size_t limbs1, mp_ptr array2, mp_size_t limbs2);
 
+FLINT_DLL void flint_mpn_mul(mp_ptr r, mp_srcptr i1, mp_size_t n1,
+                                               mp_srcptr i2, mp_size_t n2);
+
+FLINT_DLL void flint_mpn_sqr(mp_ptr r, mp_srcptr i1, mp_size_t n1);
+
 FLINT_DLL mp_limb_t flint_mpn_preinv1(mp_limb_t d, mp_limb_t d2);
 
 FLINT_DLL mp_limb_t flint_mpn_divrem_preinv1(mp_ptr q, mp_ptr a, 
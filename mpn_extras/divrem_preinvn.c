@@ -28,6 +28,7 @@
 #include "flint.h"
 #include "longlong.h"
 #include "mpn_extras.h"
+#include "fft.h"
 
 /* 
    TODO: speedup mpir's mullow and mulhigh and use instead of mul/mul_n
@@ -39,6 +40,8 @@ mp_limb_t flint_mpn_divrem_preinvn(mp_ptr qp, mp_ptr rp, mp_srcptr ap, mp_size_t
    mp_limb_t cy, hi = 0;
    mp_ptr t, q, r, a;
    mp_size_t size;
+   fft_precache_t Pd, Pinv;
+   int fft;
    TMP_INIT;
 
    a = (mp_ptr) ap + m - 2*n;
@@ -57,13 +60,32 @@ mp_limb_t flint_mpn_divrem_preinvn(mp_ptr qp, mp_ptr rp, mp_srcptr ap, mp_size_t
    TMP_START;
    t = TMP_ALLOC(2*n*sizeof(mp_limb_t));
 
+   /*
+      when there are several products by d and dinv in the Fermat ring FFT
+      range, their transforms are computed once
+   */
+   fft = m >= 3*n && n >= flint_tune_params[FLINT_TUNE_MPN_MUL_FFT]
+                  && !fft_mul_use_ntt(n, n);
+
+   if (fft)
+   {
+      fft_precache_init(Pinv, dinv, n, n);
+      fft_precache_init(Pd, d, n, n);
+   }
+
    /* 2n by n division */
    while (m >= 2*n)
    {
-      mpn_mul_n(t, dinv, r + n, n);
+      if (fft)
+         fft_mul_precache(t, r + n, n, Pinv);
+      else
+         mpn_mul_n(t, dinv, r + n, n);
       cy = mpn_add_n(q, t + n, r + n, n);
 
-      mpn_mul_n(t, d, q, n);
+      if (fft)
+         fft_mul_precache(t, q, n, Pd);
+      else
+         mpn_mul_n(t, d, q, n);
       cy = r[n] - t[n] - mpn_sub_n(r, a, t, n);
 
       while (cy > 0)
@@ -92,7 +114,10 @@ mp_limb_t flint_mpn_divrem_preinvn(mp_ptr qp, mp_ptr rp, mp_srcptr ap, mp_size_t
       if (rp != ap)
          mpn_copyi(rp, ap, size);
       
-      mpn_mul(t, dinv, n, rp + n, size);
+      if (fft)
+         fft_mul_precache(t, rp + n, size, Pinv);
+      else
+         mpn_mul(t, dinv, n, rp + n, size);
       cy = mpn_add_n(qp, t + n, rp + n, size);
 
       mpn_mul(t, d, n, qp, size);
@@ -114,6 +139,12 @@ mp_limb_t flint_mpn_divrem_preinvn(mp_ptr qp, mp_ptr rp, mp_srcptr ap, mp_size_t
       }
    }
 
+   if (fft)
+   {
+      fft_precache_clear(Pinv);
+      fft_precache_clear(Pd);
+   }
+
    TMP_END;
 
    return hi;
@@ -28,6 +28,7 @@
 #include "flint.h"
 #include "longlong.h"
 #include "mpn_extras.h"
+#include "fft.h"
 
 /* 
    TODO: speedup mpir's mullow and mulhigh and use instead of mul/mul_n
@@ -39,6 +40,8 @@ void flint_mpn_mod_preinvn(mp_ptr rp, mp_srcptr ap, mp_size_t m,
    mp_limb_t cy;
    mp_ptr t, r, a;
    mp_size_t size;
+   fft_precache_t Pd, Pinv;
+   int fft;
    TMP_INIT;
 
    a = (mp_ptr) ap + m - 2*n;
@@ -53,13 +56,32 @@ void flint_mpn_mod_preinvn(mp_ptr rp, mp_srcptr ap, mp_size_t m,
    TMP_START;
    t = TMP_ALLOC(3*n*sizeof(mp_limb_t));
 
+   /*
+      when there are several products by d and dinv in the Fermat ring FFT
+      range, their transforms are computed once
+   */
+   fft = m >= 3*n && n >= flint_tune_params[FLINT_TUNE_MPN_MUL_FFT]
+                  && !fft_mul_use_ntt(n, n);
+
+   if (fft)
+   {
+      fft_precache_init(Pinv, dinv, n, n);
+      fft_precache_init(Pd, d, n, n);
+   }
+
    /* 2n by n division */
    while (m >= 2*n)
    {
-      mpn_mul_n(t, dinv, r + n, n);
+      if (fft)
+         fft_mul_precache(t, r + n, n, Pinv);
+      else
+         mpn_mul_n(t, dinv, r + n, n);
       cy = mpn_add_n(t + 2*n, t + n, r + n, n);
 
-      mpn_mul_n(t, d, t + 2*n, n);
+      if (fft)
+         fft_mul_precache(t, t + 2*n, n, Pd);
+      else
+         mpn_mul_n(t, d, t + 2*n, n);
       cy = r[n] - t[n] - mpn_sub_n(r, a, t, n);
 
       while (cy > 0)
@@ -81,10 +103,16 @@ void flint_mpn_mod_preinvn(mp_ptr rp, mp_srcptr ap, mp_size_t m,
       if (rp != ap)
          mpn_copyi(rp, ap, size);
       
-      mpn_mul(t, dinv, n, rp + n, size);
+      if (fft)
+         fft_mul_precache(t, rp + n, size, Pinv);
+      else
+         mpn_mul(t, dinv, n, rp + n, size);
       cy = mpn_add_n(t + 2*n, t + n, rp + n, size);
 
-      mpn_mul(t, d, n, t + 2*n, size);
+      if (fft)
+         fft_mul_precache(t, t + 2*n, size, Pd);
+      else
+         mpn_mul(t, d, n, t + 2*n, size);
       if (cy)
          mpn_add_n(t + size, t + size, d, n + 1 - size);
       
@@ -97,5 +125,11 @@ void flint_mpn_mod_preinvn(mp_ptr rp, mp_srcptr ap, mp_size_t m,
          mpn_sub_n(rp, rp, d, n);
    }
 
+   if (fft)
+   {
+      fft_precache_clear(Pinv);
+      fft_precache_clear(Pd);
+   }
+
    TMP_END;
 }
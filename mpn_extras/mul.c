@@ -0,0 +1,33 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "mpn_extras.h"
+#include "fft.h"
+
+void flint_mpn_mul(mp_ptr r, mp_srcptr i1, mp_size_t n1,
+                                               mp_srcptr i2, mp_size_t n2)
+{
+    if (n2 < flint_tune_params[FLINT_TUNE_MPN_MUL_FFT])
+        mpn_mul(r, i1, n1, i2, n2);
+    else
+        flint_mpn_mul_fft_main(r, i1, n1, i2, n2);
+}
@@ -42,7 +42,10 @@ flint_mpn_mulmod_2expp1_internal(mp_ptr xp, mp_srcptr yp, mp_srcptr zp,
     n = BITS_TO_LIMBS(b);
     k = GMP_NUMB_BITS * n - b;
 
-    mpn_mul_n(tp, yp, zp, n);
+    if (yp == zp)
+        mpn_sqr(tp, yp, n);
+    else
+        mpn_mul_n(tp, yp, zp, n);
 
     if (k == 0)
     {
@@ -56,6 +56,10 @@ int main(void)
     for (i = 0; i < 10000; i++)
     {
        size = n_randint(state, 200) + 1;
+
+       /* exercise the cached FFT transforms of d and dinv */
+       flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = 64 + n_randint(state, 200);
+       flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = 0;
        size2 = n_randint(state, 200) + size;
        
        mpz_rrandomb(a, st, size2*FLINT_BITS);
@@ -105,6 +109,10 @@ int main(void)
     for (i = 0; i < 10000; i++)
     {
        size = n_randint(state, 200) + 1;
+
+       /* exercise the cached FFT transforms of d and dinv */
+       flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = 64 + n_randint(state, 200);
+       flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = 0;
        size2 = n_randint(state, 200) + size;
        
        mpz_rrandomb(a, st, size2*FLINT_BITS);
@@ -151,6 +159,8 @@ int main(void)
     /* don't clear r2 */
     
     gmp_randclear(st);
+    flint_tune_reset();
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
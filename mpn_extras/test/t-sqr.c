@@ -0,0 +1,82 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("sqr....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        mp_size_t n1, j;
+        mp_ptr i1, r1, r2;
+
+        n1 = n_randint(state, 3000) + 1;
+
+        i1 = flint_malloc(n1*sizeof(mp_limb_t));
+        r1 = flint_malloc(4*n1*sizeof(mp_limb_t));
+        r2 = r1 + 2*n1;
+
+        flint_mpn_rrandom(i1, state->gmp_state, n1);
+
+        /* the cutoff is at least 64 */
+        flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = 64 + n_randint(state, 2000);
+        flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] =
+                                          n_randint(state, 2) ? 0 : WORD_MAX;
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        flint_mpn_sqr(r1, i1, n1);
+        mpn_sqr(r2, i1, n1);
+
+        for (j = 0; j < 2*n1; j++)
+        {
+            if (r1[j] != r2[j])
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("n1 = %wd\n", n1);
+                flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                abort();
+            }
+        }
+
+        flint_free(i1);
+        flint_free(r1);
+    }
+
+    flint_tune_reset();
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -215,8 +215,9 @@ FLINT_DLL slong nmod_mat_nullspace(nmod_mat_t X, const nmod_mat_t A);
 /* Size at which pre-transposing becomes faster in classical multiplication */
 #define NMOD_MAT_MUL_TRANSPOSE_CUTOFF 20
 
-/* Strassen multiplication */
-#define NMOD_MAT_MUL_STRASSEN_CUTOFF 256
+/* Strassen multiplication, may be changed at runtime, see flint_tune_set */
+#define NMOD_MAT_MUL_STRASSEN_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_MAT_MUL_STRASSEN])
 
 /* Cutoff between classical and recursive triangular solving */
 #define NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF 64
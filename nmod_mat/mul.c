@@ -28,24 +28,29 @@
 #include "flint.h"
 #include "nmod_mat.h"
 #include "nmod_vec.h"
+#include "profiler.h"
 
 void
 nmod_mat_mul(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
 {
-    slong m, k, n;
+    slong m, k, n, dim;
 
     m = A->r;
     k = A->c;
     n = B->c;
 
+    dim = FLINT_MIN(FLINT_MIN(m, k), n);
+
     if (m < NMOD_MAT_MUL_STRASSEN_CUTOFF ||
         n < NMOD_MAT_MUL_STRASSEN_CUTOFF ||
         k < NMOD_MAT_MUL_STRASSEN_CUTOFF)
     {
-        nmod_mat_mul_classical(C, A, B);
+        FLINT_TRACE_CALL("nmod_mat_mul:classical", dim,
+            nmod_mat_mul_classical(C, A, B));
     }
     else
     {
-        nmod_mat_mul_strassen(C, A, B);
+        FLINT_TRACE_CALL("nmod_mat_mul:strassen", dim,
+            nmod_mat_mul_strassen(C, A, B));
     }
 }
@@ -30,7 +30,101 @@
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_mat.h"
+#include "thread_pool.h"
 
+typedef struct
+{
+    nmod_mat_struct * C;
+    const nmod_mat_struct * A;
+    const nmod_mat_struct * B;
+} _mul_arg_t;
+
+static void * _mul_worker(void * arg_ptr)
+{
+    _mul_arg_t * arg = (_mul_arg_t *) arg_ptr;
+
+    nmod_mat_mul(arg->C, arg->A, arg->B);
+
+    return NULL;
+}
+
+/*
+    Strassen-Winograd with all seven products spawned as tasks. This needs
+    more temporary space than the serial schedule below, but the products
+    are independent, and the recursive calls spawn their own products.
+*/
+static void
+_nmod_mat_mul_strassen_tasks(nmod_mat_t C11, nmod_mat_t C12,
+    nmod_mat_t C21, nmod_mat_t C22,
+    const nmod_mat_t A11, const nmod_mat_t A12,
+    const nmod_mat_t A21, const nmod_mat_t A22,
+    const nmod_mat_t B11, const nmod_mat_t B12,
+    const nmod_mat_t B21, const nmod_mat_t B22)
+{
+    slong anr = A11->r, anc = A11->c, bnc = B11->c;
+    mp_limb_t n = A11->mod.n;
+    nmod_mat_t S1, S2, S3, S4, T1, T2, T3, T4, X1, X3, X4;
+    flint_task_group_t G;
+    _mul_arg_t args[7];
+    slong i;
+
+    nmod_mat_init(S1, anr, anc, n);
+    nmod_mat_init(S2, anr, anc, n);
+    nmod_mat_init(S3, anr, anc, n);
+    nmod_mat_init(S4, anr, anc, n);
+    nmod_mat_init(T1, anc, bnc, n);
+    nmod_mat_init(T2, anc, bnc, n);
+    nmod_mat_init(T3, anc, bnc, n);
+    nmod_mat_init(T4, anc, bnc, n);
+    nmod_mat_init(X1, anr, bnc, n);
+    nmod_mat_init(X3, anr, bnc, n);
+    nmod_mat_init(X4, anr, bnc, n);
+
+    nmod_mat_add(S1, A21, A22);
+    nmod_mat_sub(S2, S1, A11);
+    nmod_mat_sub(S3, A11, A21);
+    nmod_mat_sub(S4, A12, S2);
+
+    nmod_mat_sub(T1, B12, B11);
+    nmod_mat_sub(T2, B22, T1);
+    nmod_mat_sub(T3, B22, B12);
+    nmod_mat_sub(T4, T2, B21);
+
+    args[0].C = X1;  args[0].A = A11; args[0].B = B11;
+    args[1].C = X3;  args[1].A = A12; args[1].B = B21;
+    args[2].C = C11; args[2].A = S4;  args[2].B = B22;
+    args[3].C = X4;  args[3].A = A22; args[3].B = T4;
+    args[4].C = C22; args[4].A = S1;  args[4].B = T1;
+    args[5].C = C12; args[5].A = S2;  args[5].B = T2;
+    args[6].C = C21; args[6].A = S3;  args[6].B = T3;
+
+    flint_task_group_init(G);
+
+    for (i = 0; i < 7; i++)
+        flint_task_spawn(G, _mul_worker, args + i);
+
+    flint_task_sync(G);
+
+    nmod_mat_add(C12, C12, X1);
+    nmod_mat_add(C21, C12, C21);
+    nmod_mat_add(C12, C12, C22);
+    nmod_mat_add(C22, C21, C22);
+    nmod_mat_add(C12, C12, C11);
+    nmod_mat_sub(C21, C21, X4);
+    nmod_mat_add(C11, X1, X3);
+
+    nmod_mat_clear(S1);
+    nmod_mat_clear(S2);
+    nmod_mat_clear(S3);
+    nmod_mat_clear(S4);
+    nmod_mat_clear(T1);
+    nmod_mat_clear(T2);
+    nmod_mat_clear(T3);
+    nmod_mat_clear(T4);
+    nmod_mat_clear(X1);
+    nmod_mat_clear(X3);
+    nmod_mat_clear(X4);
+}
 
 void
 nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
@@ -73,6 +167,14 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
     nmod_mat_window_init(C21, C, anr, 0, 2*anr, bnc);
     nmod_mat_window_init(C22, C, anr, bnc, 2*anr, 2*bnc);
 
+    /* the extra temporaries only pay off if other threads take products */
+    if (flint_task_parallel_enabled())
+    {
+        _nmod_mat_mul_strassen_tasks(C11, C12, C21, C22,
+                                  A11, A12, A21, A22, B11, B12, B21, B22);
+        goto cleanup;
+    }
+
     nmod_mat_init(X1, anr, FLINT_MAX(bnc, anc), A->mod.n);
     nmod_mat_init(X2, anc, bnc, A->mod.n);
 
@@ -120,6 +222,7 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
 
     nmod_mat_clear(X1);
 
+cleanup:
     nmod_mat_window_clear(A11);
     nmod_mat_window_clear(A12);
     nmod_mat_window_clear(A21);
@@ -48,6 +48,8 @@ main(void)
 
         slong m, k, n;
 
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
         m = n_randint(state, 400);
         k = n_randint(state, 400);
         n = n_randint(state, 400);
@@ -79,8 +81,9 @@ main(void)
         nmod_mat_clear(D);
     }
 
-    FLINT_TEST_CLEANUP(state);
-    
+    flint_randclear(state);
+    flint_cleanup_master();
+
     flint_printf("PASS\n");
     return 0;
 }
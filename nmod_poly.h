@@ -53,12 +53,32 @@
     extern "C" {
 #endif
 
-#define NMOD_DIVREM_DIVCONQUER_CUTOFF  300
-#define NMOD_DIV_DIVCONQUER_CUTOFF     300 /* Must be <= NMOD_DIVREM_DIVCONQUER_CUTOFF */
-
-#define NMOD_POLY_HGCD_CUTOFF  100      /* HGCD: Basecase -> Recursion      */
-#define NMOD_POLY_GCD_CUTOFF  340       /* GCD:  Euclidean -> HGCD          */
-#define NMOD_POLY_SMALL_GCD_CUTOFF 200  /* GCD (small n): Euclidean -> HGCD */
+/* Tuning parameters, which may be changed at runtime, see flint_tune_set */
+#define NMOD_DIVREM_DIVCONQUER_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_DIVREM_DIVCONQUER])
+#define NMOD_DIV_DIVCONQUER_CUTOFF    /* <= NMOD_DIVREM_DIVCONQUER_CUTOFF */ \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_DIV_DIVCONQUER])
+
+/* HGCD: Basecase -> Recursion */
+#define NMOD_POLY_HGCD_CUTOFF (flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD])
+/* HGCD: matrix products -> products with shared transforms */
+#define NMOD_POLY_HGCD_NTT_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD_NTT])
+/* GCD: Euclidean -> HGCD */
+#define NMOD_POLY_GCD_CUTOFF (flint_tune_params[FLINT_TUNE_NMOD_POLY_GCD])
+/* GCD (small n): Euclidean -> HGCD */
+#define NMOD_POLY_SMALL_GCD_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_SMALL_GCD])
+/* MUL: Kronecker substitution -> small prime NTT */
+#define NMOD_POLY_MUL_NTT_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_MUL_NTT])
+
+/* Subproduct tree: serial -> threaded build */
+#define NMOD_POLY_TREE_THREADED_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_THREADED])
+/* Subproduct tree: nodes of at least this degree keep their inverses */
+#define NMOD_POLY_TREE_PREINV_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_PREINV])
 
 NMOD_POLY_INLINE
 slong NMOD_DIVREM_BC_ITCH(slong lenA, slong lenB, nmod_t mod)
@@ -125,6 +145,17 @@ typedef struct
 
 typedef nmod_poly_res_struct nmod_poly_res_t[1];
 
+typedef struct
+{
+    mp_ptr * tree;
+    mp_ptr * inv;
+    mp_ptr weights;
+    slong len;
+    nmod_t mod;
+} nmod_poly_tree_struct;
+
+typedef nmod_poly_tree_struct nmod_poly_tree_t[1];
+
 typedef struct
 {
     nmod_mat_struct A;
@@ -540,12 +571,52 @@ FLINT_DLL void _nmod_poly_mul_KS4(mp_ptr res, mp_srcptr op1, slong n1,
 FLINT_DLL void nmod_poly_mul_KS4(nmod_poly_t res,
                                const nmod_poly_t poly1, const nmod_poly_t poly2);
 
+FLINT_DLL void _nmod_poly_mul_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                                     mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mul_NTT(nmod_poly_t res,
+                               const nmod_poly_t poly1, const nmod_poly_t poly2);
+
+FLINT_DLL void _nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                            mp_srcptr poly2, slong len2, slong n, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mullow_NTT(nmod_poly_t res, const nmod_poly_t poly1, 
+                                            const nmod_poly_t poly2, slong n);
+
+FLINT_DLL void _nmod_poly_conv_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                          mp_srcptr poly2, slong len2, mp_bitcnt_t depth,
+                          slong start, slong n, nmod_t mod);
+
+FLINT_DLL void _nmod_poly_ntt_crt(mp_ptr res, mp_limb_t ** r, slong n,
+                                                      int np, nmod_t mod);
+
+FLINT_DLL int _nmod_poly_ntt_direct(mp_limb_t * g, nmod_t mod,
+                                                       mp_bitcnt_t depth);
+
+FLINT_DLL void _nmod_poly_mulmid_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                                     mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid_NTT(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
 FLINT_DLL void _nmod_poly_mullow_KS(mp_ptr out, mp_srcptr in1, slong len1,
                mp_srcptr in2, slong len2, mp_bitcnt_t bits, slong n, nmod_t mod);
 
 FLINT_DLL void nmod_poly_mullow_KS(nmod_poly_t res, const nmod_poly_t poly1, 
                              const nmod_poly_t poly2, mp_bitcnt_t bits, slong n);
 
+FLINT_DLL void _nmod_poly_mulmid_classical(mp_ptr res, mp_srcptr poly1,
+                         slong len1, mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid_classical(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
+FLINT_DLL void _nmod_poly_mulmid_KS(mp_ptr out, mp_srcptr in1, slong len1,
+                        mp_srcptr in2, slong len2, mp_bitcnt_t bits, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid_KS(nmod_poly_t res,
+             const nmod_poly_t poly1, const nmod_poly_t poly2, mp_bitcnt_t bits);
+
 FLINT_DLL void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1, 
                                        mp_srcptr poly2, slong len2, nmod_t mod);
 
@@ -564,6 +635,12 @@ FLINT_DLL void _nmod_poly_mulhigh(mp_ptr res, mp_srcptr poly1, slong len1,
 FLINT_DLL void nmod_poly_mulhigh(nmod_poly_t res, const nmod_poly_t poly1, 
                                               const nmod_poly_t poly2, slong n);
 
+FLINT_DLL void _nmod_poly_mulmid(mp_ptr res, mp_srcptr poly1, slong len1, 
+                                       mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
 FLINT_DLL void _nmod_poly_mulmod(mp_ptr res, mp_srcptr poly1, slong len1, 
                              mp_srcptr poly2, slong len2, mp_srcptr f,
                             slong lenf, nmod_t mod);
@@ -719,6 +796,9 @@ FLINT_DLL void nmod_poly_inv_series_basecase(nmod_poly_t Qinv,
 FLINT_DLL void _nmod_poly_inv_series_newton(mp_ptr Qinv, 
                                               mp_srcptr Q, slong n, nmod_t mod);
 
+FLINT_DLL void _nmod_poly_inv_series_lift(mp_ptr Qinv, mp_srcptr Q,
+                                           slong m, slong n, nmod_t mod);
+
 FLINT_DLL void nmod_poly_inv_series_newton(nmod_poly_t Qinv, 
                                                   const nmod_poly_t Q, slong n);
 
@@ -807,6 +887,10 @@ FLINT_DLL void nmod_poly_evaluate_nmod_vec_iter(mp_ptr ys,
 FLINT_DLL void _nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
     slong plen, const mp_ptr * tree, slong len, nmod_t mod);
 
+FLINT_DLL void _nmod_poly_evaluate_nmod_vec_fast_precomp_preinv(mp_ptr vs,
+    mp_srcptr poly, slong plen, const mp_ptr * tree, const mp_ptr * inv,
+    slong len, nmod_t mod);
+
 FLINT_DLL void _nmod_poly_evaluate_nmod_vec_fast(mp_ptr ys, mp_srcptr coeffs, slong len,
     mp_srcptr xs, slong n, nmod_t mod);
 
@@ -828,6 +912,20 @@ FLINT_DLL void _nmod_poly_tree_free(mp_ptr * tree, slong len);
 FLINT_DLL void _nmod_poly_tree_build(mp_ptr * tree, mp_srcptr roots,
     slong len, nmod_t mod);
 
+FLINT_DLL void nmod_poly_tree_init(nmod_poly_tree_t T, mp_srcptr xs,
+                                                       slong len, mp_limb_t n);
+
+FLINT_DLL void nmod_poly_tree_clear(nmod_poly_tree_t T);
+
+FLINT_DLL void nmod_poly_evaluate_nmod_vec_tree(mp_ptr ys,
+                            const nmod_poly_t poly, const nmod_poly_tree_t T);
+
+FLINT_DLL void nmod_poly_evaluate_nmod_vec_tree_batch(mp_ptr * ys,
+      const nmod_poly_struct * polys, slong num, const nmod_poly_tree_t T);
+
+FLINT_DLL void nmod_poly_interpolate_nmod_vec_tree(nmod_poly_t poly,
+                                   mp_srcptr ys, const nmod_poly_tree_t T);
+
 /* Interpolation  ************************************************************/
 
 FLINT_DLL void _nmod_poly_interpolate_nmod_vec_newton(mp_ptr poly, mp_srcptr xs,
@@ -897,6 +995,9 @@ FLINT_DLL void _nmod_poly_taylor_shift(mp_ptr poly, mp_limb_t c, slong len, nmod
 
 FLINT_DLL void nmod_poly_taylor_shift(nmod_poly_t g, const nmod_poly_t f, mp_limb_t c);
 
+FLINT_DLL void _nmod_poly_multi_taylor_shift_horner(mp_ptr poly, mp_srcptr c,
+    slong len, const nmod_multi_t M);
+
 /* Modular composition  ******************************************************/
 
 FLINT_DLL void _nmod_poly_compose_mod_brent_kung(mp_ptr res, mp_srcptr f, slong lenf,
@@ -936,6 +1037,15 @@ FLINT_DLL void nmod_poly_compose_mod_brent_kung_preinv(nmod_poly_t res,
                     const nmod_poly_t poly1, const nmod_poly_t poly2,
                     const nmod_poly_t poly3, const nmod_poly_t poly3inv);
 
+FLINT_DLL void _nmod_poly_compose_mod_brent_kung_preinv_threaded(mp_ptr res,
+                            mp_srcptr poly1, slong len1, mp_srcptr poly2,
+                            mp_srcptr poly3, slong len3,
+                            mp_srcptr poly3inv, slong len3inv, nmod_t mod);
+
+FLINT_DLL void nmod_poly_compose_mod_brent_kung_preinv_threaded(nmod_poly_t res,
+                    const nmod_poly_t poly1, const nmod_poly_t poly2,
+                    const nmod_poly_t poly3, const nmod_poly_t poly3inv);
+
 FLINT_DLL void _nmod_poly_compose_mod_brent_kung_vec_preinv (nmod_poly_struct * res,
                  const nmod_poly_struct * polys, slong len1, slong l,
                  mp_srcptr poly, slong len, mp_srcptr polyinv,
@@ -1031,6 +1141,12 @@ FLINT_DLL slong _nmod_poly_gcd_euclidean(mp_ptr G,
 FLINT_DLL void nmod_poly_gcd_euclidean(nmod_poly_t G, 
                                      const nmod_poly_t A, const nmod_poly_t B);
 
+FLINT_DLL void _nmod_poly_mat22_mul_NTT(mp_ptr * C, slong * lenC,
+          mp_srcptr * A, const slong * lenA, mp_srcptr * B,
+                                  const slong * lenB, slong k, nmod_t mod);
+
+FLINT_DLL int _nmod_poly_hgcd_use_NTT(slong len, slong lmax, nmod_t mod);
+
 FLINT_DLL slong _nmod_poly_hgcd_recursive(mp_ptr *M, slong *lenM, 
     mp_ptr A, slong *lenA, mp_ptr B, slong *lenB, 
     mp_srcptr a, slong lena, mp_srcptr b, slong lenb, 
@@ -29,12 +29,31 @@
 #include "nmod_poly.h"
 #include "ulong_extras.h"
 
+/* from this length the threaded Brent-Kung algorithm is used if possible */
+#define NMOD_POLY_COMPOSE_MOD_THREADED_CUTOFF 64
+
 void
 _nmod_poly_compose_mod(mp_ptr res,
     mp_srcptr f, slong lenf, mp_srcptr g, mp_srcptr h, slong lenh, nmod_t mod)
 {
     if (lenh < 8 || lenf >= lenh)
         _nmod_poly_compose_mod_horner(res, f, lenf, g, h, lenh, mod);
+    else if (lenh >= NMOD_POLY_COMPOSE_MOD_THREADED_CUTOFF
+                && flint_get_num_threads() > 1)
+    {
+        mp_ptr hrev, hinv;
+
+        hrev = _nmod_vec_init(2*lenh);
+        hinv = hrev + lenh;
+
+        _nmod_poly_reverse(hrev, h, lenh, lenh);
+        _nmod_poly_inv_series(hinv, hrev, lenh, mod);
+
+        _nmod_poly_compose_mod_brent_kung_preinv_threaded(res, f, lenf, g,
+                                                 h, lenh, hinv, lenh, mod);
+
+        _nmod_vec_clear(hrev);
+    }
     else
         _nmod_poly_compose_mod_brent_kung(res, f, lenf, g, h, lenh, mod);
 }
@@ -0,0 +1,305 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "thread_pool.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    mp_ptr * rows;
+    mp_srcptr h;
+    slong i;
+    slong j;
+    mp_srcptr poly3;
+    slong len3;
+    mp_srcptr poly3inv;
+    slong len3inv;
+    nmod_t mod;
+}
+compose_mod_mulmod_arg_t;
+
+/* rows[i] := rows[j] * h, the baby steps */
+static void *
+_compose_mod_baby_worker(void * arg_ptr)
+{
+    compose_mod_mulmod_arg_t * arg = (compose_mod_mulmod_arg_t *) arg_ptr;
+    slong n = arg->len3 - 1;
+
+    _nmod_poly_mulmod_preinv(arg->rows[arg->i], arg->rows[arg->j], n,
+                             arg->h, n, arg->poly3, arg->len3,
+                             arg->poly3inv, arg->len3inv, arg->mod);
+
+    return NULL;
+}
+
+/* rows[i] := rows[i] + rows[j] * h, the giant steps */
+static void *
+_compose_mod_giant_worker(void * arg_ptr)
+{
+    compose_mod_mulmod_arg_t * arg = (compose_mod_mulmod_arg_t *) arg_ptr;
+    slong n = arg->len3 - 1;
+    mp_ptr t = _nmod_vec_init(n);
+
+    _nmod_poly_mulmod_preinv(t, arg->rows[arg->j], n,
+                             arg->h, n, arg->poly3, arg->len3,
+                             arg->poly3inv, arg->len3inv, arg->mod);
+    _nmod_vec_add(arg->rows[arg->i], arg->rows[arg->i], t, n, arg->mod);
+
+    _nmod_vec_clear(t);
+
+    return NULL;
+}
+
+typedef struct
+{
+    nmod_mat_struct * C;
+    const nmod_mat_struct * A;
+    const nmod_mat_struct * B;
+    slong c1;
+    slong c2;
+}
+compose_mod_mat_arg_t;
+
+/* columns c1 to c2 - 1 of C := B A */
+static void *
+_compose_mod_mat_worker(void * arg_ptr)
+{
+    compose_mod_mat_arg_t * arg = (compose_mod_mat_arg_t *) arg_ptr;
+    nmod_mat_t Aw, Cw;
+
+    nmod_mat_window_init(Aw, arg->A, 0, arg->c1, arg->A->r, arg->c2);
+    nmod_mat_window_init(Cw, arg->C, 0, arg->c1, arg->C->r, arg->c2);
+
+    nmod_mat_mul(Cw, arg->B, Aw);
+
+    nmod_mat_window_clear(Aw);
+    nmod_mat_window_clear(Cw);
+
+    return NULL;
+}
+
+void
+_nmod_poly_compose_mod_brent_kung_preinv_threaded(mp_ptr res,
+                            mp_srcptr poly1, slong len1, mp_srcptr poly2,
+                            mp_srcptr poly3, slong len3,
+                            mp_srcptr poly3inv, slong len3inv, nmod_t mod)
+{
+    nmod_mat_t A, B, C;
+    mp_ptr h;
+    slong i, j, k, n, m, num, num_threads;
+    compose_mod_mulmod_arg_t * args;
+    compose_mod_mat_arg_t * margs;
+
+    n = len3 - 1;
+
+    if (len3 == 1)
+        return;
+
+    if (len1 == 1)
+    {
+        res[0] = poly1[0];
+        return;
+    }
+
+    if (len3 == 2)
+    {
+        res[0] = _nmod_poly_evaluate_nmod(poly1, len1, poly2[0], mod);
+        return;
+    }
+
+    m = n_sqrt(n) + 1;
+
+    nmod_mat_init(A, m, n, mod.n);
+    nmod_mat_init(B, m, m, mod.n);
+    nmod_mat_init(C, m, n, mod.n);
+
+    h = _nmod_vec_init(n);
+
+    args = flint_malloc(m*sizeof(compose_mod_mulmod_arg_t));
+    for (i = 0; i < m; i++)
+    {
+        args[i].poly3 = poly3;
+        args[i].len3 = len3;
+        args[i].poly3inv = poly3inv;
+        args[i].len3inv = len3inv;
+        args[i].mod = mod;
+    }
+
+    /* Set rows of B to the segments of poly1 */
+    for (i = 0; i < len1 / m; i++)
+        _nmod_vec_set(B->rows[i], poly1 + i*m, m);
+
+    _nmod_vec_set(B->rows[i], poly1 + i*m, len1 % m);
+
+    /*
+       Set rows of A to powers of poly2. Given the powers below k, those
+       from k + 1 to 2k - 1 are independent products by the k-th power.
+    */
+    A->rows[0][0] = UWORD(1);
+    _nmod_vec_set(A->rows[1], poly2, n);
+    for (k = 2; k < m; k *= 2)
+    {
+        _nmod_poly_mulmod_preinv(A->rows[k], A->rows[k/2], n,
+            A->rows[k/2], n, poly3, len3, poly3inv, len3inv, mod);
+
+        num = FLINT_MIN(k, m - k) - 1;
+        for (j = 0; j < num; j++)
+        {
+            args[j].rows = A->rows;
+            args[j].h = A->rows[k];
+            args[j].i = k + j + 1;
+            args[j].j = j + 1;
+        }
+
+        flint_parallel_map(_compose_mod_baby_worker, args,
+                                     sizeof(compose_mod_mulmod_arg_t), num);
+    }
+
+    /* C := B A, by blocks of columns */
+    num_threads = flint_get_num_threads();
+    num = FLINT_MAX(WORD(1), FLINT_MIN(num_threads, n/m));
+    margs = flint_malloc(num*sizeof(compose_mod_mat_arg_t));
+
+    for (i = 0; i < num; i++)
+    {
+        margs[i].C = C;
+        margs[i].A = A;
+        margs[i].B = B;
+        margs[i].c1 = (n*i)/num;
+        margs[i].c2 = (n*(i + 1))/num;
+    }
+
+    flint_parallel_map(_compose_mod_mat_worker, margs,
+                                     sizeof(compose_mod_mat_arg_t), num);
+
+    flint_free(margs);
+
+    /*
+       Evaluate the block composition sum_i C_i h^i, h = poly2^m, by
+       Estrin's scheme: the pairs at each level are independent, and
+       h is squared between levels
+    */
+    _nmod_poly_mulmod_preinv(h, A->rows[m - 1], n, poly2, n,
+                             poly3, len3, poly3inv, len3inv, mod);
+
+    for (k = 1; k < m; k *= 2)
+    {
+        if (k > 1)
+            _nmod_poly_mulmod_preinv(h, h, n, h, n,
+                             poly3, len3, poly3inv, len3inv, mod);
+
+        for (i = 0, num = 0; i + k < m; i += 2*k, num++)
+        {
+            args[num].rows = C->rows;
+            args[num].h = h;
+            args[num].i = i;
+            args[num].j = i + k;
+        }
+
+        flint_parallel_map(_compose_mod_giant_worker, args,
+                                     sizeof(compose_mod_mulmod_arg_t), num);
+    }
+
+    _nmod_vec_set(res, C->rows[0], n);
+
+    flint_free(args);
+
+    _nmod_vec_clear(h);
+
+    nmod_mat_clear(A);
+    nmod_mat_clear(B);
+    nmod_mat_clear(C);
+}
+
+void
+nmod_poly_compose_mod_brent_kung_preinv_threaded(nmod_poly_t res, 
+                    const nmod_poly_t poly1, const nmod_poly_t poly2,
+                    const nmod_poly_t poly3, const nmod_poly_t poly3inv)
+{
+    slong len1 = poly1->length;
+    slong len2 = poly2->length;
+    slong len3 = poly3->length;
+    slong len = len3 - 1;
+
+    mp_ptr ptr2;
+
+    if (len3 == 0)
+    {
+        flint_printf("Exception (nmod_poly_compose_mod_brent_kung_preinv_threaded). Division by zero.\n");
+        abort();
+    }
+
+    if (len1 >= len3)
+    {
+        flint_printf("Exception (nmod_poly_compose_mod_brent_kung_preinv_threaded). The degree of the \n"
+               "first polynomial must be smaller than that of the modulus.\n");
+        abort();
+    }
+
+    if (len1 == 0 || len3 == 1)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    if (len1 == 1)
+    {
+        nmod_poly_set(res, poly1);
+        return;
+    }
+
+    if (res == poly3 || res == poly1 || res == poly3inv)
+    {
+        nmod_poly_t tmp;
+        nmod_poly_init_preinv(tmp, res->mod.n, res->mod.ninv);
+        nmod_poly_compose_mod_brent_kung_preinv_threaded(tmp, poly1, poly2,
+                                                         poly3, poly3inv);
+        nmod_poly_swap(tmp, res);
+        nmod_poly_clear(tmp);
+        return;
+    }
+
+    ptr2 = _nmod_vec_init(len);
+
+    if (len2 <= len)
+    {
+        flint_mpn_copyi(ptr2, poly2->coeffs, len2);
+        flint_mpn_zero(ptr2 + len2, len - len2);
+    }
+    else
+    {
+        _nmod_poly_rem(ptr2, poly2->coeffs, len2,
+                             poly3->coeffs, len3, res->mod);
+    }
+
+    nmod_poly_fit_length(res, len);
+    _nmod_poly_compose_mod_brent_kung_preinv_threaded(res->coeffs,
+        poly1->coeffs, len1, ptr2, poly3->coeffs, len3,
+        poly3inv->coeffs, poly3inv->length, res->mod);
+    res->length = len;
+    _nmod_poly_normalise(res);
+
+    _nmod_vec_clear(ptr2);
+}
@@ -25,8 +25,8 @@
 ******************************************************************************/
 
 #include <gmp.h>
-#include <pthread.h>
 #include "flint.h"
+#include "thread_pool.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
 #include "nmod_mat.h"
@@ -70,7 +70,6 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv_worker(void * arg_ptr)
 
     _nmod_vec_clear(t);
 
-    flint_cleanup();
     return NULL;
 }
 
@@ -83,9 +82,8 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv_threaded(nmod_poly_struct * res,
                                              nmod_t mod)
 {
     nmod_mat_t A, B, C;
-    slong i, j, n, m, k, len2 = l, len1, num_threads, c;
+    slong i, j, n, m, k, len2 = l, len1;
     mp_ptr h;
-    pthread_t *threads;
     compose_vec_arg_t * args;
 
     n = len - 1;
@@ -126,42 +124,27 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv_threaded(nmod_poly_struct * res,
     _nmod_poly_mulmod_preinv(h, A->rows[m - 1], n, A->rows[1], n, poly,
                              len, polyinv, leninv, mod);
 
-    num_threads = flint_get_num_threads();
+    args = flint_malloc(sizeof(compose_vec_arg_t) * len2);
 
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
-    args = flint_malloc(sizeof(compose_vec_arg_t) * num_threads);
-
-    for (j = 0; j < len2 / num_threads + 1; j++)
+    for (j = 0; j < len2; j++)
     {
-        c = 0;
-        for (i = 0; i < num_threads; i++)
-        {
-            if (i + j * num_threads < len2)
-            {
-                c++;
-                args[i].res     = res[i + j * num_threads];
-                args[i].C       = *C;
-                args[i].g       = polys[i + j * num_threads];
-                args[i].h       = h;
-                args[i].k       = k;
-                args[i].m       = m;
-                args[i].j       = i + j * num_threads;
-                args[i].poly    = poly;
-                args[i].len     = len;
-                args[i].polyinv = polyinv;
-                args[i].leninv  = leninv;
-                args[i].p       = mod;
-
-                pthread_create(&threads[i], NULL,
-                        _nmod_poly_compose_mod_brent_kung_vec_preinv_worker,
-                        &args[i]);
-            }
-        }
-        for (i = 0; i < c; i++)
-            pthread_join(threads[i], NULL);
+        args[j].res     = res[j];
+        args[j].C       = *C;
+        args[j].g       = polys[j];
+        args[j].h       = h;
+        args[j].k       = k;
+        args[j].m       = m;
+        args[j].j       = j;
+        args[j].poly    = poly;
+        args[j].len     = len;
+        args[j].polyinv = polyinv;
+        args[j].leninv  = leninv;
+        args[j].p       = mod;
     }
 
-    flint_free(threads);
+    flint_parallel_map(_nmod_poly_compose_mod_brent_kung_vec_preinv_worker,
+                           args, sizeof(compose_vec_arg_t), len2);
+
     flint_free(args);
 
     _nmod_vec_clear(h);
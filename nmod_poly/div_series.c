@@ -30,16 +30,45 @@
 #include "nmod_poly.h"
 #include "ulong_extras.h"
 
+/*
+   Below this length the quotient is the product by the full inverse,
+   above it the second half of the quotient is obtained by a Newton step
+   from the first (Karp and Markstein), so that the inverse is only needed
+   to half the length.
+*/
+#define NMOD_POLY_DIV_SERIES_CUTOFF 32
+
 void
 _nmod_poly_div_series(mp_ptr Q, mp_srcptr A, mp_srcptr B, 
                                              slong n, nmod_t mod)
 {
-    mp_ptr Binv = _nmod_vec_init(n);
+    mp_ptr Binv, W;
+    slong m;
+
+    if (n < NMOD_POLY_DIV_SERIES_CUTOFF)
+    {
+        Binv = _nmod_vec_init(n);
+        _nmod_poly_inv_series(Binv, B, n, mod);
+        _nmod_poly_mullow(Q, Binv, n, A, n, n, mod);
+        _nmod_vec_clear(Binv);
+        return;
+    }
+
+    m = (n + 1) / 2;
+    Binv = _nmod_vec_init(m);
+    W = _nmod_vec_init(n - m + 1);
+
+    _nmod_poly_inv_series(Binv, B, m, mod);
+    _nmod_poly_mullow(Q, A, m, Binv, m, m, mod);
+
+    /* W := (A - B Q)[m, n), the low m coefficients being zero */
+    _nmod_poly_mulmid(W, B, n, Q, m, mod);
+    _nmod_vec_sub(W, A + m, W + 1, n - m, mod);
 
-    _nmod_poly_inv_series(Binv, B, n, mod);
-    _nmod_poly_mullow(Q, Binv, n, A, n, n, mod);
+    _nmod_poly_mullow(Q + m, Binv, n - m, W, n - m, n - m, mod);
 
     _nmod_vec_clear(Binv);
+    _nmod_vec_clear(W);
 }
 
 void
@@ -26,6 +26,7 @@
 #include <gmp.h>
 #include "flint.h"
 #include "ulong_extras.h"
+#include "nmod_vec.h"
 #include "nmod_poly.h"
 
 /* This gives some speedup for small lengths. */
@@ -38,14 +39,32 @@ static __inline__ void _nmod_poly_rem_2(mp_ptr r, mp_srcptr a, slong al,
         _nmod_poly_rem(r, a, al, b, bl, mod);
 }
 
+/*
+   Remainder modulo a tree node, with a division by the precomputed inverse
+   of its reverse where one is given and the quotient is short enough.
+*/
+static __inline__ void _nmod_poly_rem_node(mp_ptr r, mp_srcptr a, slong al,
+    mp_srcptr b, slong bl, mp_srcptr binv, nmod_t mod)
+{
+    if (binv != NULL && al > bl + 1 && al <= 2 * bl - 2)
+    {
+        mp_ptr q = _nmod_vec_init(al - bl + 1);
+
+        _nmod_poly_divrem_newton_n_preinv(q, r, a, al, b, bl, binv, bl - 1, mod);
+        _nmod_vec_clear(q);
+    }
+    else
+        _nmod_poly_rem_2(r, a, al, b, bl, mod);
+}
+
 void
-_nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
-    slong plen, const mp_ptr * tree, slong len, nmod_t mod)
+_nmod_poly_evaluate_nmod_vec_fast_precomp_preinv(mp_ptr vs, mp_srcptr poly,
+    slong plen, const mp_ptr * tree, const mp_ptr * inv, slong len, nmod_t mod)
 {
     slong height, i, j, pow, left;
     slong tree_height;
     slong tlen;
-    mp_ptr t, u, swap, pa, pb, pc;
+    mp_ptr t, u, swap, pa, pb, pc, pi;
 
     /* avoid worrying about some degenerate cases */
     if (len < 2 || plen < 2)
@@ -77,7 +96,9 @@ _nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
     for (i = j = 0; i < len; i += pow, j += (pow + 1))
     {
         tlen = ((i + pow) <= len) ? pow : len % pow;
-        _nmod_poly_rem(t + i, poly, plen, tree[height] + j, tlen + 1, mod);
+        pi = (inv != NULL && inv[height] != NULL) ? inv[height] + i : NULL;
+        _nmod_poly_rem_node(t + i, poly, plen, tree[height] + j, tlen + 1,
+                                                                   pi, mod);
     }
 
     for (i = height - 1; i >= 0; i--)
@@ -87,15 +108,19 @@ _nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
         pa = tree[i];
         pb = t;
         pc = u;
+        pi = (inv != NULL) ? inv[i] : NULL;
 
         while (left >= 2 * pow)
         {
-            _nmod_poly_rem_2(pc, pb, 2 * pow, pa, pow + 1, mod);
-            _nmod_poly_rem_2(pc + pow, pb, 2 * pow, pa + pow + 1, pow + 1, mod);
+            _nmod_poly_rem_node(pc, pb, 2 * pow, pa, pow + 1, pi, mod);
+            _nmod_poly_rem_node(pc + pow, pb, 2 * pow, pa + pow + 1, pow + 1,
+                                          (pi == NULL) ? NULL : pi + pow, mod);
 
             pa += 2 * pow + 2;
             pb += 2 * pow;
             pc += 2 * pow;
+            if (pi != NULL)
+                pi += 2 * pow;
             left -= 2 * pow;
         }
 
@@ -117,6 +142,14 @@ _nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
     _nmod_vec_clear(u);
 }
 
+void
+_nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
+    slong plen, const mp_ptr * tree, slong len, nmod_t mod)
+{
+    _nmod_poly_evaluate_nmod_vec_fast_precomp_preinv(vs, poly, plen, tree,
+                                                             NULL, len, mod);
+}
+
 void _nmod_poly_evaluate_nmod_vec_fast(mp_ptr ys, mp_srcptr poly, slong plen,
     mp_srcptr xs, slong n, nmod_t mod)
 {
@@ -0,0 +1,82 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "thread_pool.h"
+
+typedef struct
+{
+    mp_ptr * ys;
+    const nmod_poly_struct * polys;
+    slong i0;
+    slong i1;
+    const nmod_poly_tree_struct * T;
+} _evaluate_batch_arg_t;
+
+static void * _nmod_poly_evaluate_batch_worker(void * arg_ptr)
+{
+    _evaluate_batch_arg_t * arg = (_evaluate_batch_arg_t *) arg_ptr;
+    const nmod_poly_tree_struct * T = arg->T;
+    slong i;
+
+    for (i = arg->i0; i < arg->i1; i++)
+        _nmod_poly_evaluate_nmod_vec_fast_precomp_preinv(arg->ys[i],
+                   arg->polys[i].coeffs, arg->polys[i].length, T->tree,
+                                                     T->inv, T->len, T->mod);
+
+    return NULL;
+}
+
+void nmod_poly_evaluate_nmod_vec_tree_batch(mp_ptr * ys,
+        const nmod_poly_struct * polys, slong num, const nmod_poly_tree_t T)
+{
+    slong i, num_threads;
+    _evaluate_batch_arg_t * args;
+
+    if (num <= 0)
+        return;
+
+    /* the polynomials are shared out between the threads */
+    num_threads = (num * T->len >= NMOD_POLY_TREE_THREADED_CUTOFF) ?
+                                               flint_get_num_threads() : 1;
+    num_threads = FLINT_MIN(num_threads, num);
+
+    args = flint_malloc(num_threads * sizeof(_evaluate_batch_arg_t));
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].ys = ys;
+        args[i].polys = polys;
+        args[i].i0 = (num * i) / num_threads;
+        args[i].i1 = (num * (i + 1)) / num_threads;
+        args[i].T = T;
+    }
+
+    if (num_threads == 1)
+        _nmod_poly_evaluate_batch_worker(args);
+    else
+        flint_parallel_map(_nmod_poly_evaluate_batch_worker, args,
+                                  sizeof(_evaluate_batch_arg_t), num_threads);
+
+    flint_free(args);
+}
@@ -29,7 +29,33 @@
 #include "nmod_vec.h"
 #include "nmod_poly.h"
 
-#define NMOD_POLY_NEWTON_EXP_CUTOFF 200
+#define NMOD_POLY_NEWTON_EXP_CUTOFF 100
+
+/* sets inv[k] = 1/k for 0 < k < n using a single inversion */
+static void
+_nmod_vec_inverses(mp_ptr inv, slong n, nmod_t mod)
+{
+    mp_limb_t c;
+    slong k;
+
+    inv[0] = UWORD(0);
+    if (n < 2)
+        return;
+
+    /* inv[k] := (k - 1)! */
+    inv[1] = UWORD(1);
+    for (k = 2; k < n; k++)
+        inv[k] = nmod_mul(inv[k - 1], k - 1, mod);
+
+    c = n_invmod(nmod_mul(inv[n - 1], n - 1, mod), mod.n);
+
+    /* c = 1/k! */
+    for (k = n - 1; k >= 1; k--)
+    {
+        inv[k] = nmod_mul(inv[k], c, mod);
+        c = nmod_mul(c, k, mod);
+    }
+}
 
 /* with inverse=1 simultaneously computes g = exp(-x) to length n
    with inverse=0 uses g as scratch space, computing
@@ -38,63 +64,62 @@ static void
 _nmod_poly_exp_series_newton(mp_ptr f, mp_ptr g,
     mp_srcptr h, slong n, nmod_t mod, int inverse)
 {
-    slong a[FLINT_BITS];
-    slong i, m, m2, l;
-    mp_ptr T, U, hprime;
+    slong k, glen = 0;
+    mp_ptr T, U, hprime, inv;
 
     T = _nmod_vec_init(n);
     U = _nmod_vec_init(n);
     hprime = _nmod_vec_init(n);
+    inv = _nmod_vec_init(n);
 
     _nmod_poly_derivative(hprime, h, n, mod);
     hprime[n-1] = UWORD(0);
+    _nmod_vec_inverses(inv, n, mod);
+
+    FLINT_NEWTON_INIT(NMOD_POLY_NEWTON_EXP_CUTOFF, n)
+
+    /* f := exp(h) + O(x^n0),  g := exp(-h) + O(x^glen) */
+    FLINT_NEWTON_BASECASE(n0)
+    _nmod_poly_exp_series_basecase(f, h, n0, n0, mod);
+    glen = (n0 + 1) / 2;
+    _nmod_poly_inv_series_basecase(g, f, glen, mod);
+    FLINT_NEWTON_END_BASECASE
 
-    for (i = 1; (WORD(1) << i) < n; i++);
-    a[i = 0] = n;
-    while (n >= NMOD_POLY_NEWTON_EXP_CUTOFF)
-        a[++i] = (n = (n + 1) / 2);
+    FLINT_NEWTON_LOOP(m, n1)
 
-    /* f := exp(h) + O(x^m),  g := exp(-h) + O(x^m2) */
-    _nmod_poly_exp_series_basecase(f, h, n, n, mod);
-    _nmod_poly_inv_series_basecase(g, f, (n + 1) / 2, mod);
+    /* g := exp(-h) + O(x^m) */
+    _nmod_poly_inv_series_lift(g, f, glen, m, mod);
+    glen = m;
 
-    for (i--; i >= 0; i--)
+    /*
+       f'/f = h' + O(x^(m-1)) and f'_k = 0 for k >= m - 1, so that the
+       coefficients m - 1 to n1 - 2 of f'/f = h' + g (f' - f h') are those
+       of h' - g (f h')_[m-1, n1-1), only requiring a middle product
+    */
+    _nmod_poly_mulmid(T, hprime, n1 - 1, f, m, mod);
+    _nmod_poly_mullow(U, g, n1 - m, T, n1 - m, n1 - m, mod);
+
+    /* U := (h - log(f))_[m, n1) */
+    for (k = 0; k < n1 - m; k++)
     {
-        m = n;             /* previous length */
-        n = a[i];          /* new length */
-        m2 = (m + 1) / 2;
-        l = m - 1;         /* shifted for derivative */
-
-        /* g := exp(-h) + O(x^m) */
-        _nmod_poly_mullow(T, f, m, g, m2, m, mod);
-        _nmod_poly_mullow(g + m2, g, m2, T + m2, m - m2, m - m2, mod);
-        _nmod_vec_neg(g + m2, g + m2, m - m2, mod);
-
-        /* U := h' + g (f' - f h') + O(x^(n-1))
-           Note: should replace h' by h' mod x^(m-1) */
-        _nmod_vec_zero(f + m, n - m);
-        _nmod_poly_mullow(T, f, n, hprime, n, n, mod);     /* should be mulmid */
-        _nmod_poly_derivative(U, f, n, mod); U[n - 1] = 0; /* should skip low terms */
-        _nmod_vec_sub(U + l, U + l, T + l, n - l, mod);
-        _nmod_poly_mullow(T + l, g, n - m, U + l, n - m, n - m, mod);
-        _nmod_vec_add(U + l, hprime + l, T + l, n - m, mod);
-
-        /* f := f + f * (h - int U) + O(x^n) = exp(h) + O(x^n) */
-        _nmod_poly_integral(U, U, n, mod);  /* should skip low terms */
-        _nmod_vec_sub(U + m, h + m, U + m, n - m, mod);
-        _nmod_poly_mullow(f + m, f, n - m, U + m, n - m, n - m, mod);
-
-        /* g := exp(-h) + O(x^n) */
-        /* not needed if we only want exp(x) */
-        if (i == 0 && inverse)
-        {
-            _nmod_poly_mullow(T, f, n, g, m, n, mod);
-            _nmod_poly_mullow(g + m, g, m, T + m, n - m, n - m, mod);
-            _nmod_vec_neg(g + m, g + m, n - m, mod);
-        }
+        U[k] = nmod_sub(hprime[m - 1 + k], U[k], mod);
+        U[k] = nmod_sub(h[m + k], nmod_mul(U[k], inv[m + k], mod), mod);
     }
 
+    /* f := f + f * (h - log(f)) + O(x^n1) = exp(h) + O(x^n1) */
+    _nmod_poly_mullow(f + m, f, n1 - m, U, n1 - m, n1 - m, mod);
+
+    FLINT_NEWTON_END_LOOP
+
+    FLINT_NEWTON_END
+
+    /* g := exp(-h) + O(x^n) */
+    /* not needed if we only want exp(x) */
+    if (inverse)
+        _nmod_poly_inv_series_lift(g, f, glen, n, mod);
+
     _nmod_vec_clear(hprime);
+    _nmod_vec_clear(inv);
     _nmod_vec_clear(T);
     _nmod_vec_clear(U);
 }
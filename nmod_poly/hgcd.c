@@ -198,8 +198,9 @@ static void __mat_mul_strassen(mp_ptr *C, slong *lenC,
 
 /*
     Computs the matrix product C of the two 2x2 matrices A and B, 
-    using either classical or Strassen multiplication depending 
-    on the degrees of the input polynomials.
+    using either classical or Strassen multiplication or products 
+    in the transformed domain depending on the degrees of the input 
+    polynomials.
 
     Does not support aliasing.
 
@@ -211,7 +212,7 @@ static void __mat_mul(mp_ptr *C, slong *lenC,
     mp_ptr *A, slong *lenA, mp_ptr *B, slong *lenB, mp_ptr T0, mp_ptr T1, 
     nmod_t mod)
 {
-    slong min = lenA[0];
+    slong min = lenA[0], max;
 
     min = FLINT_MIN(min, lenA[1]);
     min = FLINT_MIN(min, lenA[2]);
@@ -221,14 +222,69 @@ static void __mat_mul(mp_ptr *C, slong *lenC,
     min = FLINT_MIN(min, lenB[2]);
     min = FLINT_MIN(min, lenB[3]);
 
+    /* the top left entries of the matrices are the longest */
+    max = lenA[0] + lenB[0] - 1;
+
     if (min < 20)
     {
         __mat_mul_classical(C, lenC, A, lenA, B, lenB, T0, mod);
     }
-    else
+    else if (!_nmod_poly_hgcd_use_NTT(min, max, mod))
     {
         __mat_mul_strassen(C, lenC, A, lenA, B, lenB, T0, T1, mod);
     }
+    else
+    {
+        _nmod_poly_mat22_mul_NTT(C, lenC, (mp_srcptr *) A, lenA, 
+                                          (mp_srcptr *) B, lenB, 2, mod);
+    }
+}
+
+/*
+    Computes the pair {C0, C1} = sgn (R[0] t - R[2] s, R[3] s - R[1] t) 
+    by which the remainders are updated, transforming each of the 
+    polynomials involved once.
+
+    Does not support aliasing.
+
+    Expects T to be temporary space of length at least lent.
+ */
+
+static void __mat_vec_mul_NTT(mp_ptr C0, slong *lenC0, mp_ptr C1, 
+    slong *lenC1, mp_ptr *R, slong *lenR, mp_srcptr s, slong lens, 
+    mp_srcptr t, slong lent, slong sgn, mp_ptr T, nmod_t mod)
+{
+    mp_srcptr A[4], B[2];
+    mp_ptr C[2];
+    slong lenA[4], lenB[2], lenC[2];
+
+    A[0] = R[2];
+    A[1] = R[0];
+    A[2] = R[3];
+    A[3] = R[1];
+    lenA[0] = lenR[2];
+    lenA[1] = lenR[0];
+    lenA[2] = lenR[3];
+    lenA[3] = lenR[1];
+
+    _nmod_vec_neg(T, t, lent, mod);
+    B[0] = s;
+    B[1] = T;
+    lenB[0] = lens;
+    lenB[1] = lent;
+
+    C[0] = C0;
+    C[1] = C1;
+
+    _nmod_poly_mat22_mul_NTT(C, lenC, A, lenA, B, lenB, 1, mod);
+
+    if (sgn > 0)
+        _nmod_vec_neg(C0, C0, lenC[0], mod);
+    else
+        _nmod_vec_neg(C1, C1, lenC[1], mod);
+
+    *lenC0 = lenC[0];
+    *lenC1 = lenC[1];
 }
 
 /*
@@ -417,13 +473,30 @@ slong _nmod_poly_hgcd_recursive(mp_ptr *M, slong *lenM,
         __attach_truncate(s, lens, (mp_ptr) a, lena, m);
         __attach_truncate(t, lent, (mp_ptr) b, lenb, m);
 
-        __mul(b2, lenb2, R[2], lenR[2], s, lens);
-        __mul(T0, lenT0, R[0], lenR[0], t, lent);
-
-        if (sgnR < 0)
-            __sub(b2, lenb2, b2, lenb2, T0, lenT0);
+        if (_nmod_poly_hgcd_use_NTT(FLINT_MIN(lenR[0], lens), 
+                                    lenR[0] + lens - 1, mod))
+        {
+            __mat_vec_mul_NTT(b2, &lenb2, a2, &lena2, R, lenR, 
+                              s, lens, t, lent, sgnR, T0, mod);
+        }
         else
-            __sub(b2, lenb2, T0, lenT0, b2, lenb2);
+        {
+            __mul(b2, lenb2, R[2], lenR[2], s, lens);
+            __mul(T0, lenT0, R[0], lenR[0], t, lent);
+
+            if (sgnR < 0)
+                __sub(b2, lenb2, b2, lenb2, T0, lenT0);
+            else
+                __sub(b2, lenb2, T0, lenT0, b2, lenb2);
+
+            __mul(a2, lena2, R[3], lenR[3], s, lens);
+            __mul(T0, lenT0, R[1], lenR[1], t, lent);
+
+            if (sgnR < 0)
+                __sub(a2, lena2, T0, lenT0, a2, lena2);
+            else
+                __sub(a2, lena2, a2, lena2, T0, lenT0);
+        }
 
         flint_mpn_zero(b2 + lenb2, m + lenb3 - lenb2);
 
@@ -432,14 +505,6 @@ slong _nmod_poly_hgcd_recursive(mp_ptr *M, slong *lenM,
         lenb2 = FLINT_MAX(m + lenb3, lenb2);
         MPN_NORM(b2, lenb2);
 
-        __mul(a2, lena2, R[3], lenR[3], s, lens);
-        __mul(T0, lenT0, R[1], lenR[1], t, lent);
-
-        if (sgnR < 0)
-            __sub(a2, lena2, T0, lenT0, a2, lena2);
-        else
-            __sub(a2, lena2, a2, lena2, T0, lenT0);
-
         flint_mpn_zero(a2 + lena2, m + lena3 - lena2);
         __attach_shift(a4, lena4, a2, lena2, m);
         __add(a4, lena4, a4, lena4, a3, lena3);
@@ -546,13 +611,30 @@ slong _nmod_poly_hgcd_recursive(mp_ptr *M, slong *lenM,
             __attach_truncate(s, lens, b2, lenb2, k);
             __attach_truncate(t, lent, d, lend, k);
 
-            __mul(B, *lenB, S[2], lenS[2], s, lens);
-            __mul(T0, lenT0, S[0], lenS[0], t, lent);
-
-            if (sgnS < 0)
-                __sub(B, *lenB, B, *lenB, T0, lenT0);
+            if (_nmod_poly_hgcd_use_NTT(FLINT_MIN(lenS[0], lens), 
+                                        lenS[0] + lens - 1, mod))
+            {
+                __mat_vec_mul_NTT(B, lenB, A, lenA, S, lenS, 
+                                  s, lens, t, lent, sgnS, T0, mod);
+            }
             else
-                __sub(B, *lenB, T0, lenT0, B, *lenB);
+            {
+                __mul(B, *lenB, S[2], lenS[2], s, lens);
+                __mul(T0, lenT0, S[0], lenS[0], t, lent);
+
+                if (sgnS < 0)
+                    __sub(B, *lenB, B, *lenB, T0, lenT0);
+                else
+                    __sub(B, *lenB, T0, lenT0, B, *lenB);
+
+                __mul(A, *lenA, S[3], lenS[3], s, lens);
+                __mul(T0, lenT0, S[1], lenS[1], t, lent);
+
+                if (sgnS < 0)
+                    __sub(A, *lenA, T0, lenT0, A, *lenA);
+                else
+                    __sub(A, *lenA, A, *lenA, T0, lenT0);
+            }
 
             flint_mpn_zero(B + *lenB, k + lenb3 - *lenB);
             __attach_shift(b4, lenb4, B, *lenB, k);
@@ -560,14 +642,6 @@ slong _nmod_poly_hgcd_recursive(mp_ptr *M, slong *lenM,
             *lenB = FLINT_MAX(k + lenb3, *lenB);
             MPN_NORM(B, *lenB);
 
-            __mul(A, *lenA, S[3], lenS[3], s, lens);
-            __mul(T0, lenT0, S[1], lenS[1], t, lent);
-
-            if (sgnS < 0)
-                __sub(A, *lenA, T0, lenT0, A, *lenA);
-            else
-                __sub(A, *lenA, A, *lenA, T0, lenT0);
-
             flint_mpn_zero(A + *lenA, k + lena3 - *lenA);
             __attach_shift(a4, lena4, A, *lenA, k);
             __add(a4, lena4, a4, lena4, a3, lena3);
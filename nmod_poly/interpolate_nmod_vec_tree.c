@@ -0,0 +1,48 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+void nmod_poly_interpolate_nmod_vec_tree(nmod_poly_t poly, mp_srcptr ys,
+                                                    const nmod_poly_tree_t T)
+{
+    if (T->len == 0)
+    {
+        nmod_poly_zero(poly);
+        return;
+    }
+
+    if (T->weights == NULL)
+    {
+        flint_printf("Exception (nmod_poly_interpolate_nmod_vec_tree). "
+                     "Points not distinct modulo a factor of the modulus.\n");
+        abort();
+    }
+
+    nmod_poly_fit_length(poly, T->len);
+    _nmod_poly_interpolate_nmod_vec_fast_precomp(poly->coeffs, ys, T->tree,
+                                               T->weights, T->len, T->mod);
+    poly->length = T->len;
+    _nmod_poly_normalise(poly);
+}
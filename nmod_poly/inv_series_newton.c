@@ -34,41 +34,45 @@
 
 #define NMOD_POLY_INV_NEWTON_CUTOFF 400
 
+void
+_nmod_poly_inv_series_lift(mp_ptr Qinv, mp_srcptr Q,
+                                      slong m, slong n, nmod_t mod)
+{
+    mp_ptr W;
+    SCRATCH_INIT;
+
+    SCRATCH_START;
+
+    W = SCRATCH_ALLOC((n - m) * sizeof(mp_limb_t));
+
+    /* the low m coefficients of Q*Qinv are 1, 0, ..., 0 */
+    _nmod_poly_mulmid(W, Q + 1, n - 1, Qinv, m, mod);
+    _nmod_poly_mullow(Qinv + m, Qinv, m, W, n - m, n - m, mod);
+    _nmod_vec_neg(Qinv + m, Qinv + m, n - m, mod);
+
+    SCRATCH_END;
+}
+
 void 
 _nmod_poly_inv_series_newton(mp_ptr Qinv, mp_srcptr Q, slong n, nmod_t mod)
 {
     if (n < NMOD_POLY_INV_NEWTON_CUTOFF)
     {
         _nmod_poly_inv_series_basecase(Qinv, Q, n, mod);
+        return;
     }
-    else
-    {
-        slong *a, i, m;
-        mp_ptr W;
 
-        for (i = 1; (WORD(1) << i) < n; i++) ;
+    FLINT_NEWTON_INIT(NMOD_POLY_INV_NEWTON_CUTOFF, n)
 
-        W = flint_malloc(n * sizeof(mp_limb_t) + i * sizeof(slong));
-        a = (slong *) (W + n);
+    FLINT_NEWTON_BASECASE(n0)
+    _nmod_poly_inv_series_basecase(Qinv, Q, n0, mod);
+    FLINT_NEWTON_END_BASECASE
 
-        a[i = 0] = n;
-        while (n >= NMOD_POLY_INV_NEWTON_CUTOFF)
-            a[++i] = (n = (n + 1) / 2);
-
-        _nmod_poly_inv_series_basecase(Qinv, Q, n, mod);
+    FLINT_NEWTON_LOOP(m, n1)
+    _nmod_poly_inv_series_lift(Qinv, Q, m, n1, mod);
+    FLINT_NEWTON_END_LOOP
 
-        for (i--; i >= 0; i--)
-        {
-            m = n;
-            n = a[i];
-
-            _nmod_poly_mullow(W, Q, n, Qinv, m, n, mod);
-            _nmod_poly_mullow(Qinv + m, Qinv, m, W + m, n - m, n - m, mod);
-            _nmod_vec_neg(Qinv + m, Qinv + m, n - m, mod);
-        }
-
-        flint_free(W);
-    }
+    FLINT_NEWTON_END
 }
 
 void
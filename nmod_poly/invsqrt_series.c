@@ -28,51 +28,42 @@
 #include "nmod_poly.h"
 #include "ulong_extras.h"
 
-static void 
-__nmod_poly_invsqrt_series_prealloc(mp_ptr g, 
-                                    mp_srcptr h, mp_ptr t, mp_ptr u,
-                                    slong n, nmod_t mod)
+void _nmod_poly_invsqrt_series(mp_ptr g, mp_srcptr h, slong n, nmod_t mod)
 {
-    const int alloc = (t == NULL);
-    const slong m    = (n + 1) / 2;
+    mp_ptr t, u;
     mp_limb_t c;
 
+    g[0] = UWORD(1);
     if (n == 1)
-    {
-        g[0] = UWORD(1);
         return;
-    }
 
-    if (alloc)
-    {
-        t = _nmod_vec_init(n);
-        u = _nmod_vec_init(n);
-    }
+    t = _nmod_vec_init(n);
+    u = _nmod_vec_init(n);
+    c = n_invmod(mod.n - UWORD(2), mod.n);
 
-    __nmod_poly_invsqrt_series_prealloc(g, h, t, u, m, mod);
+    FLINT_NEWTON_INIT(1, n)
 
-    _nmod_vec_zero(g + m, n - m);
+    FLINT_NEWTON_BASECASE(n0)
+    (void) n0;
+    FLINT_NEWTON_END_BASECASE
 
-    _nmod_poly_mul(t, g, m, g, m, mod);
-    if (2*m - 1 < n)
-        t[n-1] = UWORD(0);
+    FLINT_NEWTON_LOOP(m, n1)
 
-    _nmod_poly_mullow(u, t, n, g, n, n, mod);
-    _nmod_poly_mullow(t, u, n, h, n, n, mod);
+    /* t := h g + O(x^n1), then u := (g t)_[m-1, n1), whose entries from
+       the second on are those of h g^2 - 1 */
+    _nmod_poly_mullow(t, h, n1, g, m, n1, mod);
+    _nmod_poly_mulmid(u, t, n1, g, m, mod);
 
-    c = n_invmod(mod.n - UWORD(2), mod.n);
-    _nmod_vec_scalar_mul_nmod(g + m, t + m, n - m, c, mod);
+    /* g := g - g (h g^2 - 1) / 2 */
+    _nmod_poly_mullow(g + m, g, n1 - m, u + 1, n1 - m, n1 - m, mod);
+    _nmod_vec_scalar_mul_nmod(g + m, g + m, n1 - m, c, mod);
 
-    if (alloc)
-    {
-        _nmod_vec_clear(t);
-        _nmod_vec_clear(u);
-    }
-}
+    FLINT_NEWTON_END_LOOP
 
-void _nmod_poly_invsqrt_series(mp_ptr g, mp_srcptr h, slong n, nmod_t mod)
-{
-    __nmod_poly_invsqrt_series_prealloc(g, h, NULL, NULL, n, mod);
+    FLINT_NEWTON_END
+
+    _nmod_vec_clear(t);
+    _nmod_vec_clear(u);
 }
 
 void nmod_poly_invsqrt_series(nmod_poly_t g, const nmod_poly_t h, slong n)
@@ -32,19 +32,18 @@
 void
 _nmod_poly_log_series(mp_ptr res, mp_srcptr f, slong n, nmod_t mod)
 {
-    mp_ptr f_diff;
-    mp_ptr f_inv;
+    mp_ptr f_diff, t;
 
     f_diff = _nmod_vec_init(n);
-    f_inv = _nmod_vec_init(n);
+    t = _nmod_vec_init(n);
 
-    _nmod_poly_derivative(f_diff, f, n, mod); f_diff[n-1] = UWORD(0);
-    _nmod_poly_inv_series(f_inv, f, n, mod);
-    _nmod_poly_mullow(res, f_diff, n - 1, f_inv, n - 1, n - 1, mod);
-    _nmod_poly_integral(res, res, n, mod);
+    /* log(f) = integral(f'/f) */
+    _nmod_poly_derivative(f_diff, f, n, mod);
+    _nmod_poly_div_series(t, f_diff, f, n - 1, mod);
+    _nmod_poly_integral(res, t, n, mod);
 
     _nmod_vec_clear(f_diff);
-    _nmod_vec_clear(f_inv);
+    _nmod_vec_clear(t);
 }
 
 void
@@ -0,0 +1,201 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "mpn_extras.h"
+#include "fft.h"
+
+/* C[i k + j] = A[2 i] B[j] + A[2 i + 1] B[k + j], one product at a time */
+static void
+_nmod_poly_mat22_mul_classical(mp_ptr * C, slong * lenC,
+          mp_srcptr * A, const slong * lenA, mp_srcptr * B,
+                           const slong * lenB, slong k, mp_ptr T, nmod_t mod)
+{
+    slong i, j, o, lenT;
+    mp_srcptr a, b;
+
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < k; j++)
+        {
+            o = i*k + j;
+            lenC[o] = 0;
+
+            if (lenA[2*i] != 0 && lenB[j] != 0)
+            {
+                a = A[2*i];
+                b = B[j];
+                lenC[o] = lenA[2*i] + lenB[j] - 1;
+
+                if (lenA[2*i] >= lenB[j])
+                    _nmod_poly_mul(C[o], a, lenA[2*i], b, lenB[j], mod);
+                else
+                    _nmod_poly_mul(C[o], b, lenB[j], a, lenA[2*i], mod);
+            }
+
+            if (lenA[2*i + 1] != 0 && lenB[k + j] != 0)
+            {
+                a = A[2*i + 1];
+                b = B[k + j];
+                lenT = lenA[2*i + 1] + lenB[k + j] - 1;
+
+                if (lenA[2*i + 1] >= lenB[k + j])
+                    _nmod_poly_mul(T, a, lenA[2*i + 1], b, lenB[k + j], mod);
+                else
+                    _nmod_poly_mul(T, b, lenB[k + j], a, lenA[2*i + 1], mod);
+
+                _nmod_poly_add(C[o], C[o], lenC[o], T, lenT, mod);
+                lenC[o] = FLINT_MAX(lenC[o], lenT);
+            }
+
+            MPN_NORM(C[o], lenC[o]);
+        }
+    }
+}
+
+void _nmod_poly_mat22_mul_NTT(mp_ptr * C, slong * lenC,
+          mp_srcptr * A, const slong * lenA, mp_srcptr * B,
+                                  const slong * lenB, slong k, nmod_t mod)
+{
+    slong i, j, o, lmax = 0, nmin = 0;
+    mp_ptr T;
+#if FFT_NTT
+    mp_size_t na[4], nb[4], N;
+    mp_limb_t * res[4*FFT_NTT_NUM_PRIMES];
+    mp_limb_t * r[FFT_NTT_NUM_PRIMES];
+    mp_limb_t * buf, g;
+    mp_bitcnt_t bits, depth;
+    fft_ntt_t F;
+    int np;
+#endif
+
+    /* the length of each product, and the largest inner dimension */
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < k; j++)
+        {
+            o = i*k + j;
+            lenC[o] = 0;
+
+            if (lenA[2*i] != 0 && lenB[j] != 0)
+            {
+                lenC[o] = lenA[2*i] + lenB[j] - 1;
+                nmin = FLINT_MAX(nmin, FLINT_MIN(lenA[2*i], lenB[j]));
+            }
+
+            if (lenA[2*i + 1] != 0 && lenB[k + j] != 0)
+            {
+                lenC[o] = FLINT_MAX(lenC[o],
+                                    lenA[2*i + 1] + lenB[k + j] - 1);
+                nmin = FLINT_MAX(nmin, FLINT_MIN(lenA[2*i + 1], lenB[k + j]));
+            }
+
+            lmax = FLINT_MAX(lmax, lenC[o]);
+        }
+    }
+
+    if (lmax == 0)
+        return;
+
+#if FFT_NTT
+    depth = FLINT_CLOG2(lmax);
+
+    if (depth <= FFT_NTT_MAX_DEPTH)
+    {
+        N = WORD(1) << depth;
+
+        for (i = 0; i < 4; i++)
+            na[i] = lenA[i];
+        for (i = 0; i < 2*k; i++)
+            nb[i] = lenB[i];
+
+        if (_nmod_poly_ntt_direct(&g, mod, depth))
+        {
+            buf = flint_malloc(2*k*N*sizeof(mp_limb_t));
+            for (o = 0; o < 2*k; o++)
+                res[o] = buf + o*N;
+
+            fft_ntt_init(F, mod.n, g, depth);
+            fft_ntt_mat22_mul(res, A, na, B, nb, k, F);
+            fft_ntt_clear(F);
+
+            for (o = 0; o < 2*k; o++)
+                for (i = 0; i < lenC[o]; i++)
+                    C[o][i] = (res[o][i] >= mod.n) ? res[o][i] - mod.n
+                                                   : res[o][i];
+        }
+        else
+        {
+            /* the coefficients are below 2 nmin (n - 1)^2 */
+            bits = 2*FLINT_BIT_COUNT(mod.n - 1) + FLINT_BIT_COUNT(nmin) + 1;
+            np = (bits + 48)/49;
+
+            buf = flint_malloc(2*k*np*N*sizeof(mp_limb_t));
+            for (o = 0; o < 2*k*np; o++)
+                res[o] = buf + o*N;
+
+            fft_ntt_mat22_mul_primes(res, A, na, B, nb, k, depth, np);
+
+            for (o = 0; o < 2*k; o++)
+            {
+                for (i = 0; i < np; i++)
+                    r[i] = res[2*k*i + o];
+
+                _nmod_poly_ntt_crt(C[o], r, lenC[o], np, mod);
+            }
+        }
+
+        flint_free(buf);
+
+        for (o = 0; o < 2*k; o++)
+            MPN_NORM(C[o], lenC[o]);
+
+        return;
+    }
+#endif
+
+    T = _nmod_vec_init(lmax);
+    _nmod_poly_mat22_mul_classical(C, lenC, A, lenA, B, lenB, k, T, mod);
+    _nmod_vec_clear(T);
+}
+
+int _nmod_poly_hgcd_use_NTT(slong len, slong lmax, nmod_t mod)
+{
+#if FFT_NTT
+    mp_bitcnt_t bits;
+    mp_size_t limbs;
+
+    if (len < NMOD_POLY_HGCD_NTT_CUTOFF ||
+        FLINT_CLOG2(lmax) > FFT_NTT_MAX_DEPTH)
+        return 0;
+
+    /* the size of the products under Kronecker substitution, in limbs */
+    bits = 2*FLINT_BIT_COUNT(mod.n - 1) + FLINT_BIT_COUNT(len) + 1;
+    limbs = (len*bits - 1)/FLINT_BITS + 1;
+
+    return fft_mul_use_ntt(limbs, limbs);
+#else
+    return 0;
+#endif
+}
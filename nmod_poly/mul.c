@@ -28,6 +28,7 @@
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "fft.h"
 
 void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1, 
                              mp_srcptr poly2, slong len2, nmod_t mod)
@@ -45,6 +46,10 @@ void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1,
 
     if (2 * bits + bits2 <= FLINT_BITS && len1 + len2 < 16)
         _nmod_poly_mul_classical(res, poly1, len1, poly2, len2, mod);
+#if FFT_NTT
+    else if (len2 >= NMOD_POLY_MUL_NTT_CUTOFF)
+        _nmod_poly_mul_NTT(res, poly1, len1, poly2, len2, mod);
+#endif
     else if (bits * len2 > 2000)
         _nmod_poly_mul_KS4(res, poly1, len1, poly2, len2, mod);
     else if (bits * len2 > 200)
@@ -29,6 +29,7 @@
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "mpn_extras.h"
 
 void
 _nmod_poly_mul_KS(mp_ptr out, mp_srcptr in1, slong len1,
@@ -36,6 +37,7 @@ _nmod_poly_mul_KS(mp_ptr out, mp_srcptr in1, slong len1,
 {
     slong len_out = len1 + len2 - 1, limbs1, limbs2;
     mp_ptr mpn1, mpn2, res;
+    SCRATCH_INIT;
 
     if (bits == 0)
     {
@@ -50,24 +52,22 @@ _nmod_poly_mul_KS(mp_ptr out, mp_srcptr in1, slong len1,
     limbs1 = (len1 * bits - 1) / FLINT_BITS + 1;
     limbs2 = (len2 * bits - 1) / FLINT_BITS + 1;
 
-    mpn1 = (mp_ptr) flint_malloc(sizeof(mp_limb_t) * limbs1);
-    mpn2 = (in1 == in2) ? mpn1 : (mp_ptr) flint_malloc(sizeof(mp_limb_t) * limbs2);
+    SCRATCH_START;
+
+    mpn1 = (mp_ptr) SCRATCH_ALLOC(sizeof(mp_limb_t) * limbs1);
+    mpn2 = (in1 == in2) ? mpn1 : (mp_ptr) SCRATCH_ALLOC(sizeof(mp_limb_t) * limbs2);
 
     _nmod_poly_bit_pack(mpn1, in1, len1, bits);
     if (in1 != in2)
         _nmod_poly_bit_pack(mpn2, in2, len2, bits);
 
-    res = (mp_ptr) flint_malloc(sizeof(mp_limb_t) * (limbs1 + limbs2));
+    res = (mp_ptr) SCRATCH_ALLOC(sizeof(mp_limb_t) * (limbs1 + limbs2));
 
-    mpn_mul(res, mpn1, limbs1, mpn2, limbs2);
+    flint_mpn_mul(res, mpn1, limbs1, mpn2, limbs2);
 
     _nmod_poly_bit_unpack(out, len_out, res, bits, mod);
-    
-    flint_free(mpn2);
-    if (in1 != in2)
-        flint_free(mpn1);
 
-    flint_free(res);
+    SCRATCH_END;
 }
 
 void
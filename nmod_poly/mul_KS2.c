@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "mpn_extras.h"
 
 /*
    Multiplication/squaring using Kronecker substitution at 2^b and -2^b.
@@ -150,8 +151,8 @@ _nmod_poly_mul_KS2(mp_ptr res, mp_srcptr op1, slong n1,
          compute |h(-B)| = |f1(-B)| * |f2(-B)|
          v3m_neg is set if h(-B) is negative
       */
-      mpn_mul(v3m, v1m, k1, v2m, k2);
-      mpn_mul(v3p, v1p, k1, v2p, k2);
+      flint_mpn_mul(v3m, v1m, k1, v2m, k2);
+      flint_mpn_mul(v3p, v1p, k1, v2p, k2);
    }
    else
    {
@@ -172,8 +173,8 @@ _nmod_poly_mul_KS2(mp_ptr res, mp_srcptr op1, slong n1,
          compute h(-B) = f1(-B)^2
          v3m_neg is cleared (since f1(-B)^2 is never negative)
       */
-      mpn_mul(v3m, v1m, k1, v1m, k1);
-      mpn_mul(v3p, v1p, k1, v1p, k1);
+      flint_mpn_mul(v3m, v1m, k1, v1m, k1);
+      flint_mpn_mul(v3p, v1p, k1, v1p, k1);
       v3m_neg = 0;
    }
    
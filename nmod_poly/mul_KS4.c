@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "mpn_extras.h"
 
 /*
    Multiplication/squaring using Kronecker substitution at 2^b, -2^b,
@@ -184,8 +185,8 @@ _nmod_poly_mul_KS4(mp_ptr res, mp_srcptr op1, slong n1,
             and |h(-B)| = |f1(-B)| * |f2(-B)|
          hn_neg is set if h(-B) is negative
       */
-      mpn_mul(v3pn, v1pn, k1, v2pn, k2);
-      mpn_mul(v3mn, v1mn, k1, v2mn, k2);
+      flint_mpn_mul(v3pn, v1pn, k1, v2pn, k2);
+      flint_mpn_mul(v3mn, v1mn, k1, v2mn, k2);
    }
    else
    {
@@ -207,8 +208,8 @@ _nmod_poly_mul_KS4(mp_ptr res, mp_srcptr op1, slong n1,
             and h(-B) = |f1(-B)|^2
          hn_neg is cleared since h(-B) is never negative
       */
-      mpn_mul(v3pn, v1pn, k1, v1pn, k1);
-      mpn_mul(v3mn, v1mn, k1, v1mn, k1);
+      flint_mpn_mul(v3pn, v1pn, k1, v1pn, k1);
+      flint_mpn_mul(v3mn, v1mn, k1, v1mn, k1);
       v3m_neg = 0;
    }
 
@@ -284,8 +285,8 @@ _nmod_poly_mul_KS4(mp_ptr res, mp_srcptr op1, slong n1,
                          |B^(n1-1) * f1(-1/B)| * |B^(n2-1) * f2(-1/B)|
          hr_neg is set if h(-1/B) is negative
       */
-      mpn_mul(v3pr, v1pr, k1, v2pr, k2);
-      mpn_mul(v3mr, v1mr, k1, v2mr, k2);
+      flint_mpn_mul(v3pr, v1pr, k1, v2pr, k2);
+      flint_mpn_mul(v3mr, v1mr, k1, v2mr, k2);
    }
    else
    {
@@ -309,8 +310,8 @@ _nmod_poly_mul_KS4(mp_ptr res, mp_srcptr op1, slong n1,
              and B^(n3-1) * h(-1/B) = |B^(n1-1) * f1(-1/B)|^2
          hr_neg is cleared since h(-1/B) is never negative
       */
-      mpn_mul(v3pr, v1pr, k1, v1pr, k1);
-      mpn_mul(v3mr, v1mr, k1, v1mr, k1);
+      flint_mpn_mul(v3pr, v1pr, k1, v1pr, k1);
+      flint_mpn_mul(v3mr, v1mr, k1, v1mr, k1);
       v3m_neg = 0;
    }
 
@@ -29,6 +29,7 @@
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "mpn_extras.h"
 
 void
 _nmod_poly_mullow_KS(mp_ptr out, mp_srcptr in1, slong len1,
@@ -62,7 +63,7 @@ _nmod_poly_mullow_KS(mp_ptr out, mp_srcptr in1, slong len1,
 
     res = (mp_ptr) flint_malloc(sizeof(mp_limb_t) * (limbs1 + limbs2));
 
-    mpn_mul(res, mpn1, limbs1, mpn2, limbs2);
+    flint_mpn_mul(res, mpn1, limbs1, mpn2, limbs2);
 
     _nmod_poly_bit_unpack(out, n, res, bits, mod);
     
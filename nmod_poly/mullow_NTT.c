@@ -0,0 +1,296 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "thread_pool.h"
+#include "fft.h"
+
+#if FFT_NTT
+
+/* x*c mod p where cpre = floor(c*2^64/p) */
+static __inline__ mp_limb_t
+_mulmod_shoup(mp_limb_t x, mp_limb_t c, mp_limb_t cpre, mp_limb_t p)
+{
+    mp_limb_t q, r;
+
+    umul_ppmm(q, r, x, cpre);
+    r = x*c - q*p;
+
+    return (r >= p) ? r - p : r;
+}
+
+static mp_limb_t _shoup_precomp(mp_limb_t c, mp_limb_t p)
+{
+    mp_limb_t q, r;
+    unsigned int norm;
+
+    count_leading_zeros(norm, p);
+    udiv_qrnnd(q, r, c << norm, 0, p << norm);
+
+    return q;
+}
+
+typedef struct
+{
+    mp_ptr res;
+    mp_limb_t ** r;
+    slong k0;
+    slong k1;
+    int np;
+    const mp_limb_t * inv;
+    const mp_limb_t * invpre;
+    const mp_limb_t * c;
+    nmod_t mod;
+} nmod_poly_ntt_crt_arg_t;
+
+/*
+   Garner's algorithm, as in mul_ntt, except that the mixed radix
+   representation y_0 + p_0 y_1 + p_0 p_1 y_2 + ... is evaluated modulo n,
+   given c[i] = p_0 ... p_{i-1} mod n
+*/
+static void * _nmod_poly_ntt_crt_worker(void * arg_ptr)
+{
+    nmod_poly_ntt_crt_arg_t * arg = (nmod_poly_ntt_crt_arg_t *) arg_ptr;
+    const mp_limb_t * primes = fft_ntt_primes;
+    mp_limb_t y[FFT_NTT_NUM_PRIMES];
+    mp_limb_t hi, lo, h, l, t, p;
+    slong k;
+    int i, j, np = arg->np;
+
+    for (k = arg->k0; k < arg->k1; k++)
+    {
+        t = arg->r[0][k];
+        y[0] = (t >= primes[0]) ? t - primes[0] : t;
+
+        for (i = 1; i < np; i++)
+        {
+            p = primes[i];
+            t = arg->r[i][k];
+            t = (t >= p) ? t - p : t;
+
+            for (j = 0; j < i; j++)
+            {
+                /* y_j < p_j < 2p_i */
+                l = (y[j] >= p) ? y[j] - p : y[j];
+                t = (t >= l) ? t - l : t - l + p;
+                t = _mulmod_shoup(t, arg->inv[i*np + j],
+                                     arg->invpre[i*np + j], p);
+            }
+
+            y[i] = t;
+        }
+
+        /* the terms are below 2^114, so the sum fits in two limbs */
+        hi = 0;
+        lo = y[0];
+        for (i = 1; i < np; i++)
+        {
+            umul_ppmm(h, l, arg->c[i], y[i]);
+            add_ssaaaa(hi, lo, hi, lo, h, l);
+        }
+
+        NMOD2_RED2(arg->res[k], hi, lo, arg->mod);
+    }
+
+    return NULL;
+}
+
+void _nmod_poly_ntt_crt(mp_ptr res, mp_limb_t ** r, slong n, int np,
+                                                               nmod_t mod)
+{
+    mp_limb_t inv[FFT_NTT_NUM_PRIMES*FFT_NTT_NUM_PRIMES];
+    mp_limb_t invpre[FFT_NTT_NUM_PRIMES*FFT_NTT_NUM_PRIMES];
+    mp_limb_t c[FFT_NTT_NUM_PRIMES];
+    nmod_poly_ntt_crt_arg_t * crt;
+    slong i, j, num_threads;
+
+    c[0] = 1;
+    for (i = 1; i < np; i++)
+    {
+        c[i] = n_mulmod2_preinv(c[i - 1], fft_ntt_primes[i - 1],
+                                                        mod.n, mod.ninv);
+
+        for (j = 0; j < i; j++)
+        {
+            inv[i*np + j] = n_invmod(fft_ntt_primes[j] % fft_ntt_primes[i],
+                                                           fft_ntt_primes[i]);
+            invpre[i*np + j] = _shoup_precomp(inv[i*np + j], fft_ntt_primes[i]);
+        }
+    }
+
+    num_threads = flint_get_num_threads();
+    num_threads = FLINT_MAX(WORD(1), FLINT_MIN(num_threads, n/1024));
+    crt = flint_malloc(num_threads*sizeof(nmod_poly_ntt_crt_arg_t));
+
+    for (i = 0; i < num_threads; i++)
+    {
+        crt[i].res = res;
+        crt[i].r = r;
+        crt[i].k0 = (n*i)/num_threads;
+        crt[i].k1 = (n*(i + 1))/num_threads;
+        crt[i].np = np;
+        crt[i].inv = inv;
+        crt[i].invpre = invpre;
+        crt[i].c = c;
+        crt[i].mod = mod;
+    }
+
+    flint_parallel_map(_nmod_poly_ntt_crt_worker, crt,
+                               sizeof(nmod_poly_ntt_crt_arg_t), num_threads);
+
+    flint_free(crt);
+}
+
+int _nmod_poly_ntt_direct(mp_limb_t * g, nmod_t mod, mp_bitcnt_t depth)
+{
+    mp_limb_t p = mod.n;
+
+    if (depth == 0 || p >= (UWORD(1) << 50) ||
+        ((p - 1) & ((UWORD(1) << depth) - 1)) != 0 || !n_is_prime(p))
+        return 0;
+
+    for (*g = 2; n_powmod2_preinv(*g, (p - 1)/2, p, mod.ninv) != p - 1; (*g)++) ;
+
+    return 1;
+}
+
+void _nmod_poly_conv_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                         mp_srcptr poly2, slong len2, mp_bitcnt_t depth,
+                         slong start, slong n, nmod_t mod)
+{
+    mp_bitcnt_t bits;
+    slong i, N = WORD(1) << depth;
+    mp_limb_t * r[FFT_NTT_NUM_PRIMES];
+    mp_limb_t * buf, g;
+    fft_ntt_t T;
+    int np;
+
+    if (_nmod_poly_ntt_direct(&g, mod, depth))
+    {
+        buf = flint_malloc(N*sizeof(mp_limb_t));
+
+        fft_ntt_init(T, mod.n, g, depth);
+        fft_ntt_mul(buf, poly1, len1, poly2, len2, T);
+        fft_ntt_clear(T);
+
+        for (i = 0; i < n; i++)
+            res[i] = (buf[start + i] >= mod.n) ? buf[start + i] - mod.n
+                                               : buf[start + i];
+
+        flint_free(buf);
+        return;
+    }
+
+    /*
+       the coefficients of the convolution are below min(len1, len2)*(n - 1)^2
+       as long as N >= max(len1, len2), and each prime exceeds 2^49
+    */
+    bits = 2*FLINT_BIT_COUNT(mod.n - 1) + FLINT_BIT_COUNT(FLINT_MIN(len1, len2));
+    np = (bits + 48)/49;
+    np = FLINT_MAX(np, 1);
+
+    buf = flint_malloc(np*N*sizeof(mp_limb_t));
+    for (i = 0; i < np; i++)
+        r[i] = buf + i*N;
+
+    fft_ntt_mul_primes(r, poly1, len1, poly2, len2, depth, np);
+
+    for (i = 0; i < np; i++)
+        r[i] += start;
+
+    _nmod_poly_ntt_crt(res, r, n, np, mod);
+
+    flint_free(buf);
+}
+
+void _nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                           mp_srcptr poly2, slong len2, slong n, nmod_t mod)
+{
+    mp_bitcnt_t depth;
+
+    len1 = FLINT_MIN(len1, n);
+    len2 = FLINT_MIN(len2, n);
+
+    /* the cyclic convolution must not wrap around */
+    depth = FLINT_CLOG2(len1 + len2 - 1);
+
+    if (depth > FFT_NTT_MAX_DEPTH)
+        _nmod_poly_mullow_KS(res, poly1, len1, poly2, len2, 0, n, mod);
+    else
+        _nmod_poly_conv_NTT(res, poly1, len1, poly2, len2, depth, 0, n, mod);
+}
+
+#else
+
+void _nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                           mp_srcptr poly2, slong len2, slong n, nmod_t mod)
+{
+    _nmod_poly_mullow_KS(res, poly1, len1, poly2, len2, 0, n, mod);
+}
+
+#endif
+
+void nmod_poly_mullow_NTT(nmod_poly_t res, const nmod_poly_t poly1,
+                                           const nmod_poly_t poly2, slong n)
+{
+    slong len_out;
+
+    if (poly1->length == 0 || poly2->length == 0 || n == 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    len_out = poly1->length + poly2->length - 1;
+    if (n > len_out)
+        n = len_out;
+
+    if (res == poly1 || res == poly2)
+    {
+        nmod_poly_t temp;
+        nmod_poly_init2_preinv(temp, poly1->mod.n, poly1->mod.ninv, n);
+        if (poly1->length >= poly2->length)
+            _nmod_poly_mullow_NTT(temp->coeffs, poly1->coeffs, poly1->length,
+                           poly2->coeffs, poly2->length, n, poly1->mod);
+        else
+            _nmod_poly_mullow_NTT(temp->coeffs, poly2->coeffs, poly2->length,
+                           poly1->coeffs, poly1->length, n, poly1->mod);
+        nmod_poly_swap(res, temp);
+        nmod_poly_clear(temp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, n);
+        if (poly1->length >= poly2->length)
+            _nmod_poly_mullow_NTT(res->coeffs, poly1->coeffs, poly1->length,
+                           poly2->coeffs, poly2->length, n, poly1->mod);
+        else
+            _nmod_poly_mullow_NTT(res->coeffs, poly2->coeffs, poly2->length,
+                           poly1->coeffs, poly1->length, n, poly1->mod);
+    }
+
+    res->length = n;
+    _nmod_poly_normalise(res);
+}
@@ -0,0 +1,110 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "fft.h"
+
+void
+_nmod_poly_mulmid_KS(mp_ptr out, mp_srcptr in1, slong len1,
+            mp_srcptr in2, slong len2, mp_bitcnt_t bits, nmod_t mod)
+{
+    slong limbs1, limbs2, limbs, off;
+    mp_ptr mpn1, mpn2, res;
+
+    if (bits == 0)
+    {
+        mp_bitcnt_t bits1, bits2, loglen;
+        bits1  = _nmod_vec_max_bits(in1, len1);
+        bits2  = _nmod_vec_max_bits(in2, len2);
+        loglen = FLINT_BIT_COUNT(len2);
+
+        /* one spare bit absorbs the carry from the wrapped low product */
+        bits = bits1 + bits2 + loglen + 1;
+    }
+
+    limbs1 = (len1 * bits - 1) / FLINT_BITS + 1;
+    limbs2 = (len2 * bits - 1) / FLINT_BITS + 1;
+
+    /*
+       Modulo 2^B - 1 with B >= (len1 + 1)*bits, the part of the product
+       above B wraps onto the coefficients below len2 - 2 only, leaving
+       coefficients len2 - 1 to len1 - 1 intact.
+    */
+    limbs = fft_adjust_limbs_2expm1(((len1 + 1) * bits - 1) / FLINT_BITS + 1);
+
+    mpn1 = (mp_ptr) flint_malloc(sizeof(mp_limb_t) * (limbs1 + limbs2 + limbs));
+    mpn2 = mpn1 + limbs1;
+    res = mpn2 + limbs2;
+
+    _nmod_poly_bit_pack(mpn1, in1, len1, bits);
+    _nmod_poly_bit_pack(mpn2, in2, len2, bits);
+
+    flint_mpn_mulmod_2expm1(res, mpn1, limbs1, mpn2, limbs2, limbs);
+
+    off = (len2 - 1) * bits;
+    if (off % FLINT_BITS != 0)
+        mpn_rshift(res, res + off / FLINT_BITS, limbs - off / FLINT_BITS,
+                                                        off % FLINT_BITS);
+    else
+        flint_mpn_copyi(res, res + off / FLINT_BITS, limbs - off / FLINT_BITS);
+
+    _nmod_poly_bit_unpack(out, len1 - len2 + 1, res, bits, mod);
+
+    flint_free(mpn1);
+}
+
+void
+nmod_poly_mulmid_KS(nmod_poly_t res,
+                 const nmod_poly_t poly1, const nmod_poly_t poly2,
+                 mp_bitcnt_t bits)
+{
+    slong len1 = poly1->length, len2 = poly2->length, len_out;
+
+    if (len2 == 0 || len1 < len2)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    len_out = len1 - len2 + 1;
+
+    if (res == poly1 || res == poly2)
+    {
+        nmod_poly_t temp;
+        nmod_poly_init2_preinv(temp, poly1->mod.n, poly1->mod.ninv, len_out);
+        _nmod_poly_mulmid_KS(temp->coeffs, poly1->coeffs, len1,
+                             poly2->coeffs, len2, bits, poly1->mod);
+        nmod_poly_swap(res, temp);
+        nmod_poly_clear(temp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, len_out);
+        _nmod_poly_mulmid_KS(res->coeffs, poly1->coeffs, len1,
+                             poly2->coeffs, len2, bits, poly1->mod);
+    }
+
+    res->length = len_out;
+    _nmod_poly_normalise(res);
+}
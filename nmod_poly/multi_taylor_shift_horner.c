@@ -0,0 +1,53 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+void
+_nmod_poly_multi_taylor_shift_horner(mp_ptr poly, mp_srcptr c, slong len,
+                                                    const nmod_multi_t M)
+{
+    slong i, k = M->num;
+    int one = 1, minus_one = 1;
+
+    for (i = 0; i < k; i++)
+    {
+        one &= (c[i] == 1);
+        minus_one &= (c[i] == M->mod[i].n - 1);
+    }
+
+    /* the entries are processed in increasing order, so each step can
+       read poly[j + 1] while writing poly[j] */
+    for (i = len - 2; i >= 0; i--)
+    {
+        if (one)
+            _nmod_multi_vec_add(poly + i*k, poly + i*k, poly + (i + 1)*k,
+                                                          len - 1 - i, M);
+        else if (minus_one)
+            _nmod_multi_vec_sub(poly + i*k, poly + i*k, poly + (i + 1)*k,
+                                                          len - 1 - i, M);
+        else
+            _nmod_multi_vec_scalar_addmul(poly + i*k, poly + (i + 1)*k,
+                                                       len - 1 - i, c, M);
+    }
+}
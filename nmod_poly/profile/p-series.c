@@ -0,0 +1,124 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+#include "profiler.h"
+
+/*
+   Times the power series functions for lengths 10^3 to 10^7 and a 63 bit
+   prime modulus. Besides the time per call in seconds, the cost of each
+   function is printed relative to a single mullow of the same length.
+*/
+
+#define NUM_FUNCS 8
+
+const char * names[NUM_FUNCS] = {"inv", "div", "exp", "log",
+                                 "sqrt", "invsqrt", "tan", "atan"};
+
+void call_series(int k, mp_ptr r, mp_srcptr f, mp_srcptr g, mp_srcptr h,
+                                                        slong n, nmod_t mod)
+{
+    switch (k)
+    {
+        case 0: _nmod_poly_inv_series(r, f, n, mod); break;
+        case 1: _nmod_poly_div_series(r, g, f, n, mod); break;
+        case 2: _nmod_poly_exp_series(r, h, n, mod); break;
+        case 3: _nmod_poly_log_series(r, f, n, mod); break;
+        case 4: _nmod_poly_sqrt_series(r, f, n, mod); break;
+        case 5: _nmod_poly_invsqrt_series(r, f, n, mod); break;
+        case 6: _nmod_poly_tan_series(r, h, n, mod); break;
+        default: _nmod_poly_atan_series(r, h, n, mod); break;
+    }
+}
+
+int
+main(void)
+{
+    slong n;
+    int k;
+    nmod_t mod;
+
+    FLINT_TEST_INIT(state);
+
+    nmod_init(&mod, n_nextprime(UWORD(1) << (FLINT_BITS - 2), 1));
+
+    flint_printf("len\tmullow");
+    for (k = 0; k < NUM_FUNCS; k++)
+        flint_printf("\t%s", names[k]);
+    flint_printf("\n");
+
+    for (n = 1000; n <= 10000000; n *= 10)
+    {
+        mp_ptr f, g, h, r;
+        double t0, t[NUM_FUNCS];
+        timeit_t timer;
+        slong reps;
+
+        f = _nmod_vec_init(n);
+        g = _nmod_vec_init(n);
+        h = _nmod_vec_init(n);
+        r = _nmod_vec_init(2*n);
+
+        _nmod_vec_randtest(f, state, n, mod);
+        _nmod_vec_randtest(g, state, n, mod);
+        _nmod_vec_randtest(h, state, n, mod);
+        f[0] = UWORD(1);
+        h[0] = UWORD(0);
+
+        TIMEIT_REPEAT(timer, reps)
+            _nmod_poly_mullow(r, f, n, g, n, n, mod);
+        TIMEIT_END_REPEAT(timer, reps)
+        t0 = timer->wall*0.001/reps;
+
+        for (k = 0; k < NUM_FUNCS; k++)
+        {
+            TIMEIT_REPEAT(timer, reps)
+                call_series(k, r, f, g, h, n, mod);
+            TIMEIT_END_REPEAT(timer, reps)
+            t[k] = timer->wall*0.001/reps;
+        }
+
+        flint_printf("%wd\t%.3g", n, t0);
+        for (k = 0; k < NUM_FUNCS; k++)
+            flint_printf("\t%.3g", t[k]);
+        flint_printf("\n");
+
+        flint_printf("ratio\t1.0");
+        for (k = 0; k < NUM_FUNCS; k++)
+            flint_printf("\t%.1f", t[k]/t0);
+        flint_printf("\n");
+
+        _nmod_vec_clear(f);
+        _nmod_vec_clear(g);
+        _nmod_vec_clear(h);
+        _nmod_vec_clear(r);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    return 0;
+}
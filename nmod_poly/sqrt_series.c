@@ -32,12 +32,39 @@
 #include "ulong_extras.h"
 
 
+/*
+   The inverse square root y is only computed to half the length m.
+   Then g = h y + O(x^m), and the final Newton step for the square root is
+   g := g + y (h - g^2) / 2, in which h - g^2 = O(x^m).
+*/
 void
 _nmod_poly_sqrt_series(mp_ptr g, mp_srcptr h, slong n, nmod_t mod)
 {
-    mp_ptr t = _nmod_vec_init(n);
-    _nmod_poly_invsqrt_series(t, h, n, mod);
-    _nmod_poly_mullow(g, t, n, h, n, n, mod);
+    slong m = (n + 1) / 2;
+    mp_ptr y, t;
+
+    if (n == 1)
+    {
+        g[0] = UWORD(1);
+        return;
+    }
+
+    y = _nmod_vec_init(m);
+    t = _nmod_vec_init(n);
+
+    _nmod_poly_invsqrt_series(y, h, m, mod);
+    _nmod_poly_mullow(g, h, m, y, m, m, mod);
+
+    _nmod_poly_mullow(t, g, m, g, m, FLINT_MIN(n, 2*m - 1), mod);
+    if (2*m - 1 < n)
+        t[n - 1] = UWORD(0);
+    _nmod_vec_sub(t + m, h + m, t + m, n - m, mod);
+
+    _nmod_poly_mullow(g + m, y, n - m, t + m, n - m, n - m, mod);
+    _nmod_vec_scalar_mul_nmod(g + m, g + m, n - m,
+                                (mod.n + 1) / 2, mod);
+
+    _nmod_vec_clear(y);
     _nmod_vec_clear(t);
 }
 
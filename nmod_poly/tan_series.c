@@ -34,7 +34,7 @@ void
 _nmod_poly_tan_series(mp_ptr g, mp_srcptr h, slong n, nmod_t mod)
 {
     slong m;
-    mp_ptr t, u;
+    mp_ptr t, u, v;
 
     if (n <= 3)
     {
@@ -51,17 +51,24 @@ _nmod_poly_tan_series(mp_ptr g, mp_srcptr h, slong n, nmod_t mod)
 
     t = _nmod_vec_init(n);
     u = _nmod_vec_init(n);
+    v = _nmod_vec_init(n);
 
-    _nmod_poly_mul(u, g, m, g, m, mod);
+    /* u := 1 + g^2, shared by atan(g) = integral(g'/u) and the update */
+    _nmod_poly_mullow(u, g, m, g, m, FLINT_MIN(n, 2*m - 1), mod);
     u[0] = UWORD(1);
     if (2*m - 1 < n) u[n-1] = UWORD(0);
 
-    _nmod_poly_atan_series(t, g, n, mod);
-    _nmod_vec_sub(t + m, h + m, t + m, n - m, mod);
-    _nmod_poly_mullow(g + m, u, n, t + m, n - m, n - m, mod);
+    _nmod_poly_derivative(t, g, n, mod);
+    _nmod_poly_div_series(v, t, u, n - 1, mod);
+    _nmod_poly_integral(v, v, n, mod);
+
+    /* g := g + (1 + g^2) (h - atan(g)) */
+    _nmod_vec_sub(v + m, h + m, v + m, n - m, mod);
+    _nmod_poly_mullow(g + m, u, n - m, v + m, n - m, n - m, mod);
 
     _nmod_vec_clear(t);
     _nmod_vec_clear(u);
+    _nmod_vec_clear(v);
 }
 
 void
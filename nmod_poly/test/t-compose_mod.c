@@ -76,6 +76,48 @@ main(void)
         nmod_poly_clear(e);
     }
 
+    /* Lengths reaching the threaded algorithm */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c, d, e;
+        mp_limb_t m = n_randtest_prime(state, 0);
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        nmod_poly_init(a, m);
+        nmod_poly_init(b, m);
+        nmod_poly_init(c, m);
+        nmod_poly_init(d, m);
+        nmod_poly_init(e, m);
+
+        nmod_poly_randtest(a, state, 1+n_randint(state, 300));
+        nmod_poly_randtest(b, state, 1+n_randint(state, 300));
+        nmod_poly_randtest_not_zero(c, state, 1+n_randint(state, 300));
+
+        nmod_poly_compose_mod(d, a, b, c);
+        nmod_poly_compose(e, a, b);
+        nmod_poly_rem(e, e, c);
+
+        if (!nmod_poly_equal(d, e))
+        {
+            flint_printf("FAIL (threaded composition):\n");
+            nmod_poly_print(a); flint_printf("\n");
+            nmod_poly_print(b); flint_printf("\n");
+            nmod_poly_print(c); flint_printf("\n");
+            nmod_poly_print(d); flint_printf("\n");
+            nmod_poly_print(e); flint_printf("\n");
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+        nmod_poly_clear(d);
+        nmod_poly_clear(e);
+    }
+
+    flint_set_num_threads(1);
+
     /* Test aliasing of res and a */
     for (i = 0; i < 100 * flint_test_multiplier(); i++)
     {
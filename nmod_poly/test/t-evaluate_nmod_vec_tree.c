@@ -0,0 +1,114 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result = 1;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("evaluate_nmod_vec_tree....");
+    fflush(stdout);
+
+    /* Compare with evaluate_nmod_vec_iter, including the batch version */
+    for (i = 0; i < 300 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_struct * P;
+        nmod_poly_tree_t T;
+        mp_ptr x, y, * z;
+        mp_limb_t mod;
+        slong j, k, num, npoints;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_THREADED] =
+            n_randint(state, 2) ? n_randint(state, 256) : 1024;
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_PREINV] =
+            n_randint(state, 64);
+
+        mod = n_randtest_not_zero(state);
+        npoints = n_randint(state, (i % 20 == 0) ? 1500 : 150);
+        num = n_randint(state, 5) + 1;
+
+        P = flint_malloc(num * sizeof(nmod_poly_struct));
+        z = flint_malloc(num * sizeof(mp_ptr));
+        x = _nmod_vec_init(npoints);
+        y = _nmod_vec_init(npoints);
+
+        for (k = 0; k < num; k++)
+        {
+            nmod_poly_init(P + k, mod);
+            nmod_poly_randtest(P + k, state, n_randint(state, 2 * npoints + 2));
+            z[k] = _nmod_vec_init(npoints);
+        }
+
+        for (j = 0; j < npoints; j++)
+            x[j] = n_randint(state, mod);
+
+        nmod_poly_tree_init(T, x, npoints, mod);
+        nmod_poly_evaluate_nmod_vec_tree_batch(z, P, num, T);
+
+        for (k = 0; k < num; k++)
+        {
+            nmod_poly_evaluate_nmod_vec_iter(y, P + k, x, npoints);
+
+            result = _nmod_vec_equal(y, z[k], npoints);
+
+            if (result && k == 0)
+            {
+                nmod_poly_evaluate_nmod_vec_tree(z[k], P + k, T);
+                result = _nmod_vec_equal(y, z[k], npoints);
+            }
+
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("mod=%wu, npoints=%wd, k=%wd\n\n", mod, npoints, k);
+                nmod_poly_print(P + k), flint_printf("\n\n");
+                abort();
+            }
+        }
+
+        nmod_poly_tree_clear(T);
+        for (k = 0; k < num; k++)
+        {
+            nmod_poly_clear(P + k);
+            _nmod_vec_clear(z[k]);
+        }
+        flint_free(P);
+        flint_free(z);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+    }
+
+    flint_tune_reset();
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
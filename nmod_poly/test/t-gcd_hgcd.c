@@ -53,6 +53,10 @@ main(void)
         do n = n_randtest_not_zero(state);
         while (!n_is_probabprime(n));
 
+        /* use the transform based matrix products half of the time */
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD_NTT] =
+            n_randint(state, 2) ? n_randint(state, 64) + 1 : WORD_MAX;
+
         nmod_poly_init(a, n);
         nmod_poly_init(b, n);
         nmod_poly_init(c, n);
@@ -160,6 +164,8 @@ main(void)
         nmod_poly_clear(g);
     }
 
+    flint_tune_reset();
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
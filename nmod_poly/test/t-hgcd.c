@@ -72,6 +72,10 @@ main(void)
 
         mp_limb_t n = n_randprime(state, FLINT_BITS, 0);
 
+        /* use the transform based matrix products half of the time */
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD_NTT] =
+            n_randint(state, 2) ? n_randint(state, 64) + 1 : WORD_MAX;
+
         nmod_poly_init(a, n);
         nmod_poly_init(b, n);
         nmod_poly_init(c, n);
@@ -154,6 +158,8 @@ main(void)
         _nmod_vec_clear(M[3]);
     }
 
+    flint_tune_reset();
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
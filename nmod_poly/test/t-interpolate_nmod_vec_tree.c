@@ -0,0 +1,128 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result = 1;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("interpolate_nmod_vec_tree....");
+    fflush(stdout);
+
+    for (i = 0; i < 500 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t P, Q;
+        nmod_poly_tree_t T;
+        mp_ptr x, y;
+        mp_limb_t mod;
+        slong j, k, n, npoints;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_THREADED] =
+            n_randint(state, 2) ? n_randint(state, 256) : 1024;
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_PREINV] =
+            n_randint(state, 64);
+
+        mod = n_randtest_prime(state, 0);
+        npoints = n_randint(state, FLINT_MIN((i % 20 == 0) ? 1500 : 150, mod));
+
+        nmod_poly_init(P, mod);
+        nmod_poly_init(Q, mod);
+        x = _nmod_vec_init(npoints);
+        y = _nmod_vec_init(npoints);
+
+        /* distinct points */
+        for (j = 0; j < npoints; j++)
+            x[j] = (mod > 2 * npoints) ? n_randint(state, mod) : j;
+        for (j = 0; j < npoints; j++)
+        {
+            for (k = 0; k < j; k++)
+            {
+                if (x[k] == x[j])
+                {
+                    x[j] = (x[j] + 1) % mod;
+                    k = -1;
+                }
+            }
+        }
+
+        nmod_poly_tree_init(T, x, npoints, mod);
+
+        /* the tree is reused for several polynomials */
+        for (k = 0; k < 3; k++)
+        {
+            n = n_randint(state, npoints + 1);
+            nmod_poly_randtest(P, state, n);
+
+            nmod_poly_evaluate_nmod_vec_tree(y, P, T);
+            nmod_poly_interpolate_nmod_vec_tree(Q, y, T);
+
+            result = nmod_poly_equal(P, Q);
+
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("mod=%wu, n=%wd, npoints=%wd\n\n", mod, n, npoints);
+                nmod_poly_print(P), flint_printf("\n\n");
+                nmod_poly_print(Q), flint_printf("\n\n");
+                abort();
+            }
+        }
+
+        nmod_poly_tree_clear(T);
+
+        /* repeated points have no interpolation weights */
+        if (npoints >= 2)
+        {
+            x[npoints - 1] = x[0];
+            nmod_poly_tree_init(T, x, npoints, mod);
+
+            if (T->weights != NULL)
+            {
+                flint_printf("FAIL (repeated points):\n");
+                flint_printf("mod=%wu, npoints=%wd\n\n", mod, npoints);
+                abort();
+            }
+
+            nmod_poly_tree_clear(T);
+        }
+
+        nmod_poly_clear(P);
+        nmod_poly_clear(Q);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+    }
+
+    flint_tune_reset();
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
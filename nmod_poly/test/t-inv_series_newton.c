@@ -115,6 +115,50 @@ main(void)
         nmod_poly_clear(qinv);
     }
 
+    /* Check a single Newton step against the full inverse */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t q, qinv, qinv2;
+        slong m, k;
+
+        mp_limb_t n;
+        do n = n_randtest_not_zero(state);
+        while (!n_is_probabprime(n));
+
+        nmod_poly_init(q, n);
+        nmod_poly_init(qinv, n);
+        nmod_poly_init(qinv2, n);
+        do nmod_poly_randtest(q, state, n_randint(state, 1000) + 2);
+        while (q->length < 2 || q->coeffs[0] == 0);
+
+        m = n_randint(state, q->length - 1) + 2;
+        k = (m + 1)/2 + n_randint(state, m/2);
+
+        nmod_poly_inv_series_newton(qinv, q, m);
+
+        nmod_poly_inv_series_newton(qinv2, q, k);
+        nmod_poly_fit_length(qinv2, m);
+        flint_mpn_zero(qinv2->coeffs + qinv2->length, m - qinv2->length);
+        _nmod_poly_inv_series_lift(qinv2->coeffs, q->coeffs, k, m, q->mod);
+        qinv2->length = m;
+        _nmod_poly_normalise(qinv2);
+
+        result = (nmod_poly_equal(qinv, qinv2));
+        if (!result)
+        {
+            flint_printf("FAIL (lift):\n");
+            nmod_poly_print(q), flint_printf("\n\n");
+            nmod_poly_print(qinv), flint_printf("\n\n");
+            nmod_poly_print(qinv2), flint_printf("\n\n");
+            flint_printf("n = %wd, k = %wd, m = %wd\n", n, k, m);
+            abort();
+        }
+
+        nmod_poly_clear(q);
+        nmod_poly_clear(qinv);
+        nmod_poly_clear(qinv2);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
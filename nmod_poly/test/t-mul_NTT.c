@@ -0,0 +1,172 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_NTT....");
+    fflush(stdout);
+
+    /* Check aliasing of a and b */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c;
+        mp_limb_t n = n_randtest_ntt_modulus(state);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, 50));
+        nmod_poly_randtest(c, state, n_randint(state, 50));
+
+        nmod_poly_mul_NTT(a, b, c);
+        nmod_poly_mul_NTT(b, b, c);
+
+        result = (nmod_poly_equal(a, b));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            nmod_poly_print(a), flint_printf("\n\n");
+            nmod_poly_print(b), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Check aliasing of a and c */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c;
+        mp_limb_t n = n_randtest_ntt_modulus(state);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, 50));
+        nmod_poly_randtest(c, state, n_randint(state, 50));
+
+        nmod_poly_mul_NTT(a, b, c);
+        nmod_poly_mul_NTT(c, b, c);
+
+        result = (nmod_poly_equal(a, c));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            nmod_poly_print(a), flint_printf("\n\n");
+            nmod_poly_print(c), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Compare with mul_KS, including squaring */
+    for (i = 0; i < 500 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randtest_ntt_modulus(state);
+        slong len = (i % 10 == 0) ? 5000 : 300;
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, len));
+        if (n_randint(state, 4) == 0)
+            nmod_poly_set(c, b);
+        else
+            nmod_poly_randtest(c, state, n_randint(state, len));
+
+        nmod_poly_mul_KS(a1, b, c, 0);
+        if (nmod_poly_equal(b, c))
+            nmod_poly_mul_NTT(a2, b, b);
+        else
+            nmod_poly_mul_NTT(a2, b, c);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wu\n", n);
+            nmod_poly_print(a1), flint_printf("\n\n");
+            nmod_poly_print(a2), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Check coefficients of maximal size */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randtest_ntt_modulus(state);
+        slong j, len1 = n_randint(state, 3000) + 1, len2 = n_randint(state, 3000) + 1;
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        for (j = 0; j < len1; j++)
+            nmod_poly_set_coeff_ui(b, j, n - 1);
+        for (j = 0; j < len2; j++)
+            nmod_poly_set_coeff_ui(c, j, n - 1);
+
+        nmod_poly_mul_KS(a1, b, c, 0);
+        nmod_poly_mul_NTT(a2, b, c);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL (maximal coefficients):\n");
+            flint_printf("n = %wu, len1 = %wd, len2 = %wd\n", n, len1, len2);
+            abort();
+        }
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
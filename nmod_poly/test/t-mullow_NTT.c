@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mullow_NTT....");
+    fflush(stdout);
+
+    /* Check aliasing of a and b */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c;
+        mp_limb_t n = n_randtest_ntt_modulus(state);
+        slong trunc = n_randint(state, 100);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, 50));
+        nmod_poly_randtest(c, state, n_randint(state, 50));
+
+        nmod_poly_mullow_NTT(a, b, c, trunc);
+        nmod_poly_mullow_NTT(b, b, c, trunc);
+
+        result = (nmod_poly_equal(a, b));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            nmod_poly_print(a), flint_printf("\n\n");
+            nmod_poly_print(b), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Compare with mullow_KS */
+    for (i = 0; i < 500 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randtest_ntt_modulus(state);
+        slong len = (i % 10 == 0) ? 5000 : 300;
+        slong trunc = n_randint(state, 2*len);
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, len));
+        nmod_poly_randtest(c, state, n_randint(state, len));
+
+        nmod_poly_mullow_KS(a1, b, c, 0, trunc);
+        nmod_poly_mullow_NTT(a2, b, c, trunc);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wu, trunc = %wd\n", n, trunc);
+            nmod_poly_print(a1), flint_printf("\n\n");
+            nmod_poly_print(a2), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
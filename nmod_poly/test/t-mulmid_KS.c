@@ -0,0 +1,192 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mulmid_KS....");
+    fflush(stdout);
+
+    /* Check aliasing of a and b */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c;
+        mp_limb_t n = n_randtest_not_zero(state);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, 50));
+        nmod_poly_randtest(c, state, n_randint(state, 50));
+
+        nmod_poly_mulmid_KS(a, b, c, 0);
+        nmod_poly_mulmid_KS(b, b, c, 0);
+
+        result = (nmod_poly_equal(a, b));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            nmod_poly_print(a), flint_printf("\n\n");
+            nmod_poly_print(b), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Check aliasing of a and c */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c;
+        mp_limb_t n = n_randtest_not_zero(state);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, n_randint(state, 50));
+        nmod_poly_randtest(c, state, n_randint(state, 50));
+
+        nmod_poly_mulmid_KS(a, b, c, 0);
+        nmod_poly_mulmid_KS(c, b, c, 0);
+
+        result = (nmod_poly_equal(a, c));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            nmod_poly_print(a), flint_printf("\n\n");
+            nmod_poly_print(c), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Compare with mul */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randtest_not_zero(state);
+        slong len1 = n_randint(state, 50), len2 = n_randint(state, 50);
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, FLINT_MAX(len1, len2));
+        nmod_poly_randtest(c, state, FLINT_MIN(len1, len2));
+
+        nmod_poly_mul(a1, b, c);
+        if (c->length == 0 || b->length < c->length)
+            nmod_poly_zero(a1);
+        else
+        {
+            nmod_poly_shift_right(a1, a1, c->length - 1);
+            nmod_poly_truncate(a1, b->length - c->length + 1);
+        }
+        nmod_poly_mulmid_KS(a2, b, c, 0);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("len1 = %wd, len2 = %wd\n", b->length, c->length);
+            nmod_poly_print(a1), flint_printf("\n\n");
+            nmod_poly_print(a2), flint_printf("\n\n");
+            abort();
+        }
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    /* Compare with mul for lengths reaching the FFT */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randtest_not_zero(state);
+        slong len1 = n_randint(state, 3000), len2 = n_randint(state, 3000);
+        slong cutoff = flint_tune_params[FLINT_TUNE_MPN_MUL_FFT];
+        slong ntt = flint_tune_params[FLINT_TUNE_FFT_MUL_NTT];
+
+        /* exercise the Fermat transforms as well as the small prime ones */
+        if (n_randint(state, 2))
+        {
+            flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = 64;
+            flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = 0;
+        }
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, FLINT_MAX(len1, len2));
+        nmod_poly_randtest(c, state, FLINT_MIN(len1, len2));
+
+        nmod_poly_mul(a1, b, c);
+        if (c->length == 0 || b->length < c->length)
+            nmod_poly_zero(a1);
+        else
+        {
+            nmod_poly_shift_right(a1, a1, c->length - 1);
+            nmod_poly_truncate(a1, b->length - c->length + 1);
+        }
+        nmod_poly_mulmid_KS(a2, b, c, 0);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("len1 = %wd, len2 = %wd\n", b->length, c->length);
+            nmod_poly_print(a1), flint_printf("\n\n");
+            nmod_poly_print(a2), flint_printf("\n\n");
+            abort();
+        }
+
+        flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] = cutoff;
+        flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = ntt;
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+int
+main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("multi_taylor_shift_horner....");
+    fflush(stdout);
+
+    /* Compare with the shifts modulo each prime */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        mp_limb_t primes[NMOD_MULTI_MAX], c[NMOD_MULTI_MAX];
+        nmod_multi_t M;
+        nmod_t mod;
+        mp_ptr u, v, w;
+        slong k, len, j, l;
+        mp_bitcnt_t bits;
+        int which = n_randint(state, 4);
+
+        k = n_randint(state, 2) ? 8 : n_randint(state, NMOD_MULTI_MAX) + 1;
+        len = n_randint(state, 60);
+        bits = n_randint(state, 2) ? 2 + n_randint(state, FLINT_BITS - 1)
+                                   : 20 + n_randint(state, 31);
+
+        for (j = 0; j < k; j++)
+            primes[j] = n_randprime(state, bits, 0);
+
+        nmod_multi_init(M, primes, k);
+        u = _nmod_vec_init(len + 1);
+        v = _nmod_vec_init(len * k + 1);
+        w = _nmod_vec_init(len * k + 1);
+
+        for (j = 0; j < k; j++)
+        {
+            c[j] = (which == 0) ? 1 : (which == 1) ? primes[j] - 1
+                                    : n_randint(state, primes[j]);
+            for (l = 0; l < len; l++)
+                v[l*k + j] = n_randint(state, primes[j]);
+        }
+
+        for (j = 0; j < k; j++)
+        {
+            nmod_init(&mod, primes[j]);
+            for (l = 0; l < len; l++)
+                u[l] = v[l*k + j];
+            _nmod_poly_taylor_shift_horner(u, c[j], len, mod);
+            for (l = 0; l < len; l++)
+                w[l*k + j] = u[l];
+        }
+
+        flint_set_cpu_features(n_randint(state, 8));
+        _nmod_poly_multi_taylor_shift_horner(v, c, len, M);
+        flint_set_cpu_features(-1);
+
+        if (!_nmod_vec_equal(v, w, len * k))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("len = %wd, k = %wd, bits = %wu\n", len, k, bits);
+            abort();
+        }
+
+        _nmod_vec_clear(u);
+        _nmod_vec_clear(v);
+        _nmod_vec_clear(w);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -50,6 +50,10 @@ main(void)
         do n = n_randtest_not_zero(state);
         while (!n_is_probabprime(n));
 
+        /* use the transform based matrix products half of the time */
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD_NTT] =
+            n_randint(state, 2) ? n_randint(state, 64) + 1 : WORD_MAX;
+
         nmod_poly_init(f, n);
         nmod_poly_init(g, n);
         
@@ -121,6 +125,8 @@ main(void)
         nmod_poly_clear(h);
     }
 
+    flint_tune_reset();
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -28,6 +28,7 @@
 #include "ulong_extras.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "thread_pool.h"
 
 mp_ptr * _nmod_poly_tree_alloc(slong len)
 {
@@ -58,11 +59,44 @@ void _nmod_poly_tree_free(mp_ptr * tree, slong len)
     }
 }
 
+typedef struct
+{
+    mp_ptr pa;
+    mp_ptr pb;
+    slong pow;
+    slong left;
+    nmod_t mod;
+} _tree_level_arg_t;
+
+/* multiplies out the pairs of nodes of length pow + 1 covering left roots */
+static void * _nmod_poly_tree_level_worker(void * arg_ptr)
+{
+    _tree_level_arg_t * arg = (_tree_level_arg_t *) arg_ptr;
+    slong pow = arg->pow, left = arg->left;
+    mp_ptr pa = arg->pa, pb = arg->pb;
+
+    while (left >= 2 * pow)
+    {
+        _nmod_poly_mul(pb, pa, pow + 1, pa + pow + 1, pow + 1, arg->mod);
+        left -= 2 * pow;
+        pa += 2 * pow + 2;
+        pb += 2 * pow + 1;
+    }
+
+    if (left > pow)
+        _nmod_poly_mul(pb, pa, pow + 1, pa + pow + 1, left - pow + 1, arg->mod);
+    else if (left > 0)
+        _nmod_vec_set(pb, pa, left + 1);
+
+    return NULL;
+}
+
 void
 _nmod_poly_tree_build(mp_ptr * tree, mp_srcptr roots, slong len, nmod_t mod)
 {
-    slong height, pow, left, i;
-    mp_ptr pa, pb;
+    slong height, pow, i, j, pairs, num_threads;
+    _tree_level_arg_t * args;
+    mp_ptr pa;
 
     if (len == 0)
         return;
@@ -100,24 +134,37 @@ _nmod_poly_tree_build(mp_ptr * tree, mp_srcptr roots, slong len, nmod_t mod)
         }
     }
 
+    /* the pairs of nodes on a level are multiplied in parallel */
+    num_threads = (len >= NMOD_POLY_TREE_THREADED_CUTOFF) ?
+                                             flint_get_num_threads() : 1;
+    args = flint_malloc(num_threads * sizeof(_tree_level_arg_t));
+
     for (i = 1; i < height - 1; i++)
     {
-        left = len;
+        slong n, k;
+
         pow = WORD(1) << i;
-        pa = tree[i];
-        pb = tree[i + 1];
+        pairs = (len + 2 * pow - 1) / (2 * pow);
+        n = FLINT_MIN(num_threads, pairs);
 
-        while (left >= 2 * pow)
+        for (j = k = 0; j < n; j++)
         {
-            _nmod_poly_mul(pb, pa, pow + 1, pa + pow + 1, pow + 1, mod);
-            left -= 2 * pow;
-            pa += 2 * pow + 2;
-            pb += 2 * pow + 1;
+            slong k1 = (pairs * (j + 1)) / n;
+
+            args[j].pa = tree[i] + k * (2 * pow + 2);
+            args[j].pb = tree[i + 1] + k * (2 * pow + 1);
+            args[j].pow = pow;
+            args[j].left = FLINT_MIN(len, k1 * 2 * pow) - k * 2 * pow;
+            args[j].mod = mod;
+            k = k1;
         }
 
-        if (left > pow)
-            _nmod_poly_mul(pb, pa, pow + 1, pa + pow + 1, left - pow + 1, mod);
-        else if (left > 0)
-            _nmod_vec_set(pb, pa, left + 1);
+        if (n == 1)
+            _nmod_poly_tree_level_worker(args);
+        else
+            flint_parallel_map(_nmod_poly_tree_level_worker, args,
+                                             sizeof(_tree_level_arg_t), n);
     }
+
+    flint_free(args);
 }
@@ -0,0 +1,45 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+void nmod_poly_tree_clear(nmod_poly_tree_t T)
+{
+    slong i;
+
+    if (T->len != 0)
+    {
+        for (i = 0; i <= FLINT_CLOG2(T->len); i++)
+        {
+            if (T->inv[i] != NULL)
+                _nmod_vec_clear(T->inv[i]);
+        }
+
+        flint_free(T->inv);
+    }
+
+    if (T->weights != NULL)
+        _nmod_vec_clear(T->weights);
+
+    _nmod_poly_tree_free(T->tree, T->len);
+}
@@ -0,0 +1,154 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "thread_pool.h"
+
+typedef struct
+{
+    mp_ptr node;
+    mp_ptr inv;
+    slong pow;
+    slong k0;
+    slong k1;
+    slong len;
+    nmod_t mod;
+} _tree_inv_arg_t;
+
+/*
+   sets the inverses of the reverses of nodes [k0, k1) of a level, which
+   are monic, to the length of their quotients by a polynomial of twice
+   their degree
+*/
+static void * _nmod_poly_tree_inv_worker(void * arg_ptr)
+{
+    _tree_inv_arg_t * arg = (_tree_inv_arg_t *) arg_ptr;
+    slong k, nl, pow = arg->pow;
+    mp_ptr rev = _nmod_vec_init(pow + 1);
+
+    for (k = arg->k0; k < arg->k1; k++)
+    {
+        nl = FLINT_MIN(pow, arg->len - k * pow);
+
+        _nmod_poly_reverse(rev, arg->node + k * (pow + 1), nl + 1, nl + 1);
+        _nmod_poly_inv_series(arg->inv + k * pow, rev, nl, arg->mod);
+    }
+
+    _nmod_vec_clear(rev);
+
+    return NULL;
+}
+
+void nmod_poly_tree_init(nmod_poly_tree_t T, mp_srcptr xs, slong len,
+                                                                mp_limb_t n)
+{
+    slong i, j, k, m, height, pow, nodes, num_threads;
+    _tree_inv_arg_t * args;
+    mp_ptr tmp, w;
+
+    nmod_init(&T->mod, n);
+    T->len = len;
+    T->tree = _nmod_poly_tree_alloc(len);
+    T->inv = NULL;
+    T->weights = NULL;
+
+    if (len == 0)
+        return;
+
+    _nmod_poly_tree_build(T->tree, xs, len, T->mod);
+
+    /* levels 0, ..., height - 1 are built */
+    height = FLINT_CLOG2(len);
+    T->inv = flint_malloc((height + 1) * sizeof(mp_ptr));
+
+    num_threads = (len >= NMOD_POLY_TREE_THREADED_CUTOFF) ?
+                                             flint_get_num_threads() : 1;
+    args = flint_malloc(num_threads * sizeof(_tree_inv_arg_t));
+
+    for (i = 0; i <= height; i++)
+    {
+        pow = WORD(1) << i;
+
+        if (i == height || pow < NMOD_POLY_TREE_PREINV_CUTOFF)
+        {
+            T->inv[i] = NULL;
+            continue;
+        }
+
+        T->inv[i] = _nmod_vec_init(len);
+        nodes = (len + pow - 1) / pow;
+        m = FLINT_MIN(num_threads, nodes);
+
+        for (j = k = 0; j < m; j++)
+        {
+            args[j].node = T->tree[i];
+            args[j].inv = T->inv[i];
+            args[j].pow = pow;
+            args[j].k0 = k;
+            args[j].k1 = k = (nodes * (j + 1)) / m;
+            args[j].len = len;
+            args[j].mod = T->mod;
+        }
+
+        if (m == 1)
+            _nmod_poly_tree_inv_worker(args);
+        else
+            flint_parallel_map(_nmod_poly_tree_inv_worker, args,
+                                                     sizeof(_tree_inv_arg_t), m);
+    }
+
+    flint_free(args);
+
+    /* the interpolation weights 1/f'(x_i), with f the product of x - x_i */
+    w = _nmod_vec_init(len);
+
+    if (len == 1)
+    {
+        w[0] = (n == 1) ? 0 : 1;
+    } else
+    {
+        tmp = _nmod_vec_init(len + 1);
+        pow = WORD(1) << (height - 1);
+
+        _nmod_poly_mul(tmp, T->tree[height - 1], pow + 1,
+                       T->tree[height - 1] + (pow + 1), len - pow + 1, T->mod);
+        _nmod_poly_derivative(tmp, tmp, len + 1, T->mod);
+        _nmod_poly_evaluate_nmod_vec_fast_precomp_preinv(w, tmp, len,
+                                             T->tree, T->inv, len, T->mod);
+
+        _nmod_vec_clear(tmp);
+    }
+
+    for (i = 0; i < len && n != 1; i++)
+    {
+        /* the points are not distinct modulo some factor of n */
+        if (w[i] == 0 || n_gcdinv(w + i, w[i], n) != 1)
+        {
+            _nmod_vec_clear(w);
+            return;
+        }
+    }
+
+    T->weights = w;
+}
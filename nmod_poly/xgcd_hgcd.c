@@ -208,20 +208,53 @@ slong _nmod_poly_xgcd_hgcd(mp_ptr G, mp_ptr S, mp_ptr T,
 
                 sgnR = _nmod_poly_hgcd(R, lenR, h, &lenh, j, &lenj, j,lenj, r, lenr, mod);
 
-                __mul(v, lenv, R[1], lenR[1], T, lenT);
-                __mul(w, lenw, R[2], lenR[2], S, lenS);
+                if (_nmod_poly_hgcd_use_NTT(FLINT_MIN(lenR[0], lenT), 
+                               lenR[0] + FLINT_MAX(lenS, lenT) - 1, mod))
+                {
+                    /* (v, q) = (S R[3] - T R[1], S R[2] - T R[0]) */
+                    mp_srcptr P[4], U[2];
+                    mp_ptr C[2];
+                    slong lenP[4], lenU[2], lenC[2];
 
-                __mul(q, lenq, S, lenS, R[3], lenR[3]);
-                if (sgnR > 0)
-                    __sub(S, lenS, q, lenq, v, lenv);
-                else
-                    __sub(S, lenS, v, lenv, q, lenq);
+                    P[0] = R[3]; lenP[0] = lenR[3];
+                    P[1] = R[1]; lenP[1] = lenR[1];
+                    P[2] = R[2]; lenP[2] = lenR[2];
+                    P[3] = R[0]; lenP[3] = lenR[0];
+
+                    _nmod_vec_neg(w, T, lenT, mod);
+                    U[0] = S; lenU[0] = lenS;
+                    U[1] = w; lenU[1] = lenT;
+
+                    C[0] = v;
+                    C[1] = q;
+
+                    _nmod_poly_mat22_mul_NTT(C, lenC, P, lenP, U, lenU, 1, mod);
 
-                __mul(q, lenq, T, lenT, R[0], lenR[0]);
-                if (sgnR > WORD(0))
-                    __sub(T, lenT, q, lenq, w, lenw);
+                    if (sgnR > 0)
+                        _nmod_vec_neg(q, q, lenC[1], mod);
+                    else
+                        _nmod_vec_neg(v, v, lenC[0], mod);
+
+                    __set(S, lenS, v, lenC[0]);
+                    __set(T, lenT, q, lenC[1]);
+                }
                 else
-                    __sub(T, lenT, w, lenw, q, lenq);
+                {
+                    __mul(v, lenv, R[1], lenR[1], T, lenT);
+                    __mul(w, lenw, R[2], lenR[2], S, lenS);
+
+                    __mul(q, lenq, S, lenS, R[3], lenR[3]);
+                    if (sgnR > 0)
+                        __sub(S, lenS, q, lenq, v, lenv);
+                    else
+                        __sub(S, lenS, v, lenv, q, lenq);
+
+                    __mul(q, lenq, T, lenT, R[0], lenR[0]);
+                    if (sgnR > WORD(0))
+                        __sub(T, lenT, q, lenq, w, lenw);
+                    else
+                        __sub(T, lenT, w, lenw, q, lenq);
+                }
             }
             __set(G, lenG, h, lenh);
 
@@ -72,6 +72,10 @@ typedef struct
 }
 nmod_poly_interval_poly_arg_t;
 
+/* Equal degree factorisation: serial -> threaded, by degree */
+#define NMOD_POLY_FACTOR_EQUAL_DEG_THREADED_CUTOFF \
+    (flint_tune_params[FLINT_TUNE_NMOD_POLY_FACTOR_EQUAL_DEG_THREADED])
+
 /* Factoring  ****************************************************************/
 
 typedef nmod_poly_factor_struct nmod_poly_factor_t[1];
@@ -102,6 +106,9 @@ FLINT_DLL void nmod_poly_factor_equal_deg(nmod_poly_factor_t factors,
 FLINT_DLL int nmod_poly_factor_equal_deg_prob(nmod_poly_t factor,
     flint_rand_t state, const nmod_poly_t pol, slong d);
 
+FLINT_DLL void nmod_poly_factor_equal_deg_threaded(nmod_poly_factor_t factors,
+                                const nmod_poly_t pol, slong d);
+
 FLINT_DLL void nmod_poly_factor_distinct_deg(nmod_poly_factor_t res,
                                    const nmod_poly_t poly, slong * const *degs);
 
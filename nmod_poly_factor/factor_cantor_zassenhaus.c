@@ -58,7 +58,12 @@ nmod_poly_factor_cantor_zassenhaus(nmod_poly_factor_t res, const nmod_poly_t f)
         {
             nmod_poly_make_monic(g, g);
             num = res->num;
-            nmod_poly_factor_equal_deg(res, g, i);
+            if ((flint_get_num_threads() > 1) &&
+                (nmod_poly_degree(g) >=
+                                    NMOD_POLY_FACTOR_EQUAL_DEG_THREADED_CUTOFF))
+                nmod_poly_factor_equal_deg_threaded(res, g, i);
+            else
+                nmod_poly_factor_equal_deg(res, g, i);
 
             for (j = num; j < res->num; j++)
                 res->exp[j] = nmod_poly_remove(v, res->p + j);
@@ -0,0 +1,168 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "thread_pool.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    nmod_poly_struct * factor;
+    const nmod_poly_struct * pol;
+    flint_rand_s * state;
+    slong d;
+    int found;
+}
+_equal_deg_prob_arg_t;
+
+static void *
+_equal_deg_prob_worker(void * arg_ptr)
+{
+    _equal_deg_prob_arg_t * arg = (_equal_deg_prob_arg_t *) arg_ptr;
+
+    arg->found = nmod_poly_factor_equal_deg_prob(arg->factor,
+                                          arg->state, arg->pol, arg->d);
+
+    return NULL;
+}
+
+void
+nmod_poly_factor_equal_deg_threaded(nmod_poly_factor_t factors,
+                                    const nmod_poly_t pol, slong d)
+{
+    nmod_poly_factor_t work, next, split;
+    nmod_poly_struct * f;
+    flint_rand_s * states;
+    _equal_deg_prob_arg_t * args;
+    flint_rand_t state;
+    nmod_poly_t g, h;
+    slong i, j, k, len, num, num_threads;
+
+    if (pol->length == d + 1)
+    {
+        nmod_poly_factor_insert(factors, pol, 1);
+        return;
+    }
+
+    num_threads = flint_get_num_threads();
+
+    nmod_poly_init_preinv(g, pol->mod.n, pol->mod.ninv);
+    nmod_poly_init_preinv(h, pol->mod.n, pol->mod.ninv);
+
+    flint_randinit(state);
+
+    nmod_poly_factor_init(work);
+    nmod_poly_factor_insert(work, pol, 1);
+
+    while (work->num > 0)
+    {
+        /*
+           The polynomials still to be split are independent. If there are
+           fewer of them than threads, the spare threads make further
+           random trials on them.
+        */
+        num = FLINT_MAX(work->num, num_threads);
+
+        f = flint_malloc(num * sizeof(nmod_poly_struct));
+        states = flint_malloc(num * sizeof(flint_rand_s));
+        args = flint_malloc(num * sizeof(_equal_deg_prob_arg_t));
+
+        for (j = 0; j < num; j++)
+        {
+            nmod_poly_init_preinv(f + j, pol->mod.n, pol->mod.ninv);
+
+            flint_randinit(states + j);
+            states[j].__randval = n_randlimb(state);
+            states[j].__randval2 = n_randlimb(state);
+
+            args[j].factor = f + j;
+            args[j].pol = work->p + (j % work->num);
+            args[j].state = states + j;
+            args[j].d = d;
+        }
+
+        flint_parallel_map(_equal_deg_prob_worker, args,
+                                       sizeof(_equal_deg_prob_arg_t), num);
+
+        nmod_poly_factor_init(next);
+
+        for (i = 0; i < work->num; i++)
+        {
+            nmod_poly_factor_init(split);
+            nmod_poly_factor_insert(split, work->p + i, 1);
+
+            /* refine the pieces of p_i by every factor found for it */
+            for (j = i; j < num; j += work->num)
+            {
+                if (!args[j].found)
+                    continue;
+
+                len = split->num;
+                for (k = 0; k < len; k++)
+                {
+                    if (split->p[k].length == d + 1)
+                        continue;
+
+                    if (split->num == 1)
+                        nmod_poly_set(g, f + j);
+                    else
+                        nmod_poly_gcd(g, split->p + k, f + j);
+
+                    if (g->length > 1 && g->length < split->p[k].length)
+                    {
+                        nmod_poly_div(h, split->p + k, g);
+                        nmod_poly_swap(split->p + k, g);
+                        nmod_poly_factor_insert(split, h, 1);
+                    }
+                }
+            }
+
+            for (k = 0; k < split->num; k++)
+            {
+                if (split->p[k].length == d + 1)
+                    nmod_poly_factor_insert(factors, split->p + k, 1);
+                else
+                    nmod_poly_factor_insert(next, split->p + k, 1);
+            }
+
+            nmod_poly_factor_clear(split);
+        }
+
+        for (j = 0; j < num; j++)
+        {
+            nmod_poly_clear(f + j);
+            flint_randclear(states + j);
+        }
+
+        flint_free(f);
+        flint_free(states);
+        flint_free(args);
+
+        nmod_poly_factor_clear(work);
+        *work = *next;
+    }
+
+    nmod_poly_factor_clear(work);
+    flint_randclear(state);
+    nmod_poly_clear(g);
+    nmod_poly_clear(h);
+}
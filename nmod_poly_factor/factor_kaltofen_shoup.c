@@ -74,7 +74,13 @@ void nmod_poly_factor_kaltofen_shoup(nmod_poly_factor_t res,
         {
             res_num = res->num;
 
-            nmod_poly_factor_equal_deg(res, dist_deg->p + j, degs[l]);
+            if ((flint_get_num_threads() > 1) &&
+                (nmod_poly_degree(dist_deg->p + j) >=
+                                    NMOD_POLY_FACTOR_EQUAL_DEG_THREADED_CUTOFF))
+                nmod_poly_factor_equal_deg_threaded(res, dist_deg->p + j,
+                                                    degs[l]);
+            else
+                nmod_poly_factor_equal_deg(res, dist_deg->p + j, degs[l]);
             for (k = res_num; k < res->num; k++)
                 res->exp[k] = nmod_poly_remove(v, res->p + k);
         }
@@ -0,0 +1,132 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("factor_equal_deg_threaded....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 200 * flint_test_multiplier(); iter++)
+    {
+        nmod_poly_t poly1, poly, q, r, product;
+        nmod_poly_factor_t res;
+        mp_limb_t modulus;
+        slong i, d, num, tries;
+
+        modulus = n_randtest_prime(state, 0);
+        d = n_randint(state, 4) + 1;
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        nmod_poly_init(poly1, modulus);
+        nmod_poly_init(poly, modulus);
+        nmod_poly_init(q, modulus);
+        nmod_poly_init(r, modulus);
+
+        nmod_poly_one(poly1);
+
+        /* a product of distinct irreducibles of degree d */
+        num = 0;
+        for (i = n_randint(state, 12) + 1; i > 0; i--)
+        {
+            tries = 0;
+            do
+            {
+                nmod_poly_randtest_monic(poly, state, d + 1);
+                nmod_poly_divrem(q, r, poly1, poly);
+                tries++;
+            }
+            while (tries < 100 && ((!nmod_poly_is_irreducible(poly)) ||
+                (r->length == 0)));
+
+            if (tries == 100)
+                break;
+
+            nmod_poly_mul(poly1, poly1, poly);
+            num++;
+        }
+
+        if (num == 0)
+        {
+            nmod_poly_clear(q);
+            nmod_poly_clear(r);
+            nmod_poly_clear(poly1);
+            nmod_poly_clear(poly);
+            continue;
+        }
+
+        nmod_poly_factor_init(res);
+        nmod_poly_factor_equal_deg_threaded(res, poly1, d);
+
+        if (res->num != num)
+        {
+            flint_printf("Error: number of factors incorrect: %wd != %wd\n",
+                res->num, num);
+            abort();
+        }
+
+        nmod_poly_init_preinv(product, poly1->mod.n, poly1->mod.ninv);
+        nmod_poly_one(product);
+        for (i = 0; i < res->num; i++)
+        {
+            if (res->exp[i] != 1 || res->p[i].length != d + 1
+                || !nmod_poly_is_irreducible(res->p + i))
+            {
+                flint_printf("Error: factor is not irreducible of degree %wd\n",
+                    d);
+                flint_printf("factor:\n"); nmod_poly_print(res->p + i);
+                flint_printf("\n");
+                abort();
+            }
+
+            nmod_poly_mul(product, product, res->p + i);
+        }
+
+        if (!nmod_poly_equal(poly1, product))
+        {
+            flint_printf("Error: product of factors does not equal to the original polynomial\n");
+            flint_printf("poly:\n"); nmod_poly_print(poly1); flint_printf("\n");
+            flint_printf("product:\n"); nmod_poly_print(product); flint_printf("\n");
+            abort();
+        }
+
+        nmod_poly_clear(product);
+        nmod_poly_clear(q);
+        nmod_poly_clear(r);
+        nmod_poly_clear(poly1);
+        nmod_poly_clear(poly);
+        nmod_poly_factor_clear(res);
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -94,6 +94,11 @@ main(void)
                 nmod_poly_mul(poly1, poly1, poly);
         }
 
+        /* use the threaded equal degree factorisation half of the time */
+        flint_set_num_threads(n_randint(state, 3) + 1);
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_FACTOR_EQUAL_DEG_THREADED] =
+                                n_randint(state, 2) ? 0 : poly1->length;
+
         nmod_poly_factor_init(res);
         nmod_poly_factor_kaltofen_shoup(res, poly1);
 
@@ -128,6 +133,8 @@ main(void)
         nmod_poly_factor_clear(res);
     }
 
+    flint_tune_reset();
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
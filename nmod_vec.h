@@ -306,9 +306,138 @@ FLINT_DLL int _nmod_vec_dot_bound_limbs(slong len, nmod_t mod);
 FLINT_DLL mp_limb_t _nmod_vec_dot(mp_srcptr vec1, mp_srcptr vec2,
     slong len, nmod_t mod, int nlimbs);
 
+/*
+   SIMD versions of some of the functions above, used by them for vectors
+   of length at least NMOD_VEC_SIMD_CUTOFF if flint_cpu_features reports
+   the instruction set. The multiplications need n < 2^32, or n < 2^50 with
+   IFMA, and the dot products need n <= 2^32 or n < 2^50 respectively.
+*/
+#if FLINT_BITS == 64 && defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define NMOD_VEC_SIMD 1
+#else
+#define NMOD_VEC_SIMD 0
+#endif
+
+#define NMOD_VEC_SIMD_CUTOFF 16
+
+#if NMOD_VEC_SIMD
+
+FLINT_DLL void _nmod_vec_add_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, nmod_t mod);
+FLINT_DLL void _nmod_vec_sub_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, nmod_t mod);
+FLINT_DLL void _nmod_vec_scalar_mul_nmod_avx2(mp_ptr res, mp_srcptr vec,
+                            slong len, mp_limb_t c, nmod_t mod);
+FLINT_DLL void _nmod_vec_scalar_addmul_nmod_avx2(mp_ptr res, mp_srcptr vec,
+                            slong len, mp_limb_t c, nmod_t mod);
+FLINT_DLL mp_limb_t _nmod_vec_dot_avx2(mp_srcptr vec1, mp_srcptr vec2,
+                                                     slong len, nmod_t mod);
+
+FLINT_DLL void _nmod_vec_add_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, nmod_t mod);
+FLINT_DLL void _nmod_vec_sub_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, nmod_t mod);
+FLINT_DLL void _nmod_vec_scalar_mul_nmod_avx512(mp_ptr res, mp_srcptr vec,
+                            slong len, mp_limb_t c, nmod_t mod);
+FLINT_DLL void _nmod_vec_scalar_addmul_nmod_avx512(mp_ptr res, mp_srcptr vec,
+                            slong len, mp_limb_t c, nmod_t mod);
+FLINT_DLL mp_limb_t _nmod_vec_dot_avx512(mp_srcptr vec1, mp_srcptr vec2,
+                                                     slong len, nmod_t mod);
+
+FLINT_DLL void _nmod_vec_scalar_mul_nmod_ifma(mp_ptr res, mp_srcptr vec,
+                            slong len, mp_limb_t c, nmod_t mod);
+FLINT_DLL void _nmod_vec_scalar_addmul_nmod_ifma(mp_ptr res, mp_srcptr vec,
+                            slong len, mp_limb_t c, nmod_t mod);
+FLINT_DLL mp_limb_t _nmod_vec_dot_ifma(mp_srcptr vec1, mp_srcptr vec2,
+                                                     slong len, nmod_t mod);
+
+#endif
+
 FLINT_DLL mp_limb_t _nmod_vec_dot_ptr(mp_srcptr vec1, const mp_ptr * vec2, slong offset,
     slong len, nmod_t mod, int nlimbs);
 
+/*
+   Multi-modulus vectors: the residues of each entry modulo up to
+   NMOD_MULTI_MAX moduli are stored together, so that entry j modulo
+   mod[i] is at vec[j*num + i]. When num divides 8 the operations below are
+   done by SIMD kernels working on 8 words at a time.
+*/
+#define NMOD_MULTI_MAX 8
+
+typedef struct
+{
+    nmod_t mod[NMOD_MULTI_MAX];
+    slong num;
+    mp_bitcnt_t bits;
+} nmod_multi_struct;
+
+typedef nmod_multi_struct nmod_multi_t[1];
+
+FLINT_DLL void nmod_multi_init(nmod_multi_t M, mp_srcptr moduli, slong num);
+
+FLINT_DLL mp_bitcnt_t nmod_multi_simd_mul_bits(void);
+
+FLINT_DLL void _nmod_multi_vec_add(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_sub(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_mul(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_scalar_mul(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_scalar_addmul(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_horner(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M);
+
+#if NMOD_VEC_SIMD
+
+#define NMOD_MULTI_SIMD(M, len) \
+    (8 % (M)->num == 0 && (len) * (M)->num >= NMOD_VEC_SIMD_CUTOFF)
+
+FLINT_DLL void _nmod_multi_vec_add_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_sub_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_mul_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_scalar_mul_avx2(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_scalar_addmul_avx2(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_horner_avx2(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_add_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_sub_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_mul_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_scalar_mul_avx512(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_scalar_addmul_avx512(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_horner_avx512(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M);
+
+FLINT_DLL void _nmod_multi_vec_mul_ifma(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_scalar_mul_ifma(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_scalar_addmul_ifma(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M);
+FLINT_DLL void _nmod_multi_vec_horner_ifma(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,23 @@ void _nmod_vec_add(mp_ptr res, mp_srcptr vec1,
 {
    slong i;
 
+#if NMOD_VEC_SIMD
+   if (len >= NMOD_VEC_SIMD_CUTOFF)
+   {
+      int cpu = flint_cpu_features();
+
+      if (cpu & FLINT_CPU_AVX512)
+      {
+         _nmod_vec_add_avx512(res, vec1, vec2, len, mod);
+         return;
+      } else if (cpu & FLINT_CPU_AVX2)
+      {
+         _nmod_vec_add_avx2(res, vec1, vec2, len, mod);
+         return;
+      }
+   }
+#endif
+
    if (mod.norm)
    {
 	  for (i = 0 ; i < len; i++)
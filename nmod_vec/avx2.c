@@ -0,0 +1,410 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "nmod_vec.h"
+
+#if NMOD_VEC_SIMD
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <immintrin.h>
+#undef ulong
+#define ulong mp_limb_t
+
+#define AVX2 __attribute__((target("avx2")))
+
+/* unsigned comparison x > y of 64 bit lanes */
+#define CMPGT_EPU64(x, y, sign) \
+    _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign), _mm256_xor_si256(y, sign))
+
+AVX2 void _nmod_vec_add_avx2(mp_ptr res, mp_srcptr vec1,
+                                   mp_srcptr vec2, slong len, nmod_t mod)
+{
+    __m256i a, b, nb, m, n = _mm256_set1_epi64x(mod.n);
+    __m256i sign = _mm256_set1_epi64x(WORD_MIN);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+
+        /* a + b if a < n - b, else a - (n - b); this cannot overflow */
+        nb = _mm256_sub_epi64(n, b);
+        m = CMPGT_EPU64(nb, a, sign);
+        a = _mm256_blendv_epi8(_mm256_sub_epi64(a, nb),
+                               _mm256_add_epi64(a, b), m);
+
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = nmod_add(vec1[i], vec2[i], mod);
+}
+
+AVX2 void _nmod_vec_sub_avx2(mp_ptr res, mp_srcptr vec1,
+                                   mp_srcptr vec2, slong len, nmod_t mod)
+{
+    __m256i a, b, m, n = _mm256_set1_epi64x(mod.n);
+    __m256i sign = _mm256_set1_epi64x(WORD_MIN);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+
+        m = CMPGT_EPU64(b, a, sign);
+        a = _mm256_add_epi64(_mm256_sub_epi64(a, b), _mm256_and_si256(m, n));
+
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = nmod_sub(vec1[i], vec2[i], mod);
+}
+
+/*
+   For n < 2^32 the product a c is reduced using Shoup's method with the
+   precomputed quotient w = floor(c 2^32 / n), leaving a c - q n < 2 n.
+*/
+#define SHOUP_MUL32(r, a, c, w, n) \
+    do { \
+        __m256i __q = _mm256_srli_epi64(_mm256_mul_epu32(a, w), 32); \
+        (r) = _mm256_sub_epi64(_mm256_mul_epu32(a, c), \
+                               _mm256_mul_epu32(__q, n)); \
+        (r) = _mm256_sub_epi64(r, \
+                  _mm256_andnot_si256(_mm256_cmpgt_epi64(n, r), n)); \
+    } while (0)
+
+AVX2 void _nmod_vec_scalar_mul_nmod_avx2(mp_ptr res, mp_srcptr vec,
+                                   slong len, mp_limb_t c, nmod_t mod)
+{
+    __m256i a, n = _mm256_set1_epi64x(mod.n), cc = _mm256_set1_epi64x(c);
+    __m256i w = _mm256_set1_epi64x((c << 32) / mod.n);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec + i));
+        SHOUP_MUL32(a, a, cc, w, n);
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_mulmod2_preinv(vec[i], c, mod.n, mod.ninv);
+}
+
+AVX2 void _nmod_vec_scalar_addmul_nmod_avx2(mp_ptr res, mp_srcptr vec,
+                                   slong len, mp_limb_t c, nmod_t mod)
+{
+    __m256i a, b, m, n = _mm256_set1_epi64x(mod.n), cc = _mm256_set1_epi64x(c);
+    __m256i w = _mm256_set1_epi64x((c << 32) / mod.n);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec + i));
+        b = _mm256_loadu_si256((const __m256i *) (res + i));
+        SHOUP_MUL32(a, a, cc, w, n);
+
+        /* all values are below 2^32, so signed comparison suffices */
+        a = _mm256_add_epi64(a, b);
+        m = _mm256_cmpgt_epi64(n, a);
+        a = _mm256_sub_epi64(a, _mm256_andnot_si256(m, n));
+
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < len; i++)
+        NMOD_ADDMUL(res[i], vec[i], c, mod);
+}
+
+/*
+   For n <= 2^32 each product fits in a limb. The low and high halves of
+   the products are summed separately so that the lanes cannot overflow
+   for len < 2^32.
+*/
+AVX2 mp_limb_t _nmod_vec_dot_avx2(mp_srcptr vec1, mp_srcptr vec2,
+                                                     slong len, nmod_t mod)
+{
+    __m256i a, b, p, lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+    __m256i mask = _mm256_set1_epi64x(0xffffffff);
+    mp_limb_t l[4], h[4], s0, s1, t0, t1, r;
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+        p = _mm256_mul_epu32(a, b);
+        lo = _mm256_add_epi64(lo, _mm256_and_si256(p, mask));
+        hi = _mm256_add_epi64(hi, _mm256_srli_epi64(p, 32));
+    }
+
+    _mm256_storeu_si256((__m256i *) l, lo);
+    _mm256_storeu_si256((__m256i *) h, hi);
+
+    t0 = l[0] + l[1] + l[2] + l[3];
+    t1 = h[0] + h[1] + h[2] + h[3];
+
+    for ( ; i < len; i++)
+    {
+        s0 = vec1[i] * vec2[i];
+        t0 += s0 & 0xffffffff;
+        t1 += s0 >> 32;
+    }
+
+    /* s1:s0 = t1 2^32 + t0 */
+    s1 = t1 >> 32;
+    s0 = t1 << 32;
+    add_ssaaaa(s1, s0, s1, s0, 0, t0);
+
+    NMOD2_RED2(r, s1, s0, mod);
+
+    return r;
+}
+
+/*
+   Multi-modulus kernels. The words of a vector repeat the moduli with
+   period num, which divides 8, so the moduli and the constants depending
+   on them are loaded as 8 word patterns split into two registers.
+*/
+static void multi_pattern(mp_ptr r, mp_srcptr c, const nmod_multi_struct * M)
+{
+    slong t;
+
+    for (t = 0; t < 8; t++)
+        r[t] = (c == NULL) ? M->mod[t % M->num].n : c[t % M->num];
+}
+
+AVX2 void _nmod_multi_vec_add_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    __m256i a, b, nb, m, n[2], sign = _mm256_set1_epi64x(WORD_MIN);
+    slong i, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    n[0] = _mm256_loadu_si256((const __m256i *) np);
+    n[1] = _mm256_loadu_si256((const __m256i *) (np + 4));
+
+    for (i = 0; i + 4 <= L; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+
+        nb = _mm256_sub_epi64(n[(i >> 2) & 1], b);
+        m = CMPGT_EPU64(nb, a, sign);
+        a = _mm256_blendv_epi8(_mm256_sub_epi64(a, nb),
+                               _mm256_add_epi64(a, b), m);
+
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_add(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+AVX2 void _nmod_multi_vec_sub_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    __m256i a, b, m, n[2], sign = _mm256_set1_epi64x(WORD_MIN);
+    slong i, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    n[0] = _mm256_loadu_si256((const __m256i *) np);
+    n[1] = _mm256_loadu_si256((const __m256i *) (np + 4));
+
+    for (i = 0; i + 4 <= L; i += 4)
+    {
+        a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+
+        m = CMPGT_EPU64(b, a, sign);
+        a = _mm256_add_epi64(_mm256_sub_epi64(a, b),
+                             _mm256_and_si256(m, n[(i >> 2) & 1]));
+
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_sub(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+/*
+   Products of two vectors for moduli below 2^32. The quotient is
+   estimated in double precision, which is exact enough that the remainder
+   a b - q n, computed exactly with integer multiplications, is in
+   [-n, 2 n). Integers below 2^52 are converted to and from doubles by
+   adding 2^52, which places them in the mantissa.
+*/
+#define MAGIC UWORD(0x4330000000000000)
+
+AVX2 void _nmod_multi_vec_mul_avx2(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    double dp[8];
+    __m256i a, b, q, r, n[2], magic = _mm256_set1_epi64x(MAGIC);
+    __m256i zero = _mm256_setzero_si256();
+    __m256d ad, bd, ninv[2], magicd = _mm256_set1_pd(4503599627370496.0);
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    for (t = 0; t < 8; t++)
+        dp[t] = 1.0 / (double) np[t];
+    n[0] = _mm256_loadu_si256((const __m256i *) np);
+    n[1] = _mm256_loadu_si256((const __m256i *) (np + 4));
+    ninv[0] = _mm256_loadu_pd(dp);
+    ninv[1] = _mm256_loadu_pd(dp + 4);
+
+    for (i = 0; i + 4 <= L; i += 4)
+    {
+        t = (i >> 2) & 1;
+
+        a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+
+        ad = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(a, magic)),
+                           magicd);
+        bd = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(b, magic)),
+                           magicd);
+        ad = _mm256_floor_pd(_mm256_mul_pd(_mm256_mul_pd(ad, bd), ninv[t]));
+        q = _mm256_xor_si256(_mm256_castpd_si256(_mm256_add_pd(ad, magicd)),
+                             magic);
+
+        r = _mm256_sub_epi64(_mm256_mul_epu32(a, b),
+                             _mm256_mul_epu32(q, n[t]));
+        r = _mm256_add_epi64(r, _mm256_and_si256(
+                                     _mm256_cmpgt_epi64(zero, r), n[t]));
+        r = _mm256_sub_epi64(r, _mm256_andnot_si256(
+                                     _mm256_cmpgt_epi64(n[t], r), n[t]));
+
+        _mm256_storeu_si256((__m256i *) (res + i), r);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_mul(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+AVX2 void _nmod_multi_vec_scalar_mul_avx2(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M)
+{
+    mp_limb_t np[8], cp[8], wp[8];
+    __m256i a, n[2], cc[2], w[2];
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    multi_pattern(cp, c, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = (cp[t] << 32) / np[t];
+    for (t = 0; t < 2; t++)
+    {
+        n[t] = _mm256_loadu_si256((const __m256i *) (np + 4*t));
+        cc[t] = _mm256_loadu_si256((const __m256i *) (cp + 4*t));
+        w[t] = _mm256_loadu_si256((const __m256i *) (wp + 4*t));
+    }
+
+    for (i = 0; i + 4 <= L; i += 4)
+    {
+        t = (i >> 2) & 1;
+        a = _mm256_loadu_si256((const __m256i *) (vec + i));
+        SHOUP_MUL32(a, a, cc[t], w[t], n[t]);
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_mul(vec[i], c[i % M->num], M->mod[i % M->num]);
+}
+
+AVX2 void _nmod_multi_vec_scalar_addmul_avx2(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M)
+{
+    mp_limb_t np[8], cp[8], wp[8];
+    __m256i a, n[2], cc[2], w[2];
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    multi_pattern(cp, c, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = (cp[t] << 32) / np[t];
+    for (t = 0; t < 2; t++)
+    {
+        n[t] = _mm256_loadu_si256((const __m256i *) (np + 4*t));
+        cc[t] = _mm256_loadu_si256((const __m256i *) (cp + 4*t));
+        w[t] = _mm256_loadu_si256((const __m256i *) (wp + 4*t));
+    }
+
+    for (i = 0; i + 4 <= L; i += 4)
+    {
+        t = (i >> 2) & 1;
+        a = _mm256_loadu_si256((const __m256i *) (vec + i));
+        SHOUP_MUL32(a, a, cc[t], w[t], n[t]);
+        a = _mm256_add_epi64(a, _mm256_loadu_si256((const __m256i *) (res + i)));
+        a = _mm256_sub_epi64(a, _mm256_andnot_si256(
+                                     _mm256_cmpgt_epi64(n[t], a), n[t]));
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < L; i++)
+        NMOD_ADDMUL(res[i], vec[i], c[i % M->num], M->mod[i % M->num]);
+}
+
+/*
+   Sets the 8 words res to res x + vec[8 b, 8 b + 8) for b = len - 1, ..., 0,
+   where the 8 words x are reduced modulo the corresponding moduli.
+*/
+AVX2 void _nmod_multi_vec_horner_avx2(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M)
+{
+    mp_limb_t np[8], wp[8];
+    __m256i r[2], n[2], xx[2], w[2];
+    slong b, t;
+
+    multi_pattern(np, NULL, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = (x[t] << 32) / np[t];
+    for (t = 0; t < 2; t++)
+    {
+        n[t] = _mm256_loadu_si256((const __m256i *) (np + 4*t));
+        xx[t] = _mm256_loadu_si256((const __m256i *) (x + 4*t));
+        w[t] = _mm256_loadu_si256((const __m256i *) (wp + 4*t));
+        r[t] = _mm256_loadu_si256((const __m256i *) (res + 4*t));
+    }
+
+    for (b = len - 1; b >= 0; b--)
+    {
+        for (t = 0; t < 2; t++)
+        {
+            SHOUP_MUL32(r[t], r[t], xx[t], w[t], n[t]);
+            r[t] = _mm256_add_epi64(r[t],
+                       _mm256_loadu_si256((const __m256i *) (vec + 8*b + 4*t)));
+            r[t] = _mm256_sub_epi64(r[t], _mm256_andnot_si256(
+                                     _mm256_cmpgt_epi64(n[t], r[t]), n[t]));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i *) res, r[0]);
+    _mm256_storeu_si256((__m256i *) (res + 4), r[1]);
+}
+
+#endif
@@ -0,0 +1,596 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "nmod_vec.h"
+
+#if NMOD_VEC_SIMD
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <immintrin.h>
+#undef ulong
+#define ulong mp_limb_t
+
+#define AVX512 __attribute__((target("avx512f")))
+#define IFMA __attribute__((target("avx512f,avx512ifma")))
+
+#define LOAD(p) _mm512_loadu_si512((const void *) (p))
+#define STORE(p, x) _mm512_storeu_si512((void *) (p), x)
+
+/* x - n if x >= n, for x < 2 n */
+#define REDUCE_2N(x, n) _mm512_min_epu64(x, _mm512_sub_epi64(x, n))
+
+AVX512 void _nmod_vec_add_avx512(mp_ptr res, mp_srcptr vec1,
+                                   mp_srcptr vec2, slong len, nmod_t mod)
+{
+    __m512i a, b, nb, n = _mm512_set1_epi64(mod.n);
+    __mmask8 m;
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        a = LOAD(vec1 + i);
+        b = LOAD(vec2 + i);
+
+        /* a + b if a < n - b, else a - (n - b); this cannot overflow */
+        nb = _mm512_sub_epi64(n, b);
+        m = _mm512_cmplt_epu64_mask(a, nb);
+        a = _mm512_mask_add_epi64(_mm512_sub_epi64(a, nb), m, a, b);
+
+        STORE(res + i, a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = nmod_add(vec1[i], vec2[i], mod);
+}
+
+AVX512 void _nmod_vec_sub_avx512(mp_ptr res, mp_srcptr vec1,
+                                   mp_srcptr vec2, slong len, nmod_t mod)
+{
+    __m512i a, b, n = _mm512_set1_epi64(mod.n);
+    __mmask8 m;
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        a = LOAD(vec1 + i);
+        b = LOAD(vec2 + i);
+
+        m = _mm512_cmplt_epu64_mask(a, b);
+        a = _mm512_sub_epi64(a, b);
+        a = _mm512_mask_add_epi64(a, m, a, n);
+
+        STORE(res + i, a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = nmod_sub(vec1[i], vec2[i], mod);
+}
+
+/* as for AVX2, Shoup's method with w = floor(c 2^32 / n) for n < 2^32 */
+#define SHOUP_MUL32(r, a, c, w, n) \
+    do { \
+        __m512i __q = _mm512_srli_epi64(_mm512_mul_epu32(a, w), 32); \
+        (r) = _mm512_sub_epi64(_mm512_mul_epu32(a, c), \
+                               _mm512_mul_epu32(__q, n)); \
+        (r) = REDUCE_2N(r, n); \
+    } while (0)
+
+AVX512 void _nmod_vec_scalar_mul_nmod_avx512(mp_ptr res, mp_srcptr vec,
+                                   slong len, mp_limb_t c, nmod_t mod)
+{
+    __m512i a, n = _mm512_set1_epi64(mod.n), cc = _mm512_set1_epi64(c);
+    __m512i w = _mm512_set1_epi64((c << 32) / mod.n);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL32(a, a, cc, w, n);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_mulmod2_preinv(vec[i], c, mod.n, mod.ninv);
+}
+
+AVX512 void _nmod_vec_scalar_addmul_nmod_avx512(mp_ptr res, mp_srcptr vec,
+                                   slong len, mp_limb_t c, nmod_t mod)
+{
+    __m512i a, n = _mm512_set1_epi64(mod.n), cc = _mm512_set1_epi64(c);
+    __m512i w = _mm512_set1_epi64((c << 32) / mod.n);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL32(a, a, cc, w, n);
+        a = _mm512_add_epi64(a, LOAD(res + i));
+        a = REDUCE_2N(a, n);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < len; i++)
+        NMOD_ADDMUL(res[i], vec[i], c, mod);
+}
+
+AVX512 mp_limb_t _nmod_vec_dot_avx512(mp_srcptr vec1, mp_srcptr vec2,
+                                                     slong len, nmod_t mod)
+{
+    __m512i p, lo = _mm512_setzero_si512(), hi = _mm512_setzero_si512();
+    __m512i mask = _mm512_set1_epi64(0xffffffff);
+    mp_limb_t s0, s1, t0, t1, r;
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        p = _mm512_mul_epu32(LOAD(vec1 + i), LOAD(vec2 + i));
+        lo = _mm512_add_epi64(lo, _mm512_and_si512(p, mask));
+        hi = _mm512_add_epi64(hi, _mm512_srli_epi64(p, 32));
+    }
+
+    t0 = _mm512_reduce_add_epi64(lo);
+    t1 = _mm512_reduce_add_epi64(hi);
+
+    for ( ; i < len; i++)
+    {
+        s0 = vec1[i] * vec2[i];
+        t0 += s0 & 0xffffffff;
+        t1 += s0 >> 32;
+    }
+
+    s1 = t1 >> 32;
+    s0 = t1 << 32;
+    add_ssaaaa(s1, s0, s1, s0, 0, t0);
+
+    NMOD2_RED2(r, s1, s0, mod);
+
+    return r;
+}
+
+/*
+   With IFMA the 52 bit multiplier gives Shoup's method for n < 2^50 with
+   w = floor(c 2^52 / n): for a, c < n the remainder a c - q n is below
+   2 n < 2^52, so it is determined by the low 52 bits of the products.
+*/
+#define MASK52 ((UWORD(1) << 52) - 1)
+
+#define SHOUP_MUL52(r, a, c, w, n, zero, mask) \
+    do { \
+        __m512i __q = _mm512_madd52hi_epu64(zero, a, w); \
+        (r) = _mm512_sub_epi64(_mm512_madd52lo_epu64(zero, a, c), \
+                               _mm512_madd52lo_epu64(zero, __q, n)); \
+        (r) = _mm512_and_si512(r, mask); \
+        (r) = REDUCE_2N(r, n); \
+    } while (0)
+
+static mp_limb_t shoup_precomp52(mp_limb_t c, mp_limb_t n)
+{
+    mp_limb_t q, r;
+
+    udiv_qrnnd(q, r, c >> 12, c << 52, n);
+
+    return q;
+}
+
+IFMA void _nmod_vec_scalar_mul_nmod_ifma(mp_ptr res, mp_srcptr vec,
+                                   slong len, mp_limb_t c, nmod_t mod)
+{
+    __m512i a, n = _mm512_set1_epi64(mod.n), cc = _mm512_set1_epi64(c);
+    __m512i w = _mm512_set1_epi64(shoup_precomp52(c, mod.n));
+    __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL52(a, a, cc, w, n, zero, mask);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_mulmod2_preinv(vec[i], c, mod.n, mod.ninv);
+}
+
+IFMA void _nmod_vec_scalar_addmul_nmod_ifma(mp_ptr res, mp_srcptr vec,
+                                   slong len, mp_limb_t c, nmod_t mod)
+{
+    __m512i a, n = _mm512_set1_epi64(mod.n), cc = _mm512_set1_epi64(c);
+    __m512i w = _mm512_set1_epi64(shoup_precomp52(c, mod.n));
+    __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL52(a, a, cc, w, n, zero, mask);
+        a = _mm512_add_epi64(a, LOAD(res + i));
+        a = REDUCE_2N(a, n);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < len; i++)
+        NMOD_ADDMUL(res[i], vec[i], c, mod);
+}
+
+/*
+   The products are split into their low and high 52 bits, which are summed
+   separately. Each lane takes at most 2^8 terms before the lanes are added
+   into the two limb totals, so that neither the lanes nor their sum can
+   overflow.
+*/
+IFMA mp_limb_t _nmod_vec_dot_ifma(mp_srcptr vec1, mp_srcptr vec2,
+                                                     slong len, nmod_t mod)
+{
+    __m512i a, b, lo, hi, zero = _mm512_setzero_si512();
+    mp_limb_t l1 = 0, l0 = 0, h1 = 0, h0 = 0, s2, s1, s0, t1, t0, r;
+    slong i, stop;
+
+    for (i = 0; i + 8 <= len; )
+    {
+        stop = FLINT_MIN(len, i + 8 * (WORD(1) << 8));
+        lo = hi = zero;
+
+        for ( ; i + 8 <= stop; i += 8)
+        {
+            a = LOAD(vec1 + i);
+            b = LOAD(vec2 + i);
+            lo = _mm512_madd52lo_epu64(lo, a, b);
+            hi = _mm512_madd52hi_epu64(hi, a, b);
+        }
+
+        add_ssaaaa(l1, l0, l1, l0, 0, _mm512_reduce_add_epi64(lo));
+        add_ssaaaa(h1, h0, h1, h0, 0, _mm512_reduce_add_epi64(hi));
+    }
+
+    for ( ; i < len; i++)
+    {
+        umul_ppmm(t1, t0, vec1[i], vec2[i]);
+        add_ssaaaa(l1, l0, l1, l0, 0, t0 & MASK52);
+        add_ssaaaa(h1, h0, h1, h0, 0, (t1 << 12) | (t0 >> 52));
+    }
+
+    /* s2:s1:s0 = h 2^52 + l */
+    s2 = h1 >> 12;
+    s1 = (h1 << 52) | (h0 >> 12);
+    s0 = h0 << 52;
+    add_sssaaaaaa(s2, s1, s0, s2, s1, s0, 0, l1, l0);
+
+    NMOD_RED(s2, s2, mod);
+    NMOD_RED3(r, s2, s1, s0, mod);
+
+    return r;
+}
+
+/* multi-modulus kernels; see avx2.c */
+static void multi_pattern(mp_ptr r, mp_srcptr c, const nmod_multi_struct * M)
+{
+    slong t;
+
+    for (t = 0; t < 8; t++)
+        r[t] = (c == NULL) ? M->mod[t % M->num].n : c[t % M->num];
+}
+
+AVX512 void _nmod_multi_vec_add_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    __m512i a, b, nb, n;
+    __mmask8 m;
+    slong i, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    n = LOAD(np);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec1 + i);
+        b = LOAD(vec2 + i);
+
+        nb = _mm512_sub_epi64(n, b);
+        m = _mm512_cmplt_epu64_mask(a, nb);
+        a = _mm512_mask_add_epi64(_mm512_sub_epi64(a, nb), m, a, b);
+
+        STORE(res + i, a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_add(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+AVX512 void _nmod_multi_vec_sub_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    __m512i a, b, n;
+    __mmask8 m;
+    slong i, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    n = LOAD(np);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec1 + i);
+        b = LOAD(vec2 + i);
+
+        m = _mm512_cmplt_epu64_mask(a, b);
+        a = _mm512_sub_epi64(a, b);
+        a = _mm512_mask_add_epi64(a, m, a, n);
+
+        STORE(res + i, a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_sub(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+/*
+   As for AVX2, the quotient of a product of two vectors is estimated in
+   double precision. For n < 2^50 the error is below 1, so that the
+   remainder is in [-n, 2 n), which with IFMA is determined by the low 52
+   bits of the products.
+*/
+#define MAGIC UWORD(0x4330000000000000)
+
+#define TO_DOUBLE(x, magic, magicd) \
+    _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(x, magic)), magicd)
+
+#define MUL_QUOTIENT(q, a, b, ninv, magic, magicd) \
+    do { \
+        __m512d __p = _mm512_mul_pd(TO_DOUBLE(a, magic, magicd), \
+                                    TO_DOUBLE(b, magic, magicd)); \
+        __p = _mm512_roundscale_pd(_mm512_mul_pd(__p, ninv), \
+                               _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); \
+        (q) = _mm512_xor_si512(_mm512_castpd_si512( \
+                               _mm512_add_pd(__p, magicd)), magic); \
+    } while (0)
+
+AVX512 void _nmod_multi_vec_mul_avx512(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    double dp[8];
+    __m512i a, b, q, r, n, zero = _mm512_setzero_si512();
+    __m512i magic = _mm512_set1_epi64(MAGIC);
+    __m512d ninv, magicd = _mm512_set1_pd(4503599627370496.0);
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    for (t = 0; t < 8; t++)
+        dp[t] = 1.0 / (double) np[t];
+    n = LOAD(np);
+    ninv = _mm512_loadu_pd(dp);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec1 + i);
+        b = LOAD(vec2 + i);
+
+        MUL_QUOTIENT(q, a, b, ninv, magic, magicd);
+        r = _mm512_sub_epi64(_mm512_mul_epu32(a, b), _mm512_mul_epu32(q, n));
+        r = _mm512_mask_add_epi64(r, _mm512_cmplt_epi64_mask(r, zero), r, n);
+        r = REDUCE_2N(r, n);
+
+        STORE(res + i, r);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_mul(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+AVX512 void _nmod_multi_vec_scalar_mul_avx512(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M)
+{
+    mp_limb_t np[8], cp[8], wp[8];
+    __m512i a, n, cc, w;
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    multi_pattern(cp, c, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = (cp[t] << 32) / np[t];
+    n = LOAD(np);
+    cc = LOAD(cp);
+    w = LOAD(wp);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL32(a, a, cc, w, n);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_mul(vec[i], c[i % M->num], M->mod[i % M->num]);
+}
+
+AVX512 void _nmod_multi_vec_scalar_addmul_avx512(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M)
+{
+    mp_limb_t np[8], cp[8], wp[8];
+    __m512i a, n, cc, w;
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    multi_pattern(cp, c, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = (cp[t] << 32) / np[t];
+    n = LOAD(np);
+    cc = LOAD(cp);
+    w = LOAD(wp);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL32(a, a, cc, w, n);
+        a = _mm512_add_epi64(a, LOAD(res + i));
+        a = REDUCE_2N(a, n);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < L; i++)
+        NMOD_ADDMUL(res[i], vec[i], c[i % M->num], M->mod[i % M->num]);
+}
+
+AVX512 void _nmod_multi_vec_horner_avx512(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M)
+{
+    mp_limb_t np[8], wp[8];
+    __m512i r, n, xx, w;
+    slong b, t;
+
+    multi_pattern(np, NULL, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = (x[t] << 32) / np[t];
+    n = LOAD(np);
+    xx = LOAD(x);
+    w = LOAD(wp);
+    r = LOAD(res);
+
+    for (b = len - 1; b >= 0; b--)
+    {
+        SHOUP_MUL32(r, r, xx, w, n);
+        r = _mm512_add_epi64(r, LOAD(vec + 8*b));
+        r = REDUCE_2N(r, n);
+    }
+
+    STORE(res, r);
+}
+
+IFMA void _nmod_multi_vec_mul_ifma(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    mp_limb_t np[8];
+    double dp[8];
+    __m512i a, b, q, r, n, zero = _mm512_setzero_si512();
+    __m512i magic = _mm512_set1_epi64(MAGIC);
+    __m512d ninv, magicd = _mm512_set1_pd(4503599627370496.0);
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    for (t = 0; t < 8; t++)
+        dp[t] = 1.0 / (double) np[t];
+    n = LOAD(np);
+    ninv = _mm512_loadu_pd(dp);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec1 + i);
+        b = LOAD(vec2 + i);
+
+        MUL_QUOTIENT(q, a, b, ninv, magic, magicd);
+        r = _mm512_sub_epi64(_mm512_madd52lo_epu64(zero, a, b),
+                             _mm512_madd52lo_epu64(zero, q, n));
+        /* sign extend from 52 bits */
+        r = _mm512_srai_epi64(_mm512_slli_epi64(r, 12), 12);
+        r = _mm512_mask_add_epi64(r, _mm512_cmplt_epi64_mask(r, zero), r, n);
+        r = REDUCE_2N(r, n);
+
+        STORE(res + i, r);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_mul(vec1[i], vec2[i], M->mod[i % M->num]);
+}
+
+IFMA void _nmod_multi_vec_scalar_mul_ifma(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M)
+{
+    mp_limb_t np[8], cp[8], wp[8];
+    __m512i a, n, cc, w;
+    __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    multi_pattern(cp, c, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = shoup_precomp52(cp[t], np[t]);
+    n = LOAD(np);
+    cc = LOAD(cp);
+    w = LOAD(wp);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL52(a, a, cc, w, n, zero, mask);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < L; i++)
+        res[i] = nmod_mul(vec[i], c[i % M->num], M->mod[i % M->num]);
+}
+
+IFMA void _nmod_multi_vec_scalar_addmul_ifma(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr c, const nmod_multi_t M)
+{
+    mp_limb_t np[8], cp[8], wp[8];
+    __m512i a, n, cc, w;
+    __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+    slong i, t, L = len * M->num;
+
+    multi_pattern(np, NULL, M);
+    multi_pattern(cp, c, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = shoup_precomp52(cp[t], np[t]);
+    n = LOAD(np);
+    cc = LOAD(cp);
+    w = LOAD(wp);
+
+    for (i = 0; i + 8 <= L; i += 8)
+    {
+        a = LOAD(vec + i);
+        SHOUP_MUL52(a, a, cc, w, n, zero, mask);
+        a = _mm512_add_epi64(a, LOAD(res + i));
+        a = REDUCE_2N(a, n);
+        STORE(res + i, a);
+    }
+
+    for ( ; i < L; i++)
+        NMOD_ADDMUL(res[i], vec[i], c[i % M->num], M->mod[i % M->num]);
+}
+
+IFMA void _nmod_multi_vec_horner_ifma(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M)
+{
+    mp_limb_t np[8], wp[8];
+    __m512i r, n, xx, w;
+    __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+    slong b, t;
+
+    multi_pattern(np, NULL, M);
+    for (t = 0; t < 8; t++)
+        wp[t] = shoup_precomp52(x[t], np[t]);
+    n = LOAD(np);
+    xx = LOAD(x);
+    w = LOAD(wp);
+    r = LOAD(res);
+
+    for (b = len - 1; b >= 0; b--)
+    {
+        SHOUP_MUL52(r, r, xx, w, n, zero, mask);
+        r = _mm512_add_epi64(r, LOAD(vec + 8*b));
+        r = REDUCE_2N(r, n);
+    }
+
+    STORE(res, r);
+}
+
+#endif
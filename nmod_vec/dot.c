@@ -34,6 +34,21 @@ _nmod_vec_dot(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod, int nlimbs)
 {
     mp_limb_t res;
     slong i;
+
+#if NMOD_VEC_SIMD
+    if (len >= NMOD_VEC_SIMD_CUTOFF && len < (WORD(1) << 32))
+    {
+        int cpu = flint_cpu_features();
+
+        if (mod.n <= (UWORD(1) << 32) && (cpu & FLINT_CPU_AVX512))
+            return _nmod_vec_dot_avx512(vec1, vec2, len, mod);
+        else if (mod.n <= (UWORD(1) << 32) && (cpu & FLINT_CPU_AVX2))
+            return _nmod_vec_dot_avx2(vec1, vec2, len, mod);
+        else if (mod.norm >= FLINT_BITS - 50 && (cpu & FLINT_CPU_AVX512IFMA))
+            return _nmod_vec_dot_ifma(vec1, vec2, len, mod);
+    }
+#endif
+
     NMOD_VEC_DOT(res, i, len, vec1[i], vec2[i], mod, nlimbs);
     return res;
 }
@@ -0,0 +1,91 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+
+void _nmod_multi_vec_horner(mp_ptr res, mp_srcptr vec,
+                        slong len, mp_srcptr x, const nmod_multi_t M)
+{
+    slong i, j, k = M->num;
+
+#if NMOD_VEC_SIMD
+    if (NMOD_MULTI_SIMD(M, len))
+    {
+        int cpu = flint_cpu_features();
+        void (* kernel)(mp_ptr, mp_srcptr, slong, mp_srcptr,
+                                                 const nmod_multi_t) = NULL;
+
+        if (M->bits <= 32 && (cpu & FLINT_CPU_AVX512))
+            kernel = _nmod_multi_vec_horner_avx512;
+        else if (M->bits <= 32 && (cpu & FLINT_CPU_AVX2))
+            kernel = _nmod_multi_vec_horner_avx2;
+        else if (M->bits <= 50 && (cpu & FLINT_CPU_AVX512IFMA))
+            kernel = _nmod_multi_vec_horner_ifma;
+
+        if (kernel != NULL)
+        {
+            /*
+               Each block of 8 words holds m = 8/k consecutive entries, so
+               the kernel evaluates the m polynomials made of the entries
+               congruent to r mod m at x^m, which are then combined. The
+               entries above the last full block are evaluated first and
+               enter as the starting value of the polynomial for r = 0.
+            */
+            slong r, m = 8 / k, nb = len / m;
+            mp_limb_t acc[8], xm[8];
+
+            for (i = 0; i < 8; i++)
+            {
+                acc[i] = 0;
+                xm[i] = n_powmod2_preinv(x[i % k], m,
+                                  M->mod[i % k].n, M->mod[i % k].ninv);
+            }
+
+            for (i = 0; i < k; i++)
+                for (j = len - 1; j >= nb*m; j--)
+                    acc[i] = nmod_add(nmod_mul(acc[i], x[i], M->mod[i]),
+                                                   vec[j*k + i], M->mod[i]);
+
+            kernel(acc, vec, nb, xm, M);
+
+            for (i = 0; i < k; i++)
+            {
+                res[i] = acc[(m - 1)*k + i];
+                for (r = m - 2; r >= 0; r--)
+                    res[i] = nmod_add(nmod_mul(res[i], x[i], M->mod[i]),
+                                                     acc[r*k + i], M->mod[i]);
+            }
+
+            return;
+        }
+    }
+#endif
+
+    for (i = 0; i < k; i++)
+    {
+        res[i] = 0;
+        for (j = len - 1; j >= 0; j--)
+            res[i] = nmod_add(nmod_mul(res[i], x[i], M->mod[i]),
+                                                   vec[j*k + i], M->mod[i]);
+    }
+}
@@ -0,0 +1,58 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+
+void nmod_multi_init(nmod_multi_t M, mp_srcptr moduli, slong num)
+{
+    slong i;
+
+    if (num < 1 || num > NMOD_MULTI_MAX)
+    {
+        flint_printf("Exception (nmod_multi_init). Invalid number of moduli.\n");
+        abort();
+    }
+
+    M->num = num;
+    M->bits = 0;
+
+    for (i = 0; i < num; i++)
+    {
+        nmod_init(M->mod + i, moduli[i]);
+        M->bits = FLINT_MAX(M->bits, FLINT_BIT_COUNT(moduli[i]));
+    }
+}
+
+mp_bitcnt_t nmod_multi_simd_mul_bits(void)
+{
+#if NMOD_VEC_SIMD
+    int cpu = flint_cpu_features();
+
+    if (cpu & FLINT_CPU_AVX512IFMA)
+        return 50;
+    else if (cpu & (FLINT_CPU_AVX512 | FLINT_CPU_AVX2))
+        return 32;
+#endif
+
+    return 0;
+}
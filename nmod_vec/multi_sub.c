@@ -0,0 +1,50 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+
+void _nmod_multi_vec_sub(mp_ptr res, mp_srcptr vec1,
+                        mp_srcptr vec2, slong len, const nmod_multi_t M)
+{
+    slong i, j, k = M->num;
+
+#if NMOD_VEC_SIMD
+    if (NMOD_MULTI_SIMD(M, len))
+    {
+        int cpu = flint_cpu_features();
+
+        if (cpu & FLINT_CPU_AVX512)
+        {
+            _nmod_multi_vec_sub_avx512(res, vec1, vec2, len, M);
+            return;
+        } else if (cpu & FLINT_CPU_AVX2)
+        {
+            _nmod_multi_vec_sub_avx2(res, vec1, vec2, len, M);
+            return;
+        }
+    }
+#endif
+
+    for (j = 0; j < len; j++)
+        for (i = 0; i < k; i++)
+            res[j*k + i] = nmod_sub(vec1[j*k + i], vec2[j*k + i], M->mod[i]);
+}
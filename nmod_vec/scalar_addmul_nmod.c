@@ -32,6 +32,29 @@
 void _nmod_vec_scalar_addmul_nmod(mp_ptr res, mp_srcptr vec, 
 				             slong len, mp_limb_t c, nmod_t mod)
 {
+#if NMOD_VEC_SIMD
+    if (len >= NMOD_VEC_SIMD_CUTOFF && c < mod.n)
+    {
+        int cpu = flint_cpu_features();
+
+        if (mod.norm >= FLINT_BITS/2 && (cpu & FLINT_CPU_AVX512))
+        {
+            _nmod_vec_scalar_addmul_nmod_avx512(res, vec, len, c, mod);
+            return;
+        }
+        else if (mod.norm >= FLINT_BITS/2 && (cpu & FLINT_CPU_AVX2))
+        {
+            _nmod_vec_scalar_addmul_nmod_avx2(res, vec, len, c, mod);
+            return;
+        }
+        else if (mod.norm >= FLINT_BITS - 50 && (cpu & FLINT_CPU_AVX512IFMA))
+        {
+            _nmod_vec_scalar_addmul_nmod_ifma(res, vec, len, c, mod);
+            return;
+        }
+    }
+#endif
+
     if (mod.norm >= FLINT_BITS/2) /* addmul will fit in a limb */
     {
         mpn_addmul_1(res, vec, len, c);
@@ -32,6 +32,27 @@
 void _nmod_vec_scalar_mul_nmod(mp_ptr res, mp_srcptr vec, 
 				                  slong len, mp_limb_t c, nmod_t mod)
 {
+#if NMOD_VEC_SIMD
+   if (len >= NMOD_VEC_SIMD_CUTOFF && c < mod.n)
+   {
+      int cpu = flint_cpu_features();
+
+      if (mod.norm >= FLINT_BITS/2 && (cpu & FLINT_CPU_AVX512))
+      {
+         _nmod_vec_scalar_mul_nmod_avx512(res, vec, len, c, mod);
+         return;
+      } else if (mod.norm >= FLINT_BITS/2 && (cpu & FLINT_CPU_AVX2))
+      {
+         _nmod_vec_scalar_mul_nmod_avx2(res, vec, len, c, mod);
+         return;
+      } else if (mod.norm >= FLINT_BITS - 50 && (cpu & FLINT_CPU_AVX512IFMA))
+      {
+         _nmod_vec_scalar_mul_nmod_ifma(res, vec, len, c, mod);
+         return;
+      }
+   }
+#endif
+
    if (mod.norm >= FLINT_BITS/2) /* products will fit in a limb */
    {
       mpn_mul_1(res, vec, len, c);
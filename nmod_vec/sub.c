@@ -33,6 +33,24 @@ void _nmod_vec_sub(mp_ptr res, mp_srcptr vec1,
 				   mp_srcptr vec2, slong len, nmod_t mod)
 {
    slong i;
+
+#if NMOD_VEC_SIMD
+   if (len >= NMOD_VEC_SIMD_CUTOFF)
+   {
+      int cpu = flint_cpu_features();
+
+      if (cpu & FLINT_CPU_AVX512)
+      {
+         _nmod_vec_sub_avx512(res, vec1, vec2, len, mod);
+         return;
+      } else if (cpu & FLINT_CPU_AVX2)
+      {
+         _nmod_vec_sub_avx2(res, vec1, vec2, len, mod);
+         return;
+      }
+   }
+#endif
+
    if (mod.norm)
    {
 	  for (i = 0 ; i < len; i++)
@@ -0,0 +1,188 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+/* compare the multi-modulus functions with the operations done one modulus
+   at a time, for random sets of cpu features */
+int
+main(void)
+{
+    int iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("multi....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 10000 * flint_test_multiplier(); iter++)
+    {
+        slong len = n_randint(state, 100), k, i, j;
+        mp_limb_t moduli[NMOD_MULTI_MAX], c[NMOD_MULTI_MAX];
+        mp_limb_t r[NMOD_MULTI_MAX], s[NMOD_MULTI_MAX];
+        nmod_multi_t M;
+        mp_ptr a, b, r1, r2;
+        int op, features;
+
+        k = n_randint(state, 3) ? (WORD(1) << n_randint(state, 4))
+                                : n_randint(state, NMOD_MULTI_MAX) + 1;
+
+        for (i = 0; i < k; i++)
+        {
+            switch (n_randint(state, 5))
+            {
+                case 0: moduli[i] = n_randtest_not_zero(state); break;
+                case 1: moduli[i] = n_randint(state, UWORD(1) << 32) + 1; break;
+                case 2: moduli[i] = (UWORD(1) << 32) - n_randint(state, 2);
+                        break;
+                case 3: moduli[i] = (UWORD(1) << 50) - n_randint(state, 100) - 1;
+                        break;
+                default: moduli[i] = UWORD_MAX - n_randint(state, 100); break;
+            }
+        }
+
+        /* a common size class for most sets of moduli */
+        if (n_randint(state, 2))
+            for (i = 1; i < k; i++)
+                moduli[i] = (n_randint(state, 2) || moduli[0] < 2)
+                    ? moduli[0] : moduli[0] - n_randint(state, moduli[0] / 2);
+
+        nmod_multi_init(M, moduli, k);
+        features = n_randint(state, 8);
+
+        a = _nmod_vec_init(len * k + 1);
+        b = _nmod_vec_init(len * k + 1);
+        r1 = _nmod_vec_init(len * k + 1);
+        r2 = _nmod_vec_init(len * k + 1);
+
+        for (i = 0; i < k; i++)
+        {
+            c[i] = n_randint(state, moduli[i]);
+
+            for (j = 0; j < len; j++)
+            {
+                if (n_randint(state, 4))
+                    a[j*k + i] = n_randint(state, moduli[i]);
+                else
+                    a[j*k + i] = moduli[i] - 1 - n_randint(state, 2) % moduli[i];
+
+                if (n_randint(state, 4))
+                    b[j*k + i] = n_randint(state, moduli[i]);
+                else
+                    b[j*k + i] = moduli[i] - 1 - n_randint(state, 2) % moduli[i];
+            }
+        }
+
+        flint_set_cpu_features(features);
+        op = n_randint(state, 6);
+
+        for (i = 0; i < k; i++)
+        {
+            nmod_t mod = M->mod[i];
+
+            r[i] = 0;
+            for (j = len - 1; j >= 0; j--)
+            {
+                mp_limb_t x = a[j*k + i], y = b[j*k + i];
+
+                switch (op)
+                {
+                    case 0: r1[j*k + i] = nmod_add(x, y, mod); break;
+                    case 1: r1[j*k + i] = nmod_sub(x, y, mod); break;
+                    case 2: r1[j*k + i] = nmod_mul(x, y, mod); break;
+                    case 3: r1[j*k + i] = nmod_mul(x, c[i], mod); break;
+                    case 4: r1[j*k + i] = nmod_add(y, nmod_mul(x, c[i], mod),
+                                                                   mod); break;
+                    default:
+                        r[i] = nmod_add(nmod_mul(r[i], c[i], mod), x, mod);
+                        r1[j*k + i] = 0;
+                        break;
+                }
+            }
+        }
+
+        switch (op)
+        {
+            case 0: _nmod_multi_vec_add(r2, a, b, len, M); break;
+            case 1: _nmod_multi_vec_sub(r2, a, b, len, M); break;
+            case 2: _nmod_multi_vec_mul(r2, a, b, len, M); break;
+            case 3: _nmod_multi_vec_scalar_mul(r2, a, len, c, M); break;
+            case 4:
+                _nmod_vec_set(r2, b, len * k);
+                _nmod_multi_vec_scalar_addmul(r2, a, len, c, M);
+                break;
+            default:
+                _nmod_multi_vec_horner(s, a, len, c, M);
+                _nmod_vec_zero(r2, len * k);
+                break;
+        }
+
+        if (!_nmod_vec_equal(r1, r2, len * k)
+            || (op == 5 && !_nmod_vec_equal(r, s, k)))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("op = %d, len = %wd, k = %wd, features = %d\n",
+                                                  op, len, k, features);
+            abort();
+        }
+
+        /* aliasing, with vec2 at a later position of res */
+        if (len >= 1 && op <= 1)
+        {
+            _nmod_vec_set(r1, a, len * k);
+            _nmod_vec_set(r2, a, len * k);
+
+            for (j = 0; j < len - 1; j++)
+                for (i = 0; i < k; i++)
+                    r1[j*k + i] = (op == 0)
+                        ? nmod_add(r1[j*k + i], r1[(j + 1)*k + i], M->mod[i])
+                        : nmod_sub(r1[j*k + i], r1[(j + 1)*k + i], M->mod[i]);
+
+            if (op == 0)
+                _nmod_multi_vec_add(r2, r2, r2 + k, len - 1, M);
+            else
+                _nmod_multi_vec_sub(r2, r2, r2 + k, len - 1, M);
+
+            if (!_nmod_vec_equal(r1, r2, len * k))
+            {
+                flint_printf("FAIL (aliasing):\n");
+                flint_printf("op = %d, len = %wd, k = %wd, features = %d\n",
+                                                      op, len, k, features);
+                abort();
+            }
+        }
+
+        _nmod_vec_clear(a);
+        _nmod_vec_clear(b);
+        _nmod_vec_clear(r1);
+        _nmod_vec_clear(r2);
+    }
+
+    flint_set_cpu_features(-1);
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+/* compare the functions using each set of cpu features with generic code */
+int
+main(void)
+{
+    int i, features;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("simd....");
+    fflush(stdout);
+
+    for (i = 0; i < 10000 * flint_test_multiplier(); i++)
+    {
+        slong len = n_randint(state, 300) + 1;
+        mp_limb_t n, c, d1, d2;
+        nmod_t mod;
+        mp_ptr a, b, r1, r2;
+
+        switch (n_randint(state, 5))
+        {
+            case 0: n = n_randtest_not_zero(state); break;
+            case 1: n = n_randint(state, UWORD(1) << 32) + 1; break;
+            case 2: n = (UWORD(1) << 32) - n_randint(state, 2); break;
+            case 3: n = (UWORD(1) << 50) - n_randint(state, 100) - 1; break;
+            default: n = UWORD_MAX - n_randint(state, 100); break;
+        }
+
+        nmod_init(&mod, n);
+        c = n_randint(state, n);
+        features = n_randint(state, 8);
+
+        a = _nmod_vec_init(len);
+        b = _nmod_vec_init(len);
+        r1 = _nmod_vec_init(len);
+        r2 = _nmod_vec_init(len);
+
+        if (n_randint(state, 2))
+        {
+            _nmod_vec_randtest(a, state, len, mod);
+            _nmod_vec_randtest(b, state, len, mod);
+        } else
+        {
+            slong j;
+
+            for (j = 0; j < len; j++)
+            {
+                a[j] = n - 1 - n_randint(state, 2) % n;
+                b[j] = n - 1 - n_randint(state, 2) % n;
+            }
+        }
+
+        switch (n_randint(state, 5))
+        {
+            case 0:
+                flint_set_cpu_features(0);
+                _nmod_vec_add(r1, a, b, len, mod);
+                flint_set_cpu_features(features);
+                _nmod_vec_add(r2, a, b, len, mod);
+                break;
+            case 1:
+                flint_set_cpu_features(0);
+                _nmod_vec_sub(r1, a, b, len, mod);
+                flint_set_cpu_features(features);
+                _nmod_vec_sub(r2, a, b, len, mod);
+                break;
+            case 2:
+                flint_set_cpu_features(0);
+                _nmod_vec_scalar_mul_nmod(r1, a, len, c, mod);
+                flint_set_cpu_features(features);
+                _nmod_vec_scalar_mul_nmod(r2, a, len, c, mod);
+                break;
+            case 3:
+                _nmod_vec_set(r1, b, len);
+                _nmod_vec_set(r2, b, len);
+                flint_set_cpu_features(0);
+                _nmod_vec_scalar_addmul_nmod(r1, a, len, c, mod);
+                flint_set_cpu_features(features);
+                _nmod_vec_scalar_addmul_nmod(r2, a, len, c, mod);
+                break;
+            default:
+                flint_set_cpu_features(0);
+                d1 = _nmod_vec_dot(a, b, len, mod,
+                                  _nmod_vec_dot_bound_limbs(len, mod));
+                flint_set_cpu_features(features);
+                d2 = _nmod_vec_dot(a, b, len, mod,
+                                  _nmod_vec_dot_bound_limbs(len, mod));
+                _nmod_vec_zero(r1, len);
+                _nmod_vec_zero(r2, len);
+                r1[0] = d1;
+                r2[0] = d2;
+                break;
+        }
+
+        if (!_nmod_vec_equal(r1, r2, len))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("len = %wd, n = %wu, features = %d\n",
+                                                        len, n, features);
+            abort();
+        }
+
+        _nmod_vec_clear(a);
+        _nmod_vec_clear(b);
+        _nmod_vec_clear(r1);
+        _nmod_vec_clear(r2);
+    }
+
+    flint_set_cpu_features(-1);
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
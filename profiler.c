@@ -29,6 +29,7 @@
 #include <math.h>
 #include <float.h>
 #include <string.h>
+#include <pthread.h>
 #include "profiler.h"
 
 /*
@@ -114,10 +115,16 @@ prof_repeat(double *min, double *max, profile_target_t target, void *arg)
 void get_memory_usage(meminfo_t meminfo)
 {
     FILE * file = fopen("/proc/self/status", "r");
+    flint_memory_stats_t stats;
 
     ulong result;
     char line[128];
 
+    flint_get_memory_stats(stats);
+    meminfo->flint_live = FLINT_MAX(stats->current, 0) / 1024;
+    meminfo->flint_peak = stats->peak / 1024;
+    meminfo->flint_allocs = stats->allocs;
+
     while (fgets(line, 128, file) != NULL)
     {
         result = 0;
@@ -147,3 +154,172 @@ void get_memory_usage(meminfo_t meminfo)
     fclose(file);
 }
 
+
+/*
+   Named counters. Entries are added under a lock and published by
+   incrementing trace_num after they are filled in, so lookups of existing
+   names take no lock. Counts are updated atomically where the compiler
+   supports it.
+*/
+
+typedef struct
+{
+    char * name;
+    volatile slong count;
+    volatile slong size_sum;
+    volatile slong size_max;
+    volatile ulong cycles;
+    volatile slong size_hist[FLINT_BITS];
+} trace_struct;
+
+#if defined(__GNUC__)
+#define TRACE_ADD(xx, yy) __sync_add_and_fetch(&(xx), (yy))
+#define TRACE_CAS(xx, old, new) __sync_bool_compare_and_swap(&(xx), (old), (new))
+#else
+#define TRACE_ADD(xx, yy) ((xx) += (yy))
+#define TRACE_CAS(xx, old, new) ((xx) = (new), 1)
+#endif
+
+int flint_trace_enabled = 0;
+
+static trace_struct trace_table[FLINT_TRACE_MAX];
+static volatile slong trace_num = 0;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void flint_trace_enable(int on)
+{
+    flint_trace_enabled = on;
+}
+
+slong flint_trace_lookup(const char * name)
+{
+    slong i, n = trace_num;
+
+    for (i = 0; i < n; i++)
+        if (strcmp(trace_table[i].name, name) == 0)
+            return i;
+
+    pthread_mutex_lock(&trace_lock);
+
+    for ( ; i < trace_num; i++)
+        if (strcmp(trace_table[i].name, name) == 0)
+            break;
+
+    if (i == trace_num)
+    {
+        if (i == FLINT_TRACE_MAX)
+            i = -1;
+        else
+        {
+            trace_table[i].name = flint_malloc(strlen(name) + 1);
+            strcpy(trace_table[i].name, name);
+            TRACE_ADD(trace_num, 1); /* publish after the name */
+        }
+    }
+
+    pthread_mutex_unlock(&trace_lock);
+
+    return i;
+}
+
+void flint_trace_add(slong id, slong size, double cycles)
+{
+    trace_struct * t;
+    slong max, b;
+
+    if (id < 0)
+        return;
+
+    t = trace_table + id;
+
+    b = FLINT_MIN(FLINT_BIT_COUNT(size), FLINT_BITS - 1);
+
+    TRACE_ADD(t->count, 1);
+    TRACE_ADD(t->size_sum, size);
+    TRACE_ADD(t->cycles, (ulong) cycles);
+    TRACE_ADD(t->size_hist[b], 1);
+
+    while ((max = t->size_max) < size && !TRACE_CAS(t->size_max, max, size)) ;
+}
+
+int flint_trace_get(flint_trace_entry_t entry, const char * name)
+{
+    slong i, j, n = trace_num;
+
+    for (i = 0; i < n; i++)
+    {
+        if (strcmp(trace_table[i].name, name) == 0)
+        {
+            entry->name = trace_table[i].name;
+            entry->count = trace_table[i].count;
+            entry->size_sum = trace_table[i].size_sum;
+            entry->size_max = trace_table[i].size_max;
+            entry->cycles = trace_table[i].cycles;
+            for (j = 0; j < FLINT_BITS; j++)
+                entry->size_hist[j] = trace_table[i].size_hist[j];
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void flint_trace_reset(void)
+{
+    slong i, j, n = trace_num;
+
+    for (i = 0; i < n; i++)
+    {
+        trace_table[i].count = 0;
+        trace_table[i].size_sum = 0;
+        trace_table[i].size_max = 0;
+        trace_table[i].cycles = 0;
+        for (j = 0; j < FLINT_BITS; j++)
+            trace_table[i].size_hist[j] = 0;
+    }
+}
+
+void flint_trace_dump_json(FILE * file)
+{
+    slong i, j, n = trace_num;
+    const char * c;
+    int first;
+
+    flint_fprintf(file, "{\n  \"clockspeed\": %.0f,\n  \"counters\": [",
+                                                          FLINT_CLOCKSPEED);
+
+    for (i = 0; i < n; i++)
+    {
+        trace_struct * t = trace_table + i;
+
+        flint_fprintf(file, "%s\n    {\"name\": \"", i == 0 ? "" : ",");
+
+        for (c = t->name; *c != '\0'; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                fputc('\\', file);
+            fputc(*c, file);
+        }
+
+        flint_fprintf(file, "\", \"count\": %wd, \"size_sum\": %wd, "
+            "\"size_max\": %wd, \"cycles\": %wu, \"size_hist\": {",
+            t->count, t->size_sum, t->size_max, t->cycles);
+
+        /* keyed by bit length: key b counts sizes in [2^(b-1), 2^b) */
+        first = 1;
+        for (j = 0; j < FLINT_BITS; j++)
+        {
+            if (t->size_hist[j] != 0)
+            {
+                flint_fprintf(file, "%s\"%wd\": %wd", first ? "" : ", ",
+                                                        j, t->size_hist[j]);
+                first = 0;
+            }
+        }
+
+        flint_fprintf(file, "}}");
+    }
+
+    flint_fprintf(file, "\n  ]\n}\n");
+}
@@ -73,6 +73,9 @@ typedef struct
     ulong peak;
     ulong hwm;
     ulong rss;
+    ulong flint_live;   /* memory allocated by flint_malloc and friends */
+    ulong flint_peak;
+    ulong flint_allocs;
 } meminfo_t[1];
 
 FLINT_DLL void get_memory_usage(meminfo_t meminfo);
@@ -119,7 +122,7 @@ double get_cycle_counter()
 {
 #if defined( _MSC_VER )
     return (double)__rdtsc();
-#else
+#elif defined(__i386__) || defined(__x86_64__)
     unsigned int hi;
    unsigned int lo;
 
@@ -129,6 +132,9 @@ double get_cycle_counter()
        : "%edx", "%eax");
 
    return (double) hi * (1 << 30) * 4 + lo;
+#else
+   /* no cycle counter, so scale processor time instead */
+   return (double) clock() * (FLINT_CLOCKSPEED / CLOCKS_PER_SEC);
 #endif
 }
 
@@ -167,6 +173,86 @@ void stop_clock(int n)
    clock_accum[n] += (now - clock_last[n]);
 }
 
+/******************************************************************************
+
+    Named counters and timers
+
+******************************************************************************/
+
+#define FLINT_TRACE_MAX 256
+
+typedef struct
+{
+    const char * name;
+    slong count;
+    slong size_sum;
+    slong size_max;
+    double cycles;
+    slong size_hist[FLINT_BITS];  /* calls by bit length of the size */
+} flint_trace_entry_struct;
+
+typedef flint_trace_entry_struct flint_trace_entry_t[1];
+
+FLINT_DLL extern int flint_trace_enabled;
+
+FLINT_DLL void flint_trace_enable(int on);
+
+FLINT_DLL slong flint_trace_lookup(const char * name);
+
+FLINT_DLL void flint_trace_add(slong id, slong size, double cycles);
+
+FLINT_DLL int flint_trace_get(flint_trace_entry_t entry, const char * name);
+
+FLINT_DLL void flint_trace_reset(void);
+
+FLINT_DLL void flint_trace_dump_json(FILE * file);
+
+/*
+   Run call and, if tracing is enabled, charge it to the counter with the
+   given name. The name is looked up once per call site.
+*/
+#define FLINT_TRACE_CALL(name, size, call) \
+    do { \
+        if (flint_trace_enabled) \
+        { \
+            static slong __trace_id = -1; \
+            double __trace_start; \
+            if (__trace_id < 0) \
+                __trace_id = flint_trace_lookup(name); \
+            __trace_start = get_cycle_counter(); \
+            call; \
+            flint_trace_add(__trace_id, size, \
+                                  get_cycle_counter() - __trace_start); \
+        } \
+        else \
+        { \
+            call; \
+        } \
+    } while (0)
+
+/*
+   Whether tracing is enabled is decided once at the start, so a call to
+   flint_trace_enable between the markers does not charge a bogus time.
+*/
+#define FLINT_TRACE_START(name, size) \
+    do { \
+        static slong __trace_id = -1; \
+        slong __trace_size = (size); \
+        int __trace_on = flint_trace_enabled; \
+        double __trace_start = 0.0; \
+        if (__trace_on) \
+        { \
+            if (__trace_id < 0) \
+                __trace_id = flint_trace_lookup(name); \
+            __trace_start = get_cycle_counter(); \
+        }
+
+#define FLINT_TRACE_STOP \
+        if (__trace_on && __trace_id >= 0) \
+            flint_trace_add(__trace_id, __trace_size, \
+                                  get_cycle_counter() - __trace_start); \
+    } while (0)
+
 /******************************************************************************
 
     Framework for repeatedly sampling a single target
@@ -255,6 +341,19 @@ FLINT_DLL void prof_repeat(double* min, double* max, profile_target_t target, vo
             meminfo->rss / 1024.0, meminfo->hwm / 1024.0); \
     } while (0);
 
+#if WANT_MEMORY_STATS
+#define SHOW_FLINT_MEMORY_USAGE \
+    do { \
+        meminfo_t meminfo; \
+        get_memory_usage(meminfo); \
+        flint_printf("flint live/peak(MB) allocs: %.2f %.2f %wu\n", \
+            meminfo->flint_live / 1024.0, meminfo->flint_peak / 1024.0, \
+            meminfo->flint_allocs); \
+    } while (0);
+#else
+#define SHOW_FLINT_MEMORY_USAGE
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,151 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+
+/* count calls into the pool allocator */
+
+slong count = 0;
+
+void * count_malloc(size_t size)
+{
+    count++;
+    return flint_pool_malloc(size);
+}
+
+void * count_calloc(size_t num, size_t size)
+{
+    count++;
+    return flint_pool_calloc(num, size);
+}
+
+void * count_realloc(void * ptr, size_t size)
+{
+    count++;
+    return flint_pool_realloc(ptr, size);
+}
+
+void count_free(void * ptr)
+{
+    flint_pool_free(ptr);
+}
+
+int main(void)
+{
+    int i;
+    slong j;
+    void * (*alloc_func) (size_t);
+    void * (*calloc_func) (size_t, size_t);
+    void * (*realloc_func) (void *, size_t);
+    void (*free_func) (void *);
+    flint_rand_t state;
+
+    /* the functions must be set before anything is allocated */
+    flint_set_memory_functions(count_malloc, count_calloc,
+                                        count_realloc, count_free);
+
+    flint_randinit(state);
+
+    flint_printf("memory_functions....");
+    fflush(stdout);
+
+    flint_get_memory_functions(&alloc_func, &calloc_func,
+                                        &realloc_func, &free_func);
+
+    if (alloc_func != count_malloc || calloc_func != count_calloc ||
+        realloc_func != count_realloc || free_func != count_free)
+    {
+        flint_printf("FAIL (get_memory_functions)\n");
+        abort();
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        fmpz_t a, b, c;
+        mpz_t z;
+        slong before;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        fmpz_init(c);
+
+        fmpz_randtest(a, state, 2000);
+        fmpz_randtest_not_zero(b, state, 2000);
+
+        fmpz_mul(c, a, b);
+        fmpz_divexact(c, c, b);
+
+        if (!fmpz_equal(a, c))
+        {
+            flint_printf("FAIL (fmpz)\n");
+            fmpz_print(a); flint_printf("\n");
+            fmpz_print(b); flint_printf("\n");
+            abort();
+        }
+
+        /* GMP must allocate through the FLINT functions */
+        before = count;
+        mpz_init2(z, 100 + n_randint(state, 10000));
+        mpz_clear(z);
+
+        if (count == before)
+        {
+            flint_printf("FAIL (GMP not redirected)\n");
+            abort();
+        }
+
+        /* exercise the pool directly across size classes */
+        {
+            mp_ptr p = flint_malloc(n_randint(state, 300) * sizeof(mp_limb_t));
+            slong n = n_randint(state, 300);
+
+            p = flint_realloc(p, n * sizeof(mp_limb_t));
+            for (j = 0; j < n; j++)
+                p[j] = j;
+            p = flint_realloc(p, (n + n_randint(state, 300)) * sizeof(mp_limb_t));
+            for (j = 0; j < n; j++)
+            {
+                if (p[j] != j)
+                {
+                    flint_printf("FAIL (realloc)\n");
+                    abort();
+                }
+            }
+            flint_free(p);
+        }
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        fmpz_clear(c);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+
+    flint_set_memory_functions(NULL, NULL, NULL, NULL);
+
+    flint_printf("PASS\n");
+    return 0;
+}
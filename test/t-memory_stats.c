@@ -0,0 +1,98 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("memory_stats....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        flint_memory_stats_t s0, s1, s2, t1;
+        slong j, n = n_randint(state, 100);
+        void * ptr[100];
+        size_t size[100], total = 0;
+        fmpz_t f;
+
+        flint_reset_memory_stats();
+        flint_get_memory_stats(s0);
+
+        FLINT_MEMORY_TAG_START("t-memory_stats");
+
+        for (j = 0; j < n; j++)
+        {
+            size[j] = n_randint(state, 10000);
+            total += size[j];
+            ptr[j] = flint_malloc(size[j]);
+        }
+
+        FLINT_MEMORY_TAG_END;
+
+        flint_get_memory_stats(s1);
+        flint_get_tag_memory_stats(t1, "t-memory_stats");
+
+        for (j = 0; j < n; j++)
+            flint_free(ptr[j]);
+
+        /* limbs allocated by GMP are counted as well */
+        fmpz_init(f);
+        fmpz_randbits(f, state, 100000);
+        flint_get_memory_stats(s2);
+        fmpz_clear(f);
+
+#if WANT_MEMORY_STATS
+        if (s1->allocs - s0->allocs != n || s1->bytes - s0->bytes != total
+            || s1->current - s0->current != total
+            || s1->peak < s1->current || s0->allocs != 0
+            || t1->current != total || s2->current < 100000 / 8)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wd, total = %wu\n", n, (ulong) total);
+            flint_printf("allocs = %wd, bytes = %wd, current = %wd\n",
+                s1->allocs - s0->allocs, s1->bytes - s0->bytes,
+                s1->current - s0->current);
+            flint_printf("tag current = %wd\n", t1->current);
+            abort();
+        }
+#else
+        if (s1->allocs != 0 || s1->bytes != 0 || s1->current != 0
+            || t1->current != 0 || s2->peak != 0)
+        {
+            flint_printf("FAIL (disabled):\n");
+            abort();
+        }
+#endif
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
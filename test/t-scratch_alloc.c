@@ -0,0 +1,94 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+/*
+   Allocate and fill a block at each level of a recursion, then check that
+   deeper allocations and releases did not overwrite it.
+*/
+int check_level(flint_rand_t state, slong depth)
+{
+    mp_ptr a;
+    slong i, n;
+    int ok = 1;
+    SCRATCH_INIT;
+
+    SCRATCH_START;
+
+    n = n_randint(state, 3) == 0 ? n_randint(state, 100000)
+                                 : n_randint(state, 100);
+
+    a = SCRATCH_ALLOC(n * sizeof(mp_limb_t));
+    for (i = 0; i < n; i++)
+        a[i] = depth + i;
+
+    if (depth > 0)
+    {
+        ok = check_level(state, depth - 1);
+        if (n_randint(state, 2))
+            ok = ok && check_level(state, depth - 1);
+    }
+
+    for (i = 0; i < n; i++)
+        ok = ok && (a[i] == depth + i);
+
+    SCRATCH_END;
+
+    return ok;
+}
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("scratch_alloc....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        size_t limit = flint_get_scratch_limit();
+
+        if (n_randint(state, 4) == 0)
+            flint_set_scratch_limit(n_randint(state, 1000000));
+
+        if (!check_level(state, n_randint(state, 8)))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("i = %d\n", i);
+            abort();
+        }
+
+        flint_set_scratch_limit(limit);
+
+        if (n_randint(state, 100) == 0)
+            flint_cleanup();
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz_poly.h"
+#include "nmod_mat.h"
+#include "profiler.h"
+#include "thread_pool.h"
+#include "ulong_extras.h"
+
+void * trace_worker(void * arg_ptr)
+{
+    slong i, id = flint_trace_lookup("t-trace:threads");
+
+    for (i = 0; i < 1000; i++)
+        flint_trace_add(id, i, 1.0);
+
+    return NULL;
+}
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("trace....");
+    fflush(stdout);
+
+    for (i = 0; i < 100; i++)
+    {
+        flint_trace_entry_t e;
+        fmpz_poly_t a, b, c;
+        nmod_mat_t A, B, C;
+        slong len = n_randint(state, 20) + 1, dim = n_randint(state, 10) + 1;
+        slong count;
+
+        flint_trace_reset();
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        nmod_mat_init(A, dim, dim, 17);
+        nmod_mat_init(B, dim, dim, 17);
+        nmod_mat_init(C, dim, dim, 17);
+
+        fmpz_poly_randtest_not_zero(a, state, len, 10);
+        fmpz_poly_randtest_not_zero(b, state, len, 10);
+        nmod_mat_randtest(A, state);
+        nmod_mat_randtest(B, state);
+
+        /* nothing is counted while tracing is off */
+        flint_trace_enable(0);
+        nmod_mat_mul(C, A, B);
+
+        flint_trace_enable(1);
+        fmpz_poly_mul(c, a, b);
+        nmod_mat_mul(C, A, B);
+        flint_trace_enable(0);
+
+        if (!flint_trace_get(e, "nmod_mat_mul:classical") || e->count != 1
+            || e->size_max != dim || e->size_hist[FLINT_BIT_COUNT(dim)] != 1)
+        {
+            flint_printf("FAIL (nmod_mat_mul):\n");
+            flint_printf("dim = %wd\n", dim);
+            abort();
+        }
+
+        count = 0;
+        if (flint_trace_get(e, "fmpz_poly_mul:tiny1"))
+            count += e->count;
+        if (flint_trace_get(e, "fmpz_poly_mul:tiny2"))
+            count += e->count;
+        if (flint_trace_get(e, "fmpz_poly_mul:classical"))
+            count += e->count;
+        if (flint_trace_get(e, "fmpz_poly_mul:karatsuba"))
+            count += e->count;
+        if (flint_trace_get(e, "fmpz_poly_mul:KS"))
+            count += e->count;
+
+        if (count != (FLINT_MIN(a->length, b->length) > 1))
+        {
+            flint_printf("FAIL (fmpz_poly_mul):\n");
+            flint_printf("count = %wd\n", count);
+            abort();
+        }
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(C);
+    }
+
+    /* switching tracing on or off between the markers charges nothing */
+    {
+        flint_trace_entry_t e;
+        int on;
+
+        flint_trace_reset();
+
+        for (on = 1; on >= 0; on--)
+        {
+            flint_trace_enable(on);
+
+            FLINT_TRACE_START("t-trace:markers", 1);
+            flint_trace_enable(!on);
+            FLINT_TRACE_STOP;
+        }
+
+        flint_trace_enable(0);
+
+        if (!flint_trace_get(e, "t-trace:markers") || e->count != 1)
+        {
+            flint_printf("FAIL (markers):\n");
+            abort();
+        }
+    }
+
+    /* counters shared between threads */
+    {
+        flint_trace_entry_t e;
+        char args[4];
+        FILE * file;
+
+        flint_set_num_threads(4);
+        flint_trace_reset();
+
+        flint_parallel_map(trace_worker, args, 1, 4);
+
+        if (!flint_trace_get(e, "t-trace:threads") || e->count != 4000
+            || e->size_sum != 4 * 999 * 500 || e->size_max != 999
+            || e->cycles != 4000.0)
+        {
+            flint_printf("FAIL (threads):\n");
+            flint_printf("count = %wd, sum = %wd\n", e->count, e->size_sum);
+            abort();
+        }
+
+        file = tmpfile();
+        flint_trace_dump_json(file);
+        fclose(file);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    flint_printf("PASS\n");
+    return 0;
+}
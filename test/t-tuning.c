@@ -0,0 +1,213 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz_mat.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+#define TUNE_FILE "tuning_test"
+
+static int write_profile(const char * str)
+{
+    FILE * f = fopen(TUNE_FILE, "w");
+
+    fputs(str, f);
+    fclose(f);
+
+    return flint_tune_load(TUNE_FILE);
+}
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("tuning....");
+    fflush(stdout);
+
+    /* defaults */
+    if (NMOD_MAT_MUL_STRASSEN_CUTOFF != 256 || NMOD_POLY_GCD_CUTOFF != 340
+        || FMPZ_MAT_MUL_CLASSICAL_CUTOFF != 12
+        || NMOD_POLY_TREE_THREADED_CUTOFF != 1024
+        || NMOD_POLY_TREE_PREINV_CUTOFF != 128)
+    {
+        flint_printf("FAIL (defaults)\n");
+        abort();
+    }
+
+    /* round trip through a file */
+    {
+        slong v = 100;
+        FILE * f;
+
+        if (!flint_tune_set("nmod_mat_mul_strassen", &v, 1))
+        {
+            flint_printf("FAIL (set)\n");
+            abort();
+        }
+
+        f = fopen(TUNE_FILE, "w");
+        flint_tune_write(f);
+        fclose(f);
+
+        flint_tune_reset();
+
+        if (NMOD_MAT_MUL_STRASSEN_CUTOFF != 256 || !flint_tune_load(TUNE_FILE)
+            || NMOD_MAT_MUL_STRASSEN_CUTOFF != 100)
+        {
+            flint_printf("FAIL (round trip)\n");
+            abort();
+        }
+
+        flint_tune_reset();
+    }
+
+    /* invalid profiles change nothing */
+    {
+        const char * bad[] = {
+            "nmod_poly_gcd 10\nno_such_parameter 1\n",
+            "nmod_poly_gcd 10\nnmod_mat_mul_strassen 1\n",
+            "nmod_poly_gcd 10\nnmod_mat_mul_strassen 10 20\n",
+            "nmod_poly_gcd 10\nnmod_mat_mul_strassen x\n",
+            "nmod_poly_gcd 10\nfft_tab 1 1 1 1 1 1 1 1 1\n",
+            "nmod_poly_gcd 10\nfft_tab 1 1 1 1 1 1 1 1 1 5\n",
+            "nmod_poly_gcd 10\nnmod_poly_div_divconquer 400\n"
+        };
+
+        for (i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+        {
+            if (write_profile(bad[i]) || NMOD_POLY_GCD_CUTOFF != 340)
+            {
+                flint_printf("FAIL (invalid profile %d)\n", i);
+                abort();
+            }
+        }
+
+        if (flint_tune_load("no_such_file_for_tuning_test"))
+        {
+            flint_printf("FAIL (missing file)\n");
+            abort();
+        }
+    }
+
+    /* results do not depend on the parameters */
+    if (!write_profile("# small cutoffs\n\n"
+        "fmpz_mat_mul_classical 1\nfmpz_mat_mul_multi_mod 0\n"
+        "  nmod_mat_mul_strassen 5\n"
+        "nmod_poly_divrem_divconquer 2\nnmod_poly_div_divconquer 2\n"
+        "nmod_poly_hgcd 2\nnmod_poly_gcd 8\nnmod_poly_small_gcd 8\n"
+        "nmod_poly_mul_ntt 1\n"))
+    {
+        flint_printf("FAIL (load)\n");
+        abort();
+    }
+
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        fmpz_mat_t A, B, C, D;
+        nmod_mat_t a, b, c, d;
+        nmod_poly_t f, g, q, r, q2, r2, h, h2;
+        slong m = n_randint(state, 20) + 1, k = n_randint(state, 20) + 1;
+        slong n = n_randint(state, 20) + 1;
+        mp_limb_t p = n_randtest_prime(state, 0);
+
+        fmpz_mat_init(A, m, k);
+        fmpz_mat_init(B, k, n);
+        fmpz_mat_init(C, m, n);
+        fmpz_mat_init(D, m, n);
+        fmpz_mat_randtest(A, state, n_randint(state, 100) + 1);
+        fmpz_mat_randtest(B, state, n_randint(state, 100) + 1);
+
+        nmod_mat_init(a, m, k, p);
+        nmod_mat_init(b, k, n, p);
+        nmod_mat_init(c, m, n, p);
+        nmod_mat_init(d, m, n, p);
+        nmod_mat_randtest(a, state);
+        nmod_mat_randtest(b, state);
+
+        nmod_poly_init(f, p);
+        nmod_poly_init(g, p);
+        nmod_poly_init(q, p);
+        nmod_poly_init(r, p);
+        nmod_poly_init(q2, p);
+        nmod_poly_init(r2, p);
+        nmod_poly_init(h, p);
+        nmod_poly_init(h2, p);
+        nmod_poly_randtest(f, state, n_randint(state, 100));
+        nmod_poly_randtest_not_zero(g, state, n_randint(state, 100) + 1);
+
+        fmpz_mat_mul(C, A, B);
+        fmpz_mat_mul_classical(D, A, B);
+
+        nmod_mat_mul(c, a, b);
+        nmod_mat_mul_classical(d, a, b);
+
+        nmod_poly_divrem(q, r, f, g);
+        nmod_poly_divrem_basecase(q2, r2, f, g);
+        nmod_poly_div_divconquer(h, f, g);
+
+        if (!fmpz_mat_equal(C, D) || !nmod_mat_equal(c, d)
+            || !nmod_poly_equal(q, q2) || !nmod_poly_equal(r, r2)
+            || !nmod_poly_equal(h, q2))
+        {
+            flint_printf("FAIL (products and quotients)\n");
+            abort();
+        }
+
+        nmod_poly_gcd(h, f, g);
+        nmod_poly_gcd_euclidean(h2, f, g);
+
+        if (!nmod_poly_equal(h, h2))
+        {
+            flint_printf("FAIL (gcd)\n");
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(C);
+        fmpz_mat_clear(D);
+        nmod_mat_clear(a);
+        nmod_mat_clear(b);
+        nmod_mat_clear(c);
+        nmod_mat_clear(d);
+        nmod_poly_clear(f);
+        nmod_poly_clear(g);
+        nmod_poly_clear(q);
+        nmod_poly_clear(r);
+        nmod_poly_clear(q2);
+        nmod_poly_clear(r2);
+        nmod_poly_clear(h);
+        nmod_poly_clear(h2);
+    }
+
+    flint_tune_reset();
+    remove(TUNE_FILE);
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <pthread.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "flint.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+typedef void * (*thread_pool_fxn_t)(void * arg);
+
+typedef struct
+{
+    pthread_t pth;
+    pthread_mutex_t mutex;
+    pthread_cond_t sleep1;  /* worker sleeps here until woken with work */
+    pthread_cond_t sleep2;  /* master sleeps here until work is done */
+    volatile int available; /* protected by the mutex of the pool */
+    volatile int working;
+    volatile int exit;
+    thread_pool_fxn_t fxn;
+    void * fxnarg;
+} thread_pool_entry_struct;
+
+typedef thread_pool_entry_struct thread_pool_entry_t[1];
+
+typedef struct
+{
+    thread_pool_entry_struct * tdata;
+    slong length;
+    pthread_mutex_t mutex;
+} thread_pool_struct;
+
+typedef thread_pool_struct thread_pool_t[1];
+
+typedef slong thread_pool_handle;
+
+struct flint_task_struct;
+struct flint_task_team_struct;
+
+typedef struct flint_task_worker_struct
+{
+    pthread_mutex_t mutex;  /* protects the deque and the pending counts
+                               of the groups this member owns */
+    pthread_cond_t cond;
+    struct flint_task_struct * head;
+    struct flint_task_struct * tail;
+    struct flint_task_struct * free;    /* only used by the member itself */
+    slong running;  /* tasks this member is running, nested in one another */
+    int sleeping;
+    struct flint_task_team_struct * team;
+} flint_task_worker_struct;
+
+typedef struct flint_task_team_struct
+{
+    pthread_mutex_t mutex;  /* protects the sleeping flags */
+    flint_task_worker_struct * workers;
+    slong num;
+    volatile slong num_sleeping;
+    int finished;
+} flint_task_team_struct;
+
+typedef struct flint_task_group_struct
+{
+    slong pending;          /* spawned tasks which have not yet completed */
+    int requested;
+    flint_task_worker_struct * owner;   /* member whose deque holds the tasks */
+    flint_task_team_struct * team;      /* set if the group started the team */
+    thread_pool_handle * handles;
+    slong num_handles;
+} flint_task_group_struct;
+
+typedef flint_task_group_struct flint_task_group_t[1];
+
+typedef struct flint_task_struct
+{
+    thread_pool_fxn_t f;
+    void * arg;
+    flint_task_group_struct * group;
+    struct flint_task_struct * prev;
+    struct flint_task_struct * next;
+} flint_task_struct;
+
+FLINT_DLL extern thread_pool_t global_thread_pool;
+FLINT_DLL extern int global_thread_pool_initialized;
+
+/*  Thread pools  ************************************************************/
+
+FLINT_DLL void * thread_pool_idle_loop(void * varg);
+
+FLINT_DLL void _thread_pool_start(thread_pool_t T, slong size);
+
+FLINT_DLL void _thread_pool_stop(thread_pool_t T);
+
+FLINT_DLL void thread_pool_init(thread_pool_t T, slong size);
+
+FLINT_DLL slong thread_pool_get_size(thread_pool_t T);
+
+FLINT_DLL int thread_pool_set_size(thread_pool_t T, slong new_size);
+
+FLINT_DLL slong thread_pool_request(thread_pool_t T,
+                                 thread_pool_handle * out, slong requested);
+
+FLINT_DLL void thread_pool_wake(thread_pool_t T, thread_pool_handle i,
+                                            thread_pool_fxn_t f, void * a);
+
+FLINT_DLL void thread_pool_wait(thread_pool_t T, thread_pool_handle i);
+
+FLINT_DLL void thread_pool_give_back(thread_pool_t T, thread_pool_handle i);
+
+FLINT_DLL void thread_pool_clear(thread_pool_t T);
+
+/*  Global thread pool  ******************************************************/
+
+FLINT_DLL slong flint_request_threads(thread_pool_handle ** handles,
+                                                         slong thread_limit);
+
+FLINT_DLL void flint_give_back_threads(thread_pool_handle * handles,
+                                                          slong num_handles);
+
+FLINT_DLL void flint_parallel_map(thread_pool_fxn_t f, void * args,
+                                                   size_t arg_size, slong n);
+
+/*  Fork/join tasks  *********************************************************/
+
+FLINT_DLL int flint_task_parallel_enabled(void);
+
+FLINT_DLL void flint_task_group_init(flint_task_group_t G);
+
+FLINT_DLL void flint_task_spawn(flint_task_group_t G,
+                                              thread_pool_fxn_t f, void * arg);
+
+FLINT_DLL void flint_task_sync(flint_task_group_t G);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
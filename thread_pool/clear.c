@@ -0,0 +1,53 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "thread_pool.h"
+
+void _thread_pool_stop(thread_pool_t T)
+{
+    slong i;
+    thread_pool_entry_struct * D = T->tdata;
+
+    for (i = 0; i < T->length; i++)
+    {
+        pthread_mutex_lock(&D[i].mutex);
+        D[i].exit = 1;
+        pthread_cond_signal(&D[i].sleep1);
+        pthread_mutex_unlock(&D[i].mutex);
+
+        pthread_join(D[i].pth, NULL);
+
+        pthread_cond_destroy(&D[i].sleep2);
+        pthread_cond_destroy(&D[i].sleep1);
+        pthread_mutex_destroy(&D[i].mutex);
+    }
+
+    if (T->tdata != NULL)
+        flint_free(T->tdata);
+
+    T->tdata = NULL;
+    T->length = 0;
+}
+
+void thread_pool_clear(thread_pool_t T)
+{
+    _thread_pool_stop(T);
+    pthread_mutex_destroy(&T->mutex);
+}
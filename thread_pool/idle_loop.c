@@ -0,0 +1,54 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "thread_pool.h"
+
+void * thread_pool_idle_loop(void * varg)
+{
+    thread_pool_entry_struct * D = (thread_pool_entry_struct *) varg;
+
+    while (1)
+    {
+        pthread_mutex_lock(&D->mutex);
+
+        while (!D->working && !D->exit)
+            pthread_cond_wait(&D->sleep1, &D->mutex);
+
+        if (D->exit)
+        {
+            pthread_mutex_unlock(&D->mutex);
+            break;
+        }
+
+        pthread_mutex_unlock(&D->mutex);
+
+        D->fxn(D->fxnarg);
+
+        pthread_mutex_lock(&D->mutex);
+        D->working = 0;
+        pthread_cond_signal(&D->sleep2);
+        pthread_mutex_unlock(&D->mutex);
+    }
+
+    /* release any thread local caches built up by the tasks */
+    flint_cleanup();
+
+    return NULL;
+}
@@ -0,0 +1,70 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "thread_pool.h"
+
+void _thread_pool_start(thread_pool_t T, slong size)
+{
+    slong i;
+    thread_pool_entry_struct * D;
+
+    T->length = FLINT_MAX(size, 0);
+    T->tdata = NULL;
+
+    if (T->length == 0)
+        return;
+
+    D = T->tdata = flint_malloc(T->length * sizeof(thread_pool_entry_struct));
+
+    for (i = 0; i < T->length; i++)
+    {
+        pthread_mutex_init(&D[i].mutex, NULL);
+        pthread_cond_init(&D[i].sleep1, NULL);
+        pthread_cond_init(&D[i].sleep2, NULL);
+        D[i].available = 1;
+        D[i].working = 0;
+        D[i].exit = 0;
+        D[i].fxn = NULL;
+        D[i].fxnarg = NULL;
+
+        /* if a thread cannot be started the pool keeps those that were */
+        if (pthread_create(&D[i].pth, NULL, thread_pool_idle_loop, &D[i]))
+        {
+            pthread_cond_destroy(&D[i].sleep2);
+            pthread_cond_destroy(&D[i].sleep1);
+            pthread_mutex_destroy(&D[i].mutex);
+            break;
+        }
+    }
+
+    T->length = i;
+
+    if (T->length == 0)
+    {
+        flint_free(T->tdata);
+        T->tdata = NULL;
+    }
+}
+
+void thread_pool_init(thread_pool_t T, slong size)
+{
+    pthread_mutex_init(&T->mutex, NULL);
+    _thread_pool_start(T, size);
+}
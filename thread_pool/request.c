@@ -0,0 +1,45 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "thread_pool.h"
+
+slong thread_pool_request(thread_pool_t T,
+                                   thread_pool_handle * out, slong requested)
+{
+    slong i, ret = 0;
+
+    if (requested <= 0)
+        return 0;
+
+    pthread_mutex_lock(&T->mutex);
+
+    for (i = 0; i < T->length && ret < requested; i++)
+    {
+        if (T->tdata[i].available)
+        {
+            T->tdata[i].available = 0;
+            out[ret++] = i;
+        }
+    }
+
+    pthread_mutex_unlock(&T->mutex);
+
+    return ret;
+}
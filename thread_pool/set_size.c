@@ -0,0 +1,53 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include "thread_pool.h"
+
+int thread_pool_set_size(thread_pool_t T, slong new_size)
+{
+    slong i;
+
+    new_size = FLINT_MAX(new_size, 0);
+
+    pthread_mutex_lock(&T->mutex);
+
+    if (new_size == T->length)
+    {
+        pthread_mutex_unlock(&T->mutex);
+        return 1;
+    }
+
+    /* the pool may only be resized while none of its threads are in use */
+    for (i = 0; i < T->length; i++)
+    {
+        if (!T->tdata[i].available)
+        {
+            pthread_mutex_unlock(&T->mutex);
+            return 0;
+        }
+    }
+
+    _thread_pool_stop(T);
+    _thread_pool_start(T, new_size);
+
+    pthread_mutex_unlock(&T->mutex);
+
+    return 1;
+}
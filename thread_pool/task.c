@@ -0,0 +1,453 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include "thread_pool.h"
+
+/*
+   Tasks are run by a team: the thread which makes the first spawn outside
+   a task, and the idle threads it recruits from the global pool. Every
+   member of the team has its own deque, guarded by its own mutex. A member
+   pushes the tasks it spawns at the head of its deque and pops them from
+   there again (newest first), whereas members which run out of work steal
+   from the tails of the other deques, where the oldest and hence usually
+   largest tasks of a divide and conquer recursion are found.
+
+   Members with nothing to do sleep on their own condition variable. A spawn
+   wakes a single sleeping member, and the completion of the last task of a
+   group wakes only the member waiting for that group. Task structs are
+   recycled through a free list per member, which only that member touches.
+
+   Without thread local storage a thread cannot know whether it is running
+   a task, so in a reentrant build tasks are then simply run serially, just
+   as the scratch arena is disabled.
+*/
+
+#if FLINT_REENTRANT && !HAVE_TLS
+#define TASK_PARALLEL 0
+#else
+#define TASK_PARALLEL 1
+#endif
+
+#if TASK_PARALLEL
+
+/* the team member run by this thread, if any */
+FLINT_TLS_PREFIX flint_task_worker_struct * _flint_task_self = NULL;
+
+/* requires the team mutex */
+static void _flint_task_wake_locked(flint_task_worker_struct * w)
+{
+    if (w->sleeping)
+    {
+        w->sleeping = 0;
+        w->team->num_sleeping--;
+        pthread_cond_signal(&w->cond);
+    }
+}
+
+static void _flint_task_wake(flint_task_worker_struct * w)
+{
+    pthread_mutex_lock(&w->team->mutex);
+    _flint_task_wake_locked(w);
+    pthread_mutex_unlock(&w->team->mutex);
+}
+
+static void _flint_task_wake_one(flint_task_team_struct * team)
+{
+    slong i;
+
+    pthread_mutex_lock(&team->mutex);
+
+    for (i = 0; i < team->num; i++)
+    {
+        if (team->workers[i].sleeping)
+        {
+            _flint_task_wake_locked(team->workers + i);
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&team->mutex);
+}
+
+/*
+   Pops the newest task of G from our own deque if G is not NULL, or else
+   steals the oldest task of another member. Returns NULL if there is none.
+   If take is zero the task is only looked for and left in place.
+*/
+static flint_task_struct * _flint_task_find(flint_task_worker_struct * self,
+                                        flint_task_group_struct * G, int take)
+{
+    flint_task_team_struct * team = self->team;
+    flint_task_worker_struct * v;
+    flint_task_struct * t;
+    slong i, start = self - team->workers;
+
+    if (G != NULL)
+    {
+        pthread_mutex_lock(&self->mutex);
+
+        t = self->head;
+        if (t != NULL && t->group == G)
+        {
+            if (take)
+            {
+                self->head = t->next;
+                if (t->next != NULL)
+                    t->next->prev = NULL;
+                else
+                    self->tail = NULL;
+            }
+        } else
+            t = NULL;
+
+        pthread_mutex_unlock(&self->mutex);
+
+        if (t != NULL)
+            return t;
+    }
+
+    for (i = 1; i < team->num; i++)
+    {
+        v = team->workers + (start + i) % team->num;
+
+        pthread_mutex_lock(&v->mutex);
+
+        t = v->tail;
+        if (t != NULL && take)
+        {
+            v->tail = t->prev;
+            if (t->prev != NULL)
+                t->prev->next = NULL;
+            else
+                v->head = NULL;
+        }
+
+        pthread_mutex_unlock(&v->mutex);
+
+        if (t != NULL)
+            return t;
+    }
+
+    return NULL;
+}
+
+static void _flint_task_run(flint_task_worker_struct * self,
+                                                         flint_task_struct * t)
+{
+    flint_task_group_struct * G = t->group;
+    flint_task_worker_struct * owner = G->owner;
+    int done;
+
+    self->running++;
+    t->f(t->arg);
+    self->running--;
+
+    t->next = self->free;
+    self->free = t;
+
+    pthread_mutex_lock(&owner->mutex);
+    done = (--G->pending == 0);
+    pthread_mutex_unlock(&owner->mutex);
+
+    /* G may be gone once the count is zero, but its owner is not */
+    if (done && owner != self)
+        _flint_task_wake(owner);
+}
+
+static int _flint_task_group_done(flint_task_worker_struct * self,
+                                                   flint_task_group_struct * G)
+{
+    int done;
+
+    pthread_mutex_lock(&self->mutex);
+    done = (G->pending == 0);
+    pthread_mutex_unlock(&self->mutex);
+
+    return done;
+}
+
+/*
+   Sleeps until woken, unless work, the completion of G or the end of the
+   team turns up in the meantime. Since the sleeping flag is raised before
+   looking, a spawn or completion racing with the look sees the flag and
+   wakes us, so no wakeup is lost.
+*/
+static void _flint_task_sleep(flint_task_worker_struct * self,
+                                                   flint_task_group_struct * G)
+{
+    flint_task_team_struct * team = self->team;
+    int ready;
+
+    pthread_mutex_lock(&team->mutex);
+    self->sleeping = 1;
+    team->num_sleeping++;
+    pthread_mutex_unlock(&team->mutex);
+
+    ready = _flint_task_find(self, G, 0) != NULL
+                          || (G != NULL && _flint_task_group_done(self, G));
+
+    pthread_mutex_lock(&team->mutex);
+
+    while (!ready && self->sleeping && !team->finished)
+        pthread_cond_wait(&self->cond, &team->mutex);
+
+    if (self->sleeping)
+    {
+        self->sleeping = 0;
+        team->num_sleeping--;
+    }
+
+    pthread_mutex_unlock(&team->mutex);
+}
+
+static void * _flint_task_worker(void * arg_ptr)
+{
+    flint_task_worker_struct * self = (flint_task_worker_struct *) arg_ptr;
+    flint_task_team_struct * team = self->team;
+    flint_task_struct * t;
+    int finished;
+
+    _flint_task_self = self;
+
+    while (1)
+    {
+        if ((t = _flint_task_find(self, NULL, 1)) != NULL)
+        {
+            _flint_task_run(self, t);
+            continue;
+        }
+
+        pthread_mutex_lock(&team->mutex);
+        finished = team->finished;
+        pthread_mutex_unlock(&team->mutex);
+
+        if (finished)
+            break;
+
+        _flint_task_sleep(self, NULL);
+    }
+
+    _flint_task_self = NULL;
+
+    return NULL;
+}
+
+/*
+   Recruits idle threads from the global pool into a new team, with the
+   calling thread as its first member. They serve every task spawned in the
+   team, so nested groups are run by the same bounded set of threads.
+*/
+static void _flint_task_team_start(flint_task_group_struct * G)
+{
+    flint_task_team_struct * team;
+    flint_task_worker_struct * w;
+    slong i;
+
+    G->num_handles = flint_request_threads(&G->handles,
+                                                    flint_get_num_threads());
+
+    if (G->num_handles == 0)
+    {
+        flint_give_back_threads(G->handles, 0);
+        G->handles = NULL;
+        return;
+    }
+
+    team = flint_malloc(sizeof(flint_task_team_struct));
+    team->num = G->num_handles + 1;
+    team->workers = flint_malloc(team->num*sizeof(flint_task_worker_struct));
+    team->num_sleeping = 0;
+    team->finished = 0;
+    pthread_mutex_init(&team->mutex, NULL);
+
+    for (i = 0; i < team->num; i++)
+    {
+        w = team->workers + i;
+        pthread_mutex_init(&w->mutex, NULL);
+        pthread_cond_init(&w->cond, NULL);
+        w->head = w->tail = w->free = NULL;
+        w->running = 0;
+        w->sleeping = 0;
+        w->team = team;
+    }
+
+    G->team = team;
+    _flint_task_self = team->workers + 0;
+
+    for (i = 0; i < G->num_handles; i++)
+        thread_pool_wake(global_thread_pool, G->handles[i],
+                                      _flint_task_worker, team->workers + i + 1);
+}
+
+static void _flint_task_team_stop(flint_task_group_struct * G)
+{
+    flint_task_team_struct * team = G->team;
+    flint_task_worker_struct * w;
+    flint_task_struct * t;
+    slong i;
+
+    pthread_mutex_lock(&team->mutex);
+    team->finished = 1;
+    for (i = 0; i < team->num; i++)
+        _flint_task_wake_locked(team->workers + i);
+    pthread_mutex_unlock(&team->mutex);
+
+    for (i = 0; i < G->num_handles; i++)
+        thread_pool_wait(global_thread_pool, G->handles[i]);
+
+    flint_give_back_threads(G->handles, G->num_handles);
+
+    for (i = 0; i < team->num; i++)
+    {
+        w = team->workers + i;
+
+        while ((t = w->free) != NULL)
+        {
+            w->free = t->next;
+            flint_free(t);
+        }
+
+        pthread_mutex_destroy(&w->mutex);
+        pthread_cond_destroy(&w->cond);
+    }
+
+    pthread_mutex_destroy(&team->mutex);
+    flint_free(team->workers);
+    flint_free(team);
+
+    _flint_task_self = NULL;
+}
+
+#endif
+
+int flint_task_parallel_enabled(void)
+{
+#if TASK_PARALLEL
+    thread_pool_handle * handles;
+    slong num_handles;
+
+    /* nested groups are served by the team, further top level ones not */
+    if (_flint_task_self != NULL)
+        return _flint_task_self->running > 0;
+
+    /* whether a team started now would recruit anybody */
+    num_handles = flint_request_threads(&handles, flint_get_num_threads());
+    flint_give_back_threads(handles, num_handles);
+
+    return num_handles > 0;
+#else
+    return 0;
+#endif
+}
+
+void flint_task_group_init(flint_task_group_t G)
+{
+    G->pending = 0;
+    G->requested = 0;
+    G->owner = NULL;
+    G->team = NULL;
+    G->handles = NULL;
+    G->num_handles = 0;
+}
+
+void flint_task_spawn(flint_task_group_t G, thread_pool_fxn_t f, void * arg)
+{
+#if TASK_PARALLEL
+    flint_task_worker_struct * w;
+    flint_task_struct * t;
+
+    if (!G->requested)
+    {
+        G->requested = 1;
+
+        /*
+           A second group outside any task, spawned while the team started
+           by the first is still running, is run serially: the team may be
+           stopped by the first group before the second is synced.
+        */
+        if (_flint_task_self == NULL)
+        {
+            _flint_task_team_start(G);
+            G->owner = _flint_task_self;
+        }
+        else if (_flint_task_self->running > 0)
+            G->owner = _flint_task_self;
+    }
+
+    /* without a team nobody could steal the task, so it is run below */
+    if ((w = G->owner) != NULL)
+    {
+        if ((t = w->free) != NULL)
+            w->free = t->next;
+        else
+            t = flint_malloc(sizeof(flint_task_struct));
+
+        t->f = f;
+        t->arg = arg;
+        t->group = G;
+        t->prev = NULL;
+
+        pthread_mutex_lock(&w->mutex);
+
+        t->next = w->head;
+        if (w->head != NULL)
+            w->head->prev = t;
+        else
+            w->tail = t;
+        w->head = t;
+
+        G->pending++;
+
+        pthread_mutex_unlock(&w->mutex);
+
+        if (w->team->num_sleeping > 0)
+            _flint_task_wake_one(w->team);
+
+        return;
+    }
+#endif
+
+    f(arg);
+}
+
+void flint_task_sync(flint_task_group_t G)
+{
+#if TASK_PARALLEL
+    flint_task_worker_struct * self = G->owner;
+    flint_task_struct * t;
+
+    if (self != NULL)
+    {
+        while (!_flint_task_group_done(self, G))
+        {
+            if ((t = _flint_task_find(self, G, 1)) != NULL)
+                _flint_task_run(self, t);
+            else
+                _flint_task_sleep(self, G);
+        }
+
+        if (G->team != NULL)
+            _flint_task_team_stop(G);
+    }
+#endif
+
+    flint_task_group_init(G);
+}
@@ -0,0 +1,172 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "thread_pool.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    ulong start;
+    ulong stop;
+    ulong sum;
+}
+sum_arg_t;
+
+/* sum start, ..., stop - 1 by recursively spawning both halves */
+void * sum_worker(void * arg_ptr)
+{
+    sum_arg_t * arg = (sum_arg_t *) arg_ptr;
+    sum_arg_t sub[2];
+    flint_task_group_t G;
+    ulong i, mid;
+
+    if (arg->stop - arg->start <= 100)
+    {
+        arg->sum = 0;
+        for (i = arg->start; i < arg->stop; i++)
+            arg->sum += i;
+
+        return NULL;
+    }
+
+    mid = arg->start + (arg->stop - arg->start) / 2;
+
+    sub[0].start = arg->start;
+    sub[0].stop = mid;
+    sub[1].start = mid;
+    sub[1].stop = arg->stop;
+
+    flint_task_group_init(G);
+
+    flint_task_spawn(G, sum_worker, sub + 0);
+    flint_task_spawn(G, sum_worker, sub + 1);
+
+    flint_task_sync(G);
+
+    arg->sum = sub[0].sum + sub[1].sum;
+
+    return NULL;
+}
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("task....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        sum_arg_t arg;
+        ulong n;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        n = n_randint(state, 100000);
+
+        arg.start = 0;
+        arg.stop = n;
+
+        sum_worker(&arg);
+
+        if (arg.sum != n * (n - 1) / 2)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wu, sum = %wu\n", n, arg.sum);
+            abort();
+        }
+
+        if (flint_task_parallel_enabled() != (flint_get_num_threads() > 1))
+        {
+            flint_printf("FAIL (parallel_enabled)\n");
+            abort();
+        }
+    }
+
+    /* a second group outside any task is run serially */
+    for (i = 0; i < 100; i++)
+    {
+        flint_task_group_t G1, G2;
+        sum_arg_t arg[4];
+        ulong n[4];
+        int j;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        for (j = 0; j < 4; j++)
+        {
+            n[j] = n_randint(state, 100000);
+            arg[j].start = 0;
+            arg[j].stop = n[j];
+            arg[j].sum = 1;
+        }
+
+        flint_task_group_init(G1);
+        flint_task_group_init(G2);
+
+        flint_task_spawn(G1, sum_worker, arg + 0);
+        flint_task_spawn(G1, sum_worker, arg + 1);
+
+        if (flint_task_parallel_enabled())
+        {
+            flint_printf("FAIL (parallel_enabled with a group in flight)\n");
+            abort();
+        }
+
+        flint_task_spawn(G2, sum_worker, arg + 2);
+        flint_task_spawn(G2, sum_worker, arg + 3);
+
+        for (j = 2; j < 4; j++)
+        {
+            if (arg[j].sum != n[j] * (n[j] - 1) / 2)
+            {
+                flint_printf("FAIL (second group not run serially):\n");
+                flint_printf("n = %wu, sum = %wu\n", n[j], arg[j].sum);
+                abort();
+            }
+        }
+
+        /* the first group stops the team before the second is synced */
+        flint_task_sync(G1);
+        flint_task_sync(G2);
+
+        for (j = 0; j < 4; j++)
+        {
+            if (arg[j].sum != n[j] * (n[j] - 1) / 2)
+            {
+                flint_printf("FAIL (two groups):\n");
+                flint_printf("n = %wu, sum = %wu\n", n[j], arg[j].sum);
+                abort();
+            }
+        }
+    }
+
+    flint_set_num_threads(1);
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "thread_pool.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    ulong start;
+    ulong stop;
+    ulong sum;
+}
+sum_arg_t;
+
+void * sum_worker(void * arg_ptr)
+{
+    sum_arg_t * arg = (sum_arg_t *) arg_ptr;
+    ulong i;
+
+    arg->sum = 0;
+    for (i = arg->start; i < arg->stop; i++)
+        arg->sum += i;
+
+    return NULL;
+}
+
+void * shrink_worker(void * arg_ptr)
+{
+    flint_set_num_threads(1);
+    flint_cleanup();
+    return NULL;
+}
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("thread_pool....");
+    fflush(stdout);
+
+    /* check request/wake/wait/give_back on a private pool */
+    for (i = 0; i < 100; i++)
+    {
+        thread_pool_t T;
+        thread_pool_handle * handles;
+        sum_arg_t * args;
+        slong j, size, num, num2;
+        ulong n, total;
+
+        size = n_randint(state, 5);
+        thread_pool_init(T, size);
+
+        handles = flint_malloc((size + 1)*sizeof(thread_pool_handle));
+        args = flint_malloc((size + 1)*sizeof(sum_arg_t));
+
+        num = thread_pool_request(T, handles, n_randint(state, size + 2));
+        num2 = thread_pool_request(T, handles + num, size + 1);
+
+        if (num > size || num2 != size - num)
+        {
+            flint_printf("FAIL (request):\n");
+            flint_printf("size = %wd, num = %wd\n", size, num);
+            abort();
+        }
+
+        for (j = 0; j < num2; j++)
+            thread_pool_give_back(T, handles[num + j]);
+
+        n = n_randint(state, 10000);
+
+        for (j = 0; j <= num; j++)
+        {
+            args[j].start = (n * j) / (num + 1);
+            args[j].stop = (n * (j + 1)) / (num + 1);
+        }
+
+        for (j = 0; j < num; j++)
+            thread_pool_wake(T, handles[j], sum_worker, args + j);
+
+        sum_worker(args + num);
+
+        total = args[num].sum;
+        for (j = 0; j < num; j++)
+        {
+            thread_pool_wait(T, handles[j]);
+            total += args[j].sum;
+        }
+
+        if (total != n * (n - 1) / 2)
+        {
+            flint_printf("FAIL (sum):\n");
+            flint_printf("n = %wu, total = %wu\n", n, total);
+            abort();
+        }
+
+        if (thread_pool_set_size(T, size + 1) != (num == 0))
+        {
+            flint_printf("FAIL (set_size while in use):\n");
+            flint_printf("size = %wd, num = %wd\n", size, num);
+            abort();
+        }
+
+        for (j = 0; j < num; j++)
+            thread_pool_give_back(T, handles[j]);
+
+        if (!thread_pool_set_size(T, size + 2) ||
+            thread_pool_get_size(T) != size + 2)
+        {
+            flint_printf("FAIL (set_size):\n");
+            flint_printf("size = %wd\n", size);
+            abort();
+        }
+
+        thread_pool_clear(T);
+
+        flint_free(handles);
+        flint_free(args);
+    }
+
+    /* check flint_parallel_map using the global pool */
+    for (i = 0; i < 1000; i++)
+    {
+        sum_arg_t * args;
+        slong j, num;
+        ulong n, total;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        num = n_randint(state, 10);
+        n = n_randint(state, 10000);
+
+        args = flint_malloc((num + 1)*sizeof(sum_arg_t));
+
+        for (j = 0; j < num; j++)
+        {
+            args[j].start = (n * j) / num;
+            args[j].stop = (n * (j + 1)) / num;
+        }
+
+        flint_parallel_map(sum_worker, args, sizeof(sum_arg_t), num);
+
+        total = 0;
+        for (j = 0; j < num; j++)
+            total += args[j].sum;
+
+        if (num != 0 && total != n * (n - 1) / 2)
+        {
+            flint_printf("FAIL (flint_parallel_map):\n");
+            flint_printf("num = %wd, n = %wu, total = %wu\n", num, n, total);
+            abort();
+        }
+
+        flint_free(args);
+    }
+
+    /* check a thread asking for fewer threads does not shrink the pool */
+    for (i = 0; i < 10; i++)
+    {
+        pthread_t pth;
+        slong size;
+
+        flint_set_num_threads(2 + n_randint(state, 4));
+        size = thread_pool_get_size(global_thread_pool);
+
+        pthread_create(&pth, NULL, shrink_worker, NULL);
+        pthread_join(pth, NULL);
+
+        if (thread_pool_get_size(global_thread_pool) != size)
+        {
+            flint_printf("FAIL (pool shrunk):\n");
+            flint_printf("size = %wd, new size = %wd\n", size,
+                                   thread_pool_get_size(global_thread_pool));
+            abort();
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -24,9 +24,16 @@
 ******************************************************************************/
 
 #include "flint.h"
+#include "ulong_extras.h"
+#include "thread_pool.h"
 
 FLINT_TLS_PREFIX int _flint_num_threads = 1;
 
+thread_pool_t global_thread_pool;
+int global_thread_pool_initialized = 0;
+
+static pthread_mutex_t global_thread_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
 int flint_get_num_threads()
 {
     return _flint_num_threads;
@@ -35,5 +42,158 @@ int flint_get_num_threads()
 void flint_set_num_threads(int num_threads)
 {
     _flint_num_threads = num_threads;
+
+    pthread_mutex_lock(&global_thread_pool_lock);
+
+    /*
+       The pool is shared by all threads, so it only ever grows: a thread
+       asking for fewer threads must not take them away from the others,
+       and flint_request_threads hands out no more than the calling thread's
+       own setting anyway. If some of its threads are currently in use it
+       keeps its old size, which is harmless as requests never block and
+       callers cope with however many threads they get.
+    */
+    if (!global_thread_pool_initialized)
+    {
+        thread_pool_init(global_thread_pool, num_threads - 1);
+        global_thread_pool_initialized = 1;
+    }
+    else if (num_threads - 1 > thread_pool_get_size(global_thread_pool))
+        thread_pool_set_size(global_thread_pool, num_threads - 1);
+
+    pthread_mutex_unlock(&global_thread_pool_lock);
+}
+
+int flint_limit_num_threads(int limit)
+{
+    int num_threads = _flint_num_threads;
+
+    /* the pool is left alone, this only affects the calling thread */
+    _flint_num_threads = FLINT_MAX(1, FLINT_MIN(limit, num_threads));
+
+    return num_threads;
+}
+
+void flint_restore_num_threads(int num_threads)
+{
+    _flint_num_threads = num_threads;
+}
+
+void flint_cleanup_master()
+{
+    pthread_mutex_lock(&global_thread_pool_lock);
+
+    if (global_thread_pool_initialized)
+    {
+        thread_pool_clear(global_thread_pool);
+        global_thread_pool_initialized = 0;
+    }
+
+    pthread_mutex_unlock(&global_thread_pool_lock);
+
+    n_cleanup_primes();
+
+    flint_cleanup();
+}
+
+slong flint_request_threads(thread_pool_handle ** handles, slong thread_limit)
+{
+    slong num_handles = 0;
+
+    thread_limit = FLINT_MIN(thread_limit, flint_get_num_threads());
+
+    *handles = NULL;
+
+    /* the calling thread counts towards the limit */
+    if (global_thread_pool_initialized && thread_limit > 1)
+    {
+        *handles = flint_malloc((thread_limit - 1)*sizeof(thread_pool_handle));
+        num_handles = thread_pool_request(global_thread_pool,
+                                                 *handles, thread_limit - 1);
+    }
+
+    return num_handles;
 }
 
+void flint_give_back_threads(thread_pool_handle * handles, slong num_handles)
+{
+    slong i;
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_give_back(global_thread_pool, handles[i]);
+
+    if (handles != NULL)
+        flint_free(handles);
+}
+
+typedef struct
+{
+    thread_pool_fxn_t f;
+    char * args;
+    size_t arg_size;
+    slong n;
+    slong next;
+    pthread_mutex_t mutex;
+} _parallel_map_struct;
+
+static void * _parallel_map_worker(void * arg_ptr)
+{
+    _parallel_map_struct * arg = (_parallel_map_struct *) arg_ptr;
+    slong i;
+
+    while (1)
+    {
+        pthread_mutex_lock(&arg->mutex);
+        i = arg->next++;
+        pthread_mutex_unlock(&arg->mutex);
+
+        if (i >= arg->n)
+            break;
+
+        arg->f(arg->args + i*arg->arg_size);
+    }
+
+    return NULL;
+}
+
+void flint_parallel_map(thread_pool_fxn_t f, void * args,
+                                                    size_t arg_size, slong n)
+{
+    _parallel_map_struct arg;
+    thread_pool_handle * handles;
+    slong i, num_handles;
+
+    if (n <= 0)
+        return;
+
+    num_handles = flint_request_threads(&handles, n);
+
+    if (num_handles == 0)
+    {
+        for (i = 0; i < n; i++)
+            f((char *) args + i*arg_size);
+
+        flint_give_back_threads(handles, 0);
+        return;
+    }
+
+    arg.f = f;
+    arg.args = (char *) args;
+    arg.arg_size = arg_size;
+    arg.n = n;
+    arg.next = 0;
+    pthread_mutex_init(&arg.mutex, NULL);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i],
+                                                 _parallel_map_worker, &arg);
+
+    _parallel_map_worker(&arg);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+
+    pthread_mutex_destroy(&arg.mutex);
+}
@@ -0,0 +1,730 @@
+/* 
+
+Copyright 2009, 2011 William Hart. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are
+permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this list of
+      conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice, this list
+      of conditions and the following disclaimer in the documentation and/or other materials
+      provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY William Hart ``AS IS'' AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL William Hart OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of William Hart.
+
+*/
+
+/*
+   Measures the runtime tuning parameters of FLINT on the current machine
+   and writes them to stdout in the format read by flint_tune_load. Progress
+   is reported on stderr.
+
+   Most parameters are crossover points between a basecase and an
+   asymptotically faster algorithm. These are found by timing the faster
+   algorithm at increasing sizes, once with the parameter set so that the
+   basecase is used throughout and once so that only the top level of the
+   computation uses the faster algorithm. The first size at which the
+   latter wins twice in a row is taken as the cutoff.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+#include "fft_tuning.h"
+#include "mpn_extras.h"
+#include "fmpz_mat.h"
+#include "fmpz_poly.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+
+typedef struct
+{
+    slong size;
+    mp_limb_t n;
+    mp_bitcnt_t bits;
+    fmpz_mat_t FA, FB, FC;
+    fmpz_poly_t f, g;
+    nmod_mat_t A, B, C;
+    nmod_poly_t a, b, q, r;
+    mp_ptr i1, i2, r1;
+} tune_data_struct;
+
+typedef tune_data_struct tune_data_t[1];
+
+typedef struct
+{
+    const char * name;
+    slong param;
+    int inclusive; /* the basecase is used for sizes <= rather than < */
+    void (*init)(tune_data_t, flint_rand_t);
+    void (*run)(tune_data_t);
+    void (*clear)(tune_data_t);
+} tune_bench_struct;
+
+/* fmpz_mat_mul **************************************************************/
+
+void bench_fmpz_mat_mul_init(tune_data_t d, flint_rand_t state)
+{
+    fmpz_mat_init(d->FA, d->size, d->size);
+    fmpz_mat_init(d->FB, d->size, d->size);
+    fmpz_mat_init(d->FC, d->size, d->size);
+    fmpz_mat_randbits(d->FA, state, d->bits);
+    fmpz_mat_randbits(d->FB, state, d->bits);
+}
+
+void bench_fmpz_mat_mul_run(tune_data_t d)
+{
+    fmpz_mat_mul(d->FC, d->FA, d->FB);
+}
+
+void bench_fmpz_mat_mul_clear(tune_data_t d)
+{
+    fmpz_mat_clear(d->FA);
+    fmpz_mat_clear(d->FB);
+    fmpz_mat_clear(d->FC);
+}
+
+/* fmpz_poly_inv_series_newton ***********************************************/
+
+void bench_fmpz_poly_inv_init(tune_data_t d, flint_rand_t state)
+{
+    fmpz_poly_init(d->f);
+    fmpz_poly_init(d->g);
+    fmpz_poly_randtest(d->f, state, d->size, d->bits);
+    fmpz_poly_set_coeff_ui(d->f, 0, 1);
+}
+
+void bench_fmpz_poly_inv_run(tune_data_t d)
+{
+    fmpz_poly_inv_series_newton(d->g, d->f, d->size);
+}
+
+void bench_fmpz_poly_inv_clear(tune_data_t d)
+{
+    fmpz_poly_clear(d->f);
+    fmpz_poly_clear(d->g);
+}
+
+/* nmod_mat_mul **************************************************************/
+
+void bench_nmod_mat_mul_init(tune_data_t d, flint_rand_t state)
+{
+    nmod_mat_init(d->A, d->size, d->size, d->n);
+    nmod_mat_init(d->B, d->size, d->size, d->n);
+    nmod_mat_init(d->C, d->size, d->size, d->n);
+    nmod_mat_randfull(d->A, state);
+    nmod_mat_randfull(d->B, state);
+}
+
+void bench_nmod_mat_mul_run(tune_data_t d)
+{
+    nmod_mat_mul(d->C, d->A, d->B);
+}
+
+void bench_nmod_mat_mul_clear(tune_data_t d)
+{
+    nmod_mat_clear(d->A);
+    nmod_mat_clear(d->B);
+    nmod_mat_clear(d->C);
+}
+
+/* nmod_poly division and gcd ************************************************/
+
+void bench_nmod_poly_init(tune_data_t d, flint_rand_t state)
+{
+    nmod_poly_init(d->a, d->n);
+    nmod_poly_init(d->b, d->n);
+    nmod_poly_init(d->q, d->n);
+    nmod_poly_init(d->r, d->n);
+
+    /* a has length 2 size - 1 for division and size for gcd */
+    do {
+        nmod_poly_randtest(d->a, state, 2 * d->size - 1);
+    } while (nmod_poly_length(d->a) != 2 * d->size - 1);
+
+    do {
+        nmod_poly_randtest(d->b, state, d->size);
+    } while (nmod_poly_length(d->b) != d->size);
+}
+
+void bench_nmod_poly_divrem_run(tune_data_t d)
+{
+    nmod_poly_divrem_divconquer(d->q, d->r, d->a, d->b);
+}
+
+void bench_nmod_poly_div_run(tune_data_t d)
+{
+    nmod_poly_div_divconquer(d->q, d->a, d->b);
+}
+
+void bench_nmod_poly_mul_run(tune_data_t d)
+{
+    nmod_poly_mul(d->q, d->a, d->b);
+}
+
+void bench_nmod_poly_gcd_run(tune_data_t d)
+{
+    nmod_poly_rem(d->r, d->a, d->b);
+    nmod_poly_gcd(d->q, d->b, d->r);
+}
+
+void bench_nmod_poly_clear(tune_data_t d)
+{
+    nmod_poly_clear(d->a);
+    nmod_poly_clear(d->b);
+    nmod_poly_clear(d->q);
+    nmod_poly_clear(d->r);
+}
+
+/* nmod_poly_factor_kaltofen_shoup *******************************************/
+
+/* a is a product of size distinct linear factors, split by a single EDF */
+void bench_nmod_poly_factor_init(tune_data_t d, flint_rand_t state)
+{
+    mp_limb_t w = d->n / d->size;
+    mp_ptr xs;
+    slong i;
+
+    /* the roots lie in disjoint intervals, so are distinct */
+    xs = _nmod_vec_init(d->size);
+    for (i = 0; i < d->size; i++)
+        xs[i] = i * w + n_randint(state, w);
+
+    nmod_poly_init(d->a, d->n);
+    nmod_poly_product_roots_nmod_vec(d->a, xs, d->size);
+
+    _nmod_vec_clear(xs);
+}
+
+void bench_nmod_poly_factor_run(tune_data_t d)
+{
+    nmod_poly_factor_t fac;
+
+    nmod_poly_factor_init(fac);
+    nmod_poly_factor_kaltofen_shoup(fac, d->a);
+    nmod_poly_factor_clear(fac);
+}
+
+void bench_nmod_poly_factor_clear(tune_data_t d)
+{
+    nmod_poly_clear(d->a);
+}
+
+/* nmod_poly_tree_init *******************************************************/
+
+void bench_nmod_poly_tree_init(tune_data_t d, flint_rand_t state)
+{
+    slong i;
+
+    d->i1 = _nmod_vec_init(d->size);
+    for (i = 0; i < d->size; i++)
+        d->i1[i] = n_randint(state, d->n);
+}
+
+void bench_nmod_poly_tree_run(tune_data_t d)
+{
+    nmod_poly_tree_t T;
+
+    nmod_poly_tree_init(T, d->i1, d->size, d->n);
+    nmod_poly_tree_clear(T);
+}
+
+void bench_nmod_poly_tree_clear(tune_data_t d)
+{
+    _nmod_vec_clear(d->i1);
+}
+
+/* flint_mpn_mul_fft_main ****************************************************/
+
+void bench_fft_mul_init(tune_data_t d, flint_rand_t state)
+{
+    mp_size_t n1 = d->size / 2, n2 = d->size - n1;
+
+    d->i1 = flint_malloc(2*d->size*sizeof(mp_limb_t));
+    d->i2 = d->i1 + n1;
+    d->r1 = d->i2 + n2;
+
+    flint_mpn_urandomb(d->i1, state->gmp_state, n1*FLINT_BITS);
+    flint_mpn_urandomb(d->i2, state->gmp_state, n2*FLINT_BITS);
+    d->i1[n1 - 1] |= 1;
+    d->i2[n2 - 1] |= 1;
+}
+
+void bench_fft_mul_run(tune_data_t d)
+{
+    mp_size_t n1 = d->size / 2;
+
+    flint_mpn_mul_fft_main(d->r1, d->i2, d->size - n1, d->i1, n1);
+}
+
+void bench_fft_mul_clear(tune_data_t d)
+{
+    flint_free(d->i1);
+}
+
+/* flint_mpn_mul *************************************************************/
+
+void bench_mpn_mul_init(tune_data_t d, flint_rand_t state)
+{
+    d->i1 = flint_malloc(4*d->size*sizeof(mp_limb_t));
+    d->i2 = d->i1 + d->size;
+    d->r1 = d->i2 + d->size;
+
+    flint_mpn_urandomb(d->i1, state->gmp_state, d->size*FLINT_BITS);
+    flint_mpn_urandomb(d->i2, state->gmp_state, d->size*FLINT_BITS);
+}
+
+void bench_mpn_mul_run(tune_data_t d)
+{
+    flint_mpn_mul(d->r1, d->i1, d->size, d->i2, d->size);
+}
+
+void bench_mpn_mul_clear(tune_data_t d)
+{
+    flint_free(d->i1);
+}
+
+/* Timing ********************************************************************/
+
+/*
+   seconds per call of run, averaged over at least 0.05s; wall time is used
+   so that threaded code is measured correctly
+*/
+double tune_time(void (*run)(tune_data_t), tune_data_t d)
+{
+    struct timeval start, end;
+    slong i, reps = 1;
+    double elapsed;
+
+    run(d);
+
+    while (1)
+    {
+        gettimeofday(&start, NULL);
+        for (i = 0; i < reps; i++)
+            run(d);
+        gettimeofday(&end, NULL);
+        elapsed = (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+
+        if (elapsed >= 0.05)
+            return elapsed / reps;
+
+        reps *= 2;
+    }
+}
+
+slong tune_crossover(const tune_bench_struct * b, tune_data_t d,
+                     slong lo, slong hi, flint_rand_t state)
+{
+    slong size, first = -1;
+    double t1, t2;
+
+    for (size = lo; size <= hi; size += FLINT_MAX(1, size / 8))
+    {
+        d->size = size;
+        b->init(d, state);
+
+        flint_tune_params[b->param] = b->inclusive ? size : size + 1;
+        t1 = tune_time(b->run, d);
+
+        flint_tune_params[b->param] = b->inclusive ? size - 1 : size;
+        t2 = tune_time(b->run, d);
+
+        b->clear(d);
+
+        flint_fprintf(stderr, "%s: %wd %.3g %.3g\n", b->name, size, t1, t2);
+
+        if (t2 < t1)
+        {
+            if (first != -1)
+                return first;
+            first = size;
+        }
+        else
+            first = -1;
+    }
+
+    return hi;
+}
+
+/* FFT ***********************************************************************/
+
+void tune_fft_tab(flint_rand_t state)
+{
+    mp_bitcnt_t depth, w;
+    clock_t start, end;
+    double elapsed;
+    double best = 0.0;
+    mp_size_t best_off, off;
+
+    for (depth = 6; depth <= 10; depth++)
+    {
+        for (w = 1; w <= 2; w++)
+        {
+            int iters = 100*((mp_size_t) 1 << (3*(10 - depth)/2)), i;
+            
+            mp_size_t n = (UWORD(1)<<depth);
+            mp_bitcnt_t bits1 = (n*w - (depth + 1))/2; 
+            mp_size_t len1 = 2*n;
+            mp_size_t len2 = 2*n;
+
+            mp_bitcnt_t b1 = len1*bits1, b2 = len2*bits1;
+            mp_size_t n1, n2;
+            mp_limb_t * i1, *i2, *r1;
+   
+            n1 = (b1 - 1)/FLINT_BITS + 1;
+            n2 = (b2 - 1)/FLINT_BITS + 1;
+                    
+            i1 = flint_malloc(2*(n1 + n2)*sizeof(mp_limb_t));
+            i2 = i1 + n1;
+            r1 = i2 + n2;
+   
+            flint_mpn_urandomb(i1, state->gmp_state, b1);
+            flint_mpn_urandomb(i2, state->gmp_state, b2);
+  
+            best_off = -1;
+            
+            for (off = 0; off <= 4; off++)
+            {
+               start = clock();
+               for (i = 0; i < iters; i++)
+                  mul_truncate_sqrt2(r1, i1, n1, i2, n2, depth - off, w*((mp_size_t)1 << (off*2)));
+               end = clock();
+               
+               elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+               
+               if (elapsed < best || best_off == -1)
+               {
+                  best_off = off;
+                  best = elapsed;
+               }
+            }
+           
+            flint_tune_fft_tab[depth - 6][w - 1] = best_off;
+            flint_fprintf(stderr, "fft_tab: %wu %wu %wd\n",
+                                                     depth, w, best_off);
+
+            flint_free(i1);
+        }
+    }
+}
+
+/*
+   The last entry of the mulmod table is fixed at 1, as is done by the
+   tables shipped with FLINT.
+*/
+void tune_mulmod_tab(flint_rand_t state)
+{
+    mp_bitcnt_t depth, w, depth1, w1;
+    clock_t start, end;
+    double elapsed;
+    double best = 0.0;
+    mp_size_t best_off, off, best_d, best_w;
+    slong j = 0;
+
+    best_d = 12;
+    best_w = 1;
+
+    for (depth = 12; j < FFT_N_NUM - 1; depth++)
+    {
+        for (w = 1; w <= 2; w++)
+        {
+            int iters, i;
+            mp_size_t n = (UWORD(1)<<depth);
+            mp_bitcnt_t bits = n*w;
+            mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
+            mp_limb_t * i1, * i2, * r1, * tt;
+        
+            if (depth <= 21) iters = 32*((mp_size_t) 1 << (21 - depth));
+            else iters = FLINT_MAX(32/((mp_size_t) 1 << (depth - 21)), 1);
+
+            i1 = flint_malloc(6*(int_limbs+1)*sizeof(mp_limb_t));
+            i2 = i1 + int_limbs + 1;
+            r1 = i2 + int_limbs + 1;
+            tt = r1 + 2*(int_limbs + 1);
+                
+            flint_mpn_urandomb(i1, state->gmp_state, int_limbs*FLINT_BITS);
+            flint_mpn_urandomb(i2, state->gmp_state, int_limbs*FLINT_BITS);
+            i1[int_limbs] = 0;
+            i2[int_limbs] = 0;
+
+            depth1 = FLINT_CLOG2(bits);
+            depth1 = depth1/2;
+
+            w1 = bits/(UWORD(1)<<(2*depth1));
+
+            best_off = -1;
+            
+            for (off = 0; off <= 4; off++)
+            {
+               start = clock();
+               for (i = 0; i < iters; i++)
+                  _fft_mulmod_2expp1(r1, i1, i2, int_limbs, depth1 - off, w1*((mp_size_t)1 << (off*2)));
+               end = clock();
+               
+               elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+               
+               if (best_off == -1 || elapsed < best)
+               {
+                  best_off = off;
+                  best = elapsed;
+               }
+            }
+           
+            start = clock();
+            for (i = 0; i < iters; i++)
+                flint_mpn_mulmod_2expp1_basecase(r1, i1, i2, 0, bits, tt);
+            end = clock();
+               
+            elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+            if (elapsed < best)
+            {
+                best_d = depth + (w == 2);
+                best_w = w + 1 - 2*(w == 2);
+            }
+
+            flint_tune_mulmod_tab[j++] = best_off;
+            flint_fprintf(stderr, "mulmod_tab: %wu %wu %wd\n",
+                                                     depth, w, best_off);
+
+            flint_free(i1);
+        }
+    }
+
+    flint_tune_mulmod_tab[FFT_N_NUM - 1] = 1;
+
+    flint_tune_params[FLINT_TUNE_FFT_MULMOD_2EXPP1] =
+        FLINT_MAX(((mp_limb_t) 1 << best_d)*best_w/(2*FLINT_BITS),
+                  4096 / FLINT_BITS);
+}
+
+/*****************************************************************************/
+
+const tune_bench_struct fmpz_mat_mul_classical_bench =
+    { "fmpz_mat_mul_classical", FLINT_TUNE_FMPZ_MAT_MUL_CLASSICAL, 0,
+      bench_fmpz_mat_mul_init,
+      bench_fmpz_mat_mul_run,
+      bench_fmpz_mat_mul_clear };
+
+const tune_bench_struct fmpz_mat_mul_multi_mod_bench =
+    { "fmpz_mat_mul_multi_mod", FLINT_TUNE_FMPZ_MAT_MUL_MULTI_MOD, 0,
+      bench_fmpz_mat_mul_init,
+      bench_fmpz_mat_mul_run,
+      bench_fmpz_mat_mul_clear };
+
+const tune_bench_struct fmpz_poly_inv_newton_bench =
+    { "fmpz_poly_inv_newton", FLINT_TUNE_FMPZ_POLY_INV_NEWTON, 1,
+      bench_fmpz_poly_inv_init,
+      bench_fmpz_poly_inv_run,
+      bench_fmpz_poly_inv_clear };
+
+const tune_bench_struct nmod_mat_mul_strassen_bench =
+    { "nmod_mat_mul_strassen", FLINT_TUNE_NMOD_MAT_MUL_STRASSEN, 0,
+      bench_nmod_mat_mul_init,
+      bench_nmod_mat_mul_run,
+      bench_nmod_mat_mul_clear };
+
+const tune_bench_struct nmod_poly_divrem_bench =
+    { "nmod_poly_divrem_divconquer", FLINT_TUNE_NMOD_POLY_DIVREM_DIVCONQUER, 1,
+      bench_nmod_poly_init,
+      bench_nmod_poly_divrem_run,
+      bench_nmod_poly_clear };
+
+const tune_bench_struct nmod_poly_div_bench =
+    { "nmod_poly_div_divconquer", FLINT_TUNE_NMOD_POLY_DIV_DIVCONQUER, 1,
+      bench_nmod_poly_init,
+      bench_nmod_poly_div_run,
+      bench_nmod_poly_clear };
+
+const tune_bench_struct nmod_poly_gcd_bench =
+    { "nmod_poly_gcd", FLINT_TUNE_NMOD_POLY_GCD, 0,
+      bench_nmod_poly_init,
+      bench_nmod_poly_gcd_run,
+      bench_nmod_poly_clear };
+
+const tune_bench_struct nmod_poly_small_gcd_bench =
+    { "nmod_poly_small_gcd", FLINT_TUNE_NMOD_POLY_SMALL_GCD, 0,
+      bench_nmod_poly_init,
+      bench_nmod_poly_gcd_run,
+      bench_nmod_poly_clear };
+
+const tune_bench_struct nmod_poly_mul_ntt_bench =
+    { "nmod_poly_mul_ntt", FLINT_TUNE_NMOD_POLY_MUL_NTT, 0,
+      bench_nmod_poly_init,
+      bench_nmod_poly_mul_run,
+      bench_nmod_poly_clear };
+
+const tune_bench_struct nmod_poly_factor_equal_deg_threaded_bench =
+    { "nmod_poly_factor_equal_deg_threaded",
+      FLINT_TUNE_NMOD_POLY_FACTOR_EQUAL_DEG_THREADED, 0,
+      bench_nmod_poly_factor_init,
+      bench_nmod_poly_factor_run,
+      bench_nmod_poly_factor_clear };
+
+const tune_bench_struct nmod_poly_tree_threaded_bench =
+    { "nmod_poly_tree_threaded", FLINT_TUNE_NMOD_POLY_TREE_THREADED, 0,
+      bench_nmod_poly_tree_init,
+      bench_nmod_poly_tree_run,
+      bench_nmod_poly_tree_clear };
+
+const tune_bench_struct fft_mul_threaded_bench =
+    { "fft_mul_threaded", FLINT_TUNE_FFT_MUL_THREADED, 0,
+      bench_fft_mul_init,
+      bench_fft_mul_run,
+      bench_fft_mul_clear };
+
+/* the small prime transforms are the basecase of the FFT here */
+const tune_bench_struct fft_mul_ntt_bench =
+    { "fft_mul_ntt", FLINT_TUNE_FFT_MUL_NTT, 0,
+      bench_fft_mul_init,
+      bench_fft_mul_run,
+      bench_fft_mul_clear };
+
+const tune_bench_struct mpn_mul_fft_bench =
+    { "mpn_mul_fft", FLINT_TUNE_MPN_MUL_FFT, 0,
+      bench_mpn_mul_init,
+      bench_mpn_mul_run,
+      bench_mpn_mul_clear };
+
+/*
+   The hgcd cutoffs apply inside the recursion rather than at the top
+   level, so they are chosen to minimise the time of a gcd of fixed size.
+*/
+slong tune_hgcd(tune_data_t d, const char * name, slong param,
+                                   slong lo, slong hi, flint_rand_t state)
+{
+    slong c, best_c = 0;
+    double t, best = 0.0;
+
+    d->size = 2000;
+    bench_nmod_poly_init(d, state);
+
+    for (c = lo; c <= hi; c += c / 4)
+    {
+        flint_tune_params[param] = c;
+        t = tune_time(bench_nmod_poly_gcd_run, d);
+
+        flint_fprintf(stderr, "%s: %wd %.3g\n", name, c, t);
+
+        if (best_c == 0 || t < best)
+        {
+            best_c = c;
+            best = t;
+        }
+    }
+
+    bench_nmod_poly_clear(d);
+
+    return best_c;
+}
+
+int
+main(void)
+{
+    tune_data_t d;
+    slong c;
+
+    FLINT_TEST_INIT(state);
+
+    _flint_rand_init_gmp(state);
+
+    tune_fft_tab(state);
+    tune_mulmod_tab(state);
+
+    d->bits = 2;
+    flint_tune_params[FLINT_TUNE_FMPZ_MAT_MUL_CLASSICAL] =
+        tune_crossover(&fmpz_mat_mul_classical_bench, d, 2, 64, state);
+
+    d->bits = FLINT_BITS / 2 - 2;
+    flint_tune_params[FLINT_TUNE_FMPZ_MAT_MUL_MULTI_MOD] =
+        tune_crossover(&fmpz_mat_mul_multi_mod_bench, d, 20, 256, state);
+
+    d->bits = 10;
+    flint_tune_params[FLINT_TUNE_FMPZ_POLY_INV_NEWTON] =
+        tune_crossover(&fmpz_poly_inv_newton_bench, d, 4, 256, state);
+
+    d->n = n_randprime(state, FLINT_BITS - 1, 1);
+    flint_tune_params[FLINT_TUNE_NMOD_MAT_MUL_STRASSEN] =
+        tune_crossover(&nmod_mat_mul_strassen_bench, d, 32, 1024, state);
+
+    /* the division cutoff must not exceed the divrem cutoff */
+    c = tune_crossover(&nmod_poly_divrem_bench, d, 16, 2000, state);
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_DIVREM_DIVCONQUER] = c;
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_DIV_DIVCONQUER] =
+        tune_crossover(&nmod_poly_div_bench, d, 16, c, state);
+
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD] = tune_hgcd(d,
+                "nmod_poly_hgcd", FLINT_TUNE_NMOD_POLY_HGCD, 16, 512, state);
+
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_HGCD_NTT] = tune_hgcd(d,
+            "nmod_poly_hgcd_ntt", FLINT_TUNE_NMOD_POLY_HGCD_NTT, 8, 512, state);
+
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_GCD] =
+        tune_crossover(&nmod_poly_gcd_bench, d, 50, 2000, state);
+
+#if FFT_NTT
+    /* a word sized modulus needs the most primes */
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_MUL_NTT] =
+        tune_crossover(&nmod_poly_mul_ntt_bench, d, 16, 2000, state);
+#endif
+
+    d->n = 7;
+    flint_tune_params[FLINT_TUNE_NMOD_POLY_SMALL_GCD] =
+        tune_crossover(&nmod_poly_small_gcd_bench, d, 50, 2000, state);
+
+    /* sizes are in limbs of the product */
+    if (flint_cpu_features() & FLINT_CPU_AVX512IFMA)
+        flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] =
+            tune_crossover(&fft_mul_ntt_bench, d, 1024, WORD(1) << 21, state);
+
+    /* sizes are in limbs of the smaller operand */
+    flint_tune_params[FLINT_TUNE_MPN_MUL_FFT] =
+        tune_crossover(&mpn_mul_fft_bench, d, 64, 20000, state);
+
+    /* this needs more than one core, and is timed without the above */
+    c = sysconf(_SC_NPROCESSORS_ONLN);
+    if (c > 1)
+    {
+        slong ntt = flint_tune_params[FLINT_TUNE_FFT_MUL_NTT];
+
+        flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = 0;
+        flint_set_num_threads(FLINT_MIN(c, 64));
+        flint_tune_params[FLINT_TUNE_FFT_MUL_THREADED] =
+            tune_crossover(&fft_mul_threaded_bench, d, 1024, WORD(1) << 20, state);
+
+        d->n = n_randprime(state, FLINT_BITS - 1, 1);
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_FACTOR_EQUAL_DEG_THREADED] =
+            tune_crossover(&nmod_poly_factor_equal_deg_threaded_bench, d,
+                                                            16, 2000, state);
+        flint_tune_params[FLINT_TUNE_NMOD_POLY_TREE_THREADED] =
+            tune_crossover(&nmod_poly_tree_threaded_bench, d, 64, 20000, state);
+        flint_set_num_threads(1);
+        flint_tune_params[FLINT_TUNE_FFT_MUL_NTT] = ntt;
+    }
+
+    flint_tune_write(stdout);
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    return 0;
+}
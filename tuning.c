@@ -0,0 +1,301 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "flint.h"
+#include "fft_tuning.h"
+
+#define TUNE_PARAM_DEFAULTS \
+    { 12, 60, 32, 256, 300, 300, 100, 32, 340, 200, 200, 256, 1024, 128, \
+      FFT_MULMOD_2EXPP1_CUTOFF, 16384, 1048576, 2000 }
+
+slong flint_tune_params[FLINT_TUNE_NUM] = TUNE_PARAM_DEFAULTS;
+slong flint_tune_fft_tab[5][2] = FFT_TAB;
+slong flint_tune_mulmod_tab[FFT_N_NUM] = MULMOD_TAB;
+
+static const slong tune_params_default[FLINT_TUNE_NUM] = TUNE_PARAM_DEFAULTS;
+static const slong tune_fft_tab_default[5][2] = FFT_TAB;
+static const slong tune_mulmod_tab_default[FFT_N_NUM] = MULMOD_TAB;
+
+typedef struct
+{
+    const char * name;
+    slong * values;
+    const slong * defaults;
+    slong length;
+    slong min;
+    slong max;
+} tune_entry_struct;
+
+#define TUNE_PARAM(name, i, min) \
+    { name, flint_tune_params + (i), tune_params_default + (i), \
+      1, min, WORD_MAX }
+
+/*
+   The minima keep the algorithms well defined; the FFT offsets are bounded
+   by the range searched by the tuner.
+*/
+static const tune_entry_struct tune_entries[] =
+{
+    TUNE_PARAM("fmpz_mat_mul_classical", FLINT_TUNE_FMPZ_MAT_MUL_CLASSICAL, 1),
+    TUNE_PARAM("fmpz_mat_mul_multi_mod", FLINT_TUNE_FMPZ_MAT_MUL_MULTI_MOD, 0),
+    TUNE_PARAM("fmpz_poly_inv_newton", FLINT_TUNE_FMPZ_POLY_INV_NEWTON, 2),
+    TUNE_PARAM("nmod_mat_mul_strassen", FLINT_TUNE_NMOD_MAT_MUL_STRASSEN, 5),
+    TUNE_PARAM("nmod_poly_divrem_divconquer",
+                             FLINT_TUNE_NMOD_POLY_DIVREM_DIVCONQUER, 2),
+    TUNE_PARAM("nmod_poly_div_divconquer",
+                             FLINT_TUNE_NMOD_POLY_DIV_DIVCONQUER, 2),
+    TUNE_PARAM("nmod_poly_hgcd", FLINT_TUNE_NMOD_POLY_HGCD, 2),
+    TUNE_PARAM("nmod_poly_hgcd_ntt", FLINT_TUNE_NMOD_POLY_HGCD_NTT, 1),
+    TUNE_PARAM("nmod_poly_gcd", FLINT_TUNE_NMOD_POLY_GCD, 8),
+    TUNE_PARAM("nmod_poly_small_gcd", FLINT_TUNE_NMOD_POLY_SMALL_GCD, 8),
+    TUNE_PARAM("nmod_poly_mul_ntt", FLINT_TUNE_NMOD_POLY_MUL_NTT, 1),
+    TUNE_PARAM("nmod_poly_factor_equal_deg_threaded",
+                             FLINT_TUNE_NMOD_POLY_FACTOR_EQUAL_DEG_THREADED, 0),
+    TUNE_PARAM("nmod_poly_tree_threaded",
+                             FLINT_TUNE_NMOD_POLY_TREE_THREADED, 0),
+    TUNE_PARAM("nmod_poly_tree_preinv", FLINT_TUNE_NMOD_POLY_TREE_PREINV, 0),
+    TUNE_PARAM("fft_mulmod_2expp1", FLINT_TUNE_FFT_MULMOD_2EXPP1,
+                                                          4096 / FLINT_BITS),
+    TUNE_PARAM("fft_mul_threaded", FLINT_TUNE_FFT_MUL_THREADED, 0),
+    TUNE_PARAM("fft_mul_ntt", FLINT_TUNE_FFT_MUL_NTT, 0),
+    TUNE_PARAM("mpn_mul_fft", FLINT_TUNE_MPN_MUL_FFT, 64),
+    { "fft_tab", flint_tune_fft_tab[0], tune_fft_tab_default[0], 10, 0, 4 },
+    { "mulmod_tab", flint_tune_mulmod_tab, tune_mulmod_tab_default,
+                                                          FFT_N_NUM, 0, 4 }
+};
+
+#define TUNE_ENTRIES (sizeof(tune_entries) / sizeof(tune_entry_struct))
+#define TUNE_VALUES (FLINT_TUNE_NUM + 10 + FFT_N_NUM)
+
+static int tune_consistent(void)
+{
+    return flint_tune_params[FLINT_TUNE_NMOD_POLY_DIV_DIVCONQUER]
+             <= flint_tune_params[FLINT_TUNE_NMOD_POLY_DIVREM_DIVCONQUER];
+}
+
+static void tune_save(slong * buf)
+{
+    slong i;
+
+    for (i = 0; i < TUNE_ENTRIES; i++)
+    {
+        memcpy(buf, tune_entries[i].values,
+                                      tune_entries[i].length * sizeof(slong));
+        buf += tune_entries[i].length;
+    }
+}
+
+static void tune_restore(const slong * buf)
+{
+    slong i;
+
+    for (i = 0; i < TUNE_ENTRIES; i++)
+    {
+        memcpy(tune_entries[i].values, buf,
+                                      tune_entries[i].length * sizeof(slong));
+        buf += tune_entries[i].length;
+    }
+}
+
+static int _tune_set(const char * name, const slong * values, slong len)
+{
+    slong i, j;
+
+    for (i = 0; i < TUNE_ENTRIES; i++)
+    {
+        if (strcmp(name, tune_entries[i].name) == 0)
+        {
+            if (len != tune_entries[i].length)
+                return 0;
+
+            for (j = 0; j < len; j++)
+                if (values[j] < tune_entries[i].min ||
+                    values[j] > tune_entries[i].max)
+                    return 0;
+
+            for (j = 0; j < len; j++)
+                tune_entries[i].values[j] = values[j];
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void flint_tune_reset(void)
+{
+    slong i;
+
+    for (i = 0; i < TUNE_ENTRIES; i++)
+        memcpy(tune_entries[i].values, tune_entries[i].defaults,
+                                      tune_entries[i].length * sizeof(slong));
+}
+
+int flint_tune_set(const char * name, const slong * values, slong len)
+{
+    slong buf[TUNE_VALUES];
+
+    tune_save(buf);
+
+    if (!_tune_set(name, values, len) || !tune_consistent())
+    {
+        tune_restore(buf);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+   Each line of a profile is a parameter name followed by its values,
+   separated by white space. Blank lines and lines starting with # are
+   ignored, as are parameters not mentioned in the file.
+*/
+int flint_tune_load(const char * filename)
+{
+    slong buf[TUNE_VALUES], values[64], len;
+    char line[1024], name[64], * s, * end;
+    int ok = 1;
+    FILE * file;
+
+    file = fopen(filename, "r");
+
+    if (file == NULL)
+        return 0;
+
+    tune_save(buf);
+
+    while (ok && fgets(line, sizeof(line), file) != NULL)
+    {
+        if (strchr(line, '\n') == NULL && !feof(file))
+        {
+            ok = 0; /* line too long */
+            break;
+        }
+
+        s = line;
+        while (isspace((unsigned char) *s))
+            s++;
+
+        if (*s == '\0' || *s == '#')
+            continue;
+
+        len = 0;
+        while (s[len] != '\0' && !isspace((unsigned char) s[len]))
+            len++;
+
+        if (len >= sizeof(name))
+        {
+            ok = 0;
+            break;
+        }
+
+        memcpy(name, s, len);
+        name[len] = '\0';
+        s += len;
+
+        for (len = 0; ; len++)
+        {
+            while (isspace((unsigned char) *s))
+                s++;
+
+            if (*s == '\0')
+                break;
+
+            if (len == 64)
+            {
+                ok = 0;
+                break;
+            }
+
+            values[len] = strtol(s, &end, 10);
+
+            if (end == s)
+            {
+                ok = 0;
+                break;
+            }
+
+            s = end;
+        }
+
+        ok = ok && _tune_set(name, values, len);
+    }
+
+    fclose(file);
+
+    if (!ok || !tune_consistent())
+    {
+        tune_restore(buf);
+        return 0;
+    }
+
+    return 1;
+}
+
+int flint_tune_load_env(void)
+{
+    const char * filename = getenv("FLINT_TUNE_FILE");
+
+    if (filename == NULL || filename[0] == '\0')
+        return 1;
+
+    return flint_tune_load(filename);
+}
+
+/*
+   A bad profile must not stop programs which merely link FLINT, so the
+   built-in defaults are kept and a warning is printed. Other compilers
+   have no constructors; there flint_tune_load_env has to be called by the
+   program itself.
+*/
+#if defined(__GNUC__)
+
+static void __attribute__((constructor)) tune_init(void)
+{
+    if (!flint_tune_load_env())
+        flint_fprintf(stderr, "Warning (FLINT_TUNE_FILE). Unable to load "
+           "tuning profile %s, using the defaults.\n",
+                                                  getenv("FLINT_TUNE_FILE"));
+}
+
+#endif
+
+void flint_tune_write(FILE * file)
+{
+    slong i, j;
+
+    flint_fprintf(file, "# FLINT tuning profile\n");
+
+    for (i = 0; i < TUNE_ENTRIES; i++)
+    {
+        flint_fprintf(file, "%s", tune_entries[i].name);
+
+        for (j = 0; j < tune_entries[i].length; j++)
+            flint_fprintf(file, " %wd", tune_entries[i].values[j]);
+
+        flint_fprintf(file, "\n");
+    }
+}
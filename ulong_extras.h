@@ -122,9 +122,12 @@ n_primes_next(n_primes_t iter)
 
 extern const unsigned int flint_primes_small[];
 
-extern FLINT_TLS_PREFIX mp_limb_t * _flint_primes[FLINT_BITS];
-extern FLINT_TLS_PREFIX double * _flint_prime_inverses[FLINT_BITS];
-extern FLINT_TLS_PREFIX int _flint_primes_used;
+extern mp_limb_t * _flint_primes[FLINT_BITS];
+extern double * _flint_prime_inverses[FLINT_BITS];
+extern int _flint_primes_used;
+
+FLINT_DLL mp_limb_t * _n_primes_get(int m);
+FLINT_DLL double * _n_prime_inverses_get(int m);
 
 FLINT_DLL void n_compute_primes(ulong num_primes);
 
@@ -149,6 +152,8 @@ FLINT_DLL mp_limb_t n_randprime(flint_rand_t state, ulong bits, int proved);
 
 FLINT_DLL mp_limb_t n_randtest_prime(flint_rand_t state, int proved);
 
+FLINT_DLL mp_limb_t n_randtest_ntt_modulus(flint_rand_t state);
+
 FLINT_DLL mp_limb_t n_pow(mp_limb_t n, ulong exp);
 
 FLINT_DLL mp_limb_t n_flog(mp_limb_t n, mp_limb_t b);
@@ -37,12 +37,27 @@
 #include "ulong_extras.h"
 #include <pthread.h>
 
-#if FLINT_REENTRANT && !HAVE_TLS
-
-static pthread_once_t primes_initialised = PTHREAD_ONCE_INIT;
-pthread_mutex_t primes_lock;
+/*
+   The cache is shared by all threads. Readers take no lock: they load the
+   pointer for the power-of-two slot they need with acquire semantics and
+   compute the primes only if it is still NULL. Writers are serialised by
+   primes_lock and fill a new array completely before its pointer is stored
+   with release semantics, so any non-NULL pointer a reader sees refers to
+   initialised data. Arrays are never replaced or freed while the cache is
+   in use, so returned pointers remain valid. Without the atomic builtins
+   readers take primes_lock instead.
+*/
+
+#if defined(__ATOMIC_ACQUIRE)
+#define PRIMES_ATOMIC 1
+#define PRIMES_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#else
+#define PRIMES_ATOMIC 0
+#define PRIMES_STORE(x, v) ((x) = (v))
 #endif
 
+static pthread_mutex_t primes_lock = PTHREAD_MUTEX_INITIALIZER;
+
 const unsigned int flint_primes_small[] =
 {
     2,3,5,7,11,13,17,19,23,29,31,37,41,43,47,53,59,61,67,71,73,79,83,89,97,
@@ -58,61 +73,108 @@ const unsigned int flint_primes_small[] =
 };
 
 
-/* _flint_primes[i] holds an array of 2^i primes */
-FLINT_TLS_PREFIX mp_limb_t * _flint_primes[FLINT_BITS];
-FLINT_TLS_PREFIX double * _flint_prime_inverses[FLINT_BITS];
-FLINT_TLS_PREFIX int _flint_primes_used = 0;
+/* _flint_primes[i] holds an array of at least 2^i primes, or NULL */
+mp_limb_t * _flint_primes[FLINT_BITS];
+double * _flint_prime_inverses[FLINT_BITS];
+int _flint_primes_used = 0;
 
-#if FLINT_REENTRANT && !HAVE_TLS
-void n_compute_primes_init()
+mp_limb_t * _n_primes_get(int m)
 {
-   pthread_mutex_init(&primes_lock, NULL);
+#if PRIMES_ATOMIC
+    return __atomic_load_n(&_flint_primes[m], __ATOMIC_ACQUIRE);
+#else
+    mp_limb_t * primes;
+
+    pthread_mutex_lock(&primes_lock);
+    primes = _flint_primes[m];
+    pthread_mutex_unlock(&primes_lock);
+
+    return primes;
+#endif
 }
+
+double * _n_prime_inverses_get(int m)
+{
+#if PRIMES_ATOMIC
+    return __atomic_load_n(&_flint_prime_inverses[m], __ATOMIC_ACQUIRE);
+#else
+    double * inverses;
+
+    pthread_mutex_lock(&primes_lock);
+    inverses = _flint_prime_inverses[m];
+    pthread_mutex_unlock(&primes_lock);
+
+    return inverses;
 #endif
+}
 
 void
 n_compute_primes(ulong num_primes)
 {
     int i, m;
     ulong num_computed;
-
-#if FLINT_REENTRANT && !HAVE_TLS
-    pthread_once(&primes_initialised, n_compute_primes_init);
-    pthread_mutex_lock(&primes_lock);
-#endif
+    mp_limb_t * primes;
+    double * inverses;
 
     m = FLINT_CLOG2(num_primes);
 
-    if (_flint_primes_used == 0)
-        flint_register_cleanup_function(n_cleanup_primes);
+    if (_n_primes_get(m) != NULL)
+        return;
+
+    pthread_mutex_lock(&primes_lock);
 
     if (m >= _flint_primes_used)
     {
         n_primes_t iter;
 
         num_computed = UWORD(1) << m;
-        _flint_primes[m] = flint_malloc(sizeof(mp_limb_t) * num_computed);
-        _flint_prime_inverses[m] = flint_malloc(sizeof(double) * num_computed);
+        primes = flint_malloc(sizeof(mp_limb_t) * num_computed);
+        inverses = flint_malloc(sizeof(double) * num_computed);
 
         n_primes_init(iter);
         for (i = 0; i < num_computed; i++)
         {
-            _flint_primes[m][i] = n_primes_next(iter);
-            _flint_prime_inverses[m][i] = n_precompute_inverse(_flint_primes[m][i]);
+            primes[i] = n_primes_next(iter);
+            inverses[i] = n_precompute_inverse(primes[i]);
         }
         n_primes_clear(iter);
 
-        /* copy to lower power-of-two slots */
-        for (i = m - 1; i >= _flint_primes_used; i--)
+        /* publish in this slot and the lower power-of-two slots */
+        for (i = m; i >= _flint_primes_used; i--)
         {
-            _flint_primes[i] = _flint_primes[m];
-            _flint_prime_inverses[i] = _flint_prime_inverses[m];
+            PRIMES_STORE(_flint_prime_inverses[i], inverses);
+            PRIMES_STORE(_flint_primes[i], primes);
         }
+
         _flint_primes_used = m + 1;
     }
 
-#if FLINT_REENTRANT && !HAVE_TLS
     pthread_mutex_unlock(&primes_lock);
-#endif
 }
 
+void
+n_cleanup_primes()
+{
+    int i;
+
+    pthread_mutex_lock(&primes_lock);
+
+    for (i = 0; i < _flint_primes_used; i++)
+    {
+        if (i < _flint_primes_used - 1 && _flint_primes[i] == _flint_primes[i+1])
+            continue;
+
+        flint_free(_flint_primes[i]);
+        flint_free(_flint_prime_inverses[i]);
+    }
+
+    for (i = 0; i < _flint_primes_used; i++)
+    {
+        PRIMES_STORE(_flint_primes[i], NULL);
+        PRIMES_STORE(_flint_prime_inverses[i], NULL);
+    }
+
+    _flint_primes_used = 0;
+
+    pthread_mutex_unlock(&primes_lock);
+}
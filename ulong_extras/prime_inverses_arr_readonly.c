@@ -30,15 +30,19 @@
 
 const double * n_prime_inverses_arr_readonly(ulong num_primes)
 {
+    double * arr;
     int m;
 
     if (num_primes < 1)
         return NULL;
 
     m = FLINT_CLOG2(num_primes);
-    if (m >= _flint_primes_used)
+    if ((arr = _n_prime_inverses_get(m)) == NULL)
+    {
         n_compute_primes(num_primes);
+        arr = _n_prime_inverses_get(m);
+    }
 
-    return _flint_prime_inverses[m];
+    return arr;
 }
 
@@ -30,15 +30,19 @@
 
 const mp_limb_t * n_primes_arr_readonly(ulong num_primes)
 {
+    mp_limb_t * arr;
     int m;
 
     if (num_primes < 1)
         return NULL;
 
     m = FLINT_CLOG2(num_primes);
-    if (m >= _flint_primes_used)
+    if ((arr = _n_primes_get(m)) == NULL)
+    {
         n_compute_primes(num_primes);
+        arr = _n_primes_get(m);
+    }
 
-    return _flint_primes[m];
+    return arr;
 }
 
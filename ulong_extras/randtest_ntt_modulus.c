@@ -17,30 +17,27 @@
     Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
 
 =============================================================================*/
-/******************************************************************************
-
-    Copyright (C) 2013 Fredrik Johansson
-
-******************************************************************************/
 
 #include <gmp.h>
 #include "flint.h"
 #include "ulong_extras.h"
 
-void
-n_cleanup_primes()
+mp_limb_t n_randtest_ntt_modulus(flint_rand_t state)
 {
-    int i;
-
-    for (i = 0; i < _flint_primes_used; i++)
+    /* primes with a large power of two dividing p - 1, and others */
+    switch (n_randint(state, 5))
     {
-        if (i < _flint_primes_used - 1 && _flint_primes[i] == _flint_primes[i+1])
-            continue;
-
-        flint_free(_flint_primes[i]);
-        flint_free(_flint_prime_inverses[i]);
+        case 0:
+            return UWORD(998244353);
+        case 1:
+            return UWORD(2013265921);
+#if FLINT64
+        case 2:
+            return UWORD(0x3ffc000000001);
+        case 3:
+            return n_randtest_prime(state, 0);
+#endif
+        default:
+            return n_randtest_not_zero(state);
     }
-
-    _flint_primes_used = 0;
 }
-
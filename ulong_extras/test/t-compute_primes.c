@@ -29,6 +29,32 @@
 #include <gmp.h>
 #include "flint.h"
 #include "ulong_extras.h"
+#include "thread_pool.h"
+
+typedef struct
+{
+    const mp_limb_t * ref_primes;
+    const double * ref_inverses;
+    slong n;
+    int ok;
+}
+check_arg_t;
+
+void * check_worker(void * arg_ptr)
+{
+    check_arg_t * arg = (check_arg_t *) arg_ptr;
+    const mp_limb_t * primes;
+    const double * inverses;
+    slong n = arg->n;
+
+    primes = n_primes_arr_readonly(n + 1);
+    inverses = n_prime_inverses_arr_readonly(n + 1);
+
+    arg->ok = (primes[n] == arg->ref_primes[n]
+                && inverses[n] == arg->ref_inverses[n]);
+
+    return NULL;
+}
 
 int main()
 {
@@ -78,10 +104,40 @@ int main()
         }
     }
 
+    /* extend the shared cache from several threads at once */
+    for (i = 0; i < 10; i++)
+    {
+        check_arg_t args[8];
+        slong j;
+
+        n_cleanup_primes();
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        for (j = 0; j < 8; j++)
+        {
+            args[j].ref_primes = ref_primes;
+            args[j].ref_inverses = ref_inverses;
+            args[j].n = n_randtest(state) % lim;
+        }
+
+        flint_parallel_map(check_worker, args, sizeof(check_arg_t), 8);
+
+        for (j = 0; j < 8; j++)
+        {
+            if (!args[j].ok)
+            {
+                flint_printf("FAIL (threaded)!\n");
+                flint_printf("n = %wd\n", args[j].n);
+                abort();
+            }
+        }
+    }
+
     flint_free(ref_primes);
     flint_free(ref_inverses);
-    FLINT_TEST_CLEANUP(state);
-    
+    flint_randclear(state);
+    flint_cleanup_master();
+
     flint_printf("PASS\n");
     return 0;
 }